@@ -18,6 +18,7 @@ PUBLIC_HEADERS += $$PWD/qknx1bit.h \
     $$PWD/qknxchar.h \
     $$PWD/qknxcharstring.h \
     $$PWD/qknxdatapointtype.h \
+    $$PWD/qknxdatapointtypecodec.h \
     $$PWD/qknxdatapointtypefactory.h \
     $$PWD/qknxdatetime.h \
     $$PWD/qknxelectricalenergy.h \
@@ -28,7 +29,8 @@ PUBLIC_HEADERS += $$PWD/qknx1bit.h \
     $$PWD/qknxutf8string.h \
     $$PWD/qknxvarstring.h
 
-PRIVATE_HEADERS += $$PWD/qknxdatapointtype_p.h
+PRIVATE_HEADERS += $$PWD/qknxdatapointtype_p.h \
+    $$PWD/qknxdatapointtypecodec_p.h
 
 SOURCES += $$PWD/qknx1bit.cpp \
     $$PWD/qknx1bitcontrolled.cpp \
@@ -48,6 +50,7 @@ SOURCES += $$PWD/qknx1bit.cpp \
     $$PWD/qknxchar.cpp \
     $$PWD/qknxcharstring.cpp \
     $$PWD/qknxdatapointtype.cpp \
+    $$PWD/qknxdatapointtypecodec.cpp \
     $$PWD/qknxdatapointtypefactory.cpp \
     $$PWD/qknxdatetime.cpp \
     $$PWD/qknxelectricalenergy.cpp \
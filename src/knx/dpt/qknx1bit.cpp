@@ -110,9 +110,12 @@ QKnx1Bit::QKnx1Bit(bool bit)
 QKnx1Bit::QKnx1Bit(int subType, bool bit)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-bit"));
-    setRangeText(tr("true"), tr("false"));
-    setRange(QVariant(0x00), QVariant(0x01));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("1-bit"))
+        .setRangeText(QT_TR_NOOP("true"), QT_TR_NOOP("false"))
+        .setRange(QVariant(0x00), QVariant(0x01))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setBit(bit);
 }
@@ -150,8 +153,11 @@ CLASS::CLASS() \
 CLASS::CLASS(State state) \
     : QKnx1Bit(SubType, bool(state)) \
 { \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QT_TR_NOOP(RANGE_TEXT_MINIMUM), QT_TR_NOOP(RANGE_TEXT_MAXIMUM)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::State CLASS::value() const \
 { \
@@ -33,6 +33,25 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxPrivate
+{
+    // range texts naming the state texts of the controlled 1-bit type, both
+    // are translated when read
+    static QKnxDatapointTypeMetadata::Text noControlText(const QKnxDatapointType &dpt)
+    {
+        return QKnxDatapointTypeMetadata::Text(QKnx1BitControlled::staticMetaObject.className(),
+            QT_TR_NOOP("No control, %1"))
+            .arg(QKnxDatapointTypeMetadata::of(dpt).m_minimumText);
+    }
+
+    static QKnxDatapointTypeMetadata::Text controlledText(const QKnxDatapointType &dpt)
+    {
+        return QKnxDatapointTypeMetadata::Text(QKnx1BitControlled::staticMetaObject.className(),
+            QT_TR_NOOP("Controlled, %1"))
+            .arg(QKnxDatapointTypeMetadata::of(dpt).m_maximumText);
+    }
+}
+
 /*!
     \class QKnx1BitControlled
     \inherits QKnxFixedSizeDatapointType
@@ -86,10 +105,12 @@ QKnx1BitControlled::QKnx1BitControlled()
 QKnx1BitControlled::QKnx1BitControlled(int subType, bool state, bool control)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-bit controlled"));
-
-    setRange(QVariant(0x00), QVariant(0x03));
-    setRangeText(tr("No control, false"), tr("Controlled, true"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("1-bit controlled"))
+        .setRange(QVariant(0x00), QVariant(0x03))
+        .setRangeText(QT_TR_NOOP("No control, false"), QT_TR_NOOP("Controlled, true"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValueBit(state);
     setControlBit(control);
 }
@@ -103,8 +124,10 @@ QKnx1BitControlled::QKnx1BitControlled(int subType, const QKnxDatapointType &dpt
         bool control)
     : QKnx1BitControlled(subType, state, control)
 {
-    setMinimumText(tr("No control, %1").arg(dpt.minimumText()));
-    setMaximumText(tr("Controlled, %1").arg(dpt.maximumText()));
+    // the texts depend on the argument, so this instance gets its own copy
+    QKnxDatapointTypeMetadata::assign(this, QKnxDatapointTypeMetadata(*this)
+        .setRangeText(QKnxPrivate::noControlText(dpt), QKnxPrivate::controlledText(dpt))
+        .share());
 }
 
 /*!
@@ -152,9 +175,14 @@ CLASS::CLASS() \
     : CLASS(State(0), Control::NoControl) \
 {} \
 CLASS::CLASS(State state, Control control) \
-    : QKnx1BitControlled(SubType, CLASS1(), bool(state), bool(control)) \
+    : QKnx1BitControlled(SubType, bool(state), bool(control)) \
 { \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QKnxPrivate::noControlText(CLASS1()), \
+            QKnxPrivate::controlledText(CLASS1())) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::State CLASS::state() const \
 { \
@@ -68,9 +68,12 @@ QKnx1Byte::QKnx1Byte(quint8 value)
 QKnx1Byte::QKnx1Byte(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-byte"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("Value: 0"), tr("Value: 255"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("1-byte"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setRangeText(QT_TR_NOOP("Value: 0"), QT_TR_NOOP("Value: 255"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -176,9 +179,12 @@ QKnxScloMode::QKnxScloMode()
 QKnxScloMode::QKnxScloMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("SCLO Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Autonomous, 0"), tr("Master, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("SCLO Mode"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Autonomous, 0"), QT_TR_NOOP("Master, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -256,9 +262,12 @@ QKnxBuildingMode::QKnxBuildingMode()
 QKnxBuildingMode::QKnxBuildingMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Building Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Building in use, 0"), tr("Building protection, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Building Mode"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Building in use, 0"), QT_TR_NOOP("Building protection, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -332,9 +341,12 @@ QKnxOccupyMode::QKnxOccupyMode()
 QKnxOccupyMode::QKnxOccupyMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Occupied"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Occupied, 0"), tr("Not occupied, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Occupied"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Occupied, 0"), QT_TR_NOOP("Not occupied, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -411,9 +423,12 @@ QKnxPriority::QKnxPriority()
 QKnxPriority::QKnxPriority(Priority priority)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Priority"));
-    setRange(QVariant(0x00), QVariant(0x03));
-    setRangeText(tr("High, 0"), tr("void, 3"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Priority"))
+        .setRange(QVariant(0x00), QVariant(0x03))
+        .setRangeText(QT_TR_NOOP("High, 0"), QT_TR_NOOP("void, 3"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setPriority(priority);
 }
 
@@ -486,9 +501,12 @@ QKnxLightApplicationMode::QKnxLightApplicationMode()
 QKnxLightApplicationMode::QKnxLightApplicationMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Light application mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Normal, 0"), tr("Night round, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Light application mode"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Normal, 0"), QT_TR_NOOP("Night round, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -591,9 +609,12 @@ QKnxApplicationArea::QKnxApplicationArea()
 QKnxApplicationArea::QKnxApplicationArea(Area area)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Application Area"));
-    setRange(QVariant(0x00), QVariant(0x32));
-    setRangeText(tr("no fault, 0"), tr("Shutters and blinds, 50"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Application Area"))
+        .setRange(QVariant(0x00), QVariant(0x32))
+        .setRangeText(QT_TR_NOOP("no fault, 0"), QT_TR_NOOP("Shutters and blinds, 50"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setArea(area);
 }
 
@@ -706,9 +727,12 @@ QKnxAlarmClassType::QKnxAlarmClassType()
 QKnxAlarmClassType::QKnxAlarmClassType(Type type)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Alarm"));
-    setRange(QVariant(0x01), QVariant(0x03));
-    setRangeText(tr("Simple alarm, 1"), tr("Extended alarm, 3"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Alarm"))
+        .setRange(QVariant(0x01), QVariant(0x03))
+        .setRangeText(QT_TR_NOOP("Simple alarm, 1"), QT_TR_NOOP("Extended alarm, 3"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setType(type);
 }
 
@@ -792,9 +816,12 @@ QKnxPsuMode::QKnxPsuMode()
 QKnxPsuMode::QKnxPsuMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("PSU Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Disabled, 0"), tr("Automatic, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("PSU Mode"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Disabled, 0"), QT_TR_NOOP("Automatic, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -908,9 +935,12 @@ QKnxErrorClassSystem::QKnxErrorClassSystem()
 QKnxErrorClassSystem::QKnxErrorClassSystem(Error error)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("System error class"));
-    setRange(QVariant(0x00), QVariant(0x12));
-    setRangeText(tr("No fault, 0"), tr("Group object type exceeds, 18"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("System error class"))
+        .setRange(QVariant(0x00), QVariant(0x12))
+        .setRangeText(QT_TR_NOOP("No fault, 0"), QT_TR_NOOP("Group object type exceeds, 18"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setError(error);
 }
 
@@ -988,9 +1018,12 @@ QKnxErrorClassHvac::QKnxErrorClassHvac()
 QKnxErrorClassHvac::QKnxErrorClassHvac(Error error)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("HVAC error class"));
-    setRange(QVariant(0x00), QVariant(0x04));
-    setRangeText(tr("No fault, 0"), tr("Other fault, 4"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("HVAC error class"))
+        .setRange(QVariant(0x00), QVariant(0x04))
+        .setRangeText(QT_TR_NOOP("No fault, 0"), QT_TR_NOOP("Other fault, 4"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setError(error);
 }
 
@@ -1084,9 +1117,12 @@ QKnxTimeDelay::QKnxTimeDelay()
 QKnxTimeDelay::QKnxTimeDelay(Delay delay)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Time delay"));
-    setRange(QVariant(0x00), QVariant(0x19));
-    setRangeText(tr("Not active, 0"), tr("Twenty four hours, 25"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Time delay"))
+        .setRange(QVariant(0x00), QVariant(0x19))
+        .setRangeText(QT_TR_NOOP("Not active, 0"), QT_TR_NOOP("Twenty four hours, 25"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setDelay(delay);
 }
 
@@ -1168,9 +1204,12 @@ QKnxBeaufortWindForceScale::QKnxBeaufortWindForceScale()
 QKnxBeaufortWindForceScale::QKnxBeaufortWindForceScale(Force force)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Wind force scale (0..12)"));
-    setRange(QVariant(0x00), QVariant(0x0c));
-    setRangeText(tr("Calm (no wind), 0"), tr("Hurricane, 12"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Wind force scale (0..12)"))
+        .setRange(QVariant(0x00), QVariant(0x0c))
+        .setRangeText(QT_TR_NOOP("Calm (no wind), 0"), QT_TR_NOOP("Hurricane, 12"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setForce(force);
 }
 
@@ -1247,9 +1286,12 @@ QKnxSensorSelect::QKnxSensorSelect()
 QKnxSensorSelect::QKnxSensorSelect(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Sensor mode"));
-    setRange(QVariant(0x00), QVariant(0x04));
-    setRangeText(tr("Inactive, 0"), tr("Temperature sensor input, 12"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Sensor mode"))
+        .setRange(QVariant(0x00), QVariant(0x04))
+        .setRangeText(QT_TR_NOOP("Inactive, 0"), QT_TR_NOOP("Temperature sensor input, 12"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setMode(mode);
 }
 
@@ -1321,9 +1363,12 @@ QKnxActuatorConnectType::QKnxActuatorConnectType()
 QKnxActuatorConnectType::QKnxActuatorConnectType(Type type)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Actuator connect type"));
-    setRange(QVariant(0x01), QVariant(0x02));
-    setRangeText(tr("Sensor connection, 1"), tr("Controller connection, 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Actuator connect type"))
+        .setRange(QVariant(0x01), QVariant(0x02))
+        .setRangeText(QT_TR_NOOP("Sensor connection, 1"), QT_TR_NOOP("Controller connection, 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setType(type);
 }
 
@@ -1418,9 +1463,12 @@ QKnxCloudCover::QKnxCloudCover()
 QKnxCloudCover::QKnxCloudCover(Scale scale)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Cloud cover"));
-    setRange(QVariant(0x00), QVariant(0x09));
-    setRangeText(tr("Cloudless, 0"), tr("Sky is obstructed from view, 9"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Cloud cover"))
+        .setRange(QVariant(0x00), QVariant(0x09))
+        .setRangeText(QT_TR_NOOP("Cloudless, 0"), QT_TR_NOOP("Sky is obstructed from view, 9"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setCloudCover(scale);
 }
 
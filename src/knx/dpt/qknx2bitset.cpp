@@ -71,8 +71,11 @@ QKnx2BitSet::QKnx2BitSet(quint8 value)
 QKnx2BitSet::QKnx2BitSet(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-bit set"));
-    setRange(QVariant(0x00), QVariant(0x03));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("2-bit set"))
+        .setRange(QVariant(0x00), QVariant(0x03))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(value);
 }
 
@@ -150,8 +153,11 @@ QKnxOnOffAction::QKnxOnOffAction()
 QKnxOnOffAction::QKnxOnOffAction(Action action)
     : QKnx2BitSet(SubType, quint8(action))
 {
-    setDescription(tr("On/Off Action"));
-    setRangeText(tr("Minimum Off, 0"), tr("Maximum On/Off, 3"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("On/Off Action"))
+        .setRangeText(QT_TR_NOOP("Minimum Off, 0"), QT_TR_NOOP("Maximum On/Off, 3"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
@@ -221,9 +227,12 @@ QKnxAlarmReaction::QKnxAlarmReaction()
 QKnxAlarmReaction::QKnxAlarmReaction(Alarm alarm)
     : QKnx2BitSet(SubType, quint8(alarm))
 {
-    setDescription(tr("Alarm reaction"));
-    setRangeText(tr("No alarm is used, 0"), tr("Alarm position is down, 2"));
-    setRange(QVariant(0x00), QVariant(0x02));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Alarm reaction"))
+        .setRangeText(QT_TR_NOOP("No alarm is used, 0"), QT_TR_NOOP("Alarm position is down, 2"))
+        .setRange(QVariant(0x00), QVariant(0x02))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setAlarm(alarm);
 }
 
@@ -291,8 +300,11 @@ QKnxUpDownAction::QKnxUpDownAction()
 QKnxUpDownAction::QKnxUpDownAction(Action action)
     : QKnx2BitSet(SubType, quint8(action))
 {
-    setDescription(tr("Up/Down Action"));
-    setRangeText(tr("Minimum Up, 0"), tr("Maximum Down/Up, 3"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Up/Down Action"))
+        .setRangeText(QT_TR_NOOP("Minimum Up, 0"), QT_TR_NOOP("Maximum Down/Up, 3"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
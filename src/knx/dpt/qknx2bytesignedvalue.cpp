@@ -90,9 +90,12 @@ QKnx2ByteSignedValue::QKnx2ByteSignedValue(double value)
 QKnx2ByteSignedValue::QKnx2ByteSignedValue(int subType, double value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-byte signed value"));
-    setRangeText(tr("Minimum Value, -32 768"), tr("Maximum Value, 32 767"));
-    setRange(QVariant::fromValue(-32768), QVariant::fromValue(32767));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("2-byte signed value"))
+        .setRangeText(QT_TR_NOOP("Minimum Value, -32 768"), QT_TR_NOOP("Maximum Value, 32 767"))
+        .setRange(QVariant::fromValue(-32768), QVariant::fromValue(32767))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -131,11 +134,15 @@ bool QKnx2ByteSignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx2ByteSignedValue(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setCoefficient(COEFFICIENT) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QT_TR_NOOP(RANGE_TEXT_MINIMUM), QT_TR_NOOP(RANGE_TEXT_MAXIMUM)) \
+        .setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(double value) \
     : CLASS() \
@@ -97,9 +97,12 @@ QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(quint32 value)
 QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-byte unsigned value"));
-    setRange(QVariant(0x0000), QVariant(0xffff));
-    setRangeText(tr("0"), tr("65535"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("2-byte unsigned value"))
+        .setRange(QVariant(0x0000), QVariant(0xffff))
+        .setRangeText(QT_TR_NOOP("0"), QT_TR_NOOP("65535"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(value);
 }
 
@@ -137,11 +140,15 @@ bool QKnx2ByteUnsignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx2ByteUnsignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setCoefficient(COEFFICIENT) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QT_TR_NOOP(RANGE_TEXT_MINIMUM), QT_TR_NOOP(RANGE_TEXT_MAXIMUM)) \
+        .setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(quint32 value) \
     : CLASS() \
@@ -74,9 +74,12 @@ QKnx32BitSet::QKnx32BitSet(quint32 value)
 QKnx32BitSet::QKnx32BitSet(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("32-bit set"));
-    setRange(QVariant(0x00), QVariant(0xffffffff));
-    setRangeText(tr("No bits set"), tr("All bits set"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("32-bit set"))
+        .setRange(QVariant(0x00), QVariant(0xffffffff))
+        .setRangeText(QT_TR_NOOP("No bits set"), QT_TR_NOOP("All bits set"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(value);
 }
 
@@ -187,7 +190,10 @@ QKnxCombinedInfoOnOff::QKnxCombinedInfoOnOff()
 QKnxCombinedInfoOnOff::QKnxCombinedInfoOnOff(const QVector<OutputInfo> &infos)
     : QKnx32BitSet(SubType, 0)
 {
-    setDescription(tr("Bit-combined info On/Off"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Bit-combined info On/Off"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     for (const auto &info : qAsConst(infos))
         setValue(info.Output, info.OutputState, info.OutputValidity);
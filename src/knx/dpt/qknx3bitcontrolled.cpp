@@ -93,9 +93,12 @@ QKnx3BitControlled::QKnx3BitControlled(bool control, NumberOfIntervals n)
 QKnx3BitControlled::QKnx3BitControlled(int subType, bool control, NumberOfIntervals n)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("3-bit controlled"));
-    setRange(QVariant(0x00), QVariant(0x0f));
-    setRangeText(tr("No control, Break"), tr("Controlled, 32 intervals"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("3-bit controlled"))
+        .setRange(QVariant(0x00), QVariant(0x0f))
+        .setRangeText(QT_TR_NOOP("No control, Break"), QT_TR_NOOP("Controlled, 32 intervals"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setControlBit(control);
     setNumberOfIntervals(n);
@@ -195,8 +198,11 @@ QKnxControlDimming::QKnxControlDimming()
 QKnxControlDimming::QKnxControlDimming(Control control, NumberOfIntervals interval)
     : QKnx3BitControlled(SubType, bool(control), interval)
 {
-    setDescription(tr("Control Dimming"));
-    setRangeText(tr("Decrease, Break"), tr("Increase, 32 intervals"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Control Dimming"))
+        .setRangeText(QT_TR_NOOP("Decrease, Break"), QT_TR_NOOP("Increase, 32 intervals"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
@@ -259,8 +265,11 @@ QKnxControlBlinds::QKnxControlBlinds()
 QKnxControlBlinds::QKnxControlBlinds(Control control, NumberOfIntervals interval)
     : QKnx3BitControlled (SubType, bool(control), interval)
 {
-    setDescription(tr("Control Blinds"));
-    setRangeText(tr("Up, Break"), tr("Down, 32 intervals"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Control Blinds"))
+        .setRangeText(QT_TR_NOOP("Up, Break"), QT_TR_NOOP("Down, 32 intervals"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
@@ -158,10 +158,14 @@ QKnx4ByteFloat::QKnx4ByteFloat(float value)
 QKnx4ByteFloat::QKnx4ByteFloat(int subType, float value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte float value"));
-    setRangeText(tr("Minimum Value, -3.40282e+38"), tr("Maximum Value, 3.40282e+38"));
-    setRange(QVariant::fromValue(std::numeric_limits<float>::lowest()),
-        QVariant::fromValue(std::numeric_limits<float>::max()));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("4-byte float value"))
+        .setRangeText(QT_TR_NOOP("Minimum Value, -3.40282e+38"),
+            QT_TR_NOOP("Maximum Value, 3.40282e+38"))
+        .setRange(QVariant::fromValue(std::numeric_limits<float>::lowest()),
+            QVariant::fromValue(std::numeric_limits<float>::max()))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -203,8 +207,11 @@ bool QKnx4ByteFloat::isValid() const
 CLASS::CLASS() \
     : QKnx4ByteFloat(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(float value) \
     : CLASS() \
@@ -86,9 +86,13 @@ QKnx4ByteSignedValue::QKnx4ByteSignedValue(qint32 value)
 QKnx4ByteSignedValue::QKnx4ByteSignedValue(int subType, qint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte signed value"));
-    setRange(QVariant::fromValue(INT_MIN), QVariant::fromValue(INT_MAX));
-    setRangeText(tr("Minimum Value, -2 147 483 648"), tr("Maximum Value, 2 147 483 647"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("4-byte signed value"))
+        .setRange(QVariant::fromValue(INT_MIN), QVariant::fromValue(INT_MAX))
+        .setRangeText(QT_TR_NOOP("Minimum Value, -2 147 483 648"),
+            QT_TR_NOOP("Maximum Value, 2 147 483 647"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -127,8 +131,11 @@ bool QKnx4ByteSignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx4ByteSignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(qint32 value) \
     : CLASS() \
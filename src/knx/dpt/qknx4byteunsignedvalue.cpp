@@ -72,9 +72,12 @@ QKnx4ByteUnsignedValue::QKnx4ByteUnsignedValue(quint32 value)
 QKnx4ByteUnsignedValue::QKnx4ByteUnsignedValue(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte unsigned value"));
-    setRangeText(tr("Minimum Value, 0"), tr("Maximum Value, 4 294 967 295"));
-    setRange(QVariant::fromValue(0), QVariant::fromValue(4294967295));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("4-byte unsigned value"))
+        .setRangeText(QT_TR_NOOP("Minimum Value, 0"), QT_TR_NOOP("Maximum Value, 4 294 967 295"))
+        .setRange(QVariant::fromValue(0), QVariant::fromValue(4294967295))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(value);
 }
 
@@ -106,7 +109,10 @@ QKnxValue4UCount::QKnxValue4UCount()
 QKnxValue4UCount::QKnxValue4UCount(quint32 value)
     : QKnx4ByteUnsignedValue(SubType, value)
 {
-    setUnit(tr("counter pulses"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setUnit(QT_TR_NOOP("counter pulses"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
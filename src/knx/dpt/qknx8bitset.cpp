@@ -74,9 +74,12 @@ QKnx8BitSet::QKnx8BitSet(quint8 value)
 QKnx8BitSet::QKnx8BitSet(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-bit set"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("No bits set"), tr("All bits set"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("8-bit set"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setRangeText(QT_TR_NOOP("No bits set"), QT_TR_NOOP("All bits set"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setByte(value);
 }
@@ -169,8 +172,11 @@ QKnxGeneralStatus::QKnxGeneralStatus()
 QKnxGeneralStatus::QKnxGeneralStatus(Attributes attributes)
     : QKnx8BitSet(SubType, 0)
 {
-    setDescription(tr("General Status"));
-    setRange(QVariant(0x00), QVariant(0x1f));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("General Status"))
+        .setRange(QVariant(0x00), QVariant(0x1f))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(attributes);
 }
 
@@ -275,8 +281,11 @@ QKnxDeviceControl::QKnxDeviceControl()
 QKnxDeviceControl::QKnxDeviceControl(Attributes attributes)
     : QKnx8BitSet(SubType, 0)
 {
-    setDescription(tr("Device Control"));
-    setRange(QVariant(0x00), QVariant(0x15));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Device Control"))
+        .setRange(QVariant(0x00), QVariant(0x15))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(attributes);
 }
 
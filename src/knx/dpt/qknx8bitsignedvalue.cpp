@@ -78,9 +78,12 @@ QKnx8BitSignedValue::QKnx8BitSignedValue(qint8 value)
 QKnx8BitSignedValue::QKnx8BitSignedValue(int subType, qint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setRangeText(tr("-128"), tr("127"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setDescription(tr("8-bit signed value"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setRangeText(QT_TR_NOOP("-128"), QT_TR_NOOP("127"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setDescription(QT_TR_NOOP("8-bit signed value"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -106,10 +109,14 @@ void QKnx8BitSignedValue::setValue(qint8 value)
 CLASS::CLASS() \
     : QKnx8BitSignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QT_TR_NOOP(RANGE_TEXT_MINIMUM), QT_TR_NOOP(RANGE_TEXT_MAXIMUM)) \
+        .setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(qint8 value) \
     : CLASS() \
@@ -82,9 +82,12 @@ QKnx8BitUnsignedValue::QKnx8BitUnsignedValue(double value)
 QKnx8BitUnsignedValue::QKnx8BitUnsignedValue(int subType, double value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-bit unsigned value"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("0"), tr("255"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("8-bit unsigned value"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setRangeText(QT_TR_NOOP("0"), QT_TR_NOOP("255"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -125,11 +128,15 @@ bool QKnxTariff::isValid() const
 CLASS::CLASS() \
     : QKnx8BitUnsignedValue(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setCoefficient(COEFFICIENT) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .setRangeText(QT_TR_NOOP(RANGE_TEXT_MINIMUM), QT_TR_NOOP(RANGE_TEXT_MAXIMUM)) \
+        .setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(double value) \
     : CLASS() \
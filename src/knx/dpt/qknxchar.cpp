@@ -74,9 +74,12 @@ QKnxChar::QKnxChar(unsigned char value)
 QKnxChar::QKnxChar(int subType, unsigned char value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Character"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("0"), tr("255"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Character"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setRangeText(QT_TR_NOOP("0"), QT_TR_NOOP("255"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -131,8 +134,11 @@ bool QKnxChar::isValid() const
 QKnxCharASCII::QKnxCharASCII()
     : QKnxChar(SubType, 0)
 {
-    setDescription(tr("Character (ASCII)"));
-    setRange(QVariant(0x00), QVariant(0x7f));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Character (ASCII)"))
+        .setRange(QVariant(0x00), QVariant(0x7f))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
@@ -185,8 +191,11 @@ bool QKnxCharASCII::setCharacter(char value)
 QKnxChar88591::QKnxChar88591()
     : QKnxChar(SubType, 0)
 {
-    setDescription(tr("Character (ISO 8859-1)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Character (ISO 8859-1)"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
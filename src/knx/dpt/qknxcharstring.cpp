@@ -29,6 +29,8 @@
 
 #include "qknxcharstring.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdatapointtypecodec.h"
+#include "qknxdatapointtypecodec_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -53,18 +55,6 @@ QT_BEGIN_NAMESPACE
 
 // -- QKnxCharString
 
-static bool isAscii(const char *bytes, int size, quint8 maxValue)
-{
-    if (maxValue < 0x80) {
-        for (int i = 0; i < size; ++i) {
-            if (unsigned (bytes[i]) < 0x80)
-                continue;
-            return false;
-        }
-    }
-    return true;
-}
-
 /*!
     Creates a fixed size datapoint type with the value set to \c 0.
 */
@@ -94,9 +84,13 @@ QKnxCharString::QKnxCharString(const char *string, int size)
 QKnxCharString::QKnxCharString(int subType, const char* string, int size)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Fixed length character string"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("Minimum number of characters: 0"), tr("Maximum number of characters: 14"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Fixed length character string"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .setRangeText(QT_TR_NOOP("Minimum number of characters: 0"),
+            QT_TR_NOOP("Maximum number of characters: 14"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setString(string, size);
 }
 
@@ -105,7 +99,7 @@ QKnxCharString::QKnxCharString(int subType, const char* string, int size)
 */
 QLatin1String QKnxCharString::string() const
 {
-    return QLatin1String((const char*) constData());
+    return QKnxDatapointTypeCodec::decodeDpt16(constData());
 }
 
 /*!
@@ -129,17 +123,20 @@ bool QKnxCharString::setString(QLatin1String string)
 */
 bool QKnxCharString::setString(const char *string, int size)
 {
-    static auto null = QKnxByteArray(TypeSize, 0);
-    if (!string)
-        return setBytes(null, 0, TypeSize);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, TypeSize);
+    size = (string ? (size < 0 ? int(strlen(string)) : size) : 0);
+    if (size > TypeSize)
+        return false;
 
-    if (size > TypeSize || !isAscii(string, size, maximum().toUInt()))
+    quint8 buffer[TypeSize];
+    if (!QKnxDatapointTypeCodec::encodeDpt16(QLatin1String(string, size), buffer,
+        maximum().toUInt() < 0x80)) {
         return false;
-    return setBytes(QKnxByteArray(string, size) + null.mid(0, TypeSize - size), 0, TypeSize);
+    }
+
+    // written in place, so that a datapoint type not shared does not allocate
+    for (int i = 0; i < TypeSize; ++i)
+        setByte(quint16(i), buffer[i]);
+    return true;
 }
 
 /*!
@@ -148,7 +145,7 @@ bool QKnxCharString::setString(const char *string, int size)
 bool QKnxCharString::isValid() const
 {
     return QKnxDatapointType::isValid()
-        && isAscii((const char*) constData(), TypeSize, maximum().toUInt());
+        && (maximum().toUInt() >= 0x80 || QKnxPrivate::isAscii(constData(), TypeSize));
 }
 
 
@@ -193,8 +190,11 @@ QKnxCharStringASCII::QKnxCharStringASCII(QLatin1String string)
 QKnxCharStringASCII::QKnxCharStringASCII(const char *string, int size)
     : QKnxCharString(SubType, nullptr, 0)
 {
-    setDescription(tr("Fixed length character string (ASCII)"));
-    setRange(QVariant(0x00), QVariant(0x7f));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Fixed length character string (ASCII)"))
+        .setRange(QVariant(0x00), QVariant(0x7f))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setString(string, size);
 }
 
@@ -240,7 +240,10 @@ QKnxCharString88591::QKnxCharString88591(QLatin1String string)
 QKnxCharString88591::QKnxCharString88591(const char *string, int size)
     : QKnxCharString(SubType, string, size)
 {
-    setDescription(tr("Fixed length character string (ISO 8859-1)"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Fixed length character string (ISO 8859-1)"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 QT_END_NAMESPACE
@@ -711,7 +711,7 @@ QKnxDatapointType::QKnxDatapointType(Type type, int size)
 QKnxDatapointType::QKnxDatapointType(const QString &dptId, int size)
     : d_ptr(new QKnxDatapointTypePrivate)
 {
-    auto match = d_ptr->m_dpt.match(dptId);
+    auto match = QKnxDatapointTypePrivate::dptExpression().match(dptId);
     if (!match.hasMatch())
         return;
 
@@ -768,7 +768,7 @@ int QKnxDatapointType::mainType() const
 */
 QVariant QKnxDatapointType::minimum() const
 {
-    return d_ptr->m_minimum;
+    return d_ptr->m_metadata->m_minimum;
 }
 
 /*!
@@ -776,7 +776,7 @@ QVariant QKnxDatapointType::minimum() const
 */
 void QKnxDatapointType::setMinimum(const QVariant &minimum)
 {
-    d_ptr->m_minimum = minimum;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) { d->m_minimum = minimum; });
 }
 
 /*!
@@ -784,7 +784,7 @@ void QKnxDatapointType::setMinimum(const QVariant &minimum)
 */
 QVariant QKnxDatapointType::maximum() const
 {
-    return d_ptr->m_maximum;
+    return d_ptr->m_metadata->m_maximum;
 }
 
 /*!
@@ -792,7 +792,7 @@ QVariant QKnxDatapointType::maximum() const
 */
 void QKnxDatapointType::setMaximum(const QVariant &maximum)
 {
-    d_ptr->m_maximum = maximum;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) { d->m_maximum = maximum; });
 }
 
 /*!
@@ -800,7 +800,7 @@ void QKnxDatapointType::setMaximum(const QVariant &maximum)
 */
 double QKnxDatapointType::coefficient() const
 {
-    return d_ptr->m_coefficient;
+    return d_ptr->m_metadata->m_coefficient;
 }
 
 /*!
@@ -808,7 +808,7 @@ double QKnxDatapointType::coefficient() const
 */
 void QKnxDatapointType::setCoefficient(double coef)
 {
-    d_ptr->m_coefficient = coef;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) { d->m_coefficient = coef; });
 }
 
 /*!
@@ -816,7 +816,7 @@ void QKnxDatapointType::setCoefficient(double coef)
 */
 QString QKnxDatapointType::minimumText() const
 {
-    return d_ptr->m_minimumText;
+    return d_ptr->m_metadata->m_minimumText.toString();
 }
 
 /*!
@@ -825,7 +825,9 @@ QString QKnxDatapointType::minimumText() const
 */
 void QKnxDatapointType::setMinimumText(const QString &minimumText)
 {
-    d_ptr->m_minimumText = minimumText;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) {
+        d->m_minimumText = minimumText;
+    });
 }
 
 /*!
@@ -833,7 +835,7 @@ void QKnxDatapointType::setMinimumText(const QString &minimumText)
 */
 QString QKnxDatapointType::maximumText() const
 {
-    return d_ptr->m_maximumText;
+    return d_ptr->m_metadata->m_maximumText.toString();
 }
 
 /*!
@@ -842,7 +844,9 @@ QString QKnxDatapointType::maximumText() const
 */
 void QKnxDatapointType::setMaximumText(const QString &maximumText)
 {
-    d_ptr->m_maximumText = maximumText;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) {
+        d->m_maximumText = maximumText;
+    });
 }
 
 /*!
@@ -851,8 +855,10 @@ void QKnxDatapointType::setMaximumText(const QString &maximumText)
 */
 void QKnxDatapointType::setRange(const QVariant &minimum, const QVariant &maximum)
 {
-    d_ptr->m_minimum = minimum;
-    d_ptr->m_maximum = maximum;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) {
+        d->m_minimum = minimum;
+        d->m_maximum = maximum;
+    });
 }
 
 /*!
@@ -861,8 +867,10 @@ void QKnxDatapointType::setRange(const QVariant &minimum, const QVariant &maximu
 */
 void QKnxDatapointType::setRangeText(const QString &minimumText, const QString &maximumText)
 {
-    d_ptr->m_minimumText = minimumText;
-    d_ptr->m_maximumText = maximumText;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) {
+        d->m_minimumText = minimumText;
+        d->m_maximumText = maximumText;
+    });
 }
 
 /*!
@@ -870,7 +878,7 @@ void QKnxDatapointType::setRangeText(const QString &minimumText, const QString &
 */
 QString QKnxDatapointType::unit() const
 {
-    return d_ptr->m_unit;
+    return d_ptr->m_metadata->m_unit.toString();
 }
 
 /*!
@@ -878,7 +886,7 @@ QString QKnxDatapointType::unit() const
 */
 void QKnxDatapointType::setUnit(const QString &unit)
 {
-    d_ptr->m_unit = unit;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) { d->m_unit = unit; });
 }
 
 /*!
@@ -886,7 +894,7 @@ void QKnxDatapointType::setUnit(const QString &unit)
 */
 QString QKnxDatapointType::description() const
 {
-    return d_ptr->m_descrition;
+    return d_ptr->m_metadata->m_descrition.toString();
 }
 
 /*!
@@ -894,7 +902,9 @@ QString QKnxDatapointType::description() const
 */
 void QKnxDatapointType::setDescription(const QString &description)
 {
-    d_ptr->m_descrition = description;
+    d_ptr->updateMetadata([&](QKnxDatapointTypeMetadata *d) {
+        d->m_descrition = description;
+    });
 }
 
 /*!
@@ -1014,13 +1024,8 @@ bool QKnxDatapointType::operator==(const QKnxDatapointType &other) const
         || (d_ptr->m_subType == other.d_ptr->m_subType
             && d_ptr->m_mainType == other.d_ptr->m_mainType
             && d_ptr->m_bytes == other.d_ptr->m_bytes
-            && d_ptr->m_unit == other.d_ptr->m_unit
-            && d_ptr->m_descrition == other.d_ptr->m_descrition
-            && d_ptr->m_minimum == other.d_ptr->m_minimum
-            && d_ptr->m_maximum == other.d_ptr->m_maximum
-            && d_ptr->m_coefficient == other.d_ptr->m_coefficient
-            && d_ptr->m_minimumText == other.d_ptr->m_minimumText
-            && d_ptr->m_maximumText == other.d_ptr->m_maximumText);
+            && (d_ptr->m_metadata == other.d_ptr->m_metadata
+                || *d_ptr->m_metadata == *other.d_ptr->m_metadata));
 }
 
 /*!
@@ -1039,8 +1044,7 @@ bool QKnxDatapointType::operator!=(const QKnxDatapointType &other) const
 */
 QKnxDatapointType::Type QKnxDatapointType::toType(const QString &dpt)
 {
-    QKnxDatapointTypePrivate dtp;
-    auto match = dtp.m_dpt.match(dpt);
+    auto match = QKnxDatapointTypePrivate::dptExpression().match(dpt);
     if (!match.hasMatch())
         return QKnxDatapointType::Type::Unknown;
 
@@ -1052,7 +1056,7 @@ QKnxDatapointType::Type QKnxDatapointType::toType(const QString &dpt)
     }
 
     quint32 type;
-    if (dtp.toType(mainType, subType, &type))
+    if (QKnxDatapointTypePrivate::toType(mainType, subType, &type))
         return static_cast<Type> (type);
     return QKnxDatapointType::Type::Unknown;
 }
@@ -1075,6 +1079,155 @@ QKnxDatapointType::QKnxDatapointType(QKnxDatapointTypePrivate &dd)
     : d_ptr(new QKnxDatapointTypePrivate(dd))
 {}
 
+/*!
+    \internal
+
+    Creates metadata holding a copy of the descriptive data of \a type. Texts
+    set afterwards are translated in the translation context \a context.
+*/
+QKnxDatapointTypeMetadata::QKnxDatapointTypeMetadata(const QKnxDatapointType &type,
+        const char *context)
+    : QKnxDatapointTypeMetadata(of(type))
+{
+    m_context = context;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setMinimum(const QVariant &minimum)
+{
+    m_minimum = minimum;
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setMaximum(const QVariant &maximum)
+{
+    m_maximum = maximum;
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setCoefficient(double coef)
+{
+    m_coefficient = coef;
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setMinimumText(const char *minimumText)
+{
+    m_minimumText = Text(m_context, minimumText);
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setMaximumText(const char *maximumText)
+{
+    m_maximumText = Text(m_context, maximumText);
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setRange(const QVariant &minimum,
+    const QVariant &maximum)
+{
+    m_minimum = minimum;
+    m_maximum = maximum;
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setRangeText(const char *minimumText,
+    const char *maximumText)
+{
+    return setRangeText(Text(m_context, minimumText), Text(m_context, maximumText));
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setRangeText(const Text &minimumText,
+    const Text &maximumText)
+{
+    m_minimumText = minimumText;
+    m_maximumText = maximumText;
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setUnit(const char *unit)
+{
+    m_unit = Text(m_context, unit);
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::setDescription(const char *description)
+{
+    m_descrition = Text(m_context, description);
+    return *this;
+}
+
+/*!
+    \internal
+
+    Shares \a metadata with the datapoint type \a type. Constructors build the
+    metadata of their class once and pass it here, so that instances do not
+    copy it until one of the setters is called.
+*/
+void QKnxDatapointTypeMetadata::assign(QKnxDatapointType *type, const Pointer &metadata)
+{
+    type->d_ptr->m_metadata = metadata;
+}
+
+/*!
+    \internal
+
+    Returns the metadata currently used by \a type.
+*/
+const QKnxDatapointTypeMetadata &QKnxDatapointTypeMetadata::of(const QKnxDatapointType &type)
+{
+    return *type.d_ptr->m_metadata;
+}
+
+/*!
+    \internal
+*/
+QKnxDatapointTypeMetadata::Pointer QKnxDatapointTypeMetadata::empty()
+{
+    static const Pointer metadata(new QKnxDatapointTypeMetadata);
+    return metadata;
+}
+
+/*!
+    \internal
+*/
+const QRegularExpression &QKnxDatapointTypePrivate::dptExpression()
+{
+    static const QRegularExpression expression { QStringLiteral("^DPT-(?<MainOnly>\\d{1,5})$"
+        "|^(DPST-)?(?<MainType>\\d{1,5})(\\.|-)(?<SubType>\\d{1,5})$"),
+            QRegularExpression::CaseInsensitiveOption };
+    return expression;
+}
+
 
 // -- QKnxVariableSizeDatapointType
 
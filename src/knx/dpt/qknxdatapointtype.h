@@ -40,6 +40,7 @@
 
 QT_BEGIN_NAMESPACE
 
+struct QKnxDatapointTypeMetadata;
 struct QKnxDatapointTypePrivate;
 
 class Q_KNX_EXPORT QKnxDatapointType
@@ -234,6 +235,7 @@ protected:
     void resize(int newSize);
 
 private:
+    friend struct QKnxDatapointTypeMetadata;
     QKnxDatapointType() = delete;
     explicit QKnxDatapointType(QKnxDatapointTypePrivate &dd);
 
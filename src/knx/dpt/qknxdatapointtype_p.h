@@ -41,14 +41,111 @@
 // We mean it.
 //
 
+#include <QtCore/qcoreapplication.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qvariant.h>
 #include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxdatapointtype.h>
 #include <QtKnx/qtknxglobal.h>
 
 QT_BEGIN_NAMESPACE
 
+// Descriptive data of a datapoint type. Each datapoint type class builds its
+// metadata once and all its instances share that copy instead of carrying their
+// own strings and variants. An instance detaches only if one of its setters is
+// called.
+struct Q_KNX_EXPORT QKnxDatapointTypeMetadata : public QSharedData
+{
+    using Pointer = QExplicitlySharedDataPointer<QKnxDatapointTypeMetadata>;
+
+    // A descriptive text. The classes store the untranslated source text and
+    // the translation context it belongs to, so that it is translated each time
+    // it is read and follows the translators installed later on. Texts set
+    // through the public setters are kept as they are.
+    class Text
+    {
+    public:
+        Text() = default;
+        Text(const QString &text)
+            : m_text(text)
+        {}
+        Text(const char *context, const char *source)
+            : m_context(context)
+            , m_source(source)
+        {}
+
+        // fills the %1 placeholder of the text with argument when read
+        Text arg(const Text &argument) const
+        {
+            Text text = *this;
+            text.m_argument = QSharedPointer<const Text>(new Text(argument));
+            return text;
+        }
+
+        QString toString() const
+        {
+            if (!m_source)
+                return m_text;
+            const auto text = QCoreApplication::translate(m_context, m_source);
+            return m_argument ? text.arg(m_argument->toString()) : text;
+        }
+
+    private:
+        const char *m_context { nullptr };
+        const char *m_source { nullptr };
+        QString m_text;
+        QSharedPointer<const Text> m_argument;
+    };
+
+    QKnxDatapointTypeMetadata() = default;
+    QKnxDatapointTypeMetadata(const QKnxDatapointType &type, const char *context);
+
+    // starts from the metadata of type, texts are set in the translation
+    // context of its class as tr() would use it
+    template <typename T> explicit QKnxDatapointTypeMetadata(const T &type)
+        : QKnxDatapointTypeMetadata(type, T::staticMetaObject.className())
+    {}
+
+    const char *m_context { nullptr };
+    Text m_unit, m_descrition;
+    QVariant m_minimum, m_maximum;
+    double m_coefficient { 1 };
+    Text m_minimumText, m_maximumText;
+
+    // the texts are source texts marked with QT_TR_NOOP()
+    QKnxDatapointTypeMetadata &setMinimum(const QVariant &minimum);
+    QKnxDatapointTypeMetadata &setMaximum(const QVariant &maximum);
+    QKnxDatapointTypeMetadata &setCoefficient(double coef);
+    QKnxDatapointTypeMetadata &setMinimumText(const char *minimumText);
+    QKnxDatapointTypeMetadata &setMaximumText(const char *maximumText);
+    QKnxDatapointTypeMetadata &setRange(const QVariant &minimum, const QVariant &maximum);
+    QKnxDatapointTypeMetadata &setRangeText(const char *minimumText, const char *maximumText);
+    QKnxDatapointTypeMetadata &setRangeText(const Text &minimumText, const Text &maximumText);
+    QKnxDatapointTypeMetadata &setUnit(const char *unit);
+    QKnxDatapointTypeMetadata &setDescription(const char *description);
+
+    Pointer share() const { return Pointer(new QKnxDatapointTypeMetadata(*this)); }
+
+    bool operator==(const QKnxDatapointTypeMetadata &other) const
+    {
+        return m_unit.toString() == other.m_unit.toString()
+            && m_descrition.toString() == other.m_descrition.toString()
+            && m_minimum == other.m_minimum
+            && m_maximum == other.m_maximum
+            && m_coefficient == other.m_coefficient
+            && m_minimumText.toString() == other.m_minimumText.toString()
+            && m_maximumText.toString() == other.m_maximumText.toString();
+    }
+
+    // the datapoint type class only befriends the metadata, which reaches its
+    // d-pointer through these instead of a setter in the public API
+    static void assign(QKnxDatapointType *type, const Pointer &metadata);
+    static const QKnxDatapointTypeMetadata &of(const QKnxDatapointType &type);
+    static Pointer empty();
+};
+
 struct Q_KNX_EXPORT QKnxDatapointTypePrivate : public QSharedData
 {
     QKnxDatapointTypePrivate() = default;
@@ -58,13 +155,16 @@ struct Q_KNX_EXPORT QKnxDatapointTypePrivate : public QSharedData
     int m_mainType { 0 };
     quint32 m_type { 0 };
     QKnxByteArray m_bytes;
-    QString m_unit, m_descrition;
-    QVariant m_minimum, m_maximum;
-    double m_coefficient { 1 };
-    QString m_minimumText, m_maximumText;
-    const QRegularExpression m_dpt { QStringLiteral("^DPT-(?<MainOnly>\\d{1,5})$"
-        "|^(DPST-)?(?<MainType>\\d{1,5})(\\.|-)(?<SubType>\\d{1,5})$"),
-            QRegularExpression::CaseInsensitiveOption };
+    QKnxDatapointTypeMetadata::Pointer m_metadata { QKnxDatapointTypeMetadata::empty() };
+
+    // Detaches the metadata if it is shared and applies \a change to it.
+    template <typename Change> void updateMetadata(Change change)
+    {
+        m_metadata.detach();
+        change(m_metadata.data());
+    }
+
+    static const QRegularExpression &dptExpression();
 
     static bool toType(quint16 main, quint16 sub, quint32 *type) {
         return toType(QString::number(main), QString::number(sub), type);
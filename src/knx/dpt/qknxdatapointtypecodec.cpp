@@ -0,0 +1,744 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxdatapointtypecodec.h"
+#include "qknxdatapointtypecodec_p.h"
+
+#include <QtCore/private/qsimd_p.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxDatapointTypeCodec
+    \inmodule QtKnx
+    \ingroup qtknx-datapoint-types
+    \since 5.13
+
+    \brief The QKnxDatapointTypeCodec class converts arrays of fixed size
+    numeric datapoint type values from and to their KNX encoding.
+
+    The functions operate on contiguous spans of encoded values, as found in
+    recorded telegram payloads, without constructing a datapoint type object
+    per value. Each encoded value occupies the type size of its main type and
+    is stored in network byte order.
+
+    The results are bit-identical to decoding or encoding every value with the
+    corresponding datapoint type class, for example QKnx2ByteFloat for DPT 9.
+    Where available, SSE2 and AVX2 are used to process several values at once;
+    the scalar code is used otherwise and for the remaining tail of a span.
+
+    The decoding functions accept any encoded value. The encoding functions
+    check each value against the encoding range of the main type and stop at
+    the first value that cannot be encoded, returning the number of values
+    written to the destination. Range restrictions that only apply to a
+    subtype are not checked.
+
+    For the string types DPT 16, 24 and 28 the functions encode into and
+    decode from caller provided buffers of fixed capacity. ASCII runs are
+    checked and converted 16 bytes at a time where SSE2 is available, and the
+    UTF-8 conversions validate their input instead of substituting invalid
+    sequences.
+
+    \sa QKnxDatapointType, {Qt KNX Datapoint Type Classes}
+*/
+
+namespace QKnxPrivate
+{
+    static inline quint16 load16(const quint8 *src)
+    {
+        return quint16(quint16(src[0]) << 8 | src[1]);
+    }
+
+    static inline quint32 load32(const quint8 *src)
+    {
+        return quint32(src[0]) << 24 | quint32(src[1]) << 16 | quint32(src[2]) << 8 | src[3];
+    }
+
+    static inline void store16(quint8 *dst, quint16 value)
+    {
+        dst[0] = quint8(value >> 8);
+        dst[1] = quint8(value);
+    }
+
+    static inline void store32(quint8 *dst, quint32 value)
+    {
+        dst[0] = quint8(value >> 24);
+        dst[1] = quint8(value >> 16);
+        dst[2] = quint8(value >> 8);
+        dst[3] = quint8(value);
+    }
+
+    // The vector kernels below return the number of values they processed;
+    // the caller finishes the remaining tail with the scalar code.
+
+#ifdef __SSE2__
+    static inline __m128i byteSwap16(__m128i v)
+    {
+        return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+    static inline __m128i byteSwap32(__m128i v)
+    {
+        v = byteSwap16(v);
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+
+    static size_t swap32Sse2(const quint8 *src, quint8 *dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 4 * i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4 * i), byteSwap32(v));
+        }
+        return i;
+    }
+
+    static size_t decodeDpt7Sse2(const quint8 *src, quint32 *dst, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i raw = byteSwap16(_mm_loadu_si128(reinterpret_cast<const __m128i *>
+                (src + 2 * i)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi16(raw, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4),
+                _mm_unpackhi_epi16(raw, zero));
+        }
+        return i;
+    }
+
+    static size_t decodeDpt8Sse2(const quint8 *src, double *dst, size_t count, double coefficient)
+    {
+        const __m128d factor = _mm_set1_pd(coefficient);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128i raw = byteSwap16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>
+                (src + 2 * i)));
+            // sign extend the 16 bit values into 32 bit lanes
+            const __m128i value = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+            _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_cvtepi32_pd(value), factor));
+            _mm_storeu_pd(dst + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(value, 8)),
+                factor));
+        }
+        return i;
+    }
+
+    static size_t decodeDpt9Sse2(const quint8 *src, float *dst, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i mantissaMask = _mm_set1_epi16(0x07ff);
+        const __m128i signFill = _mm_set1_epi16(qint16(0xf800));
+        const __m128i exponentMask = _mm_set1_epi16(0x000f);
+        const __m128i exponentBias = _mm_set1_epi32(1023);
+        const __m128d hundredth = _mm_set1_pd(0.01);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128i raw = byteSwap16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>
+                (src + 2 * i)));
+
+            const __m128i sign = _mm_srai_epi16(raw, 15);
+            const __m128i mantissa16 = _mm_or_si128(_mm_and_si128(raw, mantissaMask),
+                _mm_and_si128(sign, signFill));
+            const __m128i mantissa = _mm_srai_epi32(_mm_unpacklo_epi16(mantissa16, mantissa16), 16);
+
+            // 2^E is exact, so build it straight from the exponent bits of a double
+            const __m128i exponent = _mm_add_epi32(_mm_unpacklo_epi16(_mm_and_si128(
+                _mm_srli_epi16(raw, 11), exponentMask), zero), exponentBias);
+            const __m128d scale01 = _mm_castsi128_pd(_mm_slli_epi64(_mm_unpacklo_epi32(exponent,
+                zero), 52));
+            const __m128d scale23 = _mm_castsi128_pd(_mm_slli_epi64(_mm_unpackhi_epi32(exponent,
+                zero), 52));
+
+            const __m128d value01 = _mm_mul_pd(_mm_mul_pd(hundredth, _mm_cvtepi32_pd(mantissa)),
+                scale01);
+            const __m128d value23 = _mm_mul_pd(_mm_mul_pd(hundredth,
+                _mm_cvtepi32_pd(_mm_srli_si128(mantissa, 8))), scale23);
+            _mm_storeu_ps(dst + i, _mm_movelh_ps(_mm_cvtpd_ps(value01), _mm_cvtpd_ps(value23)));
+        }
+        return i;
+    }
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    QT_FUNCTION_TARGET(AVX2)
+    static size_t swap32Avx2(const quint8 *src, quint8 *dst, size_t count)
+    {
+        const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+            13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 4 * i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 4 * i),
+                _mm256_shuffle_epi8(v, shuffle));
+        }
+        return i;
+    }
+
+    QT_FUNCTION_TARGET(AVX2)
+    static size_t decodeDpt9Avx2(const quint8 *src, float *dst, size_t count)
+    {
+        const __m128i shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15,
+            14);
+        const __m128i mantissaMask = _mm_set1_epi16(0x07ff);
+        const __m128i signFill = _mm_set1_epi16(qint16(0xf800));
+        const __m128i exponentMask = _mm_set1_epi16(0x000f);
+        const __m256i exponentBias = _mm256_set1_epi64x(1023);
+        const __m256d hundredth = _mm256_set1_pd(0.01);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i raw = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>
+                (src + 2 * i)), shuffle);
+
+            const __m128i sign = _mm_srai_epi16(raw, 15);
+            const __m128i mantissa = _mm_or_si128(_mm_and_si128(raw, mantissaMask),
+                _mm_and_si128(sign, signFill));
+            const __m128i exponent = _mm_and_si128(_mm_srli_epi16(raw, 11), exponentMask);
+
+            const __m256d scale0 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(
+                _mm256_cvtepu16_epi64(exponent), exponentBias), 52));
+            const __m256d scale1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(
+                _mm256_cvtepu16_epi64(_mm_srli_si128(exponent, 8)), exponentBias), 52));
+
+            const __m256d value0 = _mm256_mul_pd(_mm256_mul_pd(hundredth,
+                _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(mantissa))), scale0);
+            const __m256d value1 = _mm256_mul_pd(_mm256_mul_pd(hundredth,
+                _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_srli_si128(mantissa, 8)))), scale1);
+            _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(value0));
+            _mm_storeu_ps(dst + i + 4, _mm256_cvtpd_ps(value1));
+        }
+        return i;
+    }
+#endif
+
+    // Reverses the byte order of \a count 32 bit values; used in both
+    // directions since the swap is its own inverse.
+    static void swap32(const void *src, void *dst, size_t count)
+    {
+        auto in = static_cast<const quint8 *>(src);
+        auto out = static_cast<quint8 *>(dst);
+
+        size_t i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+        if (qCpuHasFeature(AVX2))
+            i = swap32Avx2(in, out, count);
+#endif
+#ifdef __SSE2__
+        i += swap32Sse2(in + 4 * i, out + 4 * i, count - i);
+#endif
+        for (; i < count; ++i) {
+            const quint32 value = load32(in + 4 * i);
+            memcpy(out + 4 * i, &value, sizeof(value));
+        }
+    }
+
+    bool isAscii(const quint8 *data, int size)
+    {
+        int i = 0;
+#ifdef __SSE2__
+        for (; i + 16 <= size; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            if (_mm_movemask_epi8(v))
+                return false;
+        }
+#endif
+        for (; i < size; ++i) {
+            if (data[i] >= 0x80)
+                return false;
+        }
+        return true;
+    }
+
+    // Decodes and validates UTF-8, rejecting overlong forms, surrogates and
+    // code points above U+10FFFF. If \a dst is \c nullptr, the input is only
+    // validated. Returns the number of UTF-16 code units or -1.
+    static int utf8ToUtf16(const quint8 *src, int size, QChar *dst, int capacity)
+    {
+        int i = 0, out = 0;
+        while (i < size) {
+#ifdef __SSE2__
+            const __m128i zero = _mm_setzero_si128();
+            while (i + 16 <= size) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                if (_mm_movemask_epi8(v))
+                    break;
+                if (dst) {
+                    if (out + 16 > capacity)
+                        break;
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + out),
+                        _mm_unpacklo_epi8(v, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + out + 8),
+                        _mm_unpackhi_epi8(v, zero));
+                }
+                i += 16;
+                out += 16;
+            }
+            if (i >= size)
+                break;
+#endif
+            const quint8 lead = src[i];
+            int trailing = 0;
+            quint32 codePoint = lead;
+            quint32 minimum = 0;
+            if ((lead & 0xe0) == 0xc0) {
+                trailing = 1;
+                codePoint = lead & 0x1f;
+                minimum = 0x80;
+            } else if ((lead & 0xf0) == 0xe0) {
+                trailing = 2;
+                codePoint = lead & 0x0f;
+                minimum = 0x800;
+            } else if ((lead & 0xf8) == 0xf0) {
+                trailing = 3;
+                codePoint = lead & 0x07;
+                minimum = 0x10000;
+            } else if (lead >= 0x80) {
+                return -1; // continuation byte or invalid lead byte
+            }
+
+            if (trailing >= size - i)
+                return -1;
+            for (int k = 1; k <= trailing; ++k) {
+                const quint8 next = src[i + k];
+                if ((next & 0xc0) != 0x80)
+                    return -1;
+                codePoint = codePoint << 6 | (next & 0x3f);
+            }
+            if (codePoint < minimum || codePoint > 0x10ffff
+                || (codePoint >= 0xd800 && codePoint <= 0xdfff)) {
+                return -1;
+            }
+            i += trailing + 1;
+
+            const int units = QChar::requiresSurrogates(codePoint) ? 2 : 1;
+            if (dst) {
+                if (out + units > capacity)
+                    return -1;
+                if (units == 2) {
+                    dst[out] = QChar(QChar::highSurrogate(codePoint));
+                    dst[out + 1] = QChar(QChar::lowSurrogate(codePoint));
+                } else {
+                    dst[out] = QChar(ushort(codePoint));
+                }
+            }
+            out += units;
+        }
+        return out;
+    }
+
+    // Encodes UTF-16 as UTF-8, rejecting unpaired surrogates. Returns the
+    // number of bytes written or -1.
+    static int utf16ToUtf8(const QChar *src, int size, quint8 *dst, int capacity)
+    {
+        int i = 0, out = 0;
+        while (i < size) {
+#ifdef __SSE2__
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i nonAscii = _mm_set1_epi16(qint16(0xff80));
+            while (i + 8 <= size && out + 8 <= capacity) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonAscii), zero)) != 0xffff)
+                    break;
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + out), _mm_packus_epi16(v, v));
+                i += 8;
+                out += 8;
+            }
+            if (i >= size)
+                break;
+#endif
+            const ushort unit = src[i].unicode();
+            uint codePoint = unit;
+            if (QChar::isHighSurrogate(unit)) {
+                if (i + 1 >= size || !src[i + 1].isLowSurrogate())
+                    return -1;
+                codePoint = QChar::surrogateToUcs4(unit, src[i + 1].unicode());
+                ++i;
+            } else if (QChar::isLowSurrogate(unit)) {
+                return -1;
+            }
+            ++i;
+
+            const int length = codePoint < 0x80 ? 1 : (codePoint < 0x800 ? 2
+                : (codePoint < 0x10000 ? 3 : 4));
+            if (out + length > capacity)
+                return -1;
+            switch (length) {
+            case 1:
+                dst[out] = quint8(codePoint);
+                break;
+            case 2:
+                dst[out] = quint8(0xc0 | codePoint >> 6);
+                dst[out + 1] = quint8(0x80 | (codePoint & 0x3f));
+                break;
+            case 3:
+                dst[out] = quint8(0xe0 | codePoint >> 12);
+                dst[out + 1] = quint8(0x80 | ((codePoint >> 6) & 0x3f));
+                dst[out + 2] = quint8(0x80 | (codePoint & 0x3f));
+                break;
+            default:
+                dst[out] = quint8(0xf0 | codePoint >> 18);
+                dst[out + 1] = quint8(0x80 | ((codePoint >> 12) & 0x3f));
+                dst[out + 2] = quint8(0x80 | ((codePoint >> 6) & 0x3f));
+                dst[out + 3] = quint8(0x80 | (codePoint & 0x3f));
+                break;
+            }
+            out += length;
+        }
+        return out;
+    }
+}
+
+/*!
+    Decodes \a count DPT 5 values from \a src into \a dst. Each value is
+    multiplied with \a coefficient, as done by QKnx8BitUnsignedValue::value().
+*/
+void QKnxDatapointTypeCodec::decodeDpt5(const quint8 *src, double *dst, size_t count,
+    double coefficient)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = src[i] * coefficient;
+}
+
+/*!
+    Encodes \a count DPT 5 values from \a src into \a dst. Each value is divided
+    by \a coefficient and rounded to the nearest integer.
+
+    Returns the number of encoded values, which is less than \a count if a
+    value does not round to an 8-bit unsigned integer.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt5(const double *src, quint8 *dst, size_t count,
+    double coefficient)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const double scaled = src[i] / coefficient;
+        if (!(scaled > -0.5 && scaled < 255.5))
+            return i;
+        dst[i] = quint8(qRound(scaled));
+    }
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 6 values from \a src into \a dst.
+*/
+void QKnxDatapointTypeCodec::decodeDpt6(const quint8 *src, qint8 *dst, size_t count)
+{
+    if (count > 0)
+        memcpy(dst, src, count);
+}
+
+/*!
+    Encodes \a count DPT 6 values from \a src into \a dst and returns \a count.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt6(const qint8 *src, quint8 *dst, size_t count)
+{
+    if (count > 0)
+        memcpy(dst, src, count);
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 7 values from \a src into \a dst. Each value is
+    multiplied with \a coefficient and truncated, as done by
+    QKnx2ByteUnsignedValue::value().
+*/
+void QKnxDatapointTypeCodec::decodeDpt7(const quint8 *src, quint32 *dst, size_t count,
+    double coefficient)
+{
+    size_t i = 0;
+    if (coefficient == 1.) {
+#ifdef __SSE2__
+        i = QKnxPrivate::decodeDpt7Sse2(src, dst, count);
+#endif
+        for (; i < count; ++i)
+            dst[i] = QKnxPrivate::load16(src + 2 * i);
+        return;
+    }
+
+    for (; i < count; ++i)
+        dst[i] = quint32(QKnxPrivate::load16(src + 2 * i) * coefficient);
+}
+
+/*!
+    Encodes \a count DPT 7 values from \a src into \a dst. Each value is divided
+    by \a coefficient and rounded to the nearest integer.
+
+    Returns the number of encoded values, which is less than \a count if a
+    value does not round to a 16-bit unsigned integer.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt7(const quint32 *src, quint8 *dst, size_t count,
+    double coefficient)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const double scaled = src[i] / coefficient;
+        if (!(scaled > -0.5 && scaled < 65535.5))
+            return i;
+        QKnxPrivate::store16(dst + 2 * i, quint16(qRound(scaled)));
+    }
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 8 values from \a src into \a dst. Each value is
+    multiplied with \a coefficient, as done by QKnx2ByteSignedValue::value().
+*/
+void QKnxDatapointTypeCodec::decodeDpt8(const quint8 *src, double *dst, size_t count,
+    double coefficient)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    i = QKnxPrivate::decodeDpt8Sse2(src, dst, count, coefficient);
+#endif
+    for (; i < count; ++i)
+        dst[i] = qint16(QKnxPrivate::load16(src + 2 * i)) * coefficient;
+}
+
+/*!
+    Encodes \a count DPT 8 values from \a src into \a dst. Each value is divided
+    by \a coefficient and rounded to the nearest integer.
+
+    Returns the number of encoded values, which is less than \a count if a
+    value does not round to a 16-bit signed integer.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt8(const double *src, quint8 *dst, size_t count,
+    double coefficient)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const double scaled = src[i] / coefficient;
+        if (!(scaled >= -32768.5 && scaled < 32767.5))
+            return i;
+        QKnxPrivate::store16(dst + 2 * i, quint16(qRound(scaled)));
+    }
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 9 values from \a src into \a dst.
+*/
+void QKnxDatapointTypeCodec::decodeDpt9(const quint8 *src, float *dst, size_t count)
+{
+    size_t i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        i = QKnxPrivate::decodeDpt9Avx2(src, dst, count);
+#endif
+#ifdef __SSE2__
+    i += QKnxPrivate::decodeDpt9Sse2(src + 2 * i, dst + i, count - i);
+#endif
+    for (; i < count; ++i)
+        dst[i] = QKnxPrivate::decode2ByteFloat(QKnxPrivate::load16(src + 2 * i));
+}
+
+/*!
+    Encodes \a count DPT 9 values from \a src into \a dst.
+
+    Returns the number of encoded values, which is less than \a count if a
+    value is outside the range accepted by QKnx2ByteFloat::setValue().
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt9(const float *src, quint8 *dst, size_t count)
+{
+    const float minimum = float(-671088.64);
+    const float maximum = float(670760.96);
+
+    for (size_t i = 0; i < count; ++i) {
+        quint16 encoded = 0;
+        if (!(src[i] >= minimum && src[i] <= maximum)
+            || !QKnxPrivate::encode2ByteFloat(src[i], &encoded)) {
+            return i;
+        }
+        QKnxPrivate::store16(dst + 2 * i, encoded);
+    }
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 12 values from \a src into \a dst.
+*/
+void QKnxDatapointTypeCodec::decodeDpt12(const quint8 *src, quint32 *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+}
+
+/*!
+    Encodes \a count DPT 12 values from \a src into \a dst and returns \a count.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt12(const quint32 *src, quint8 *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 13 values from \a src into \a dst.
+*/
+void QKnxDatapointTypeCodec::decodeDpt13(const quint8 *src, qint32 *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+}
+
+/*!
+    Encodes \a count DPT 13 values from \a src into \a dst and returns \a count.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt13(const qint32 *src, quint8 *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+    return count;
+}
+
+/*!
+    Decodes \a count DPT 14 values from \a src into \a dst. The bit pattern of
+    each value is preserved, including the payload of NaN values.
+*/
+void QKnxDatapointTypeCodec::decodeDpt14(const quint8 *src, float *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+}
+
+/*!
+    Encodes \a count DPT 14 values from \a src into \a dst and returns \a count.
+*/
+size_t QKnxDatapointTypeCodec::encodeDpt14(const float *src, quint8 *dst, size_t count)
+{
+    QKnxPrivate::swap32(src, dst, count);
+    return count;
+}
+
+/*!
+    Returns the DPT 16 string stored in the 14 bytes at \a src. The string ends
+    at the first null byte or after 14 characters and references \a src
+    without copying.
+*/
+QLatin1String QKnxDatapointTypeCodec::decodeDpt16(const quint8 *src)
+{
+    const auto data = reinterpret_cast<const char *>(src);
+    return QLatin1String(data, int(qstrnlen(data, 14)));
+}
+
+/*!
+    Encodes \a string as DPT 16 into the 14 bytes at \a dst, padding the
+    remaining bytes with null bytes. If \a asciiOnly is \c true, as for
+    QKnxCharStringASCII, all characters must be in the ASCII range.
+
+    Returns \c false and leaves \a dst untouched if \a string is longer than
+    14 characters or contains characters outside the allowed range.
+*/
+bool QKnxDatapointTypeCodec::encodeDpt16(QLatin1String string, quint8 *dst, bool asciiOnly)
+{
+    const int size = string.size();
+    if (size > 14)
+        return false;
+
+    const auto data = reinterpret_cast<const quint8 *>(string.latin1());
+    if (asciiOnly && !QKnxPrivate::isAscii(data, size))
+        return false;
+
+    if (size > 0)
+        memcpy(dst, data, size_t(size));
+    memset(dst + size, 0, size_t(14 - size));
+    return true;
+}
+
+/*!
+    Returns the DPT 24 string stored in the \a size bytes at \a src. The string
+    ends at the first null byte and references \a src without copying.
+*/
+QLatin1String QKnxDatapointTypeCodec::decodeDpt24(const quint8 *src, int size)
+{
+    const auto data = reinterpret_cast<const char *>(src);
+    return QLatin1String(data, int(qstrnlen(data, uint(qMax(size, 0)))));
+}
+
+/*!
+    Encodes \a string including the terminating null byte as DPT 24 into the
+    buffer \a dst holding \a capacity bytes.
+
+    Returns the number of bytes written, or \c -1 if the buffer is too small.
+*/
+int QKnxDatapointTypeCodec::encodeDpt24(QLatin1String string, quint8 *dst, int capacity)
+{
+    const int size = string.size();
+    if (size >= capacity)
+        return -1;
+
+    if (size > 0)
+        memcpy(dst, string.latin1(), size_t(size));
+    dst[size] = 0;
+    return size + 1;
+}
+
+/*!
+    Decodes the DPT 28 UTF-8 string stored in the \a size bytes at \a src into
+    the buffer \a dst holding \a capacity UTF-16 code units. The string ends at
+    the first null byte.
+
+    Returns the number of code units written, or \c -1 if the string is not
+    valid UTF-8 or does not fit into the buffer.
+*/
+int QKnxDatapointTypeCodec::decodeDpt28(const quint8 *src, int size, QChar *dst, int capacity)
+{
+    const auto data = reinterpret_cast<const char *>(src);
+    return QKnxPrivate::utf8ToUtf16(src, int(qstrnlen(data, uint(qMax(size, 0)))), dst,
+        capacity);
+}
+
+/*!
+    Encodes \a string as UTF-8 including the terminating null byte as DPT 28
+    into the buffer \a dst holding \a capacity bytes.
+
+    Returns the number of bytes written, or \c -1 if \a string contains an
+    unpaired surrogate or the buffer is too small.
+*/
+int QKnxDatapointTypeCodec::encodeDpt28(QStringView string, quint8 *dst, int capacity)
+{
+    if (capacity < 1)
+        return -1;
+
+    const int size = QKnxPrivate::utf16ToUtf8(string.data(), int(string.size()), dst,
+        capacity - 1);
+    if (size < 0)
+        return -1;
+    dst[size] = 0;
+    return size + 1;
+}
+
+/*!
+    Returns \c true if the \a size bytes at \a src are valid UTF-8; otherwise
+    returns \c false. Overlong forms, encoded surrogates and code points above
+    U+10FFFF are rejected.
+*/
+bool QKnxDatapointTypeCodec::isValidUtf8(const quint8 *src, int size)
+{
+    return QKnxPrivate::utf8ToUtf16(src, size, nullptr, 0) >= 0;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,84 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDATAPOINTTYPECODEC_H
+#define QKNXDATAPOINTTYPECODEC_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+struct Q_KNX_EXPORT QKnxDatapointTypeCodec final
+{
+    QKnxDatapointTypeCodec() = delete;
+
+    static void decodeDpt5(const quint8 *src, double *dst, size_t count, double coefficient = 1.);
+    static size_t encodeDpt5(const double *src, quint8 *dst, size_t count,
+        double coefficient = 1.);
+
+    static void decodeDpt6(const quint8 *src, qint8 *dst, size_t count);
+    static size_t encodeDpt6(const qint8 *src, quint8 *dst, size_t count);
+
+    static void decodeDpt7(const quint8 *src, quint32 *dst, size_t count,
+        double coefficient = 1.);
+    static size_t encodeDpt7(const quint32 *src, quint8 *dst, size_t count,
+        double coefficient = 1.);
+
+    static void decodeDpt8(const quint8 *src, double *dst, size_t count, double coefficient = 1.);
+    static size_t encodeDpt8(const double *src, quint8 *dst, size_t count,
+        double coefficient = 1.);
+
+    static void decodeDpt9(const quint8 *src, float *dst, size_t count);
+    static size_t encodeDpt9(const float *src, quint8 *dst, size_t count);
+
+    static void decodeDpt12(const quint8 *src, quint32 *dst, size_t count);
+    static size_t encodeDpt12(const quint32 *src, quint8 *dst, size_t count);
+
+    static void decodeDpt13(const quint8 *src, qint32 *dst, size_t count);
+    static size_t encodeDpt13(const qint32 *src, quint8 *dst, size_t count);
+
+    static void decodeDpt14(const quint8 *src, float *dst, size_t count);
+    static size_t encodeDpt14(const float *src, quint8 *dst, size_t count);
+
+    static QLatin1String decodeDpt16(const quint8 *src);
+    static bool encodeDpt16(QLatin1String string, quint8 *dst, bool asciiOnly = false);
+
+    static QLatin1String decodeDpt24(const quint8 *src, int size);
+    static int encodeDpt24(QLatin1String string, quint8 *dst, int capacity);
+
+    static int decodeDpt28(const quint8 *src, int size, QChar *dst, int capacity);
+    static int encodeDpt28(QStringView string, quint8 *dst, int capacity);
+    static bool isValidUtf8(const quint8 *src, int size);
+};
+
+QT_END_NAMESPACE
+
+#endif
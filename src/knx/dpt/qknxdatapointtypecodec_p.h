@@ -0,0 +1,129 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDATAPOINTTYPECODEC_P_H
+#define QKNXDATAPOINTTYPECODEC_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qglobal.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxPrivate
+{
+    // Scalar reference conversions shared by the datapoint type classes and
+    // the bulk codec, so that both produce bit-identical results.
+
+    inline float compute2ByteFloat(quint16 raw)
+    {
+        // Turning on bits reserved for E.
+        // Only needed for reinterpretation of negative values
+        const qint16 M = qint16((raw & 0x07ff) | ((raw & 0x8000) ? 0xf800 : 0x0000));
+        const int E = (raw & 0x7800) >> 11;
+        return float(0.01 * M * double(1 << E));
+    }
+
+    // All 65536 decoded values, computed on first use.
+    const float *twoByteFloatTable();
+
+    inline float decode2ByteFloat(quint16 raw)
+    {
+        return twoByteFloatTable()[raw];
+    }
+
+    // Encodes \a value as 0.01 * M * 2^E with the smallest exponent E that
+    // can hold the rounded mantissa M, rounding half away from zero. The
+    // computation is done on the integer bits of the float: 100 times the
+    // 24-bit significand fits into 31 bits, so no precision is lost.
+    inline bool encode2ByteFloat(float value, quint16 *raw)
+    {
+        quint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const quint32 negative = bits >> 31;
+        const int biased = int((bits >> 23) & 0xff);
+        if (biased == 0xff)
+            return false; // infinity or NaN
+
+        // |value| * 100 == N * 2^e
+        const quint32 significand = (bits & 0x7fffff) | (biased ? 0x800000 : 0);
+        const int e = (biased ? biased : 1) - 150;
+        const quint64 N = quint64(significand) * 100;
+        if (N == 0) {
+            *raw = 0;
+            return true;
+        }
+
+        // round(N * 2^-shift), the shift is never negative for a finite float
+        // since N has at least 30 significant bits unless the value is subnormal
+        const auto roundShift = [N](int shift) -> quint32 {
+            shift = qMin(shift, 40);
+            return quint32((N + (quint64(1) << (shift - 1))) >> shift);
+        };
+
+        // the smallest exponent for which the unrounded mantissa is below 2048
+        const int bitLength = 64 - qCountLeadingZeroBits(N);
+        int E = qMax(0, e + bitLength - 11);
+        quint32 M = roundShift(E - e);
+
+        // rounding up can reach 2048, which only fits as -2048; a negative
+        // value might even fit as -2048 with the next smaller exponent
+        const bool lower = negative && E > 0 && roundShift(E - 1 - e) == 2048;
+        const bool higher = !negative && M == 2048;
+        E += int(higher) - int(lower);
+        M = higher ? 1024 : (lower ? 2048 : M);
+
+        if (E > 15)
+            return false;
+
+        const quint32 mantissa = (negative ? 0u - M : M) & 0x0fff;
+        *raw = quint16((mantissa & 0x0800) << 4 | quint32(E) << 11 | (mantissa & 0x07ff));
+        return true;
+    }
+
+    bool isAscii(const quint8 *data, int size);
+}
+
+QT_END_NAMESPACE
+
+#endif
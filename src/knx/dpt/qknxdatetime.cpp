@@ -66,9 +66,13 @@ QKnxTimeOfDay::QKnxTimeOfDay()
 QKnxTimeOfDay::QKnxTimeOfDay(const QKnxTime &time)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Time of day"));
-    setRangeText(tr("No day, 00:00:00"), tr("Sunday, 23:59:59"));
-    setRange(QVariant::fromValue(QKnxTime(00, 00, 00)), QVariant::fromValue(QKnxTime(23, 59, 59)));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Time of day"))
+        .setRangeText(QT_TR_NOOP("No day, 00:00:00"), QT_TR_NOOP("Sunday, 23:59:59"))
+        .setRange(QVariant::fromValue(QKnxTime(00, 00, 00)),
+            QVariant::fromValue(QKnxTime(23, 59, 59)))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setValue(time);
 }
 
@@ -225,9 +229,12 @@ bool QKnxTimeOfDay::isValid() const
 QKnxDate::QKnxDate()
     : QKnxDate(QDate(2000, 0, 0))
 {
-    setDescription(tr("Date"));
-    setRange(QDate(1990, 1, 1), QDate(2089, 12, 31));
-    setRangeText(tr("Monday, 1990-01-01"), tr("Saturday, 2089-12-31"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Date"))
+        .setRange(QDate(1990, 1, 1), QDate(2089, 12, 31))
+        .setRangeText(QT_TR_NOOP("Monday, 1990-01-01"), QT_TR_NOOP("Saturday, 2089-12-31"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 }
 
 /*!
@@ -420,11 +427,14 @@ QKnxDateTime::QKnxDateTime(const QDate &date, const QKnxTime24 &time, Attributes
         ClockQuality quality)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Date Time"));
-    setMinimumText(tr("Monday, 1900-01-01; Any day, 00:00:00"));
-    setMaximumText(tr("Wednesday, 2155-12-31; Sunday, 24:00:00"));
-    setMinimum(QVariant({ QDate(1900, 01, 01), QVariant::fromValue(QKnxTime24(00, 00, 00)) }));
-    setMaximum(QVariant({ QDate(2155, 12, 31), QVariant::fromValue(QKnxTime24(24, 00, 00)) }));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Date Time"))
+        .setMinimumText(QT_TR_NOOP("Monday, 1900-01-01; Any day, 00:00:00"))
+        .setMaximumText(QT_TR_NOOP("Wednesday, 2155-12-31; Sunday, 24:00:00"))
+        .setMinimum(QVariant({ QDate(1900, 01, 01), QVariant::fromValue(QKnxTime24(00, 00, 00)) }))
+        .setMaximum(QVariant({ QDate(2155, 12, 31), QVariant::fromValue(QKnxTime24(24, 00, 00)) }))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(date, time, attributes, quality);
 }
@@ -81,10 +81,13 @@ QKnxElectricalEnergy::QKnxElectricalEnergy(qint64 value)
 QKnxElectricalEnergy::QKnxElectricalEnergy(int subType, qint64 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-byte signed value"));
-    setRange(QVariant::fromValue(LONG_MIN), QVariant::fromValue(LONG_MAX));
-    setRangeText(tr("Minimum Value, -9 223 372 036 854 775 808"),
-        tr("Maximum Value, 9 223 372 036 854 775 807"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("8-byte signed value"))
+        .setRange(QVariant::fromValue(LONG_MIN), QVariant::fromValue(LONG_MAX))
+        .setRangeText(QT_TR_NOOP("Minimum Value, -9 223 372 036 854 775 808"),
+            QT_TR_NOOP("Maximum Value, 9 223 372 036 854 775 807"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(value);
 }
@@ -123,8 +126,11 @@ bool QKnxElectricalEnergy::isValid() const
 CLASS::CLASS() \
     : QKnxElectricalEnergy(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metadata = QKnxDatapointTypeMetadata(*this) \
+        .setUnit(QT_TR_NOOP(UNIT)) \
+        .setDescription(QT_TR_NOOP(DESCRIPTION)) \
+        .share(); \
+    QKnxDatapointTypeMetadata::assign(this, metadata); \
 } \
 CLASS::CLASS(qint64 value) \
     : CLASS() \
@@ -91,9 +91,12 @@ QKnxEntranceAccess::QKnxEntranceAccess()
 QKnxEntranceAccess::QKnxEntranceAccess(quint32 idCode, Attributes attributes, quint8 index)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Entrance Access"));
-    setRangeText(tr("Low Code, 0 0 0 0 0 0"), tr("High Code, 9 9 9 9 9 9"));
-    setRange(QVariant::fromValue(0), QVariant::fromValue(2576980479));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Entrance Access"))
+        .setRangeText(QT_TR_NOOP("Low Code, 0 0 0 0 0 0"), QT_TR_NOOP("High Code, 9 9 9 9 9 9"))
+        .setRange(QVariant::fromValue(0), QVariant::fromValue(2576980479))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setValue(idCode, attributes, index);
 }
@@ -118,9 +118,12 @@ QKnxSceneNumber::QKnxSceneNumber()
 QKnxSceneNumber::QKnxSceneNumber(quint8 number)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Number"));
-    setRange(QVariant(0x00), QVariant(0x3f));
-    setRangeText(tr("Minimum, 0"), tr("Maximum, 63"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Scene Number"))
+        .setRange(QVariant(0x00), QVariant(0x3f))
+        .setRangeText(QT_TR_NOOP("Minimum, 0"), QT_TR_NOOP("Maximum, 63"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setSceneNumber(number);
 }
@@ -176,9 +179,12 @@ QKnxSceneControl::QKnxSceneControl()
 QKnxSceneControl::QKnxSceneControl(quint8 sceneNumber, QKnxSceneControl::Control control)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Control"));
-    setRange(QVariant(0x00), QVariant(0xbf));
-    setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Scene Control"))
+        .setRange(QVariant(0x00), QVariant(0xbf))
+        .setRangeText(QT_TR_NOOP("Minimum scene number, 0"), QT_TR_NOOP("Maximum scene number, 63"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setSceneNumber(sceneNumber);
     setControl(control);
@@ -268,9 +274,12 @@ QKnxSceneInfo::QKnxSceneInfo()
 QKnxSceneInfo::QKnxSceneInfo(quint8 sceneNumber, QKnxSceneInfo::Info info)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Information"));
-    setRange(QVariant(0x00), QVariant(0x7f));
-    setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Scene Information"))
+        .setRange(QVariant(0x00), QVariant(0x7f))
+        .setRangeText(QT_TR_NOOP("Minimum scene number, 0"), QT_TR_NOOP("Maximum scene number, 63"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setSceneNumber(sceneNumber);
     setInfo(info);
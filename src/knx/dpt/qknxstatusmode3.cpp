@@ -99,9 +99,12 @@ QKnxStatusMode3::QKnxStatusMode3()
 QKnxStatusMode3::QKnxStatusMode3(Mode mode, StatusFlags statusFlags)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Status with Mode"));
-    setRange(QVariant(0x01), QVariant(0xfc));
-    setRangeText(tr("All set and Mode 0"), tr("All cleared and Mode 2"));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Status with Mode"))
+        .setRange(QVariant(0x01), QVariant(0xfc))
+        .setRangeText(QT_TR_NOOP("All set and Mode 0"), QT_TR_NOOP("All cleared and Mode 2"))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
 
     setMode(mode);
     setStatusFlags(statusFlags);
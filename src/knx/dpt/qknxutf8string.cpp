@@ -29,7 +29,7 @@
 
 #include "qknxutf8string.h"
 #include "qknxdatapointtype_p.h"
-#include "qtextcodec.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -82,34 +82,49 @@ QKnxUtf8String::QKnxUtf8String(const char *string, int size)
 QKnxUtf8String::QKnxUtf8String(int subType, const char *string, int size)
     : QKnxVariableSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Variable length character string (UTF-8)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Variable length character string (UTF-8)"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setString(string, size);
 }
 
 /*!
     Returns the string stored in the datapoint type.
+
+    If the stored bytes are not valid UTF-8, returns a null string.
 */
 QString QKnxUtf8String::string() const
 {
-    auto data = bytes(); // TODO: fix this
-    return QString::fromUtf8((const char*) data.constData(), data.size() - 1);
+    // a UTF-8 string never has more UTF-16 code units than bytes
+    QString string(size(), Qt::Uninitialized);
+    const int length = QKnxDatapointTypeCodec::decodeDpt28(constData(), size(), string.data(),
+        string.size());
+    if (length < 0)
+        return {};
+    string.resize(length);
+    return string;
 }
 
 /*!
     Sets the string stored in the datapoint type to \a string.
 
-    If the value is outside the allowed range, returns \c false and does not set
-    the string.
+    If the value is outside the allowed range or \a string contains an unpaired
+    surrogate, returns \c false and does not set the string.
 */
 bool QKnxUtf8String::setString(const QString &string)
 {
     if (string.size() >= USHRT_MAX)
         return false;
 
-    auto utf8 = string.toUtf8();
-    return setBytes(QKnxByteArray(utf8.constData(), utf8.size()) + QKnxByteArray::fromHex("00"), 0,
-        utf8.size() + 1);
+    // at most three bytes per UTF-16 code unit, plus the terminating null byte
+    QKnxByteArray bytes(qMin(3 * string.size() + 1, int(USHRT_MAX)), Qt::Uninitialized);
+    const int size = QKnxDatapointTypeCodec::encodeDpt28(string, bytes.data(), bytes.size());
+    if (size < 0)
+        return false;
+    bytes.resize(size);
+    return setBytes(bytes, 0, quint16(size));
 }
 
 /*!
@@ -123,34 +138,30 @@ bool QKnxUtf8String::setString(const QString &string)
 */
 bool QKnxUtf8String::setString(const char *string, int size)
 {
-    auto null = QKnxByteArray::fromHex("00");
-    if (!string)
-        return setBytes(null, 0, 1);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, 1);
-
+    size = (string ? (size < 0 ? int(strlen(string)) : size) : 0);
     if (size >= USHRT_MAX)
         return false;
 
-    QTextCodec *codec = QTextCodec::codecForName("UTF-8");
-    if (!codec)
+    const auto data = reinterpret_cast<const quint8 *>(string);
+    if (!QKnxDatapointTypeCodec::isValidUtf8(data, size))
         return false;
 
-    QTextCodec::ConverterState state;
-    auto text = codec->toUnicode(string, size, &state);
-    if (state.invalidChars > 0)
-        return false;
-    return setString(text);
+    QKnxByteArray bytes(size + 1, Qt::Uninitialized);
+    if (size > 0)
+        memcpy(bytes.data(), data, size_t(size));
+    bytes.set(size, 0);
+    return setBytes(bytes, 0, quint16(size + 1));
 }
 
 /*!
     \reimp
+
+    The stored bytes must be null terminated and valid UTF-8.
 */
 bool QKnxUtf8String::isValid() const
 {
-    return QKnxDatapointType::isValid() && byte(quint8(size()-1)) == 0;
+    return QKnxDatapointType::isValid() && size() > 0 && byte(quint16(size() - 1)) == 0
+        && QKnxDatapointTypeCodec::decodeDpt28(constData(), size(), nullptr, 0) >= 0;
 }
 
 
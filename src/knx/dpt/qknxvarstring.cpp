@@ -29,6 +29,7 @@
 
 #include "qknxvarstring.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -83,8 +84,11 @@ QKnxVarString::QKnxVarString(const char *string, int size)
 QKnxVarString::QKnxVarString(int subType, const char *string, int size)
     : QKnxVariableSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Variable length character string (ISO 8859-1)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metadata = QKnxDatapointTypeMetadata(*this)
+        .setDescription(QT_TR_NOOP("Variable length character string (ISO 8859-1)"))
+        .setRange(QVariant(0x00), QVariant(0xff))
+        .share();
+    QKnxDatapointTypeMetadata::assign(this, metadata);
     setString(string, size);
 }
 
@@ -93,7 +97,7 @@ QKnxVarString::QKnxVarString(int subType, const char *string, int size)
 */
 QLatin1String QKnxVarString::string() const
 {
-    return QLatin1String((const char*) constData());
+    return QKnxDatapointTypeCodec::decodeDpt24(constData(), size());
 }
 
 /*!
@@ -116,17 +120,13 @@ bool QKnxVarString::setString(QLatin1String string)
 */
 bool QKnxVarString::setString(const char *string, int size)
 {
-    auto null = QKnxByteArray::fromHex("00");
-    if (!string)
-        return setBytes(null, 0, 1);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, 1);
-
+    size = (string ? (size < 0 ? int(strlen(string)) : size) : 0);
     if (size >= USHRT_MAX)
         return false;
-    return setBytes(QKnxByteArray(string, size) + null, 0, size + 1);
+
+    QKnxByteArray bytes(size + 1, Qt::Uninitialized);
+    QKnxDatapointTypeCodec::encodeDpt24(QLatin1String(string, size), bytes.data(), bytes.size());
+    return setBytes(bytes, 0, quint16(bytes.size()));
 }
 
 /*!
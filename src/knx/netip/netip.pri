@@ -1,6 +1,12 @@
 INCLUDEPATH += $$PWD
 
-PUBLIC_HEADERS += $$PWD/qknxnetip.h \
+PUBLIC_HEADERS += $$PWD/qknxbusmonitorbuffer.h \
+    $$PWD/qknxcapturereader.h \
+    $$PWD/qknxcapturereplay.h \
+    $$PWD/qknxcapturewriter.h \
+    $$PWD/qknxgroupvaluecache.h \
+    $$PWD/qknxgroupvaluedecoder.h \
+    $$PWD/qknxnetip.h \
     $$PWD/qknxnetipconfigdib.h \
     $$PWD/qknxnetipconnectionheader.h \
     $$PWD/qknxnetipconnectionstaterequest.h \
@@ -53,17 +59,36 @@ PUBLIC_HEADERS += $$PWD/qknxnetip.h \
     $$PWD/qknxnetipsessionstatus.h \
     $$PWD/qknxnetiptimernotify.h \
     $$PWD/qknxnetipsecurewrapper.h \
-    $$PWD/qknxnetiprouter.h
+    $$PWD/qknxnetiprouter.h \
+    $$PWD/qknxnetipsecureconfiguration.h \
+    $$PWD/qknxnetipsharedtransport.h \
+    $$PWD/qknxvirtualclock.h
 
 PRIVATE_HEADERS += \
     $$PWD/qknxbuilderdata_p.h \
+    $$PWD/qknxbusloadestimator_p.h \
+    $$PWD/qknxcapturewriter_p.h \
+    $$PWD/qknxgroupvaluecache_p.h \
+    $$PWD/qknxgroupvaluedecoder_p.h \
     $$PWD/qknxnetipendpointconnection_p.h \
+    $$PWD/qknxnetipframescheduler_p.h \
     $$PWD/qknxnetipserverdescriptionagent_p.h \
     $$PWD/qknxnetipserverdiscoveryagent_p.h \
     $$PWD/qknxnetipserverinfo_p.h \
-    $$PWD/qknxnetiptestrouter_p.h
+    $$PWD/qknxnetipservicedispatcher_p.h \
+    $$PWD/qknxnetipstructlayout_p.h \
+    $$PWD/qknxnetiptestrouter_p.h \
+    $$PWD/qknxtimer_p.h \
+    $$PWD/qknxtimerwheel_p.h
 
-SOURCES += $$PWD/qknxnetip.cpp \
+SOURCES += $$PWD/qknxbusloadestimator.cpp \
+    $$PWD/qknxbusmonitorbuffer.cpp \
+    $$PWD/qknxcapturereader.cpp \
+    $$PWD/qknxcapturereplay.cpp \
+    $$PWD/qknxcapturewriter.cpp \
+    $$PWD/qknxgroupvaluecache.cpp \
+    $$PWD/qknxgroupvaluedecoder.cpp \
+    $$PWD/qknxnetip.cpp \
     $$PWD/qknxnetipconfigdib.cpp \
     $$PWD/qknxnetipconnectionheader.cpp \
     $$PWD/qknxnetipconnectionstaterequest.cpp \
@@ -117,4 +142,9 @@ SOURCES += $$PWD/qknxnetip.cpp \
     $$PWD/qknxnetiptimernotify.cpp \
     $$PWD/qknxnetipsecurewrapper.cpp \
     $$PWD/qknxnetiprouter.cpp \
-    $$PWD/qknxnetiprouter_p.cpp
+    $$PWD/qknxnetiprouter_p.cpp \
+    $$PWD/qknxnetipsecureconfiguration.cpp \
+    $$PWD/qknxnetipsharedtransport.cpp \
+    $$PWD/qknxtimer.cpp \
+    $$PWD/qknxtimerwheel.cpp \
+    $$PWD/qknxvirtualclock.cpp
@@ -0,0 +1,146 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxbusloadestimator_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxBusLoadEstimator
+
+    \brief The QKnxBusLoadEstimator class estimates the utilization of a KNX
+    TP1 line from the telegrams seen on it.
+
+    The bus time of each telegram is accumulated in buckets of BucketLength
+    milliseconds, the load is the busy time of the last BucketCount buckets
+    divided by their duration. All time stamps passed to the estimator are
+    milliseconds of a monotonic clock.
+*/
+
+/*!
+    Returns the time in microseconds the TP1 telegram carried by the link layer
+    \a frame occupies the bus, including the line idle time in front of the
+    telegram and the acknowledgment.
+*/
+qint64 QKnxBusLoadEstimator::busTime(const QKnxLinkLayerFrame &frame)
+{
+    // control field, source, destination, length, TPDU, checksum; extended
+    // frames carry an additional control field
+    const bool extended = frame.controlField().frameFormat()
+        == QKnxControlField::FrameFormat::Extended;
+    return busTime(7 + int(extended) + frame.tpdu().size());
+}
+
+/*!
+    Returns the time in microseconds a TP1 telegram of \a octets bytes occupies
+    the bus, including the line idle time in front of the telegram and the
+    acknowledgment.
+*/
+qint64 QKnxBusLoadEstimator::busTime(int octets)
+{
+    // 03_02_02 Communication Medium TP1: 50 bit times of idle line before the
+    // telegram, 13 bit times per character (start, 8 data, parity, stop and
+    // 2 bits pause), 15 bit times before the single acknowledge character
+    const qint64 bits = 50 + 13 * qint64(octets) + 15 + 13;
+    return (bits * 1000000 + BitRate - 1) / BitRate;
+}
+
+/*!
+    Sets the load above which sending should be throttled to \a limit, a value
+    between \c 0 and \c 1. A limit of \c 1 or more disables throttling.
+
+    A limit of \c 0 or less would throttle even an idle line forever, so it
+    disables throttling as well and the limit is reset to \c 1.
+*/
+void QKnxBusLoadEstimator::setLimit(qreal limit)
+{
+    m_limit = (limit > 0. && limit < 1.) ? limit : 1.;
+}
+
+/*!
+    Records a telegram that occupied the bus for \a busTime microseconds at
+    time \a now.
+*/
+void QKnxBusLoadEstimator::record(qint64 busTime, qint64 now)
+{
+    advance(now);
+    m_busy[m_current] += busTime;
+}
+
+/*!
+    Returns the estimated bus load at time \a now, \c 0 for an idle line and
+    \c 1 for a line that was busy all the time.
+*/
+qreal QKnxBusLoadEstimator::load(qint64 now) const
+{
+    advance(now);
+
+    qint64 busy = 0;
+    for (auto bucket : m_busy)
+        busy += bucket;
+    return qMin(1., qreal(busy) / (BucketCount * BucketLength * 1000));
+}
+
+/*!
+    Returns the number of milliseconds from \a now until the oldest bucket
+    drops out of the estimate and the load can decrease.
+*/
+int QKnxBusLoadEstimator::nextDecay(qint64 now) const
+{
+    advance(now);
+    return int(m_bucketStart + BucketLength - now);
+}
+
+/*!
+    Forgets all recorded telegrams.
+*/
+void QKnxBusLoadEstimator::reset()
+{
+    for (auto &bucket : m_busy)
+        bucket = 0;
+    m_bucketStart = 0;
+    m_current = 0;
+}
+
+void QKnxBusLoadEstimator::advance(qint64 now) const
+{
+    if (now < m_bucketStart + BucketLength)
+        return;
+
+    const qint64 elapsed = (now - m_bucketStart) / BucketLength;
+    const int steps = int(qMin<qint64>(elapsed, BucketCount));
+    for (int i = 0; i < steps; ++i) {
+        m_current = (m_current + 1) % BucketCount;
+        m_busy[m_current] = 0;
+    }
+    m_bucketStart += elapsed * BucketLength;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,83 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXBUSLOADESTIMATOR_P_H
+#define QKNXBUSLOADESTIMATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxBusLoadEstimator final
+{
+public:
+    // utilization is averaged over BucketCount * BucketLength milliseconds
+    enum : int { BitRate = 9600, BucketCount = 10, BucketLength = 100 };
+
+    QKnxBusLoadEstimator() = default;
+    ~QKnxBusLoadEstimator() = default;
+
+    static qint64 busTime(const QKnxLinkLayerFrame &frame);
+    static qint64 busTime(int octets);
+
+    qreal limit() const { return m_limit; }
+    void setLimit(qreal limit);
+
+    void record(qint64 busTime, qint64 now);
+    qreal load(qint64 now) const;
+
+    bool isThrottled(qint64 now) const { return m_limit < 1. && load(now) >= m_limit; }
+    int nextDecay(qint64 now) const;
+
+    void reset();
+
+private:
+    void advance(qint64 now) const;
+
+    mutable qint64 m_busy[BucketCount] {};
+    mutable qint64 m_bucketStart { 0 };
+    mutable int m_current { 0 };
+    qreal m_limit { 1. };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,315 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxbusmonitorbuffer.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmath.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxBusMonitorBuffer
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxBusMonitorBuffer class stores timestamped bus monitor
+    frames in a preallocated ring buffer.
+
+    The buffer is meant for capturing all telegrams of a KNX line over a long
+    time. All memory is allocated up front; storing a frame copies the raw
+    cEMI bytes, including the additional information such as the bus monitor
+    status and the time stamps provided by the KNXnet/IP server, into a fixed
+    size slot without decoding them. Frames are only decoded when they are
+    read.
+
+    The buffer supports exactly one writer and one reader, which may live in
+    different threads. Neither side ever takes a lock. If the buffer is full,
+    new frames are dropped and counted by droppedCount(); frames that are
+    already stored are never overwritten.
+
+    The following code sample illustrates how to capture the frames of a bus
+    monitor tunnel:
+
+    \code
+        QKnxBusMonitorBuffer buffer(1 << 20);
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setTunnelLayer(QKnxNetIp::TunnelLayer::Busmonitor);
+        tunnel.setBusMonitorBuffer(&buffer);
+        tunnel.connectToHost(...);
+
+        // later, possibly from another thread
+        QKnxLinkLayerFrame frame;
+        qint64 timestamp;
+        while (buffer.read(&frame, &timestamp))
+            ...
+    \endcode
+
+    \sa QKnxNetIpTunnel::setBusMonitorBuffer()
+*/
+
+/*!
+    \enum QKnxBusMonitorBuffer::anonymous
+
+    \value DefaultCapacity
+        The number of frames a buffer holds if no capacity is passed to the
+        constructor.
+    \value MaximumFrameSize
+        The maximum size in bytes of a stored cEMI frame. Larger frames are
+        dropped.
+*/
+
+/*!
+    \typedef QKnxBusMonitorBuffer::Visitor
+
+    A synonym for std::function<void (qint64 timestamp, const quint8 *cemi, int size)>,
+    the type of the function called by consume() for each stored frame.
+*/
+
+class QKnxBusMonitorBufferPrivate final
+{
+public:
+    struct Slot
+    {
+        qint64 timestamp;
+        quint16 size;
+        quint8 data[QKnxBusMonitorBuffer::MaximumFrameSize];
+    };
+
+    explicit QKnxBusMonitorBufferPrivate(int capacity)
+        : m_capacity(capacity)
+        , m_slots(new Slot[capacity])
+    {}
+
+    const Slot *peek() const
+    {
+        const auto tail = m_tail.load();
+        if (tail == m_head.loadAcquire())
+            return nullptr;
+        return &m_slots[int(tail & (m_capacity - 1))];
+    }
+
+    void pop()
+    {
+        m_tail.storeRelease(m_tail.load() + 1);
+    }
+
+    const int m_capacity;
+    QScopedArrayPointer<Slot> m_slots;
+
+    // the writer owns m_head, the reader owns m_tail
+    QAtomicInteger<quint64> m_head { 0 };
+    QAtomicInteger<quint64> m_tail { 0 };
+    QAtomicInteger<quint64> m_dropped { 0 };
+};
+
+/*!
+    Creates a buffer able to hold \a capacity frames. The capacity is rounded
+    up to the next power of two. Each frame occupies 128 bytes.
+*/
+QKnxBusMonitorBuffer::QKnxBusMonitorBuffer(int capacity)
+    : d_ptr(new QKnxBusMonitorBufferPrivate(int(qNextPowerOfTwo(quint32(qBound(2,
+        capacity, 1 << 30) - 1)))))
+{}
+
+/*!
+    Destroys the buffer and all stored frames.
+*/
+QKnxBusMonitorBuffer::~QKnxBusMonitorBuffer() = default;
+
+/*!
+    Returns the number of frames the buffer can hold.
+*/
+int QKnxBusMonitorBuffer::capacity() const
+{
+    Q_D(const QKnxBusMonitorBuffer);
+    return d->m_capacity;
+}
+
+/*!
+    Returns the number of frames stored in the buffer that have not been read.
+*/
+int QKnxBusMonitorBuffer::size() const
+{
+    Q_D(const QKnxBusMonitorBuffer);
+    const auto tail = d->m_tail.loadAcquire();
+    return int(d->m_head.loadAcquire() - tail);
+}
+
+/*!
+    Returns \c true if there are no frames to read; otherwise returns \c false.
+*/
+bool QKnxBusMonitorBuffer::isEmpty() const
+{
+    return size() == 0;
+}
+
+/*!
+    Returns the number of frames that were not stored because the buffer was
+    full or the frame exceeded MaximumFrameSize.
+*/
+quint64 QKnxBusMonitorBuffer::droppedCount() const
+{
+    Q_D(const QKnxBusMonitorBuffer);
+    return d->m_dropped.loadAcquire();
+}
+
+/*!
+    Stores the \a size bytes of the raw cEMI frame \a cemi together with the
+    \a timestamp in milliseconds since epoch. Returns \c true on success;
+    otherwise returns \c false and counts the frame as dropped.
+
+    This function must only be called by the writer.
+*/
+bool QKnxBusMonitorBuffer::write(const quint8 *cemi, int size, qint64 timestamp)
+{
+    Q_D(QKnxBusMonitorBuffer);
+    const auto head = d->m_head.load();
+    if (!cemi || size <= 0 || size > MaximumFrameSize
+        || head - d->m_tail.loadAcquire() >= quint64(d->m_capacity)) {
+        d->m_dropped.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    auto &slot = d->m_slots[int(head & (d->m_capacity - 1))];
+    slot.timestamp = timestamp;
+    slot.size = quint16(size);
+    std::memcpy(slot.data, cemi, size_t(size));
+
+    d->m_head.storeRelease(head + 1);
+    return true;
+}
+
+/*!
+    \overload
+
+    Stores the raw cEMI frame \a cemi together with the \a timestamp in
+    milliseconds since epoch.
+*/
+bool QKnxBusMonitorBuffer::write(const QKnxByteArray &cemi, qint64 timestamp)
+{
+    return write(cemi.constData(), cemi.size(), timestamp);
+}
+
+/*!
+    Removes the oldest frame from the buffer, decodes it into \a frame and
+    stores its time stamp in \a timestamp if \a timestamp is not \c nullptr.
+    Returns \c true if a frame was read; otherwise returns \c false.
+
+    This function must only be called by the reader.
+*/
+bool QKnxBusMonitorBuffer::read(QKnxLinkLayerFrame *frame, qint64 *timestamp)
+{
+    Q_D(QKnxBusMonitorBuffer);
+    const auto slot = d->peek();
+    if (!slot)
+        return false;
+
+    if (frame) {
+        *frame = QKnxLinkLayerFrame::builder()
+            .setMedium(QKnx::MediumType::NetIP)
+            .setData(QKnxByteArray(slot->data, slot->size))
+            .createFrame();
+    }
+    if (timestamp)
+        *timestamp = slot->timestamp;
+
+    d->pop();
+    return true;
+}
+
+/*!
+    Removes the oldest frame from the buffer and copies its raw cEMI bytes to
+    \a cemi and its time stamp to \a timestamp if \a timestamp is not
+    \c nullptr. Returns \c true if a frame was read; otherwise returns
+    \c false.
+
+    This function must only be called by the reader.
+*/
+bool QKnxBusMonitorBuffer::readRaw(QKnxByteArray *cemi, qint64 *timestamp)
+{
+    Q_D(QKnxBusMonitorBuffer);
+    const auto slot = d->peek();
+    if (!slot)
+        return false;
+
+    if (cemi)
+        *cemi = QKnxByteArray(slot->data, slot->size);
+    if (timestamp)
+        *timestamp = slot->timestamp;
+
+    d->pop();
+    return true;
+}
+
+/*!
+    Calls \a visitor with the time stamp and raw cEMI bytes of up to
+    \a maximum frames, oldest first, and removes them from the buffer. A
+    negative \a maximum consumes all stored frames. Returns the number of
+    frames consumed.
+
+    The bytes passed to \a visitor are only valid during the call. This
+    function must only be called by the reader.
+*/
+int QKnxBusMonitorBuffer::consume(const Visitor &visitor, int maximum)
+{
+    Q_D(QKnxBusMonitorBuffer);
+
+    int count = 0;
+    while (maximum < 0 || count < maximum) {
+        const auto slot = d->peek();
+        if (!slot)
+            break;
+        if (visitor)
+            visitor(slot->timestamp, slot->data, slot->size);
+        d->pop();
+        ++count;
+    }
+    return count;
+}
+
+/*!
+    Removes all stored frames from the buffer. The dropped frame count is not
+    reset.
+
+    This function must only be called by the reader.
+*/
+void QKnxBusMonitorBuffer::clear()
+{
+    Q_D(QKnxBusMonitorBuffer);
+    d->m_tail.storeRelease(d->m_head.loadAcquire());
+}
+
+QT_END_NAMESPACE
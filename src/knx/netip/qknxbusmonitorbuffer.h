@@ -0,0 +1,76 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXBUSMONITORBUFFER_H
+#define QKNXBUSMONITORBUFFER_H
+
+#include <QtCore/qscopedpointer.h>
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxBusMonitorBufferPrivate;
+class Q_KNX_EXPORT QKnxBusMonitorBuffer final
+{
+public:
+    enum : int { DefaultCapacity = 65536, MaximumFrameSize = 118 };
+
+    explicit QKnxBusMonitorBuffer(int capacity = DefaultCapacity);
+    ~QKnxBusMonitorBuffer();
+
+    int capacity() const;
+    int size() const;
+    bool isEmpty() const;
+    quint64 droppedCount() const;
+
+    bool write(const quint8 *cemi, int size, qint64 timestamp);
+    bool write(const QKnxByteArray &cemi, qint64 timestamp);
+
+    bool read(QKnxLinkLayerFrame *frame, qint64 *timestamp = nullptr);
+    bool readRaw(QKnxByteArray *cemi, qint64 *timestamp = nullptr);
+
+    using Visitor = std::function<void (qint64 timestamp, const quint8 *cemi, int size)>;
+    int consume(const Visitor &visitor, int maximum = -1);
+
+    void clear();
+
+private:
+    Q_DISABLE_COPY(QKnxBusMonitorBuffer)
+    Q_DECLARE_PRIVATE(QKnxBusMonitorBuffer)
+    QScopedPointer<QKnxBusMonitorBufferPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
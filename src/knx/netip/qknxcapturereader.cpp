@@ -0,0 +1,598 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcapturereader.h"
+#include "qknxcapturewriter_p.h"
+#include "qknxlinklayerframebuilder.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxCaptureReader
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxCaptureReader class reads KNXnet/IP and cEMI frames from
+    pcap and pcapng capture files.
+
+    The reader maps the capture file into memory and walks it record by record,
+    so even very large captures are never loaded as a whole. Each call to
+    readNext() advances to the next record that carries a KNXnet/IP frame or a
+    cEMI frame, skipping all other traffic. KNXnet/IP frames are found in UDP
+    datagrams of Ethernet, raw IP and IPv4 captures; cEMI frames are read from
+    records of the \c LINKTYPE_USER0 link type, as written by
+    QKnxCaptureWriter.
+
+    constData() and size() give access to the bytes of the current frame
+    without copying them; the pointer stays valid until the next call to
+    readNext() or close(). netIpFrame() and linkLayerFrame() decode the
+    current record on demand.
+
+    \code
+        QKnxCaptureReader reader("knx.pcapng");
+        while (reader.readNext()) {
+            if (reader.recordType() == QKnxCaptureReader::RecordType::Cemi)
+                qDebug() << reader.timestamp() << reader.linkLayerFrame();
+        }
+    \endcode
+
+    \sa QKnxCaptureWriter
+*/
+
+/*!
+    \enum QKnxCaptureReader::Format
+
+    This enum describes the format of a capture file.
+
+    \value Unknown
+        No file is open or the file format is not supported.
+    \value Pcap
+        The classic libpcap format.
+    \value Pcapng
+        The pcap next generation format.
+*/
+
+/*!
+    \enum QKnxCaptureReader::RecordType
+
+    This enum describes the type of the current record.
+
+    \value Unknown
+        There is no current record.
+    \value NetIp
+        The record holds a KNXnet/IP frame.
+    \value Cemi
+        The record holds a cEMI frame.
+*/
+
+class QKnxCaptureReaderPrivate final
+{
+public:
+    struct Interface
+    {
+        quint16 linkType { 0 };
+        quint8 resolution { 6 }; // pcapng if_tsresol, 10^-6 seconds by default
+    };
+
+    quint16 read16(qint64 offset) const
+    {
+        return m_bigEndian ? qFromBigEndian<quint16>(m_data + offset)
+                           : qFromLittleEndian<quint16>(m_data + offset);
+    }
+
+    quint32 read32(qint64 offset) const
+    {
+        return m_bigEndian ? qFromBigEndian<quint32>(m_data + offset)
+                           : qFromLittleEndian<quint32>(m_data + offset);
+    }
+
+    static qint64 toNanoseconds(quint64 value, quint8 resolution);
+
+    bool setError(const QString &error)
+    {
+        m_errorString = error;
+        m_offset = m_size;
+        return false;
+    }
+
+    bool detectFormat();
+    bool readPcapRecord();
+    bool readPcapngBlock(bool *isRecord);
+    bool setRecord(quint16 linkType, const uchar *data, int size);
+    bool setIpv4Record(const uchar *data, int size);
+
+    QFile m_file;
+    QByteArray m_fallback;
+    const uchar *m_data { nullptr };
+    qint64 m_size { 0 };
+    qint64 m_offset { 0 };
+
+    QKnxCaptureReader::Format m_format { QKnxCaptureReader::Format::Unknown };
+    bool m_bigEndian { false };
+    QString m_errorString;
+    QVector<Interface> m_interfaces;
+
+    QKnxCaptureReader::RecordType m_type { QKnxCaptureReader::RecordType::Unknown };
+    qint64 m_timestamp { 0 };
+    QKnxCaptureWriter::Direction m_direction { QKnxCaptureWriter::Direction::Unknown };
+    const quint8 *m_record { nullptr };
+    int m_recordSize { 0 };
+};
+
+qint64 QKnxCaptureReaderPrivate::toNanoseconds(quint64 value, quint8 resolution)
+{
+    const quint8 exponent = resolution & 0x7f;
+    if (resolution & 0x80) {
+        // negative power of two
+        if (exponent >= 64)
+            return 0;
+        const quint64 mask = (quint64(1) << exponent) - 1;
+        return qint64((value >> exponent) * 1000000000
+            + (((value & mask) * 1000000000) >> exponent));
+    }
+
+    qint64 result = qint64(value);
+    for (int i = exponent; i < 9; ++i)
+        result *= 10;
+    for (int i = 9; i < exponent; ++i)
+        result /= 10;
+    return result;
+}
+
+bool QKnxCaptureReaderPrivate::detectFormat()
+{
+    using namespace QKnxPcapng;
+
+    m_interfaces.clear();
+    if (m_size < 24) {
+        m_errorString = QKnxCaptureReader::tr("File too short for a capture file.");
+        return false;
+    }
+
+    const quint32 magic = qFromLittleEndian<quint32>(m_data);
+    if (magic == SectionHeaderBlock) {
+        m_format = QKnxCaptureReader::Format::Pcapng;
+        return true; // the byte order is read per section
+    }
+
+    for (const bool bigEndian : { false, true }) {
+        m_bigEndian = bigEndian;
+        const quint32 value = read32(0);
+        if (value != PcapMagic && value != PcapNanosecondMagic)
+            continue;
+
+        m_format = QKnxCaptureReader::Format::Pcap;
+        m_interfaces.append({ quint16(read32(20)), quint8(value == PcapMagic ? 6 : 9) });
+        m_offset = 24;
+        return true;
+    }
+
+    m_errorString = QKnxCaptureReader::tr("Unsupported capture file format.");
+    return false;
+}
+
+bool QKnxCaptureReaderPrivate::readPcapRecord()
+{
+    if (m_offset + 16 > m_size)
+        return setError(QKnxCaptureReader::tr("Truncated record header."));
+
+    const quint32 seconds = read32(m_offset);
+    const quint32 fraction = read32(m_offset + 4);
+    const quint32 captured = read32(m_offset + 8);
+    if (m_offset + 16 + captured > m_size)
+        return setError(QKnxCaptureReader::tr("Truncated record."));
+
+    const auto data = m_data + m_offset + 16;
+    m_offset += 16 + captured;
+
+    const auto &iface = m_interfaces.first();
+    m_timestamp = qint64(seconds) * 1000000000 + toNanoseconds(fraction, iface.resolution);
+    m_direction = QKnxCaptureWriter::Direction::Unknown;
+    return setRecord(iface.linkType, data, int(captured));
+}
+
+bool QKnxCaptureReaderPrivate::readPcapngBlock(bool *isRecord)
+{
+    using namespace QKnxPcapng;
+
+    *isRecord = false;
+    if (m_offset + 12 > m_size)
+        return setError(QKnxCaptureReader::tr("Truncated block header."));
+
+    const quint32 type = qFromLittleEndian<quint32>(m_data + m_offset);
+    if (type == SectionHeaderBlock) {
+        if (m_offset + 28 > m_size)
+            return setError(QKnxCaptureReader::tr("Truncated section header."));
+        const quint32 magic = qFromLittleEndian<quint32>(m_data + m_offset + 8);
+        if (magic != ByteOrderMagic && magic != qbswap(quint32(ByteOrderMagic)))
+            return setError(QKnxCaptureReader::tr("Invalid byte order magic."));
+        m_bigEndian = (magic != ByteOrderMagic);
+        m_interfaces.clear();
+    }
+
+    const quint32 length = read32(m_offset + 4);
+    if (length < 12 || (length % 4) != 0 || m_offset + length > m_size)
+        return setError(QKnxCaptureReader::tr("Invalid block length."));
+
+    const qint64 block = m_offset;
+    const qint64 end = block + length - 4; // options end before the trailing length
+    m_offset += length;
+
+    switch (read32(block)) {
+    case InterfaceDescriptionBlock: {
+        if (length < 20)
+            return setError(QKnxCaptureReader::tr("Invalid interface description."));
+        Interface iface;
+        iface.linkType = read16(block + 8);
+        for (qint64 option = block + 16; option + 4 <= end;) {
+            const quint16 code = read16(option);
+            const quint16 size = read16(option + 2);
+            if (code == EndOfOptions || option + 4 + size > end)
+                break;
+            if (code == InterfaceTimestampResolution && size == 1)
+                iface.resolution = m_data[option + 4];
+            option += 4 + ((size + 3) & ~3);
+        }
+        m_interfaces.append(iface);
+    }   break;
+    case EnhancedPacketBlock: {
+        if (length < 32)
+            return setError(QKnxCaptureReader::tr("Invalid enhanced packet block."));
+        const quint32 id = read32(block + 8);
+        const quint32 captured = read32(block + 20);
+        if (int(id) >= m_interfaces.size() || block + 28 + captured > end)
+            return setError(QKnxCaptureReader::tr("Invalid enhanced packet block."));
+
+        const auto &iface = m_interfaces.at(int(id));
+        const quint64 ts = quint64(read32(block + 12)) << 32 | read32(block + 16);
+        m_timestamp = toNanoseconds(ts, iface.resolution);
+
+        m_direction = QKnxCaptureWriter::Direction::Unknown;
+        for (qint64 option = block + 28 + ((captured + 3) & ~3); option + 4 <= end;) {
+            const quint16 code = read16(option);
+            const quint16 size = read16(option + 2);
+            if (code == EndOfOptions || option + 4 + size > end)
+                break;
+            if (code == PacketFlags && size == 4) {
+                const quint32 flags = read32(option + 4) & DirectionMask;
+                if (flags == Inbound)
+                    m_direction = QKnxCaptureWriter::Direction::Inbound;
+                else if (flags == Outbound)
+                    m_direction = QKnxCaptureWriter::Direction::Outbound;
+            }
+            option += 4 + ((size + 3) & ~3);
+        }
+        *isRecord = setRecord(iface.linkType, m_data + block + 28, int(captured));
+    }   break;
+    case SimplePacketBlock: {
+        if (m_interfaces.isEmpty() || length < 16)
+            return setError(QKnxCaptureReader::tr("Invalid simple packet block."));
+        const qint64 captured = qMin<qint64>(read32(block + 8), end - (block + 12));
+        m_timestamp = 0;
+        m_direction = QKnxCaptureWriter::Direction::Unknown;
+        *isRecord = setRecord(m_interfaces.first().linkType, m_data + block + 12, int(captured));
+    }   break;
+    default:
+        break; // section headers and unknown blocks carry no frames
+    }
+    return true;
+}
+
+bool QKnxCaptureReaderPrivate::setRecord(quint16 linkType, const uchar *data, int size)
+{
+    using namespace QKnxPcapng;
+
+    switch (linkType) {
+    case LinkTypeUser0:
+        if (size < 2)
+            return false;
+        m_type = QKnxCaptureReader::RecordType::Cemi;
+        m_record = data;
+        m_recordSize = size;
+        return true;
+    case LinkTypeIpv4:
+    case LinkTypeRaw:
+        return setIpv4Record(data, size);
+    case LinkTypeEthernet: {
+        int offset = 12;
+        if (size >= offset + 2 && qFromBigEndian<quint16>(data + offset) == 0x8100)
+            offset += 4; // 802.1Q VLAN tag
+        if (size < offset + 2 || qFromBigEndian<quint16>(data + offset) != 0x0800)
+            return false;
+        return setIpv4Record(data + offset + 2, size - offset - 2);
+    }
+    default:
+        break;
+    }
+    return false;
+}
+
+bool QKnxCaptureReaderPrivate::setIpv4Record(const uchar *data, int size)
+{
+    using namespace QKnxPcapng;
+
+    if (size < Ipv4HeaderSize || (data[0] >> 4) != 4 || data[9] != 17)
+        return false;
+
+    const int headerSize = (data[0] & 0x0f) * 4;
+    const int totalSize = qMin<int>(qFromBigEndian<quint16>(data + 2), size);
+    if (headerSize < Ipv4HeaderSize || totalSize < headerSize + UdpHeaderSize)
+        return false;
+
+    // KNXnet/IP frames start with a six byte header
+    const auto payload = data + headerSize + UdpHeaderSize;
+    const int payloadSize = totalSize - headerSize - UdpHeaderSize;
+    if (payloadSize < 6 || payload[0] != 0x06)
+        return false;
+
+    m_type = QKnxCaptureReader::RecordType::NetIp;
+    m_record = payload;
+    m_recordSize = payloadSize;
+    return true;
+}
+
+/*!
+    Creates a capture reader without an open file.
+*/
+QKnxCaptureReader::QKnxCaptureReader()
+    : d_ptr(new QKnxCaptureReaderPrivate)
+{}
+
+/*!
+    Creates a capture reader and opens the capture file \a fileName.
+*/
+QKnxCaptureReader::QKnxCaptureReader(const QString &fileName)
+    : QKnxCaptureReader()
+{
+    open(fileName);
+}
+
+/*!
+    Closes the capture file and destroys the reader.
+*/
+QKnxCaptureReader::~QKnxCaptureReader()
+{
+    close();
+}
+
+/*!
+    Opens the capture file \a fileName and detects its format. An already open
+    file is closed first.
+
+    Returns \c true on success; otherwise returns \c false and errorString()
+    describes the error.
+*/
+bool QKnxCaptureReader::open(const QString &fileName)
+{
+    close();
+
+    Q_D(QKnxCaptureReader);
+    d->m_file.setFileName(fileName);
+    if (!d->m_file.open(QIODevice::ReadOnly)) {
+        d->m_errorString = d->m_file.errorString();
+        return false;
+    }
+
+    d->m_size = d->m_file.size();
+    d->m_data = d->m_file.map(0, d->m_size);
+    if (!d->m_data) {
+        // not every file system supports mapping, read the file instead
+        d->m_fallback = d->m_file.readAll();
+        d->m_data = reinterpret_cast<const uchar *>(d->m_fallback.constData());
+        d->m_size = d->m_fallback.size();
+    }
+
+    d->m_errorString.clear();
+    if (!d->detectFormat()) {
+        const auto error = d->m_errorString;
+        close();
+        d->m_errorString = error;
+        return false;
+    }
+    return true;
+}
+
+/*!
+    Returns \c true if a capture file is open; otherwise returns \c false.
+*/
+bool QKnxCaptureReader::isOpen() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_data != nullptr;
+}
+
+/*!
+    Closes the capture file. All pointers returned by constData() become
+    invalid.
+*/
+void QKnxCaptureReader::close()
+{
+    Q_D(QKnxCaptureReader);
+    if (d->m_data && d->m_fallback.isEmpty())
+        d->m_file.unmap(const_cast<uchar *>(d->m_data));
+    d->m_file.close();
+    d->m_fallback.clear();
+
+    d->m_data = nullptr;
+    d->m_size = 0;
+    d->m_offset = 0;
+    d->m_format = Format::Unknown;
+    d->m_interfaces.clear();
+    d->m_type = RecordType::Unknown;
+    d->m_record = nullptr;
+    d->m_recordSize = 0;
+}
+
+/*!
+    Returns the format of the open capture file.
+*/
+QKnxCaptureReader::Format QKnxCaptureReader::format() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_format;
+}
+
+/*!
+    Returns a human-readable description of the last error, or an empty string
+    if the file was read without errors.
+*/
+QString QKnxCaptureReader::errorString() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_errorString;
+}
+
+/*!
+    Advances to the next record carrying a KNXnet/IP or cEMI frame. Returns
+    \c true if such a record was found; otherwise returns \c false, either at
+    the end of the file or if the file is corrupt.
+
+    \sa atEnd(), errorString()
+*/
+bool QKnxCaptureReader::readNext()
+{
+    Q_D(QKnxCaptureReader);
+    d->m_type = RecordType::Unknown;
+    d->m_record = nullptr;
+    d->m_recordSize = 0;
+
+    while (d->m_data && d->m_offset < d->m_size) {
+        if (d->m_format == Format::Pcap) {
+            if (d->readPcapRecord())
+                return true;
+        } else {
+            bool isRecord = false;
+            if (!d->readPcapngBlock(&isRecord))
+                return false;
+            if (isRecord)
+                return true;
+        }
+    }
+
+    d->m_type = RecordType::Unknown;
+    return false;
+}
+
+/*!
+    Returns \c true if all records of the file have been read or no file is
+    open; otherwise returns \c false.
+*/
+bool QKnxCaptureReader::atEnd() const
+{
+    Q_D(const QKnxCaptureReader);
+    return !d->m_data || d->m_offset >= d->m_size;
+}
+
+/*!
+    Returns the type of the current record.
+*/
+QKnxCaptureReader::RecordType QKnxCaptureReader::recordType() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_type;
+}
+
+/*!
+    Returns the time stamp of the current record in nanoseconds since epoch,
+    or \c 0 if the record carries no time stamp.
+*/
+qint64 QKnxCaptureReader::timestamp() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_timestamp;
+}
+
+/*!
+    Returns the direction of the current record, if it was recorded.
+*/
+QKnxCaptureWriter::Direction QKnxCaptureReader::direction() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_direction;
+}
+
+/*!
+    Returns a pointer to the bytes of the KNXnet/IP or cEMI frame in the
+    current record. The pointer stays valid until the next call to readNext()
+    or close().
+
+    \sa size()
+*/
+const quint8 *QKnxCaptureReader::constData() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_record;
+}
+
+/*!
+    Returns the size in bytes of the KNXnet/IP or cEMI frame in the current
+    record.
+
+    \sa constData()
+*/
+int QKnxCaptureReader::size() const
+{
+    Q_D(const QKnxCaptureReader);
+    return d->m_recordSize;
+}
+
+/*!
+    Decodes the current record as a KNXnet/IP frame. Returns an invalid frame
+    if the current record does not hold a KNXnet/IP frame.
+*/
+QKnxNetIpFrame QKnxCaptureReader::netIpFrame() const
+{
+    Q_D(const QKnxCaptureReader);
+    if (d->m_type != RecordType::NetIp)
+        return {};
+    return QKnxNetIpFrame::fromBytes(QKnxByteArray(d->m_record, d->m_recordSize));
+}
+
+/*!
+    Decodes the current record as a cEMI link layer frame. Returns an invalid
+    frame if the current record does not hold a cEMI frame.
+*/
+QKnxLinkLayerFrame QKnxCaptureReader::linkLayerFrame() const
+{
+    Q_D(const QKnxCaptureReader);
+    if (d->m_type != RecordType::Cemi)
+        return {};
+    return QKnxLinkLayerFrame::builder()
+        .setMedium(QKnx::MediumType::NetIP)
+        .setData(QKnxByteArray(d->m_record, d->m_recordSize))
+        .createFrame();
+}
+
+QT_END_NAMESPACE
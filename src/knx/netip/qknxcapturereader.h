@@ -0,0 +1,96 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCAPTUREREADER_H
+#define QKNXCAPTUREREADER_H
+
+#include <QtCore/qscopedpointer.h>
+
+#include <QtKnx/qknxcapturewriter.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxCaptureReaderPrivate;
+class Q_KNX_EXPORT QKnxCaptureReader final
+{
+    Q_GADGET
+
+public:
+    enum class Format : quint8
+    {
+        Unknown,
+        Pcap,
+        Pcapng
+    };
+    Q_ENUM(Format)
+
+    enum class RecordType : quint8
+    {
+        Unknown,
+        NetIp,
+        Cemi
+    };
+    Q_ENUM(RecordType)
+
+    QKnxCaptureReader();
+    explicit QKnxCaptureReader(const QString &fileName);
+    ~QKnxCaptureReader();
+
+    bool open(const QString &fileName);
+    bool isOpen() const;
+    void close();
+
+    Format format() const;
+    QString errorString() const;
+
+    bool readNext();
+    bool atEnd() const;
+
+    RecordType recordType() const;
+    qint64 timestamp() const;
+    QKnxCaptureWriter::Direction direction() const;
+
+    const quint8 *constData() const;
+    int size() const;
+
+    QKnxNetIpFrame netIpFrame() const;
+    QKnxLinkLayerFrame linkLayerFrame() const;
+
+private:
+    Q_DISABLE_COPY(QKnxCaptureReader)
+    Q_DECLARE_PRIVATE(QKnxCaptureReader)
+    QScopedPointer<QKnxCaptureReaderPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,533 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcapturereader.h"
+#include "qknxcapturereplay.h"
+#include "qknxdevicemanagementframe.h"
+#include "qknxnetipendpointconnection.h"
+#include "qknxnetipendpointconnection_p.h"
+#include "qknxnetiprouter.h"
+#include "qknxnetiprouter_p.h"
+#include "qknxnetiproutingindication.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxCaptureReplay
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxCaptureReplay class feeds recorded KNX traffic into a
+    router or an endpoint connection.
+
+    The replay reads a capture file written by QKnxCaptureWriter, or any other
+    pcap or pcapng file holding KNXnet/IP traffic, and injects its frames into
+    the receive path of a target as if they had arrived from the network. This
+    allows to reproduce traffic storms locally and to measure the maximum rate
+    the library can sustain, without KNX hardware.
+
+    Frames recorded with the outbound direction were sent by the recording
+    side and are skipped. KNXnet/IP frames are passed through the same
+    validation and dispatching as received datagrams. A QKnxNetIpRouter
+    target receives cEMI records wrapped into routing indications, an endpoint
+    connection processes them like the cEMI frame of a tunneling or device
+    configuration request. The target must be routing or connected; frames
+    replayed to a target that is not are counted as dropped. So are frames
+    the target ignores, for example because of a wrong channel ID or
+    sequence number.
+
+    With the \l {QKnxCaptureReplay::Pacing}{Timed} pacing, frames are
+    delivered at the relative times they were recorded, scaled by speed(). A
+    speed of \c 1.0 replays in real time, a speed of \c 10.0 ten times
+    faster. With the \l {QKnxCaptureReplay::Pacing}{AsFastAsPossible} pacing,
+    frames are delivered in batches of BatchSize frames per event loop pass.
+
+    \code
+        QKnxCaptureReplay replay;
+        replay.open("storm.pcapng");
+        replay.setTarget(&router);
+        replay.setSpeed(4.0);
+        QObject::connect(&replay, &QKnxCaptureReplay::finished, [&] {
+            qDebug() << replay.throughput() << "frames/s," << replay.droppedCount()
+                     << "dropped";
+        });
+        replay.start();
+    \endcode
+
+    \sa QKnxCaptureReader, QKnxCaptureWriter
+*/
+
+/*!
+    \enum QKnxCaptureReplay::Pacing
+
+    This enum describes how recorded frames are paced.
+
+    \value Timed
+        Frames are delivered at their recorded time stamps, scaled by speed().
+    \value AsFastAsPossible
+        Frames are delivered without delay, BatchSize frames per event loop
+        pass.
+*/
+
+/*!
+    \variable QKnxCaptureReplay::BatchSize
+
+    The number of frames delivered per event loop pass with the
+    \l {QKnxCaptureReplay::Pacing}{AsFastAsPossible} pacing. It matches the
+    number of datagrams after which a router signals that it is busy.
+*/
+
+/*!
+    \fn void QKnxCaptureReplay::started()
+
+    This signal is emitted when the replay starts.
+*/
+
+/*!
+    \fn void QKnxCaptureReplay::finished()
+
+    This signal is emitted when all frames were replayed or the replay was
+    stopped.
+*/
+
+class QKnxCaptureReplayPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxCaptureReplay)
+
+public:
+    bool advance();
+    qint64 dueTime() const;
+    bool deliver(QKnxNetIpRouterPrivate *router);
+    bool deliver(QKnxNetIpEndpointConnectionPrivate *connection);
+    void replay();
+    void finish();
+
+    QKnxCaptureReader m_reader;
+    QString m_fileName;
+    QPointer<QObject> m_target;
+
+    QKnxCaptureReplay::Pacing m_pacing { QKnxCaptureReplay::Pacing::Timed };
+    qreal m_speed { 1.0 };
+
+    QTimer *m_timer { nullptr };
+    QElapsedTimer m_clock;
+    bool m_running { false };
+    bool m_hasRecord { false };
+    qint64 m_firstTimestamp { 0 };
+
+    quint64 m_replayed { 0 };
+    quint64 m_dropped { 0 };
+    qint64 m_elapsed { 0 };
+    qint64 m_maximumLateness { 0 };
+};
+
+bool QKnxCaptureReplayPrivate::advance()
+{
+    do {
+        m_hasRecord = m_reader.readNext();
+    } while (m_hasRecord && m_reader.direction() == QKnxCaptureWriter::Direction::Outbound);
+    return m_hasRecord;
+}
+
+qint64 QKnxCaptureReplayPrivate::dueTime() const
+{
+    const qint64 offset = m_reader.timestamp() - m_firstTimestamp;
+    return offset > 0 ? qint64(offset / m_speed) : 0;
+}
+
+bool QKnxCaptureReplayPrivate::deliver(QKnxNetIpRouterPrivate *router)
+{
+    if (m_reader.recordType() == QKnxCaptureReader::RecordType::NetIp) {
+        return router->processDatagram(m_reader.constData(), m_reader.size(),
+            QHostAddress(QHostAddress::AnyIPv4));
+    }
+
+    const auto cemi = m_reader.linkLayerFrame();
+    if (!cemi.isValid())
+        return false;
+
+    const auto bytes = QKnxNetIpRoutingIndicationProxy::builder().setCemi(cemi).create().bytes();
+    return router->processDatagram(bytes.constData(), bytes.size(),
+        QHostAddress(QHostAddress::AnyIPv4));
+}
+
+bool QKnxCaptureReplayPrivate::deliver(QKnxNetIpEndpointConnectionPrivate *connection)
+{
+    if (m_reader.recordType() == QKnxCaptureReader::RecordType::NetIp) {
+        // a dispatched frame still counts as dropped if its handler ignored it
+        const quint64 discarded = connection->discardedFrames();
+        return connection->processDatagram(m_reader.constData(), m_reader.size(),
+            QHostAddress(QHostAddress::AnyIPv4), 0)
+            && connection->discardedFrames() == discarded;
+    }
+
+    // cEMI device management message codes start at 0xf0
+    if (m_reader.size() > 0 && m_reader.constData()[0] >= 0xf0) {
+        const QKnxByteArray bytes(m_reader.constData(), m_reader.size());
+        const auto frame = QKnxDeviceManagementFrame::fromBytes(bytes, 0, quint16(bytes.size()));
+        if (!frame.isValid())
+            return false;
+        connection->process(frame);
+        return true;
+    }
+
+    const auto frame = m_reader.linkLayerFrame();
+    if (!frame.isValid())
+        return false;
+    connection->process(frame);
+    return true;
+}
+
+void QKnxCaptureReplayPrivate::replay()
+{
+    const bool timed = (m_pacing == QKnxCaptureReplay::Pacing::Timed);
+    const qint64 now = m_clock.nsecsElapsed();
+
+    auto router = qobject_cast<QKnxNetIpRouter *>(m_target.data());
+    if (router && router->state() != QKnxNetIpRouter::State::Routing
+        && router->state() != QKnxNetIpRouter::State::NeighborBusy) {
+        router = nullptr;
+    }
+    auto routerPrivate = router ? static_cast<QKnxNetIpRouterPrivate *>
+        (QObjectPrivate::get(router)) : nullptr;
+
+    auto connection = qobject_cast<QKnxNetIpEndpointConnection *>(m_target.data());
+    if (connection && connection->state() != QKnxNetIpEndpointConnection::State::Connected)
+        connection = nullptr;
+    auto connectionPrivate = connection ? static_cast<QKnxNetIpEndpointConnectionPrivate *>
+        (QObjectPrivate::get(connection)) : nullptr;
+
+    // a batch behaves like a single read notification of the target's socket
+    if (routerPrivate)
+        routerPrivate->beginReadBatch();
+
+    int delivered = 0;
+    while (m_hasRecord) {
+        if (timed) {
+            const qint64 due = dueTime();
+            if (due > now)
+                break;
+            m_maximumLateness = qMax(m_maximumLateness, now - due);
+        } else if (delivered == QKnxCaptureReplay::BatchSize) {
+            break;
+        }
+
+        bool accepted = false;
+        if (routerPrivate)
+            accepted = deliver(routerPrivate);
+        else if (connectionPrivate)
+            accepted = deliver(connectionPrivate);
+        if (accepted)
+            ++m_replayed;
+        else
+            ++m_dropped;
+        ++delivered;
+
+        // the target might have been destroyed or the replay stopped while
+        // the target processed the frame, the batch is closed either way
+        if (!m_target) {
+            routerPrivate = nullptr;
+            connectionPrivate = nullptr;
+        }
+        if (!m_running)
+            break;
+        advance();
+    }
+
+    if (routerPrivate)
+        routerPrivate->endReadBatch();
+
+    if (!m_running)
+        return;
+
+    if (!m_hasRecord) {
+        finish();
+        return;
+    }
+
+    if (timed) {
+        // wake up slightly early rather than late, the remainder of the last
+        // millisecond is spent in zero timeouts to hit the recorded time
+        const qint64 remaining = dueTime() - m_clock.nsecsElapsed();
+        m_timer->start(int(qBound<qint64>(0, remaining / 1000000, std::numeric_limits<int>::max())));
+    } else {
+        m_timer->start(0);
+    }
+}
+
+void QKnxCaptureReplayPrivate::finish()
+{
+    m_timer->stop();
+    m_elapsed = m_clock.nsecsElapsed();
+    m_running = false;
+
+    Q_Q(QKnxCaptureReplay);
+    emit q->finished();
+}
+
+/*!
+    Creates a capture replay with the parent \a parent.
+*/
+QKnxCaptureReplay::QKnxCaptureReplay(QObject *parent)
+    : QObject(*new QKnxCaptureReplayPrivate, parent)
+{
+    Q_D(QKnxCaptureReplay);
+    d->m_timer = new QTimer(this);
+    d->m_timer->setSingleShot(true);
+    d->m_timer->setTimerType(Qt::PreciseTimer);
+    connect(d->m_timer, &QTimer::timeout, this, [d]() { d->replay(); });
+}
+
+/*!
+    Stops the replay and destroys the object.
+*/
+QKnxCaptureReplay::~QKnxCaptureReplay()
+{
+    Q_D(QKnxCaptureReplay);
+    d->m_timer->stop();
+}
+
+/*!
+    Opens the capture file \a fileName for replay. Stops a running replay.
+
+    Returns \c true on success; otherwise returns \c false and errorString()
+    describes the error.
+*/
+bool QKnxCaptureReplay::open(const QString &fileName)
+{
+    stop();
+
+    Q_D(QKnxCaptureReplay);
+    d->m_fileName = fileName;
+    return d->m_reader.open(fileName);
+}
+
+/*!
+    Stops the replay and closes the capture file.
+*/
+void QKnxCaptureReplay::close()
+{
+    stop();
+
+    Q_D(QKnxCaptureReplay);
+    d->m_reader.close();
+    d->m_fileName.clear();
+}
+
+/*!
+    Returns a human-readable description of the last error that occurred
+    while reading the capture file.
+*/
+QString QKnxCaptureReplay::errorString() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_reader.errorString();
+}
+
+/*!
+    Returns the router or endpoint connection frames are replayed to, or
+    \c nullptr if no target was set.
+*/
+QObject *QKnxCaptureReplay::target() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_target.data();
+}
+
+/*!
+    Replays frames to the KNXnet/IP router \a router.
+*/
+void QKnxCaptureReplay::setTarget(QKnxNetIpRouter *router)
+{
+    Q_D(QKnxCaptureReplay);
+    d->m_target = router;
+}
+
+/*!
+    Replays frames to the KNXnet/IP tunnel or device management connection
+    \a connection.
+*/
+void QKnxCaptureReplay::setTarget(QKnxNetIpEndpointConnection *connection)
+{
+    Q_D(QKnxCaptureReplay);
+    d->m_target = connection;
+}
+
+/*!
+    Returns the pacing of the replay. The default is
+    \l {QKnxCaptureReplay::Pacing}{Timed}.
+*/
+QKnxCaptureReplay::Pacing QKnxCaptureReplay::pacing() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_pacing;
+}
+
+/*!
+    Sets the pacing of the replay to \a pacing.
+*/
+void QKnxCaptureReplay::setPacing(Pacing pacing)
+{
+    Q_D(QKnxCaptureReplay);
+    d->m_pacing = pacing;
+}
+
+/*!
+    Returns the speed factor of a timed replay. The default is \c 1.0, which
+    replays in real time.
+*/
+qreal QKnxCaptureReplay::speed() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_speed;
+}
+
+/*!
+    Sets the speed factor of a timed replay to \a speed. Values that are not
+    positive are ignored.
+*/
+void QKnxCaptureReplay::setSpeed(qreal speed)
+{
+    if (speed <= 0.)
+        return;
+
+    Q_D(QKnxCaptureReplay);
+    d->m_speed = speed;
+}
+
+/*!
+    Returns \c true while frames are replayed; otherwise returns \c false.
+*/
+bool QKnxCaptureReplay::isRunning() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_running;
+}
+
+/*!
+    Returns the number of frames the target accepted during the last replay.
+*/
+quint64 QKnxCaptureReplay::replayedCount() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_replayed;
+}
+
+/*!
+    Returns the number of frames dropped during the last replay, either by
+    the target or because the target was not ready to receive them.
+*/
+quint64 QKnxCaptureReplay::droppedCount() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_dropped;
+}
+
+/*!
+    Returns the wall clock duration of the last replay in nanoseconds. While
+    the replay is running, the time elapsed since start() is returned.
+*/
+qint64 QKnxCaptureReplay::elapsedTime() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_running ? d->m_clock.nsecsElapsed() : d->m_elapsed;
+}
+
+/*!
+    Returns the largest delay in nanoseconds by which a frame was delivered
+    after its scheduled time in a timed replay.
+*/
+qint64 QKnxCaptureReplay::maximumLateness() const
+{
+    Q_D(const QKnxCaptureReplay);
+    return d->m_maximumLateness;
+}
+
+/*!
+    Returns the number of frames delivered per second, accepted and dropped
+    ones, during the last replay.
+*/
+qreal QKnxCaptureReplay::throughput() const
+{
+    const qint64 elapsed = elapsedTime();
+    if (elapsed <= 0)
+        return 0.;
+
+    Q_D(const QKnxCaptureReplay);
+    return (d->m_replayed + d->m_dropped) * 1e9 / elapsed;
+}
+
+/*!
+    Starts replaying the capture file from its first frame. Resets the
+    statistics of the previous replay.
+*/
+void QKnxCaptureReplay::start()
+{
+    Q_D(QKnxCaptureReplay);
+    if (d->m_running || d->m_fileName.isEmpty())
+        return;
+
+    // rewind by reopening, the reader only walks forward
+    if (!d->m_reader.open(d->m_fileName))
+        return;
+
+    d->m_replayed = 0;
+    d->m_dropped = 0;
+    d->m_elapsed = 0;
+    d->m_maximumLateness = 0;
+
+    d->m_running = true;
+    d->advance();
+    d->m_firstTimestamp = d->m_hasRecord ? d->m_reader.timestamp() : 0;
+    d->m_clock.start();
+
+    emit started();
+    d->m_timer->start(0);
+}
+
+/*!
+    Stops the replay. Emits finished() if the replay was running.
+*/
+void QKnxCaptureReplay::stop()
+{
+    Q_D(QKnxCaptureReplay);
+    if (d->m_running)
+        d->finish();
+}
+
+QT_END_NAMESPACE
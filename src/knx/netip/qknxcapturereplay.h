@@ -0,0 +1,95 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCAPTUREREPLAY_H
+#define QKNXCAPTUREREPLAY_H
+
+#include <QtCore/qobject.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpEndpointConnection;
+class QKnxNetIpRouter;
+
+class QKnxCaptureReplayPrivate;
+class Q_KNX_EXPORT QKnxCaptureReplay final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxCaptureReplay)
+    Q_DECLARE_PRIVATE(QKnxCaptureReplay)
+
+public:
+    enum class Pacing : quint8
+    {
+        Timed,
+        AsFastAsPossible
+    };
+    Q_ENUM(Pacing)
+
+    enum : int { BatchSize = 10 };
+
+    explicit QKnxCaptureReplay(QObject *parent = nullptr);
+    ~QKnxCaptureReplay() override;
+
+    bool open(const QString &fileName);
+    void close();
+    QString errorString() const;
+
+    QObject *target() const;
+    void setTarget(QKnxNetIpRouter *router);
+    void setTarget(QKnxNetIpEndpointConnection *connection);
+
+    Pacing pacing() const;
+    void setPacing(Pacing pacing);
+
+    qreal speed() const;
+    void setSpeed(qreal speed);
+
+    bool isRunning() const;
+
+    quint64 replayedCount() const;
+    quint64 droppedCount() const;
+    qint64 elapsedTime() const;
+    qint64 maximumLateness() const;
+    qreal throughput() const;
+
+public Q_SLOTS:
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void started();
+    void finished();
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,590 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcapturewriter.h"
+#include "qknxcapturewriter_p.h"
+#include "qknxnetipdevicemanagement.h"
+#include "qknxnetiprouter.h"
+#include "qknxnetiptunnel.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxCaptureWriter
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxCaptureWriter class records KNXnet/IP and cEMI traffic to a
+    pcapng file that can be opened with Wireshark or QKnxCaptureReader.
+
+    The writer creates two interfaces in the capture file. KNXnet/IP frames
+    are stored as IPv4 UDP datagrams, so that they are decoded by Wireshark
+    without any further configuration. cEMI frames are stored with the link
+    type \c LINKTYPE_USER0; to decode them, add an entry for \c User \c 0
+    (DLT=147) with the payload protocol \c cemi to Wireshark's DLT_USER
+    preferences. Each frame carries a nanosecond time stamp and, if known,
+    its direction.
+
+    Frames are serialized straight into an in-memory buffer. Once the buffer
+    holds bufferSize() bytes it is handed to a task on the global thread pool
+    that writes it to disk, so recording never blocks on file I/O. This keeps
+    the cost per frame low enough to leave a capture running permanently.
+
+    The writer can tap connections with attach():
+
+    \list
+        \li A QKnxNetIpTunnel contributes every received link layer frame.
+        \li A QKnxNetIpDeviceManagement connection contributes every received
+            device management frame.
+        \li A QKnxNetIpRouter contributes every sent and received routing
+            message as a multicast datagram.
+    \endlist
+
+    \code
+        QKnxCaptureWriter capture;
+        capture.open("knx.pcapng");
+        capture.attach(&tunnel);
+    \endcode
+
+    \sa QKnxCaptureReader
+*/
+
+/*!
+    \enum QKnxCaptureWriter::Direction
+
+    This enum describes the direction of a recorded frame.
+
+    \value Unknown
+        The direction is unknown.
+    \value Inbound
+        The frame was received.
+    \value Outbound
+        The frame was sent.
+*/
+
+/*!
+    \enum QKnxCaptureWriter::anonymous
+
+    \value DefaultBufferSize
+        The default number of bytes collected before they are written to disk.
+*/
+
+namespace QKnxPrivate
+{
+    static int pad(int size)
+    {
+        return (size + 3) & ~3;
+    }
+
+    static quint8 *put16(quint8 *dst, quint16 value)
+    {
+        qToLittleEndian(value, dst);
+        return dst + 2;
+    }
+
+    static quint8 *put32(quint8 *dst, quint32 value)
+    {
+        qToLittleEndian(value, dst);
+        return dst + 4;
+    }
+
+    static quint32 ipv4Address(const QHostAddress &address)
+    {
+        bool ok = false;
+        const auto ipv4 = address.toIPv4Address(&ok);
+        return ok ? ipv4 : 0;
+    }
+
+    static void writeIpv4UdpHeader(quint8 *dst, const QHostAddress &source, quint16 sourcePort,
+        const QHostAddress &destination, quint16 destinationPort, int payloadSize)
+    {
+        using namespace QKnxPcapng;
+
+        const int udpSize = UdpHeaderSize + payloadSize;
+        std::memset(dst, 0, Ipv4HeaderSize + UdpHeaderSize);
+        dst[0] = 0x45; // version 4, 5 * 4 bytes header length
+        qToBigEndian(quint16(Ipv4HeaderSize + udpSize), dst + 2);
+        dst[6] = 0x40; // don't fragment
+        dst[8] = 64; // time to live
+        dst[9] = 17; // UDP
+        qToBigEndian(ipv4Address(source), dst + 12);
+        qToBigEndian(ipv4Address(destination), dst + 16);
+
+        quint32 sum = 0;
+        for (int i = 0; i < Ipv4HeaderSize; i += 2)
+            sum += quint32(dst[i] << 8 | dst[i + 1]);
+        while (sum >> 16)
+            sum = (sum & 0xffff) + (sum >> 16);
+        qToBigEndian(quint16(~sum), dst + 10);
+
+        // the UDP checksum is optional for IPv4 and left zero
+        auto udp = dst + Ipv4HeaderSize;
+        qToBigEndian(sourcePort, udp);
+        qToBigEndian(destinationPort, udp + 2);
+        qToBigEndian(quint16(udpSize), udp + 4);
+    }
+
+    static quint8 *writeInterfaceDescription(quint8 *dst, quint16 linkType, const char *name)
+    {
+        using namespace QKnxPcapng;
+
+        const int nameSize = int(std::strlen(name));
+        const int size = 20 + (4 + pad(nameSize)) + 8 + 4;
+
+        auto it = put32(dst, InterfaceDescriptionBlock);
+        it = put32(it, quint32(size));
+        it = put16(it, linkType);
+        it = put16(it, 0);
+        it = put32(it, 0); // no snapshot length limit
+
+        it = put16(it, InterfaceName);
+        it = put16(it, quint16(nameSize));
+        std::memset(it, 0, size_t(pad(nameSize)));
+        std::memcpy(it, name, size_t(nameSize));
+        it += pad(nameSize);
+
+        it = put16(it, InterfaceTimestampResolution);
+        it = put16(it, 1);
+        it = put32(it, 9); // 10^-9, the padding bytes are zero
+
+        it = put32(it, EndOfOptions);
+        return put32(it, quint32(size));
+    }
+}
+
+class QKnxCaptureWriterTask final : public QRunnable
+{
+public:
+    explicit QKnxCaptureWriterTask(QKnxCaptureWriterPrivate *d)
+        : m_d(d)
+    {}
+
+    void run() override
+    {
+        m_d->drain();
+    }
+
+private:
+    QKnxCaptureWriterPrivate *m_d { nullptr };
+};
+
+quint8 *QKnxCaptureWriterPrivate::beginPacket(quint32 interfaceId, int size,
+    QKnxCaptureWriter::Direction direction)
+{
+    using namespace QKnxPcapng;
+    using namespace QKnxPrivate;
+
+    // enhanced packet block with a packet flags option
+    const int blockSize = 28 + pad(size) + 8 + 4 + 4;
+
+    m_packetStart = m_buffer.size();
+    m_buffer.resize(m_packetStart + blockSize);
+    auto block = reinterpret_cast<quint8 *>(m_buffer.data()) + m_packetStart;
+
+    const quint64 ts = quint64(timestamp());
+    auto it = put32(block, EnhancedPacketBlock);
+    it = put32(it, quint32(blockSize));
+    it = put32(it, interfaceId);
+    it = put32(it, quint32(ts >> 32));
+    it = put32(it, quint32(ts));
+    it = put32(it, quint32(size));
+    it = put32(it, quint32(size));
+
+    auto packet = it;
+    it += size;
+    for (int i = size; i < pad(size); ++i)
+        *it++ = 0;
+
+    quint32 flags = 0;
+    if (direction == QKnxCaptureWriter::Direction::Inbound)
+        flags = Inbound;
+    else if (direction == QKnxCaptureWriter::Direction::Outbound)
+        flags = Outbound;
+    it = put16(it, PacketFlags);
+    it = put16(it, 4);
+    it = put32(it, flags);
+    it = put32(it, EndOfOptions);
+    put32(it, quint32(blockSize));
+
+    return packet;
+}
+
+void QKnxCaptureWriterPrivate::endPacket(bool written)
+{
+    if (!written) {
+        m_buffer.resize(m_packetStart);
+        return;
+    }
+
+    ++m_frameCount;
+    if (m_buffer.size() >= m_bufferSize)
+        submit();
+}
+
+void QKnxCaptureWriterPrivate::writeHeader()
+{
+    using namespace QKnxPcapng;
+    using namespace QKnxPrivate;
+
+    m_buffer.resize(28 + 2 * 64);
+    auto it = reinterpret_cast<quint8 *>(m_buffer.data());
+
+    // section header block without options, the section length is unknown
+    it = put32(it, SectionHeaderBlock);
+    it = put32(it, 28);
+    it = put32(it, ByteOrderMagic);
+    it = put16(it, 1);
+    it = put16(it, 0);
+    it = put32(it, 0xffffffff);
+    it = put32(it, 0xffffffff);
+    it = put32(it, 28);
+
+    // the order must match NetIpInterface and CemiInterface
+    it = writeInterfaceDescription(it, LinkTypeIpv4, "KNXnet/IP");
+    it = writeInterfaceDescription(it, LinkTypeUser0, "cEMI");
+
+    m_buffer.resize(int(it - reinterpret_cast<quint8 *>(m_buffer.data())));
+}
+
+void QKnxCaptureWriterPrivate::submit()
+{
+    if (m_buffer.isEmpty())
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending.append(m_buffer);
+        if (!m_draining) {
+            m_draining = true;
+            QThreadPool::globalInstance()->start(new QKnxCaptureWriterTask(this));
+        }
+    }
+
+    m_buffer = QByteArray();
+    m_buffer.reserve(m_bufferSize + 1024);
+}
+
+void QKnxCaptureWriterPrivate::drain()
+{
+    forever {
+        QByteArray chunk;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_pending.isEmpty()) {
+                m_draining = false;
+                m_drained.wakeAll();
+                return;
+            }
+            chunk = m_pending.takeFirst();
+        }
+
+        if (m_file.write(chunk) != chunk.size()) {
+            QMutexLocker locker(&m_mutex);
+            m_errorString = m_file.errorString();
+        }
+    }
+}
+
+void QKnxCaptureWriterPrivate::waitForDrained()
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_draining)
+        m_drained.wait(&m_mutex);
+}
+
+/*!
+    Creates a capture writer with the parent \a parent.
+*/
+QKnxCaptureWriter::QKnxCaptureWriter(QObject *parent)
+    : QObject(*new QKnxCaptureWriterPrivate, parent)
+{}
+
+/*!
+    Writes all buffered frames to disk, closes the capture file, and destroys
+    the writer.
+*/
+QKnxCaptureWriter::~QKnxCaptureWriter()
+{
+    close();
+}
+
+/*!
+    Creates or truncates the capture file \a fileName and writes the pcapng
+    section and interface headers. An already open file is closed first.
+
+    Returns \c true on success; otherwise returns \c false and errorString()
+    describes the error.
+*/
+bool QKnxCaptureWriter::open(const QString &fileName)
+{
+    close();
+
+    Q_D(QKnxCaptureWriter);
+    d->m_file.setFileName(fileName);
+    if (!d->m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QMutexLocker locker(&d->m_mutex);
+        d->m_errorString = d->m_file.errorString();
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->m_errorString.clear();
+    }
+    d->m_frameCount = 0;
+    d->m_buffer.reserve(d->m_bufferSize + 1024);
+    d->m_epoch = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    d->m_clock.start();
+    d->writeHeader();
+    return true;
+}
+
+/*!
+    Returns \c true if a capture file is open; otherwise returns \c false.
+*/
+bool QKnxCaptureWriter::isOpen() const
+{
+    Q_D(const QKnxCaptureWriter);
+    return d->m_file.isOpen();
+}
+
+/*!
+    Writes all buffered frames to disk and waits until they have been written.
+*/
+void QKnxCaptureWriter::flush()
+{
+    Q_D(QKnxCaptureWriter);
+    if (!d->m_file.isOpen())
+        return;
+
+    d->submit();
+    d->waitForDrained();
+    d->m_file.flush();
+}
+
+/*!
+    Writes all buffered frames to disk and closes the capture file.
+*/
+void QKnxCaptureWriter::close()
+{
+    Q_D(QKnxCaptureWriter);
+    if (!d->m_file.isOpen())
+        return;
+
+    d->submit();
+    d->waitForDrained();
+    d->m_file.close();
+    d->m_buffer.clear();
+}
+
+/*!
+    Returns a human-readable description of the last file error.
+*/
+QString QKnxCaptureWriter::errorString() const
+{
+    Q_D(const QKnxCaptureWriter);
+    QMutexLocker locker(&d->m_mutex);
+    return d->m_errorString;
+}
+
+/*!
+    Returns the number of bytes collected in memory before they are written to
+    disk. The default is DefaultBufferSize.
+*/
+int QKnxCaptureWriter::bufferSize() const
+{
+    Q_D(const QKnxCaptureWriter);
+    return d->m_bufferSize;
+}
+
+/*!
+    Sets the number of bytes collected in memory before they are written to
+    disk to \a size.
+*/
+void QKnxCaptureWriter::setBufferSize(int size)
+{
+    Q_D(QKnxCaptureWriter);
+    d->m_bufferSize = qMax(size, 1024);
+}
+
+/*!
+    Returns the number of frames recorded since the capture file was opened.
+*/
+quint64 QKnxCaptureWriter::frameCount() const
+{
+    Q_D(const QKnxCaptureWriter);
+    return d->m_frameCount;
+}
+
+/*!
+    Records all link layer frames received by \a tunnel.
+*/
+void QKnxCaptureWriter::attach(QKnxNetIpTunnel *tunnel)
+{
+    if (!tunnel)
+        return;
+    QObject::connect(tunnel, &QKnxNetIpTunnel::frameReceived, this,
+        [this](QKnxLinkLayerFrame frame) { writeCemiFrame(frame, Direction::Inbound); });
+}
+
+/*!
+    Records all routing messages sent and received by \a router. The router's
+    interface affinity and multicast address are used as datagram addresses;
+    the source of received messages is not known and recorded as \c 0.0.0.0.
+*/
+void QKnxCaptureWriter::attach(QKnxNetIpRouter *router)
+{
+    if (!router)
+        return;
+
+    QHostAddress local;
+    const auto entries = router->interfaceAffinity().addressEntries();
+    for (const auto &entry : entries) {
+        if (entry.ip().protocol() == QAbstractSocket::IPv4Protocol) {
+            local = entry.ip();
+            break;
+        }
+    }
+
+    const auto group = router->multicastAddress();
+    const quint16 port = QKnxNetIp::Constants::DefaultPort;
+    const auto sent = [this, local, group, port](QKnxNetIpFrame frame) {
+        writeNetIpFrame(frame, local, port, group, port, Direction::Outbound);
+    };
+    const auto received = [this, group, port](QKnxNetIpFrame frame) {
+        writeNetIpFrame(frame, {}, port, group, port, Direction::Inbound);
+    };
+
+    QObject::connect(router, &QKnxNetIpRouter::routingIndicationSent, this, sent);
+    QObject::connect(router, &QKnxNetIpRouter::routingBusySent, this, sent);
+    QObject::connect(router, &QKnxNetIpRouter::routingLostCountSent, this, sent);
+    QObject::connect(router, &QKnxNetIpRouter::routingSystemBroadcastSent, this, sent);
+
+    QObject::connect(router, &QKnxNetIpRouter::routingIndicationReceived, this, received);
+    QObject::connect(router, &QKnxNetIpRouter::routingBusyReceived, this, received);
+    QObject::connect(router, &QKnxNetIpRouter::routingLostCountReceived, this, received);
+    QObject::connect(router, &QKnxNetIpRouter::routingSystemBroadcastReceived, this, received);
+}
+
+/*!
+    Records all device management frames received by \a management.
+*/
+void QKnxCaptureWriter::attach(QKnxNetIpDeviceManagement *management)
+{
+    if (!management)
+        return;
+    QObject::connect(management, &QKnxNetIpDeviceManagement::frameReceived, this,
+        [this](QKnxDeviceManagementFrame frame) { writeCemiFrame(frame, Direction::Inbound); });
+}
+
+/*!
+    Stops recording the traffic of the tunnel, router, or device management
+    connection \a source.
+*/
+void QKnxCaptureWriter::detach(QObject *source)
+{
+    if (source)
+        QObject::disconnect(source, nullptr, this, nullptr);
+}
+
+/*!
+    Records the KNXnet/IP \a frame as a UDP datagram sent from \a source and
+    \a sourcePort to \a destination and \a destinationPort, travelling in the
+    given \a direction. Addresses that are not IPv4 addresses are recorded as
+    \c 0.0.0.0.
+
+    Returns \c true if the frame was recorded; otherwise returns \c false.
+*/
+bool QKnxCaptureWriter::writeNetIpFrame(const QKnxNetIpFrame &frame, const QHostAddress &source,
+    quint16 sourcePort, const QHostAddress &destination, quint16 destinationPort,
+    Direction direction)
+{
+    Q_D(QKnxCaptureWriter);
+    const int size = frame.serializedSize();
+    if (!d->m_file.isOpen() || size == 0)
+        return false;
+
+    using namespace QKnxPcapng;
+    const int headerSize = Ipv4HeaderSize + UdpHeaderSize;
+    auto packet = d->beginPacket(NetIpInterface, headerSize + size, direction);
+    QKnxPrivate::writeIpv4UdpHeader(packet, source, sourcePort, destination, destinationPort,
+        size);
+    const bool written = frame.serializeInto(packet + headerSize, size_t(size)) == size;
+    d->endPacket(written);
+    return written;
+}
+
+/*!
+    Records the cEMI link layer \a frame travelling in the given \a direction.
+
+    Returns \c true if the frame was recorded; otherwise returns \c false.
+*/
+bool QKnxCaptureWriter::writeCemiFrame(const QKnxLinkLayerFrame &frame, Direction direction)
+{
+    Q_D(QKnxCaptureWriter);
+    const int size = frame.serializedSize();
+    if (!d->m_file.isOpen() || size == 0)
+        return false;
+
+    auto packet = d->beginPacket(QKnxPcapng::CemiInterface, size, direction);
+    const bool written = frame.serializeInto(packet, size_t(size)) == size;
+    d->endPacket(written);
+    return written;
+}
+
+/*!
+    \overload
+
+    Records the cEMI device management \a frame travelling in the given
+    \a direction.
+*/
+bool QKnxCaptureWriter::writeCemiFrame(const QKnxDeviceManagementFrame &frame,
+    Direction direction)
+{
+    Q_D(QKnxCaptureWriter);
+    const int size = frame.serializedSize();
+    if (!d->m_file.isOpen() || size == 0)
+        return false;
+
+    auto packet = d->beginPacket(QKnxPcapng::CemiInterface, size, direction);
+    const bool written = frame.serializeInto(packet, size_t(size)) == size;
+    d->endPacket(written);
+    return written;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,95 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCAPTUREWRITER_H
+#define QKNXCAPTUREWRITER_H
+
+#include <QtCore/qobject.h>
+
+#include <QtKnx/qknxdevicemanagementframe.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpDeviceManagement;
+class QKnxNetIpRouter;
+class QKnxNetIpTunnel;
+
+class QKnxCaptureWriterPrivate;
+class Q_KNX_EXPORT QKnxCaptureWriter final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxCaptureWriter)
+    Q_DECLARE_PRIVATE(QKnxCaptureWriter)
+
+public:
+    enum class Direction : quint8
+    {
+        Unknown,
+        Inbound,
+        Outbound
+    };
+    Q_ENUM(Direction)
+
+    enum : int { DefaultBufferSize = 0x10000 };
+
+    explicit QKnxCaptureWriter(QObject *parent = nullptr);
+    ~QKnxCaptureWriter() override;
+
+    bool open(const QString &fileName);
+    bool isOpen() const;
+    void flush();
+    void close();
+
+    QString errorString() const;
+
+    int bufferSize() const;
+    void setBufferSize(int size);
+
+    quint64 frameCount() const;
+
+    void attach(QKnxNetIpTunnel *tunnel);
+    void attach(QKnxNetIpRouter *router);
+    void attach(QKnxNetIpDeviceManagement *management);
+    void detach(QObject *source);
+
+    bool writeNetIpFrame(const QKnxNetIpFrame &frame, const QHostAddress &source,
+        quint16 sourcePort, const QHostAddress &destination, quint16 destinationPort,
+        Direction direction = Direction::Unknown);
+    bool writeCemiFrame(const QKnxLinkLayerFrame &frame, Direction direction);
+    bool writeCemiFrame(const QKnxDeviceManagementFrame &frame, Direction direction);
+};
+
+QT_END_NAMESPACE
+
+#endif
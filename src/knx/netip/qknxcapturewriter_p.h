@@ -0,0 +1,132 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCAPTUREWRITER_P_H
+#define QKNXCAPTUREWRITER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <QtKnx/qknxcapturewriter.h>
+
+QT_BEGIN_NAMESPACE
+
+// block and option codes of the PCAP Next Generation (pcapng) file format
+namespace QKnxPcapng
+{
+    enum : quint32
+    {
+        SectionHeaderBlock = 0x0a0d0d0a,
+        InterfaceDescriptionBlock = 0x00000001,
+        SimplePacketBlock = 0x00000003,
+        EnhancedPacketBlock = 0x00000006,
+        ByteOrderMagic = 0x1a2b3c4d
+    };
+
+    enum : quint16
+    {
+        EndOfOptions = 0,
+        InterfaceName = 2,
+        InterfaceTimestampResolution = 9,
+        PacketFlags = 2
+    };
+
+    enum : quint32 { Inbound = 0x01, Outbound = 0x02, DirectionMask = 0x03 };
+
+    enum : quint16
+    {
+        LinkTypeEthernet = 1,
+        LinkTypeRaw = 101,
+        LinkTypeUser0 = 147, // cEMI, decode with Wireshark's "cemi" dissector
+        LinkTypeIpv4 = 228
+    };
+
+    // the interfaces written by QKnxCaptureWriter
+    enum : quint32 { NetIpInterface = 0, CemiInterface = 1 };
+
+    enum : int { Ipv4HeaderSize = 20, UdpHeaderSize = 8 };
+
+    // classic pcap file header magics, microsecond and nanosecond resolution
+    enum : quint32 { PcapMagic = 0xa1b2c3d4, PcapNanosecondMagic = 0xa1b23c4d };
+}
+
+class QKnxCaptureWriterPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxCaptureWriter)
+
+public:
+    QKnxCaptureWriterPrivate() = default;
+    ~QKnxCaptureWriterPrivate() override = default;
+
+    qint64 timestamp() const { return m_epoch + m_clock.nsecsElapsed(); }
+
+    quint8 *beginPacket(quint32 interfaceId, int size, QKnxCaptureWriter::Direction direction);
+    void endPacket(bool written);
+
+    void writeHeader();
+    void submit();
+    void drain();
+    void waitForDrained();
+
+    QFile m_file;
+    QString m_errorString;
+    QByteArray m_buffer;
+    int m_packetStart { 0 };
+    int m_bufferSize { QKnxCaptureWriter::DefaultBufferSize };
+    quint64 m_frameCount { 0 };
+
+    QElapsedTimer m_clock;
+    qint64 m_epoch { 0 };
+
+    // written chunks are handed to a single pool task, which owns the file
+    // while it is draining
+    mutable QMutex m_mutex;
+    QWaitCondition m_drained;
+    QList<QByteArray> m_pending;
+    bool m_draining { false };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,447 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxgroupvaluecache.h"
+#include "qknxgroupvaluecache_p.h"
+#include "qknxnetiproutingindication.h"
+#include "qknxnetiprouter.h"
+#include "qknxnetiptunnel.h"
+
+#include <QtKnx/qknxdatapointtypefactory.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxGroupValueCache
+
+    \since 5.13
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+
+    \brief The QKnxGroupValueCache class keeps the latest value of every group
+    address seen on the bus.
+
+    The cache can be attached to any number of tunnels and routers. It records
+    the value carried by every group value write and group value response
+    telegram together with the time it was received. The cache can also be fed
+    directly with link layer frames using update().
+
+    \code
+        QKnxNetIpTunnel tunnel;
+        QKnxGroupValueCache cache;
+        cache.attach(&tunnel);
+
+        QObject::connect(&cache, &QKnxGroupValueCache::valuesChanged,
+            [&](const QVector<QKnxAddress> &addresses) {
+                for (const auto &address : addresses)
+                    qDebug() << address << cache.value(address);
+            });
+    \endcode
+
+    Values are stored in a flat table with one fixed size entry for each of
+    the 65536 group addresses. Values longer than \l MaximumValueSize bytes,
+    the maximum of a standard frame, are not cached.
+
+    The cache is written from the thread it lives in. The value(), timestamp(),
+    lookup(), and contains() functions do not lock and can be called from any
+    thread at the same time.
+
+    Instead of signaling every telegram, the cache collects the addresses of
+    changed values and emits valuesChanged() once per notificationInterval().
+
+    If group address information from an ETS project is set using
+    setGroupAddressInfos(), cached values can be decoded into datapoint types
+    with createDatapointType().
+*/
+
+/*!
+    \variable QKnxGroupValueCache::MaximumValueSize
+
+    The maximum number of bytes of a value that is kept in the cache.
+*/
+
+/*!
+    \fn void QKnxGroupValueCache::valuesChanged(const QVector<QKnxAddress> &addresses)
+
+    This signal is emitted with the group \a addresses whose values have
+    changed since the signal was last emitted. Each address is contained only
+    once.
+*/
+
+bool QKnxGroupValueCachePrivate::write(quint16 address, const QKnxByteArray &value,
+    qint64 timestamp)
+{
+    quint32 words[Slot::WordCount] = { 0 };
+    auto bytes = reinterpret_cast<quint8 *>(words);
+    bytes[0] = quint8(value.size());
+    memcpy(bytes + 1, value.constData(), size_t(value.size()));
+    words[Slot::TimestampWord] = quint32(quint64(timestamp));
+    words[Slot::TimestampWord + 1] = quint32(quint64(timestamp) >> 32);
+
+    auto &slot = m_slots[address];
+    const quint32 sequence = slot.sequence.load();
+
+    bool changed = (sequence == 0);
+    for (int i = 0; i < Slot::ValueWords; ++i)
+        changed |= (slot.words[i].load() != words[i]);
+
+    slot.sequence.store(sequence + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < Slot::WordCount; ++i)
+        slot.words[i].store(words[i]);
+
+    const quint32 next = sequence + 2;
+    slot.sequence.storeRelease(next == 0 ? 2 : next); // 0 is reserved for empty entries
+
+    return changed;
+}
+
+bool QKnxGroupValueCachePrivate::read(quint16 address, QKnxByteArray *value,
+    qint64 *timestamp) const
+{
+    const auto &slot = m_slots[address];
+
+    quint32 words[Slot::WordCount];
+    forever {
+        const quint32 before = slot.sequence.loadAcquire();
+        if (before == 0)
+            return false;
+        if (before & 1)
+            continue; // the writer is in the middle of an update
+
+        for (int i = 0; i < Slot::WordCount; ++i)
+            words[i] = slot.words[i].load();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load() == before)
+            break;
+    }
+
+    const auto bytes = reinterpret_cast<const quint8 *>(words);
+    if (value) {
+        const int size = qMin<int>(bytes[0], QKnxGroupValueCache::MaximumValueSize);
+        *value = QKnxByteArray(bytes + 1, size);
+    }
+    if (timestamp) {
+        *timestamp = qint64(quint64(words[Slot::TimestampWord])
+            | quint64(words[Slot::TimestampWord + 1]) << 32);
+    }
+    return true;
+}
+
+void QKnxGroupValueCachePrivate::markChanged(quint16 address)
+{
+    if (m_pending.testBit(address))
+        return;
+    m_pending.setBit(address);
+    m_changed.append(address);
+
+    if (!m_notifyTimer.isActive())
+        m_notifyTimer.start();
+}
+
+void QKnxGroupValueCachePrivate::notify()
+{
+    Q_Q(QKnxGroupValueCache);
+
+    QVector<QKnxAddress> addresses;
+    addresses.reserve(m_changed.size());
+    for (auto address : qAsConst(m_changed)) {
+        m_pending.clearBit(address);
+        addresses.append({ QKnxAddress::Type::Group, address });
+    }
+    m_changed.clear();
+
+    if (!addresses.isEmpty())
+        emit q->valuesChanged(addresses);
+}
+
+/*!
+    Creates an empty group value cache with the parent \a parent.
+*/
+QKnxGroupValueCache::QKnxGroupValueCache(QObject *parent)
+    : QObject(*new QKnxGroupValueCachePrivate, parent)
+{
+    Q_D(QKnxGroupValueCache);
+    d->m_notifyTimer.setSingleShot(true);
+    d->m_notifyTimer.setInterval(0);
+    QObject::connect(&d->m_notifyTimer, &QTimer::timeout, this, [d]() { d->notify(); });
+}
+
+/*!
+    Destroys the cache.
+*/
+QKnxGroupValueCache::~QKnxGroupValueCache() = default;
+
+/*!
+    Records the group values of all frames received by \a tunnel.
+*/
+void QKnxGroupValueCache::attach(QKnxNetIpTunnel *tunnel)
+{
+    if (!tunnel)
+        return;
+    QObject::connect(tunnel, &QKnxNetIpTunnel::frameReceived, this,
+        [this](QKnxLinkLayerFrame frame) { update(frame); });
+}
+
+/*!
+    Records the group values of all routing indications received by \a router.
+*/
+void QKnxGroupValueCache::attach(QKnxNetIpRouter *router)
+{
+    if (!router)
+        return;
+    QObject::connect(router, &QKnxNetIpRouter::routingIndicationReceived, this,
+        [this](QKnxNetIpFrame frame) {
+            update(QKnxNetIpRoutingIndicationProxy(frame).cemi());
+    });
+}
+
+/*!
+    Stops recording the values received by the tunnel or router \a source.
+*/
+void QKnxGroupValueCache::detach(QObject *source)
+{
+    if (source)
+        QObject::disconnect(source, nullptr, this, nullptr);
+}
+
+/*!
+    Records the group value carried by the link layer \a frame. Returns \c true
+    if the frame carried a group value; otherwise returns \c false.
+
+    Data indications and positive data confirmations for group value write and
+    group value response telegrams are taken into account, all other frames are
+    ignored.
+
+    \note This function must be called from the thread the cache lives in.
+*/
+bool QKnxGroupValueCache::update(const QKnxLinkLayerFrame &frame)
+{
+    switch (frame.messageCode()) {
+    case QKnxLinkLayerFrame::MessageCode::DataIndication:
+        break;
+    case QKnxLinkLayerFrame::MessageCode::DataConfirmation:
+        if (frame.controlField().confirm() == QKnxControlField::Confirm::Error)
+            return false;
+        break;
+    default:
+        return false;
+    }
+
+    const auto destination = frame.destinationAddress();
+    if (destination.type() != QKnxAddress::Type::Group)
+        return false;
+
+    const auto tpdu = frame.tpdu();
+    switch (tpdu.applicationControlField()) {
+    case QKnxTpdu::ApplicationControlField::GroupValueWrite:
+    case QKnxTpdu::ApplicationControlField::GroupValueResponse:
+        break;
+    default:
+        return false;
+    }
+
+    const auto data = tpdu.data();
+    if (data.isEmpty() || data.size() > MaximumValueSize)
+        return false;
+
+    Q_D(QKnxGroupValueCache);
+    const auto address = destination.toUInt16();
+    if (d->write(address, data, QDateTime::currentMSecsSinceEpoch()))
+        d->markChanged(address);
+    return true;
+}
+
+/*!
+    Returns \c true if a value is cached for the group \a address; otherwise
+    returns \c false.
+*/
+bool QKnxGroupValueCache::contains(const QKnxAddress &address) const
+{
+    if (address.type() != QKnxAddress::Type::Group)
+        return false;
+    Q_D(const QKnxGroupValueCache);
+    return d->m_slots[address.toUInt16()].sequence.loadAcquire() != 0;
+}
+
+/*!
+    Returns the latest value of the group \a address, or an empty byte array
+    if no value is cached for the address.
+*/
+QKnxByteArray QKnxGroupValueCache::value(const QKnxAddress &address) const
+{
+    QKnxByteArray value;
+    lookup(address, &value);
+    return value;
+}
+
+/*!
+    Returns the time the latest value of the group \a address was received,
+    or an invalid date time if no value is cached for the address.
+*/
+QDateTime QKnxGroupValueCache::timestamp(const QKnxAddress &address) const
+{
+    QDateTime timestamp;
+    lookup(address, nullptr, &timestamp);
+    return timestamp;
+}
+
+/*!
+    Reads the latest \a value of the group \a address and the \a timestamp at
+    which it was received in one consistent step. Returns \c false if no value
+    is cached for the address. Both \a value and \a timestamp may be \c nullptr.
+*/
+bool QKnxGroupValueCache::lookup(const QKnxAddress &address, QKnxByteArray *value,
+    QDateTime *timestamp) const
+{
+    if (address.type() != QKnxAddress::Type::Group)
+        return false;
+
+    Q_D(const QKnxGroupValueCache);
+    qint64 msecs = 0;
+    if (!d->read(address.toUInt16(), value, timestamp ? &msecs : nullptr))
+        return false;
+    if (timestamp)
+        *timestamp = QDateTime::fromMSecsSinceEpoch(msecs);
+    return true;
+}
+
+/*!
+    Returns all group addresses with a cached value.
+*/
+QVector<QKnxAddress> QKnxGroupValueCache::addresses() const
+{
+    Q_D(const QKnxGroupValueCache);
+
+    QVector<QKnxAddress> addresses;
+    for (int i = 0; i < QKnxGroupValueCachePrivate::AddressCount; ++i) {
+        if (d->m_slots[i].sequence.loadAcquire() != 0)
+            addresses.append({ QKnxAddress::Type::Group, quint16(i) });
+    }
+    return addresses;
+}
+
+/*!
+    Removes all values from the cache. Pending change notifications are
+    discarded.
+
+    \note This function must be called from the thread the cache lives in.
+*/
+void QKnxGroupValueCache::clear()
+{
+    Q_D(QKnxGroupValueCache);
+    for (int i = 0; i < QKnxGroupValueCachePrivate::AddressCount; ++i)
+        d->m_slots[i].sequence.storeRelease(0);
+
+    d->m_notifyTimer.stop();
+    d->m_pending.fill(false);
+    d->m_changed.clear();
+}
+
+/*!
+    Returns the interval in milliseconds in which changes are collected before
+    valuesChanged() is emitted. The default value is \c 0, changes are then
+    signaled once control returns to the event loop.
+*/
+int QKnxGroupValueCache::notificationInterval() const
+{
+    Q_D(const QKnxGroupValueCache);
+    return d->m_notifyTimer.interval();
+}
+
+/*!
+    Sets the interval in which changes are collected to \a msec milliseconds.
+*/
+void QKnxGroupValueCache::setNotificationInterval(int msec)
+{
+    Q_D(QKnxGroupValueCache);
+    d->m_notifyTimer.setInterval(qMax(0, msec));
+}
+
+/*!
+    Uses the datapoint types of the group addresses described by \a infos
+    for the project \a projectId and the optional \a installation to decode
+    cached values. Any previously set information is replaced.
+
+    \sa datapointType(), createDatapointType()
+*/
+void QKnxGroupValueCache::setGroupAddressInfos(const QKnxGroupAddressInfos &infos,
+    const QString &projectId, const QString &installation)
+{
+    Q_D(QKnxGroupValueCache);
+    d->m_types.fill(QKnxDatapointType::Type::Unknown, QKnxGroupValueCachePrivate::AddressCount);
+
+    const auto addressInfos = infos.addressInfos(projectId, installation);
+    for (const auto &info : addressInfos) {
+        const auto address = info.address();
+        if (address.type() == QKnxAddress::Type::Group)
+            d->m_types[address.toUInt16()] = info.datapointType();
+    }
+}
+
+/*!
+    Returns the datapoint type of the group \a address as known from the group
+    address information, or \l QKnxDatapointType::Type::Unknown.
+*/
+QKnxDatapointType::Type QKnxGroupValueCache::datapointType(const QKnxAddress &address) const
+{
+    Q_D(const QKnxGroupValueCache);
+    if (address.type() != QKnxAddress::Type::Group || d->m_types.isEmpty())
+        return QKnxDatapointType::Type::Unknown;
+    return d->m_types.at(address.toUInt16());
+}
+
+/*!
+    Returns a datapoint type object of the type known for the group \a address
+    holding the cached value of the address. Returns \c nullptr if the type is
+    unknown, no value is cached, or the value does not fit the type.
+
+    The caller takes ownership of the returned object.
+*/
+QKnxDatapointType *QKnxGroupValueCache::createDatapointType(const QKnxAddress &address) const
+{
+    const auto type = datapointType(address);
+    if (type == QKnxDatapointType::Type::Unknown)
+        return nullptr;
+
+    QKnxByteArray bytes;
+    if (!lookup(address, &bytes))
+        return nullptr;
+
+    auto dpt = QKnxDatapointTypeFactory::instance().createType(type);
+    if (dpt && !dpt->setBytes(bytes, 0, quint16(bytes.size()))) {
+        delete dpt;
+        return nullptr;
+    }
+    return dpt;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,91 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPVALUECACHE_H
+#define QKNXGROUPVALUECACHE_H
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxdatapointtype.h>
+#include <QtKnx/qknxgroupaddressinfos.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpRouter;
+class QKnxNetIpTunnel;
+
+class QKnxGroupValueCachePrivate;
+class Q_KNX_EXPORT QKnxGroupValueCache final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxGroupValueCache)
+    Q_DECLARE_PRIVATE(QKnxGroupValueCache)
+
+public:
+    enum : int { MaximumValueSize = 14 };
+
+    explicit QKnxGroupValueCache(QObject *parent = nullptr);
+    ~QKnxGroupValueCache() override;
+
+    void attach(QKnxNetIpTunnel *tunnel);
+    void attach(QKnxNetIpRouter *router);
+    void detach(QObject *source);
+
+    bool update(const QKnxLinkLayerFrame &frame);
+
+    bool contains(const QKnxAddress &address) const;
+    QKnxByteArray value(const QKnxAddress &address) const;
+    QDateTime timestamp(const QKnxAddress &address) const;
+    bool lookup(const QKnxAddress &address, QKnxByteArray *value,
+        QDateTime *timestamp = nullptr) const;
+
+    QVector<QKnxAddress> addresses() const;
+    void clear();
+
+    int notificationInterval() const;
+    void setNotificationInterval(int msec);
+
+    void setGroupAddressInfos(const QKnxGroupAddressInfos &infos, const QString &projectId,
+        const QString &installation = {});
+    QKnxDatapointType::Type datapointType(const QKnxAddress &address) const;
+    QKnxDatapointType *createDatapointType(const QKnxAddress &address) const;
+
+Q_SIGNALS:
+    void valuesChanged(const QVector<QKnxAddress> &addresses);
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,92 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPVALUECACHE_P_H
+#define QKNXGROUPVALUECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qbitarray.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <QtKnx/qknxgroupvaluecache.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxGroupValueCachePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxGroupValueCache)
+
+public:
+    enum : int { AddressCount = 0x10000 };
+
+    // One entry per group address, guarded by a sequence lock so readers on
+    // any thread never block the writer. The words are only accessed through
+    // relaxed atomics, the sequence orders them.
+    struct Slot final
+    {
+        enum : int { ValueWords = 4, TimestampWord = 4, WordCount = 7 };
+
+        QAtomicInteger<quint32> sequence { 0 }; // 0: never written, odd: being written
+        QAtomicInteger<quint32> words[WordCount]; // size and value, timestamp, padding
+    };
+
+    QKnxGroupValueCachePrivate() = default;
+    ~QKnxGroupValueCachePrivate() = default;
+
+    bool write(quint16 address, const QKnxByteArray &value, qint64 timestamp);
+    bool read(quint16 address, QKnxByteArray *value, qint64 *timestamp) const;
+
+    void markChanged(quint16 address);
+    void notify();
+
+    QScopedArrayPointer<Slot> m_slots { new Slot[AddressCount] };
+
+    QTimer m_notifyTimer;
+    QBitArray m_pending { AddressCount };
+    QVector<quint16> m_changed;
+
+    QVector<QKnxDatapointType::Type> m_types;
+};
+
+QT_END_NAMESPACE
+
+#endif
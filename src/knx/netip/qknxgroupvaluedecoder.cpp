@@ -0,0 +1,600 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxbusmonitorbuffer.h"
+#include "qknxgroupvaluedecoder.h"
+#include "qknxgroupvaluedecoder_p.h"
+
+#include <QtCore/qscopedpointer.h>
+#include <QtKnx/qknxdatapointtypecodec.h>
+#include <QtKnx/qknxdatapointtypefactory.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxGroupValueDecoder
+
+    \since 5.13
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+
+    \brief The QKnxGroupValueDecoder class turns group telegrams into typed
+    values using the datapoint types of an ETS project.
+
+    The decoder is set up once from the group address information of a
+    project. For every group address it resolves the datapoint type to a
+    decoding function up front, so that decoding a telegram neither searches
+    the project nor creates a datapoint type object. Each group value write or
+    group value response telegram is converted into a \l Record holding the
+    group address, the time stamp, the datapoint type, and the value.
+
+    Values of the numeric datapoint types DPT 1, 5 to 9, and 12 to 14 are
+    decoded to a number. All other values are passed on as raw bytes and can be
+    turned into a datapoint type object with createDatapointType().
+
+    \code
+        QKnxGroupAddressInfos infos("project.knxproj");
+        infos.parse();
+        QKnxGroupValueDecoder decoder(infos, infos.projectIds().value(0));
+
+        QKnxCaptureReader reader("line.pcapng");
+        QKnxGroupValueDecoder::Record record;
+        while (reader.readNext()) {
+            if (reader.recordType() != QKnxCaptureReader::RecordType::Cemi)
+                continue;
+            if (decoder.decode(reader.constData(), reader.size(), reader.timestamp(), &record))
+                qDebug() << record.address << record.value;
+        }
+    \endcode
+
+    Besides link layer frames, the decoder works directly on the raw bytes of
+    cEMI data indications, data confirmations, and bus monitor indications. It
+    can consume the frames stored in a QKnxBusMonitorBuffer in one pass.
+
+    All const functions are thread-safe, so one decoder can be shared by a
+    pool of worker threads, for example one per KNX line:
+
+    \code
+        QVector<QKnxBusMonitorBuffer *> lines = ...;
+        QtConcurrent::blockingMap(lines, [&decoder](QKnxBusMonitorBuffer *buffer) {
+            QVector<QKnxGroupValueDecoder::Record> records;
+            decoder.decode(buffer, &records);
+            ...
+        });
+    \endcode
+
+    \sa QKnxGroupAddressInfos, QKnxDatapointTypeCodec, QKnxGroupValueCache
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::MaximumValueSize
+
+    The maximum number of bytes of a decoded group value. Telegrams carrying
+    larger values are ignored.
+*/
+
+/*!
+    \enum QKnxGroupValueDecoder::ValueType
+
+    This enum describes how the value of a \l Record was decoded.
+
+    \value Raw
+           The datapoint type is unknown or not numeric, or the size of the
+           value does not match the datapoint type. Only the raw bytes are set.
+    \value Boolean
+           The value of a 1-bit datapoint type, either \c 0 or \c 1.
+    \value Integer
+           An integer value.
+    \value Real
+           A floating point value.
+*/
+
+/*!
+    \class QKnxGroupValueDecoder::Record
+    \inmodule QtKnx
+
+    \brief The Record struct holds a decoded group value.
+
+    The record has a fixed size and does not allocate, so that large numbers
+    of records can be kept in a QVector.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::timestamp
+
+    The time stamp passed when decoding the telegram.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::value
+
+    The decoded value. Integer values are represented exactly. Set to \c 0 if
+    \l valueType is \l {QKnxGroupValueDecoder::ValueType}{Raw}.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::type
+
+    The datapoint type of the group address, or
+    \l {QKnxDatapointType::Type}{Unknown}.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::address
+
+    The raw destination group address of the telegram.
+
+    \sa QKnxAddress::toUInt16()
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::valueType
+
+    Describes how \l value was decoded.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::size
+
+    The number of valid bytes in \l data.
+*/
+
+/*!
+    \variable QKnxGroupValueDecoder::Record::data
+
+    The raw bytes of the group value.
+*/
+
+QKnxGroupValueDecoderPrivate::QKnxGroupValueDecoderPrivate()
+    : m_decoders(1)
+{}
+
+quint16 QKnxGroupValueDecoderPrivate::compile(QKnxDatapointType::Type type)
+{
+    for (int i = 0; i < m_decoders.size(); ++i) {
+        if (m_decoders.at(i).type == type)
+            return quint16(i);
+    }
+
+    Decoder decoder;
+    decoder.type = type;
+
+    QScopedPointer<QKnxDatapointType> dpt(QKnxDatapointTypeFactory::instance().createType(type));
+    if (dpt) {
+        decoder.coefficient = dpt->coefficient();
+        decoder.size = quint8(dpt->size());
+
+        switch (dpt->mainType()) {
+        case 1:
+            decoder.codec = Codec::Bit;
+            break;
+        case 5:
+            decoder.codec = Codec::Unsigned8;
+            break;
+        case 6:
+            if (type != QKnxDatapointType::Type::DptStatusMode3) // a bit set
+                decoder.codec = Codec::Signed8;
+            break;
+        case 7:
+            decoder.codec = Codec::Unsigned16;
+            break;
+        case 8:
+            decoder.codec = Codec::Signed16;
+            break;
+        case 9:
+            decoder.codec = Codec::Float16;
+            break;
+        case 12:
+            decoder.codec = Codec::Unsigned32;
+            break;
+        case 13:
+            decoder.codec = Codec::Signed32;
+            break;
+        case 14:
+            decoder.codec = Codec::Float32;
+            break;
+        default:
+            break;
+        }
+    }
+
+    m_decoders.append(decoder);
+    return quint16(m_decoders.size() - 1);
+}
+
+bool QKnxGroupValueDecoderPrivate::decodeTpdu(quint16 address, const quint8 *tpdu, int size,
+    qint64 timestamp, QKnxGroupValueDecoder::Record *record) const
+{
+    if (size < 2)
+        return false;
+
+    const auto apci = QKnxTpdu::ApplicationControlField((tpdu[0] & 0x03) << 8 | (tpdu[1] & 0xc0));
+    if (apci != QKnxTpdu::ApplicationControlField::GroupValueWrite
+        && apci != QKnxTpdu::ApplicationControlField::GroupValueResponse) {
+        return false;
+    }
+
+    // values of up to 6 bits are carried in the APCI byte
+    const quint8 small = tpdu[1] & 0x3f;
+    const quint8 *data = (size == 2 ? &small : tpdu + 2);
+    const int dataSize = (size == 2 ? 1 : size - 2);
+    if (dataSize > QKnxGroupValueDecoder::MaximumValueSize)
+        return false;
+
+    const auto &decoder = m_decoders.at(m_table.isEmpty() ? 0 : m_table.at(address));
+
+    record->timestamp = timestamp;
+    record->value = 0.;
+    record->type = decoder.type;
+    record->address = address;
+    record->valueType = QKnxGroupValueDecoder::ValueType::Raw;
+    record->size = quint8(dataSize);
+    memcpy(record->data, data, size_t(dataSize));
+    memset(record->data + dataSize, 0, size_t(QKnxGroupValueDecoder::MaximumValueSize - dataSize));
+
+    if (decoder.codec == Codec::Raw || decoder.size != dataSize)
+        return true;
+
+    const auto integerOrReal = (decoder.coefficient == 1. ? QKnxGroupValueDecoder::ValueType::Integer
+        : QKnxGroupValueDecoder::ValueType::Real);
+
+    switch (decoder.codec) {
+    case Codec::Bit:
+        record->value = data[0] & 0x01;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Boolean;
+        break;
+    case Codec::Unsigned8:
+        QKnxDatapointTypeCodec::decodeDpt5(data, &record->value, 1, decoder.coefficient);
+        record->valueType = integerOrReal;
+        break;
+    case Codec::Signed8: {
+        qint8 value;
+        QKnxDatapointTypeCodec::decodeDpt6(data, &value, 1);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Integer;
+    }   break;
+    case Codec::Unsigned16: {
+        quint32 value;
+        QKnxDatapointTypeCodec::decodeDpt7(data, &value, 1, decoder.coefficient);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Integer;
+    }   break;
+    case Codec::Signed16:
+        QKnxDatapointTypeCodec::decodeDpt8(data, &record->value, 1, decoder.coefficient);
+        record->valueType = integerOrReal;
+        break;
+    case Codec::Float16: {
+        float value;
+        QKnxDatapointTypeCodec::decodeDpt9(data, &value, 1);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Real;
+    }   break;
+    case Codec::Unsigned32: {
+        quint32 value;
+        QKnxDatapointTypeCodec::decodeDpt12(data, &value, 1);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Integer;
+    }   break;
+    case Codec::Signed32: {
+        qint32 value;
+        QKnxDatapointTypeCodec::decodeDpt13(data, &value, 1);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Integer;
+    }   break;
+    case Codec::Float32: {
+        float value;
+        QKnxDatapointTypeCodec::decodeDpt14(data, &value, 1);
+        record->value = value;
+        record->valueType = QKnxGroupValueDecoder::ValueType::Real;
+    }   break;
+    case Codec::Raw:
+        break;
+    }
+    return true;
+}
+
+/*!
+    Creates a decoder without any datapoint types. All group values are decoded
+    as raw bytes until types are set.
+*/
+QKnxGroupValueDecoder::QKnxGroupValueDecoder()
+    : d_ptr(new QKnxGroupValueDecoderPrivate)
+{}
+
+/*!
+    Destroys the decoder.
+*/
+QKnxGroupValueDecoder::~QKnxGroupValueDecoder()
+{}
+
+/*!
+    Creates a decoder for the group addresses described by \a infos for the
+    project \a projectId and the optional \a installation.
+
+    \sa setGroupAddressInfos()
+*/
+QKnxGroupValueDecoder::QKnxGroupValueDecoder(const QKnxGroupAddressInfos &infos,
+        const QString &projectId, const QString &installation)
+    : QKnxGroupValueDecoder()
+{
+    setGroupAddressInfos(infos, projectId, installation);
+}
+
+/*!
+    Uses the datapoint types of the group addresses described by \a infos for
+    the project \a projectId and the optional \a installation to decode group
+    values. Any previously set datapoint types are replaced.
+
+    The decoding function of each datapoint type is resolved once by this
+    function.
+*/
+void QKnxGroupValueDecoder::setGroupAddressInfos(const QKnxGroupAddressInfos &infos,
+    const QString &projectId, const QString &installation)
+{
+    clear();
+    d_ptr->m_table.fill(0, QKnxGroupValueDecoderPrivate::AddressCount);
+
+    const auto addressInfos = infos.addressInfos(projectId, installation);
+    for (const auto &info : addressInfos) {
+        const auto address = info.address();
+        if (address.type() == QKnxAddress::Type::Group)
+            d_ptr->m_table[address.toUInt16()] = d_ptr->compile(info.datapointType());
+    }
+}
+
+/*!
+    Returns the datapoint type used to decode the values of the group
+    \a address, or \l {QKnxDatapointType::Type}{Unknown}.
+*/
+QKnxDatapointType::Type QKnxGroupValueDecoder::datapointType(const QKnxAddress &address) const
+{
+    if (address.type() != QKnxAddress::Type::Group || d_ptr->m_table.isEmpty())
+        return QKnxDatapointType::Type::Unknown;
+    return d_ptr->m_decoders.at(d_ptr->m_table.at(address.toUInt16())).type;
+}
+
+/*!
+    Sets the datapoint type used to decode the values of the group \a address
+    to \a type.
+*/
+void QKnxGroupValueDecoder::setDatapointType(const QKnxAddress &address,
+    QKnxDatapointType::Type type)
+{
+    if (address.type() != QKnxAddress::Type::Group)
+        return;
+
+    if (d_ptr->m_table.isEmpty())
+        d_ptr->m_table.fill(0, QKnxGroupValueDecoderPrivate::AddressCount);
+    d_ptr->m_table[address.toUInt16()] = d_ptr->compile(type);
+}
+
+/*!
+    Removes all datapoint types from the decoder.
+*/
+void QKnxGroupValueDecoder::clear()
+{
+    d_ptr->m_decoders.resize(1);
+    d_ptr->m_table.clear();
+}
+
+/*!
+    Decodes the group value carried by the link layer \a frame into \a record,
+    using \a timestamp as the time stamp of the record. Returns \c true if the
+    frame carried a group value; otherwise returns \c false and leaves
+    \a record unchanged.
+
+    Data indications and positive data confirmations of group value write and
+    group value response telegrams are decoded, all other frames are ignored.
+*/
+bool QKnxGroupValueDecoder::decode(const QKnxLinkLayerFrame &frame, qint64 timestamp,
+    Record *record) const
+{
+    if (!record)
+        return false;
+
+    switch (frame.messageCode()) {
+    case QKnxLinkLayerFrame::MessageCode::DataIndication:
+        break;
+    case QKnxLinkLayerFrame::MessageCode::DataConfirmation:
+        if (frame.controlField().confirm() == QKnxControlField::Confirm::Error)
+            return false;
+        break;
+    default:
+        return false;
+    }
+
+    const auto destination = frame.destinationAddress();
+    if (destination.type() != QKnxAddress::Type::Group)
+        return false;
+
+    quint8 tpdu[2 + MaximumValueSize];
+    const auto size = frame.tpdu().serializeInto(tpdu, sizeof(tpdu));
+    return size > 0 && d_ptr->decodeTpdu(destination.toUInt16(), tpdu, size, timestamp, record);
+}
+
+/*!
+    Decodes the group value carried by the raw cEMI frame \a cemi of \a size
+    bytes into \a record, using \a timestamp as the time stamp of the record.
+    Returns \c true if the frame carried a group value; otherwise returns
+    \c false.
+
+    Besides data indications and positive data confirmations, bus monitor
+    indications are decoded if they carry a standard or extended TP1 frame with
+    a valid checksum. Repeated bus monitor frames are ignored.
+
+    The frame is read in place without creating a QKnxLinkLayerFrame.
+*/
+bool QKnxGroupValueDecoder::decode(const quint8 *cemi, int size, qint64 timestamp,
+    Record *record) const
+{
+    if (!cemi || !record || size < 2)
+        return false;
+
+    const int offset = 2 + cemi[1]; // message code, additional information
+    if (size <= offset)
+        return false;
+
+    const quint8 *frame = cemi + offset;
+    const int frameSize = size - offset;
+
+    switch (QKnxLinkLayerFrame::MessageCode(cemi[0])) {
+    case QKnxLinkLayerFrame::MessageCode::DataConfirmation:
+        if (frame[0] & 0x01) // confirm flag
+            return false;
+        Q_FALLTHROUGH();
+    case QKnxLinkLayerFrame::MessageCode::DataIndication: {
+        // control fields, source and destination address, length, TPDU
+        if (frameSize < 9 || !(frame[1] & 0x80))
+            return false;
+        const int tpduSize = frame[6] + 1;
+        if (frameSize - 7 < tpduSize)
+            return false;
+        return d_ptr->decodeTpdu(quint16(frame[4] << 8 | frame[5]), frame + 7, tpduSize,
+            timestamp, record);
+    }
+    case QKnxLinkLayerFrame::MessageCode::BusmonitorIndication: {
+        quint8 checksum = 0;
+        for (int i = 0; i < frameSize; ++i)
+            checksum ^= frame[i];
+        if (frameSize < 9 || checksum != 0xff || !(frame[0] & 0x20)) // invalid or repeated
+            return false;
+
+        if (frame[0] & 0x80) {
+            // standard frame: control field, source and destination address, address
+            // type with hop count and length, TPDU, checksum
+            const int tpduSize = (frame[5] & 0x0f) + 1;
+            if (!(frame[5] & 0x80) || frameSize != tpduSize + 7)
+                return false;
+            return d_ptr->decodeTpdu(quint16(frame[3] << 8 | frame[4]), frame + 6, tpduSize,
+                timestamp, record);
+        }
+
+        // extended frame: control fields, source and destination address, length, TPDU,
+        // checksum
+        const int tpduSize = frame[6] + 1;
+        if (!(frame[1] & 0x80) || frameSize != tpduSize + 8)
+            return false;
+        return d_ptr->decodeTpdu(quint16(frame[4] << 8 | frame[5]), frame + 7, tpduSize,
+            timestamp, record);
+    }
+    default:
+        break;
+    }
+    return false;
+}
+
+/*!
+    Consumes up to \a maximum frames from \a buffer and appends the decoded
+    group values to \a records, oldest first. A negative \a maximum consumes
+    all stored frames. Frames that do not carry a group value are consumed
+    and skipped. Returns the number of records appended.
+
+    \note The caller must be the only reader of \a buffer.
+*/
+int QKnxGroupValueDecoder::decode(QKnxBusMonitorBuffer *buffer, QVector<Record> *records,
+    int maximum) const
+{
+    if (!buffer || !records)
+        return 0;
+
+    const int count = records->size();
+    Record record;
+    buffer->consume([&](qint64 timestamp, const quint8 *cemi, int size) {
+        if (decode(cemi, size, timestamp, &record))
+            records->append(record);
+    }, maximum);
+    return records->size() - count;
+}
+
+/*!
+    Returns a datapoint type object of the type of \a record holding the value
+    of the record. Returns \c nullptr if the type is unknown or the value does
+    not fit the type.
+
+    The caller takes ownership of the returned object.
+*/
+QKnxDatapointType *QKnxGroupValueDecoder::createDatapointType(const Record &record) const
+{
+    if (record.type == QKnxDatapointType::Type::Unknown)
+        return nullptr;
+
+    auto dpt = QKnxDatapointTypeFactory::instance().createType(record.type);
+    if (dpt && !dpt->setBytes(QKnxByteArray(record.data, record.size), 0, record.size)) {
+        delete dpt;
+        return nullptr;
+    }
+    return dpt;
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QKnxGroupValueDecoder::QKnxGroupValueDecoder(const QKnxGroupValueDecoder &other)
+    : d_ptr(other.d_ptr)
+{}
+
+/*!
+    Assigns the specified \a other to this object.
+*/
+QKnxGroupValueDecoder &QKnxGroupValueDecoder::operator=(const QKnxGroupValueDecoder &other)
+{
+    d_ptr = other.d_ptr;
+    return *this;
+}
+
+/*!
+    Move-constructs an object instance, making it point to the same object that
+    \a other was pointing to.
+*/
+QKnxGroupValueDecoder::QKnxGroupValueDecoder(QKnxGroupValueDecoder &&other) Q_DECL_NOTHROW
+    : d_ptr(other.d_ptr)
+{
+    other.d_ptr = Q_NULLPTR;
+}
+
+/*!
+    Move-assigns \a other to this object instance.
+*/
+QKnxGroupValueDecoder &QKnxGroupValueDecoder::operator=(QKnxGroupValueDecoder &&other) Q_DECL_NOTHROW
+{
+    swap(other);
+    return *this;
+}
+
+/*!
+    Swaps \a other with this object. This operation is very fast and never fails.
+*/
+void QKnxGroupValueDecoder::swap(QKnxGroupValueDecoder &other) Q_DECL_NOTHROW
+{
+    d_ptr.swap(other.d_ptr);
+}
+
+QT_END_NAMESPACE
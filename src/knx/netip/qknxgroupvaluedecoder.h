@@ -0,0 +1,110 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPVALUEDECODER_H
+#define QKNXGROUPVALUEDECODER_H
+
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxdatapointtype.h>
+#include <QtKnx/qknxgroupaddressinfos.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxBusMonitorBuffer;
+
+class QKnxGroupValueDecoderPrivate;
+class Q_KNX_EXPORT QKnxGroupValueDecoder final
+{
+    Q_GADGET
+
+public:
+    enum : int { MaximumValueSize = 14 };
+
+    enum class ValueType : quint8
+    {
+        Raw,
+        Boolean,
+        Integer,
+        Real
+    };
+    Q_ENUM(ValueType)
+
+    struct Record
+    {
+        qint64 timestamp;
+        double value;
+        QKnxDatapointType::Type type;
+        quint16 address;
+        ValueType valueType;
+        quint8 size;
+        quint8 data[MaximumValueSize];
+    };
+
+    QKnxGroupValueDecoder();
+    ~QKnxGroupValueDecoder();
+
+    QKnxGroupValueDecoder(const QKnxGroupAddressInfos &infos, const QString &projectId,
+        const QString &installation = {});
+
+    void setGroupAddressInfos(const QKnxGroupAddressInfos &infos, const QString &projectId,
+        const QString &installation = {});
+
+    QKnxDatapointType::Type datapointType(const QKnxAddress &address) const;
+    void setDatapointType(const QKnxAddress &address, QKnxDatapointType::Type type);
+
+    void clear();
+
+    bool decode(const QKnxLinkLayerFrame &frame, qint64 timestamp, Record *record) const;
+    bool decode(const quint8 *cemi, int size, qint64 timestamp, Record *record) const;
+    int decode(QKnxBusMonitorBuffer *buffer, QVector<Record> *records, int maximum = -1) const;
+
+    QKnxDatapointType *createDatapointType(const Record &record) const;
+
+    QKnxGroupValueDecoder(const QKnxGroupValueDecoder &other);
+    QKnxGroupValueDecoder &operator=(const QKnxGroupValueDecoder &other);
+
+    QKnxGroupValueDecoder(QKnxGroupValueDecoder &&other) Q_DECL_NOTHROW;
+    QKnxGroupValueDecoder &operator=(QKnxGroupValueDecoder &&other) Q_DECL_NOTHROW;
+
+    void swap(QKnxGroupValueDecoder &other) Q_DECL_NOTHROW;
+
+private:
+    QSharedDataPointer<QKnxGroupValueDecoderPrivate> d_ptr;
+};
+Q_DECLARE_TYPEINFO(QKnxGroupValueDecoder::Record, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,96 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPVALUEDECODER_P_H
+#define QKNXGROUPVALUEDECODER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qknxgroupvaluedecoder.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxGroupValueDecoderPrivate final : public QSharedData
+{
+public:
+    enum : int { AddressCount = 0x10000 };
+
+    enum class Codec : quint8
+    {
+        Raw,
+        Bit,        // DPT 1
+        Unsigned8,  // DPT 5
+        Signed8,    // DPT 6
+        Unsigned16, // DPT 7
+        Signed16,   // DPT 8
+        Float16,    // DPT 9
+        Unsigned32, // DPT 12
+        Signed32,   // DPT 13
+        Float32     // DPT 14
+    };
+
+    // Everything needed to turn the bytes of a group value into a typed value,
+    // resolved once per datapoint type when the address table is compiled.
+    struct Decoder final
+    {
+        QKnxDatapointType::Type type { QKnxDatapointType::Type::Unknown };
+        double coefficient { 1. };
+        Codec codec { Codec::Raw };
+        quint8 size { 0 };
+    };
+
+    QKnxGroupValueDecoderPrivate();
+    ~QKnxGroupValueDecoderPrivate() = default;
+
+    quint16 compile(QKnxDatapointType::Type type);
+
+    bool decodeTpdu(quint16 address, const quint8 *tpdu, int size, qint64 timestamp,
+        QKnxGroupValueDecoder::Record *record) const;
+
+    // The decoders of all datapoint types in use, the first one decodes to raw
+    // bytes. The address table holds the decoder index for each group address.
+    QVector<Decoder> m_decoders;
+    QVector<quint16> m_table;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -28,10 +28,24 @@
 ******************************************************************************/
 
 #include "qknxnetipconfigdib.h"
-#include "qknxutils.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxConfigDib
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using IpAddress = Field<0, 4>;
+    using SubnetMask = Field<4, 4>;
+    using DefaultGateway = Field<8, 4>;
+    using Capabilities = Field<12, 1>;
+    using AssignmentMethods = Field<13, 1>;
+
+    using Layout = QKnxNetIpStructLayout::Layout<14, IpAddress, SubnetMask, DefaultGateway,
+        Capabilities, AssignmentMethods>;
+}
+
 /*!
     \class QKnxNetIpConfigDibProxy
 
@@ -93,7 +107,7 @@ QKnxNetIpConfigDibProxy::QKnxNetIpConfigDibProxy(const QKnxNetIpDib &dib)
 */
 bool QKnxNetIpConfigDibProxy::isValid() const
 {
-    return m_dib.isValid() && m_dib.size() == 16
+    return m_dib.isValid() && QKnxConfigDib::Layout::hasSize(m_dib.constData())
         && m_dib.code() == QKnxNetIp::DescriptionType::IpConfiguration;
 }
 
@@ -117,7 +131,7 @@ QKnxNetIp::DescriptionType QKnxNetIpConfigDibProxy::descriptionType() const
 QHostAddress QKnxNetIpConfigDibProxy::ipAddress() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData());
+        return QHostAddress(QKnxConfigDib::IpAddress::read(m_dib.constData()));
     return {};
 }
 
@@ -129,7 +143,7 @@ QHostAddress QKnxNetIpConfigDibProxy::ipAddress() const
 QHostAddress QKnxNetIpConfigDibProxy::subnetMask() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 4);
+        return QHostAddress(QKnxConfigDib::SubnetMask::read(m_dib.constData()));
     return {};
 }
 
@@ -141,7 +155,7 @@ QHostAddress QKnxNetIpConfigDibProxy::subnetMask() const
 QHostAddress QKnxNetIpConfigDibProxy::defaultGateway() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 8);
+        return QHostAddress(QKnxConfigDib::DefaultGateway::read(m_dib.constData()));
     return {};
 }
 
@@ -153,7 +167,7 @@ QHostAddress QKnxNetIpConfigDibProxy::defaultGateway() const
 QKnxNetIp::Capabilities QKnxNetIpConfigDibProxy::capabilities() const
 {
     if (isValid())
-        return QKnxNetIp::Capabilities(m_dib.constData().value(12));
+        return QKnxNetIp::Capabilities(QKnxConfigDib::Capabilities::read(m_dib.constData()));
     return QKnxNetIp::Capability::Unknown;
 }
 
@@ -165,7 +179,7 @@ QKnxNetIp::Capabilities QKnxNetIpConfigDibProxy::capabilities() const
 QKnxNetIp::AssignmentMethods QKnxNetIpConfigDibProxy::assignmentMethods() const
 {
     if (isValid())
-        return QKnxNetIp::AssignmentMethods(m_dib.constData().value(13));
+        return QKnxNetIp::AssignmentMethods(QKnxConfigDib::AssignmentMethods::read(m_dib.constData()));
     return QKnxNetIp::AssignmentMethod::Unknown;
 }
 
@@ -286,12 +300,14 @@ QKnxNetIpDib QKnxNetIpConfigDibProxy::Builder::create() const
             return { QKnxNetIp::DescriptionType::IpConfiguration };
     }
 
-    return { QKnxNetIp::DescriptionType::IpConfiguration,
-        QKnxUtils::HostAddress::bytes(m_ipAddress)
-        + QKnxUtils::HostAddress::bytes(m_subnetMask)
-        + QKnxUtils::HostAddress::bytes(m_gateway)
-        + QKnxByteArray { quint8(m_caps), quint8(m_methods) }
-    };
+    auto data = QKnxConfigDib::Layout::create();
+    QKnxConfigDib::IpAddress::write(data, m_ipAddress.toIPv4Address());
+    QKnxConfigDib::SubnetMask::write(data, m_subnetMask.toIPv4Address());
+    QKnxConfigDib::DefaultGateway::write(data, m_gateway.toIPv4Address());
+    QKnxConfigDib::Capabilities::write(data, quint8(m_caps));
+    QKnxConfigDib::AssignmentMethods::write(data, quint8(m_methods));
+
+    return { QKnxNetIp::DescriptionType::IpConfiguration, data };
 }
 
 QT_END_NAMESPACE
@@ -220,6 +220,38 @@ QKnxByteArray QKnxNetIpConnectionHeader::bytes() const
     return m_bytes;
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for this connection
+    header. This is the header size if the header is valid; otherwise \c 0.
+
+    \sa serializeInto(), bytes()
+*/
+quint16 QKnxNetIpConnectionHeader::serializedSize() const
+{
+    return isValid() ? m_bytes.size() : 0;
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the KNXnet/IP connection header to \a dst,
+    which must provide room for at least \a capacity bytes. Returns the number
+    of bytes written, or \c 0 if the header is invalid or \a capacity is too
+    small.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxNetIpConnectionHeader::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (size == 0 || !dst || capacity < size)
+        return 0;
+    memcpy(dst, m_bytes.constData(), size);
+    return size;
+}
+
 /*!
     Constructs the KNXnet/IP frame connection header from the byte array \a bytes
     starting at the position \a index inside the array.
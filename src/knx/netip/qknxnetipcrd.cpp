@@ -28,9 +28,19 @@
 ******************************************************************************/
 
 #include "qknxnetipcrd.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxTunnelCrd
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using IndividualAddress = Field<0, 2>;
+
+    using Layout = QKnxNetIpStructLayout::Layout<2, IndividualAddress>;
+}
+
 /*!
     \class QKnxNetIpCrdProxy
 
@@ -101,8 +111,7 @@ bool QKnxNetIpCrdProxy::isValid() const
 {
     switch (m_crd.code()) {
         case QKnxNetIp::ConnectionType::Tunnel: {
-            const QKnxAddress address { QKnxAddress::Type::Individual, m_crd.constData() };
-            return m_crd.isValid() && m_crd.size() == 4 && address.isValid();
+            return m_crd.isValid() && QKnxTunnelCrd::Layout::hasSize(m_crd.constData());
         } break;
         case QKnxNetIp::ConnectionType::DeviceManagement:
         case QKnxNetIp::ConnectionType::RemoteLogging:
@@ -136,8 +145,9 @@ QKnxNetIp::ConnectionType QKnxNetIpCrdProxy::connectionType() const
 */
 QKnxAddress QKnxNetIpCrdProxy::individualAddress() const
 {
-    if (isValid())
-        return { QKnxAddress::Type::Individual, m_crd.constData() };
+    if (isValid() && QKnxTunnelCrd::Layout::hasSize(m_crd.constData()))
+        return { QKnxAddress::Type::Individual,
+            QKnxTunnelCrd::IndividualAddress::read(m_crd.constData()) };
     return {};
 }
 
@@ -28,9 +28,22 @@
 ******************************************************************************/
 
 #include "qknxnetipcri.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxTunnelCri
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using TunnelLayer = Field<0, 1>;
+    // byte 1 is reserved
+    using IndividualAddress = Field<2, 2>;
+
+    using Layout = QKnxNetIpStructLayout::Layout<2, TunnelLayer>;
+    using ExtendedLayout = QKnxNetIpStructLayout::Layout<4, TunnelLayer, IndividualAddress>;
+}
+
 /*!
     \class QKnxNetIpCriProxy
 
@@ -99,9 +112,11 @@ bool QKnxNetIpCriProxy::isValid() const
 {
     switch (m_cri.code()) {
         case QKnxNetIp::ConnectionType::Tunnel: {
-            auto tmp = m_cri.constData().value(0);
-            return m_cri.isValid() && QKnxNetIp::isTunnelLayer(QKnxNetIp::TunnelLayer(tmp))
-                && (m_cri.size() == 4 || m_cri.size() == 6);
+            const auto &data = m_cri.constData();
+            const auto layer = QKnxNetIp::TunnelLayer(QKnxTunnelCri::TunnelLayer::read(data));
+            return m_cri.isValid() && QKnxNetIp::isTunnelLayer(layer)
+                && (QKnxTunnelCri::Layout::hasSize(data)
+                    || QKnxTunnelCri::ExtendedLayout::hasSize(data));
         }
         case QKnxNetIp::ConnectionType::DeviceManagement:
         case QKnxNetIp::ConnectionType::RemoteLogging:
@@ -127,7 +142,8 @@ bool QKnxNetIpCriProxy::isValid() const
 */
 bool QKnxNetIpCriProxy::isExtended() const
 {
-    return (m_cri.code() == QKnxNetIp::ConnectionType::Tunnel) && (m_cri.size() == 6);
+    return (m_cri.code() == QKnxNetIp::ConnectionType::Tunnel)
+        && QKnxTunnelCri::ExtendedLayout::hasSize(m_cri.constData());
 }
 
 /*!
@@ -152,7 +168,7 @@ QKnxNetIp::ConnectionType QKnxNetIpCriProxy::connectionType() const
 QKnxNetIp::TunnelLayer QKnxNetIpCriProxy::tunnelLayer() const
 {
     if (isValid())
-        return QKnxNetIp::TunnelLayer(m_cri.constData().value(0));
+        return QKnxNetIp::TunnelLayer(QKnxTunnelCri::TunnelLayer::read(m_cri.constData()));
     return QKnxNetIp::TunnelLayer::Unknown;
 }
 
@@ -168,7 +184,8 @@ QKnxNetIp::TunnelLayer QKnxNetIpCriProxy::tunnelLayer() const
 QKnxAddress QKnxNetIpCriProxy::individualAddress() const
 {
     if (isExtended() && isValid())
-        return { QKnxAddress::Type::Individual, m_cri.constData().mid(2, 2) };
+        return { QKnxAddress::Type::Individual,
+            QKnxTunnelCri::IndividualAddress::read(m_cri.constData()) };
     return {};
 }
 
@@ -28,10 +28,25 @@
 ******************************************************************************/
 
 #include "qknxnetipcurrentconfigdib.h"
-#include "qknxutils.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxCurrentConfigDib
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using IpAddress = Field<0, 4>;
+    using SubnetMask = Field<4, 4>;
+    using DefaultGateway = Field<8, 4>;
+    using DhcpOrBootP = Field<12, 4>;
+    using AssignmentMethod = Field<16, 1>;
+    // byte 17 is reserved
+
+    using Layout = QKnxNetIpStructLayout::Layout<18, IpAddress, SubnetMask, DefaultGateway,
+        DhcpOrBootP, AssignmentMethod>;
+}
+
 /*!
     \class QKnxNetIpCurrentConfigDibProxy
 
@@ -97,7 +112,7 @@ QKnxNetIpCurrentConfigDibProxy::QKnxNetIpCurrentConfigDibProxy(const QKnxNetIpDi
 */
 bool QKnxNetIpCurrentConfigDibProxy::isValid() const
 {
-    return m_dib.isValid() && m_dib.size() == 20
+    return m_dib.isValid() && QKnxCurrentConfigDib::Layout::hasSize(m_dib.constData())
         && m_dib.code() == QKnxNetIp::DescriptionType::CurrentIpConfiguration;
 }
 
@@ -121,7 +136,7 @@ QKnxNetIp::DescriptionType QKnxNetIpCurrentConfigDibProxy::descriptionType() con
 QHostAddress QKnxNetIpCurrentConfigDibProxy::ipAddress() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData());
+        return QHostAddress(QKnxCurrentConfigDib::IpAddress::read(m_dib.constData()));
     return {};
 }
 
@@ -133,7 +148,7 @@ QHostAddress QKnxNetIpCurrentConfigDibProxy::ipAddress() const
 QHostAddress QKnxNetIpCurrentConfigDibProxy::subnetMask() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 4);
+        return QHostAddress(QKnxCurrentConfigDib::SubnetMask::read(m_dib.constData()));
     return {};
 }
 
@@ -145,7 +160,7 @@ QHostAddress QKnxNetIpCurrentConfigDibProxy::subnetMask() const
 QHostAddress QKnxNetIpCurrentConfigDibProxy::defaultGateway() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 8);
+        return QHostAddress(QKnxCurrentConfigDib::DefaultGateway::read(m_dib.constData()));
     return {};
 }
 
@@ -158,7 +173,7 @@ QHostAddress QKnxNetIpCurrentConfigDibProxy::defaultGateway() const
 QHostAddress QKnxNetIpCurrentConfigDibProxy::dhcpOrBootP() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 12);
+        return QHostAddress(QKnxCurrentConfigDib::DhcpOrBootP::read(m_dib.constData()));
     return {};
 }
 
@@ -170,7 +185,8 @@ QHostAddress QKnxNetIpCurrentConfigDibProxy::dhcpOrBootP() const
 QKnxNetIp::AssignmentMethod QKnxNetIpCurrentConfigDibProxy::assignmentMethod() const
 {
     if (isValid())
-        return QKnxNetIp::AssignmentMethod(m_dib.constData().value(16));
+        return QKnxNetIp::AssignmentMethod(QKnxCurrentConfigDib::AssignmentMethod::read(m_dib
+            .constData()));
     return QKnxNetIp::AssignmentMethod::Unknown;
 }
 
@@ -291,13 +307,14 @@ QKnxNetIpDib QKnxNetIpCurrentConfigDibProxy::Builder::create() const
             return { QKnxNetIp::DescriptionType::CurrentIpConfiguration };
     }
 
-    return { QKnxNetIp::DescriptionType::CurrentIpConfiguration,
-        QKnxUtils::HostAddress::bytes(m_ipAddress)
-        + QKnxUtils::HostAddress::bytes(m_subnetMask)
-        + QKnxUtils::HostAddress::bytes(m_gateway)
-        + QKnxUtils::HostAddress::bytes(m_dhcpBootP)
-        + QKnxByteArray { quint8(m_method), 0x00 } // last byte is reserved
-    };
+    auto data = QKnxCurrentConfigDib::Layout::create();
+    QKnxCurrentConfigDib::IpAddress::write(data, m_ipAddress.toIPv4Address());
+    QKnxCurrentConfigDib::SubnetMask::write(data, m_subnetMask.toIPv4Address());
+    QKnxCurrentConfigDib::DefaultGateway::write(data, m_gateway.toIPv4Address());
+    QKnxCurrentConfigDib::DhcpOrBootP::write(data, m_dhcpBootP.toIPv4Address());
+    QKnxCurrentConfigDib::AssignmentMethod::write(data, quint8(m_method));
+
+    return { QKnxNetIp::DescriptionType::CurrentIpConfiguration, data };
 }
 
 QT_END_NAMESPACE
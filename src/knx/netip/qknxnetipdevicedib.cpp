@@ -28,10 +28,28 @@
 ******************************************************************************/
 
 #include "qknxnetipdevicedib.h"
-#include "qknxutils.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxDeviceDib
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using MediumType = Field<0, 1>;
+    using DeviceStatus = Field<1, 1>;
+    using IndividualAddress = Field<2, 2>;
+    using ProjectInstallationId = Field<4, 2>;
+    using SerialNumber = Bytes<6, 6>;
+    using MulticastAddress = Field<12, 4>;
+    using MacAddress = Bytes<16, 6>;
+    using DeviceName = Bytes<22, 30>;
+
+    using Layout = QKnxNetIpStructLayout::Layout<52, MediumType, DeviceStatus,
+        IndividualAddress, ProjectInstallationId, SerialNumber, MulticastAddress, MacAddress,
+        DeviceName>;
+}
+
 /*!
     \class QKnxNetIpDeviceDibProxy
 
@@ -92,7 +110,7 @@ QKnxNetIpDeviceDibProxy::QKnxNetIpDeviceDibProxy(const QKnxNetIpDib &dib)
 */
 bool QKnxNetIpDeviceDibProxy::isValid() const
 {
-    return m_dib.isValid() && m_dib.size() == 54
+    return m_dib.isValid() && QKnxDeviceDib::Layout::hasSize(m_dib.constData())
         && m_dib.code() == QKnxNetIp::DescriptionType::DeviceInfo;
 }
 
@@ -116,7 +134,7 @@ QKnxNetIp::DescriptionType QKnxNetIpDeviceDibProxy::descriptionType() const
 QKnx::MediumType QKnxNetIpDeviceDibProxy::mediumType() const
 {
     if (isValid())
-        return QKnx::MediumType(m_dib.constData().value(0));
+        return QKnx::MediumType(QKnxDeviceDib::MediumType::read(m_dib.constData()));
     return QKnx::MediumType::Unknown;
 }
 
@@ -127,7 +145,7 @@ QKnx::MediumType QKnxNetIpDeviceDibProxy::mediumType() const
 */
 QKnxNetIp::ProgrammingMode QKnxNetIpDeviceDibProxy::deviceStatus() const
 {
-    return QKnxNetIp::ProgrammingMode(m_dib.constData().value(1));
+    return QKnxNetIp::ProgrammingMode(QKnxDeviceDib::DeviceStatus::read(m_dib.constData()));
 }
 
 /*!
@@ -138,7 +156,8 @@ QKnxNetIp::ProgrammingMode QKnxNetIpDeviceDibProxy::deviceStatus() const
 QKnxAddress QKnxNetIpDeviceDibProxy::individualAddress() const
 {
     if (isValid())
-        return { QKnxAddress::Type::Individual, m_dib.constData().mid(2, 2) };
+        return { QKnxAddress::Type::Individual,
+            QKnxDeviceDib::IndividualAddress::read(m_dib.constData()) };
     return {};
 }
 
@@ -148,7 +167,7 @@ QKnxAddress QKnxNetIpDeviceDibProxy::individualAddress() const
 */
 quint16 QKnxNetIpDeviceDibProxy::projectInstallationId() const
 {
-    return QKnxUtils::QUint16::fromBytes(m_dib.constData(), 4);
+    return QKnxDeviceDib::ProjectInstallationId::read(m_dib.constData());
 }
 
 /*!
@@ -159,7 +178,7 @@ quint16 QKnxNetIpDeviceDibProxy::projectInstallationId() const
 QKnxByteArray QKnxNetIpDeviceDibProxy::serialNumber() const
 {
     if (isValid())
-        return m_dib.constData().mid(6, 6);
+        return QKnxDeviceDib::SerialNumber::read(m_dib.constData());
     return {};
 }
 
@@ -171,7 +190,7 @@ QKnxByteArray QKnxNetIpDeviceDibProxy::serialNumber() const
 QHostAddress QKnxNetIpDeviceDibProxy::multicastAddress() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_dib.constData(), 12);
+        return QHostAddress(QKnxDeviceDib::MulticastAddress::read(m_dib.constData()));
     return {};
 }
 
@@ -183,7 +202,7 @@ QHostAddress QKnxNetIpDeviceDibProxy::multicastAddress() const
 QKnxByteArray QKnxNetIpDeviceDibProxy::macAddress() const
 {
     if (isValid())
-        return m_dib.constData().mid(16, 6);
+        return QKnxDeviceDib::MacAddress::read(m_dib.constData());
     return {};
 }
 
@@ -194,10 +213,8 @@ QKnxByteArray QKnxNetIpDeviceDibProxy::macAddress() const
 */
 QByteArray QKnxNetIpDeviceDibProxy::deviceName() const
 {
-    if (isValid()) {
-        auto tmp = m_dib.constData().mid(22, 30);
-        return QByteArray((const char *) tmp.constData());
-    }
+    if (isValid())
+        return QKnxDeviceDib::DeviceName::readString(m_dib.constData());
     return {};
 }
 
@@ -384,19 +401,17 @@ QKnxNetIpDib QKnxNetIpDeviceDibProxy::Builder::create() const
             return { QKnxNetIp::DescriptionType::DeviceInfo };
     }
 
-    QKnxByteArray data;
-    data.append(quint8(m_mediumType));
-    data.append(quint8(m_progMode));
-    data.append(m_address.bytes());
-    data.append(QKnxUtils::QUint16::bytes(m_projectId));
-    data.append(m_serialNumber);
-    data.append(QKnxUtils::HostAddress::bytes(m_multicastAddress));
-    data.append(m_macAddress);
-    data.append(QKnxByteArray::fromByteArray(m_deviceName));
-
-    if (data.size() < 52)
-        data.append(QKnxByteArray(52 - data.size(), 0));
-    data.resize(52); // size enforced by 7.5.4.2 Device information DIB
+    // size enforced by 7.5.4.2 Device information DIB, the name is truncated
+    // or zero padded to 30 bytes
+    auto data = QKnxDeviceDib::Layout::create();
+    QKnxDeviceDib::MediumType::write(data, quint8(m_mediumType));
+    QKnxDeviceDib::DeviceStatus::write(data, quint8(m_progMode));
+    QKnxDeviceDib::IndividualAddress::write(data, m_address.toUInt16());
+    QKnxDeviceDib::ProjectInstallationId::write(data, m_projectId);
+    QKnxDeviceDib::SerialNumber::write(data, m_serialNumber);
+    QKnxDeviceDib::MulticastAddress::write(data, m_multicastAddress.toIPv4Address());
+    QKnxDeviceDib::MacAddress::write(data, m_macAddress);
+    QKnxDeviceDib::DeviceName::write(data, m_deviceName);
 
     return { QKnxNetIp::DescriptionType::DeviceInfo, data };
 }
@@ -47,6 +47,15 @@
 #include "qtcpsocket.h"
 #include "qudpsocket.h"
 
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#if QT_CONFIG(opensslv11)
+#include "qknxcurve25519.h"
+#include "qknxcurve25519keypool_p.h"
+#include "qknxnetipsecuresession_p.h"
+#include "qknxnetipsessionstatus.h"
+#endif
+
 QT_BEGIN_NAMESPACE
 /*!
     \class QKnxNetIpEndpointConnection
@@ -106,6 +115,9 @@ QT_BEGIN_NAMESPACE
             State request timeout.
     \value Cemi
             No cEMI frame acknowledge in time.
+    \value SecureSession
+            The secure session could not be established or was closed by the
+            server. This value was introduced in Qt 5.13.
     \value Unknown
 */
 /*!
@@ -149,7 +161,7 @@ QT_BEGIN_NAMESPACE
 */
 namespace QKnxPrivate
 {
-    static void clearTimer(QTimer **timer)
+    static void clearTimer(QKnxTimer **timer)
     {
         if (*timer) {
             (*timer)->stop();
@@ -179,15 +191,15 @@ void QKnxNetIpEndpointConnectionPrivate::setupTimer()
     QKnxPrivate::clearTimer(&m_acknowledgeTimer);
 
     Q_Q(QKnxNetIpEndpointConnection);
-    m_heartbeatTimer = new QTimer(q);
+    m_heartbeatTimer = new QKnxTimer(q);
     m_heartbeatTimer->setSingleShot(true);
-    QObject::connect(m_heartbeatTimer, &QTimer::timeout, [&]() {
+    QObject::connect(m_heartbeatTimer, &QKnxTimer::timeout, [&]() {
         sendStateRequest();
     });
 
-    m_connectRequestTimer = new QTimer(q);
+    m_connectRequestTimer = new QKnxTimer(q);
     m_connectRequestTimer->setSingleShot(true);
-    QObject::connect(m_connectRequestTimer, &QTimer::timeout, [&]() {
+    QObject::connect(m_connectRequestTimer, &QKnxTimer::timeout, [&]() {
         setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Bound);
         setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Acknowledge,
             QKnxNetIpEndpointConnection::tr("Connect request timeout."));
@@ -196,9 +208,9 @@ void QKnxNetIpEndpointConnectionPrivate::setupTimer()
         q->disconnectFromHost();
     });
 
-    m_connectionStateTimer = new QTimer(q);
+    m_connectionStateTimer = new QKnxTimer(q);
     m_connectionStateTimer->setSingleShot(true);
-    QObject::connect(m_connectionStateTimer, &QTimer::timeout, [&]() {
+    QObject::connect(m_connectionStateTimer, &QKnxTimer::timeout, [&]() {
         m_heartbeatTimer->stop();
         m_connectionStateTimer->stop();
         if (m_stateRequests > m_maxStateRequests) {
@@ -212,18 +224,18 @@ void QKnxNetIpEndpointConnectionPrivate::setupTimer()
         }
     });
 
-    m_disconnectRequestTimer = new QTimer(q);
+    m_disconnectRequestTimer = new QKnxTimer(q);
     m_disconnectRequestTimer->setSingleShot(true);
-    QObject::connect(m_disconnectRequestTimer, &QTimer::timeout, [&] () {
+    QObject::connect(m_disconnectRequestTimer, &QKnxTimer::timeout, [&] () {
         setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Acknowledge,
             QKnxNetIpEndpointConnection::tr("Disconnect request timeout."));
         processDisconnectResponse(QKnxNetIpDisconnectResponseProxy::builder()
             .setChannelId(m_channelId).setStatus(QKnxNetIp::Error::None).create());
     });
 
-    m_acknowledgeTimer = new QTimer(q);
+    m_acknowledgeTimer = new QKnxTimer(q);
     m_acknowledgeTimer->setSingleShot(true);
-    QObject::connect(m_acknowledgeTimer, &QTimer::timeout, [&]() {
+    QObject::connect(m_acknowledgeTimer, &QKnxTimer::timeout, [&]() {
         if (m_cemiRequests > m_maxCemiRequest) {
             setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Cemi,
                 QKnxNetIpEndpointConnection::tr("Did not receive acknowledge in time."));
@@ -245,15 +257,90 @@ namespace QKnxPrivate
     }
 }
 
-void QKnxNetIpEndpointConnectionPrivate::processReceivedFrame(const QHostAddress &address, int port)
+void QKnxNetIpEndpointConnectionPrivate::setupServiceHandlers()
 {
-    const auto frame = QKnxNetIpFrame::fromBytes(m_rxBuffer);
-    if (!frame.isValid())
-        return;
+    using Type = QKnxNetIp::ServiceType;
+    auto add = [this](Type type, void (QKnxNetIpEndpointConnectionPrivate::*process)
+        (const QKnxNetIpFrame &)) {
+            m_dispatcher.registerBuiltInHandler(type, [this, process](const QKnxNetIpFrame &f) {
+                (this->*process)(f);
+            });
+    };
+
+    add(Type::ConnectResponse, &QKnxNetIpEndpointConnectionPrivate::processConnectResponse);
+    add(Type::ConnectionStateResponse,
+        &QKnxNetIpEndpointConnectionPrivate::processConnectionStateResponse);
+    add(Type::DisconnectRequest, &QKnxNetIpEndpointConnectionPrivate::processDisconnectRequest);
+    add(Type::DisconnectResponse, &QKnxNetIpEndpointConnectionPrivate::processDisconnectResponse);
+
+    add(Type::TunnelingRequest, &QKnxNetIpEndpointConnectionPrivate::processTunnelingRequest);
+    add(Type::TunnelingAcknowledge,
+        &QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge);
+
+    add(Type::DeviceConfigurationRequest,
+        &QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationRequest);
+    add(Type::DeviceConfigurationAcknowledge,
+        &QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationAcknowledge);
+
+    add(Type::TunnelingFeatureInfo, &QKnxNetIpEndpointConnectionPrivate::processFeatureFrame);
+    add(Type::TunnelingFeatureResponse, &QKnxNetIpEndpointConnectionPrivate::processFeatureFrame);
+
+    add(Type::SessionResponse, &QKnxNetIpEndpointConnectionPrivate::processSessionResponse);
+    add(Type::SessionStatus, &QKnxNetIpEndpointConnectionPrivate::processSessionStatus);
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::processReceivedFrame(const quint8 *data, int size,
+    int *consumed, const QHostAddress &address, int port)
+{
+    // validate the headers straight from the received bytes, so that invalid,
+    // foreign or unhandled frames are dropped before anything gets copied
+    *consumed = 0;
+    const auto peek = QKnxNetIpFramePeek::peek(data, size);
+    if (peek.status == QKnxNetIpFramePeek::Status::Incomplete)
+        return false; // wait for more data
+    if (peek.status == QKnxNetIpFramePeek::Status::Invalid) {
+        *consumed = size; // there is no way to find the start of the next frame
+        return false;
+    }
+    *consumed = peek.totalSize;
+
+    if (m_secureSession) {
+        if (peek.serviceType == QKnxNetIp::ServiceType::SecureWrapper)
+            return processSecureWrapper(data, peek.totalSize, address, port);
 
-    // remove already processed KNX frame from buffer
-    m_rxBuffer.remove(0, frame.size());
+        // the session response is the only frame the server sends unencrypted, a
+        // session status is only trusted once its secure wrapper passed authentication
+        if (peek.serviceType != QKnxNetIp::ServiceType::SessionResponse) {
+            qDebug() << "Dropped unencrypted frame on secure connection:" << peek.serviceType;
+            return false;
+        }
+    } else if (m_keyDerivationWatcher) {
+        qDebug() << "Dropped frame received before the secure session was set up.";
+        return false;
+    }
+
+    const bool foreignChannel = peek.hasChannelId && m_channelId >= 0
+        && peek.channelId != m_channelId;
+    if (foreignChannel || !m_dispatcher.contains(peek.serviceType))
+        return false;
+
+    const auto frame = peek.createFrame(data);
+    if (frame.isNull())
+        return false;
+    dispatchFrame(frame, address, port);
+    return true;
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::processDatagram(const quint8 *data, int size,
+    const QHostAddress &address, int port)
+{
+    int consumed = 0; // a frame never continues in the next datagram
+    return processReceivedFrame(data, size, &consumed, address, port);
+}
 
+void QKnxNetIpEndpointConnectionPrivate::dispatchFrame(const QKnxNetIpFrame &frame,
+    const QHostAddress &address, int port)
+{
     // TODO: fix the version and validity checks
     // if (!m_supportedVersions.contains(header.protocolVersion())) {
     //     send E_VERSION_NOT_SUPPORTED confirmation frame
@@ -263,48 +350,15 @@ void QKnxNetIpEndpointConnectionPrivate::processReceivedFrame(const QHostAddress
     // } else {
     // TODO: set the m_dataEndpointVersion once we receive or send the first frame
 
-    switch (frame.serviceType()) {
-    case QKnxNetIp::ServiceType::ConnectResponse:
-        if (m_nat) { // TODO: Review this for TCP connections
-            if (QKnxPrivate::isNullOrLocal(m_remoteDataEndpoint.address)
-                || m_remoteDataEndpoint.port == 0) {
-                    m_remoteDataEndpoint.port = port;
-                    m_remoteDataEndpoint.address = address;
-            }
+    if (frame.serviceType() == QKnxNetIp::ServiceType::ConnectResponse && m_nat) {
+        // TODO: Review this for TCP connections
+        if (QKnxPrivate::isNullOrLocal(m_remoteDataEndpoint.address)
+            || m_remoteDataEndpoint.port == 0) {
+                m_remoteDataEndpoint.port = port;
+                m_remoteDataEndpoint.address = address;
         }
-        processConnectResponse(frame);
-        break;
-    case QKnxNetIp::ServiceType::ConnectionStateResponse:
-        processConnectionStateResponse(frame);
-        break;
-    case QKnxNetIp::ServiceType::DisconnectRequest:
-        processDisconnectRequest(frame);
-        break;
-    case QKnxNetIp::ServiceType::DisconnectResponse:
-        processDisconnectResponse(frame);
-        break;
-
-    case QKnxNetIp::ServiceType::TunnelingRequest:
-        processTunnelingRequest(frame);
-        break;
-    case QKnxNetIp::ServiceType::TunnelingAcknowledge:
-        processTunnelingAcknowledge(frame);
-        break;
-
-    case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
-        processDeviceConfigurationRequest(frame);
-        break;
-    case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
-        processDeviceConfigurationAcknowledge(frame);
-        break;
-
-    case QKnxNetIp::ServiceType::TunnelingFeatureInfo:
-    case QKnxNetIp::ServiceType::TunnelingFeatureResponse:
-        processFeatureFrame(frame);
-        break;
-    default:
-        break;
     }
+    m_dispatcher.dispatch(frame);
 }
 
 void QKnxNetIpEndpointConnectionPrivate::setup()
@@ -330,15 +384,16 @@ void QKnxNetIpEndpointConnectionPrivate::setup()
     if (m_tcpSocket) {
         QObject::connect(m_tcpSocket, &QIODevice::readyRead, [&]() {
             m_rxBuffer += QKnxByteArray::fromByteArray(m_tcpSocket->readAll());
-            int bufferSize = m_rxBuffer.size();
-            bool continueProcessingRxBuffer = false;
-            do {
+            forever {
                 // TODO: AN184 v03 KNXnet-IP Core v2 AS, 2.2.3.2.3.2
-                processReceivedFrame(m_remoteControlEndpoint.address,
-                                m_remoteControlEndpoint.port);
-                continueProcessingRxBuffer = (m_rxBuffer.size() < bufferSize);
-                bufferSize = m_rxBuffer.size();
-            } while (continueProcessingRxBuffer);
+                int consumed = 0;
+                processReceivedFrame(m_rxBuffer.constData(), m_rxBuffer.size(), &consumed,
+                    m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
+                if (consumed == 0)
+                    break;
+                // the handler might have cleared the buffer, removing is still safe
+                m_rxBuffer.remove(0, consumed);
+            }
         });
 
         using overload = void (QTcpSocket::*)(QTcpSocket::SocketError);
@@ -354,9 +409,10 @@ void QKnxNetIpEndpointConnectionPrivate::setup()
         QObject::connect(m_udpSocket, &QUdpSocket::readyRead, [&]() {
             while (m_udpSocket && m_udpSocket->state() == QUdpSocket::BoundState
                 && m_udpSocket->hasPendingDatagrams()) {
-                auto datagram = m_udpSocket->receiveDatagram();
-                m_rxBuffer += QKnxByteArray::fromByteArray(datagram.data());
-                processReceivedFrame(datagram.senderAddress(), datagram.senderPort());
+                const auto datagram = m_udpSocket->receiveDatagram();
+                const auto data = datagram.data();
+                processDatagram(reinterpret_cast<const quint8 *> (data.constData()), data.size(),
+                    datagram.senderAddress(), datagram.senderPort());
             }
         });
 
@@ -380,13 +436,16 @@ void QKnxNetIpEndpointConnectionPrivate::cleanup()
     QKnxPrivate::clearTimer(&m_disconnectRequestTimer);
     QKnxPrivate::clearTimer(&m_acknowledgeTimer);
 
+    clearSecureSession();
+
     if (m_udpSocket) {
         m_udpSocket->close();
         QKnxPrivate::clearSocket(&m_udpSocket);
-    } else {
+    } else if (m_tcpSocket) {
         m_tcpSocket->close();
         QKnxPrivate::clearSocket(&m_tcpSocket);
     }
+    detachTransport();
 
     setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
 }
@@ -395,14 +454,12 @@ bool QKnxNetIpEndpointConnectionPrivate::sendCemiRequest()
 {
     if (!m_waitForAcknowledgement && !m_tcpSocket) {
         m_waitForAcknowledgement = true;
-        m_udpSocket->writeDatagram(m_lastSendCemiRequest.bytes().toByteArray(),
-                                m_remoteDataEndpoint.address,
-                                m_remoteDataEndpoint.port);
+        writeFrame(m_lastSendCemiRequest, m_remoteDataEndpoint);
 
         m_cemiRequests++;
         m_acknowledgeTimer->start(m_acknowledgeTimeout);
     } else if (m_tcpSocket) {
-        m_tcpSocket->write(m_lastSendCemiRequest.bytes().toByteArray());
+        writeFrame(m_lastSendCemiRequest, m_remoteDataEndpoint);
         m_waitForAcknowledgement = false;
     }
     return !m_waitForAcknowledgement;
@@ -413,17 +470,75 @@ void QKnxNetIpEndpointConnectionPrivate::sendStateRequest()
     qDebug().noquote().nospace() << "Sending connection state request: 0x" << m_lastStateRequest
         .bytes().toHex();
 
-    if (m_tcpSocket) {
-        m_tcpSocket->write(m_lastStateRequest.bytes().toByteArray());
-    } else {
-        m_udpSocket->writeDatagram(m_lastStateRequest.bytes().toByteArray(),
-            m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
-    }
+    writeFrame(m_lastStateRequest, m_remoteControlEndpoint);
 
     m_stateRequests++;
     m_connectionStateTimer->start(QKnxNetIp::ConnectionStateRequestTimeout);
 }
 
+void QKnxNetIpEndpointConnectionPrivate::sendConnectRequest()
+{
+    auto request = QKnxNetIpConnectRequestProxy::builder()
+        .setControlEndpoint(m_nat ? m_natEndpoint : m_localEndpoint)
+        .setDataEndpoint(m_nat ? m_natEndpoint : m_localEndpoint)
+        .setRequestInformation(m_cri)
+        .create();
+    m_controlEndpointVersion = request.header().protocolVersion();
+
+    qDebug() << "Sending connect request:" << request;
+    writeFrame(request, m_remoteControlEndpoint);
+}
+
+qint64 QKnxNetIpEndpointConnectionPrivate::writeFrame(const QKnxNetIpFrame &frame,
+    const Endpoint &endpoint)
+{
+    // serialize into the reused send buffer, it only grows and is never shrunk
+    const auto size = frame.serializedSize();
+    if (m_txBuffer.size() < size)
+        m_txBuffer.resize(size);
+
+    const auto written = frame.serializeInto(reinterpret_cast<quint8 *> (m_txBuffer.data()),
+        size_t(m_txBuffer.size()));
+    if (written == 0)
+        return -1;
+
+    if (m_secureSession)
+        return writeSecureFrame(int(written));
+    if (m_tcpSocket)
+        return m_tcpSocket->write(m_txBuffer.constData(), written);
+    if (m_transportAttached) {
+        return m_transport->writeDatagram(this, m_txBuffer.constData(), written,
+            endpoint.address, endpoint.port);
+    }
+    if (m_udpSocket)
+        return m_udpSocket->writeDatagram(m_txBuffer.constData(), written, endpoint.address,
+            endpoint.port);
+    return -1;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::detachTransport()
+{
+    if (m_transportAttached && m_transport)
+        m_transport->detach(this);
+    m_transportAttached = false;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processTransportClosed()
+{
+    detachTransport();
+    setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+        QKnxNetIpEndpointConnection::tr("The shared transport was closed."));
+    cleanup();
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processTransportError(const QString &errorString)
+{
+    setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network, errorString);
+
+    Q_Q(QKnxNetIpEndpointConnection);
+    q->disconnectFromHost();
+}
+
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLinkLayerFrame &)
 {}
 
@@ -434,9 +549,8 @@ void QKnxNetIpEndpointConnectionPrivate::processTunnelingRequest(const QKnxNetIp
 {
     qDebug() << "Received tunneling request:" << frame;
 
-    QKnxNetIpTunnelingRequestProxy request(frame);
     if (m_tcpSocket) {
-        process(request.cemi());
+        processTunnelingCemi(frame);
         return; // no need to send ACK in TCP connection
     }
 
@@ -452,20 +566,31 @@ void QKnxNetIpEndpointConnectionPrivate::processTunnelingRequest(const QKnxNetIp
                     .create();
 
                 qDebug() << "Sending tunneling acknowledge:" << ack;
-                m_udpSocket->writeDatagram(ack.bytes().toByteArray(),
-                    m_remoteDataEndpoint.address, m_remoteDataEndpoint.port);
+                writeFrame(ack, m_remoteDataEndpoint);
 
-                if (!counterEquals)
+                if (!counterEquals) {
+                    ++m_discardedFrames; // repeated request, already processed
                     return;
+                }
                 m_receiveCount++;
-                process(request.cemi());
+                processTunnelingCemi(frame);
+        } else {
+            qDebug() << "Frame was ignored due to wrong sequence number. Expected:"
+                << m_receiveCount << "Current:" << frame.sequenceNumber();
+            ++m_discardedFrames;
         }
     } else {
         qDebug() << "Request was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << frame.channelId();
+        ++m_discardedFrames;
     }
 }
 
+void QKnxNetIpEndpointConnectionPrivate::processTunnelingCemi(const QKnxNetIpFrame &frame)
+{
+    process(QKnxNetIpTunnelingRequestProxy(frame).cemi());
+}
+
 void QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge(const QKnxNetIpFrame &frame)
 {
     qDebug() << "Received tunneling acknowledge:" << frame;
@@ -485,6 +610,7 @@ void QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge(const QKnxN
     } else {
         qDebug() << "Acknowledge was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << frame.channelId();
+        ++m_discardedFrames;
     }
 }
 
@@ -513,12 +639,14 @@ void QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationRequest(const
     if (frame.channelId() != m_channelId) {
         qDebug() << "Request was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << frame.channelId();
+        ++m_discardedFrames;
         return;
     }
 
     if (request.sequenceNumber() != m_receiveCount) {
         qDebug() << "Request was ignored due to wrong sequence number. Expected:" << m_receiveCount
             << "Current:" << request.sequenceNumber();
+        ++m_discardedFrames;
         return;
     }
 
@@ -529,8 +657,7 @@ void QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationRequest(const
         .create();
 
     qDebug() << "Sending device configuration acknowledge:" << ack;
-    m_udpSocket->writeDatagram(ack.bytes().toByteArray(),
-        m_remoteDataEndpoint.address, m_remoteDataEndpoint.port);
+    writeFrame(ack, m_remoteDataEndpoint);
 
     m_receiveCount++;
     if (m_waitForAcknowledgement)
@@ -561,6 +688,7 @@ void QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationAcknowledge(c
     } else {
         qDebug() << "Acknowledge was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << frame.channelId();
+        ++m_discardedFrames;
     }
 }
 
@@ -623,17 +751,23 @@ void QKnxNetIpEndpointConnectionPrivate::processFeatureFrame(const QKnxNetIpFram
                     .create();
 
                 qDebug() << "Sending tunneling acknowledge:" << ack;
-                m_udpSocket->writeDatagram(ack.bytes().toByteArray(),
-                    m_remoteDataEndpoint.address, m_remoteDataEndpoint.port);
+                writeFrame(ack, m_remoteDataEndpoint);
 
-                if (!counterEquals)
+                if (!counterEquals) {
+                    ++m_discardedFrames; // repeated request, already processed
                     return;
+                }
                 m_receiveCount++;
                 processTunnelingFeatureFrame(frame);
+        } else {
+            qDebug() << "Frame was ignored due to wrong sequence number. Expected:"
+                << m_receiveCount << "Current:" << frame.sequenceNumber();
+            ++m_discardedFrames;
         }
     } else {
         qDebug() << "Frame was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << frame.channelId();
+        ++m_discardedFrames;
     }
 }
 
@@ -690,6 +824,7 @@ void QKnxNetIpEndpointConnectionPrivate::processConnectionStateResponse(const QK
     } else {
         qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << response.channelId();
+        ++m_discardedFrames;
     }
 }
 
@@ -704,18 +839,14 @@ void QKnxNetIpEndpointConnectionPrivate::processDisconnectRequest(const QKnxNetI
             .setStatus(QKnxNetIp::Error::None)
             .create();
         qDebug() << "Sending disconnect response:" << frame;
-        if (m_tcpSocket) {
-            m_tcpSocket->write(frame.bytes().toByteArray());
-        } else {
-            m_udpSocket->writeDatagram(frame.bytes().toByteArray(),
-                                    m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
-        }
+        writeFrame(frame, m_remoteControlEndpoint);
 
         Q_Q(QKnxNetIpEndpointConnection);
         q->disconnectFromHost();
     } else {
         qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << request.channelId();
+        ++m_discardedFrames;
     }
 }
 
@@ -729,9 +860,268 @@ void QKnxNetIpEndpointConnectionPrivate::processDisconnectResponse(const QKnxNet
     } else {
         qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
             << "Current:" << response.channelId();
+        ++m_discardedFrames;
     }
 }
 
+#if QT_CONFIG(opensslv11)
+
+QKnxNetIpEndpointConnectionPrivate::~QKnxNetIpEndpointConnectionPrivate()
+{
+    detachTransport();
+    delete m_secureSession;
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::setupSecureSession()
+{
+    clearSecureSession();
+    if (!m_secureConfiguration.isValid())
+        return false;
+
+    // derive both hashes on the thread pool, they are served from the derived
+    // key cache on reconnect and the futures are finished right away then
+    m_userPasswordHash =
+        QKnxCryptographicEngine::userPasswordHashAsync(m_secureConfiguration.userPassword());
+    const auto code = m_secureConfiguration.deviceAuthenticationCode();
+    if (!code.isEmpty())
+        m_deviceAuthenticationCodeHash =
+            QKnxCryptographicEngine::deviceAuthenticationCodeHashAsync(code);
+
+    Q_Q(QKnxNetIpEndpointConnection);
+    m_keyDerivationWatcher = new QFutureWatcher<QKnxByteArray>(q);
+    QObject::connect(m_keyDerivationWatcher, &QFutureWatcherBase::finished, q, [this]() {
+        continueSecureSession();
+    });
+    return true;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::continueSecureSession()
+{
+    if (!m_keyDerivationWatcher)
+        return;
+
+    for (const auto &future : { m_userPasswordHash, m_deviceAuthenticationCodeHash }) {
+        if (!future.isFinished()) {
+            m_keyDerivationWatcher->setFuture(future);
+            return;
+        }
+    }
+
+    const auto passwordHash = m_userPasswordHash.resultCount() > 0
+        ? m_userPasswordHash.result() : QKnxByteArray();
+    const bool needsDeviceCode = !m_secureConfiguration.deviceAuthenticationCode().isEmpty();
+    const auto deviceAuthenticationCode = m_deviceAuthenticationCodeHash.resultCount() > 0
+        ? m_deviceAuthenticationCodeHash.result() : QKnxByteArray();
+    clearKeyDerivation();
+
+    if (!passwordHash.isEmpty() && (!needsDeviceCode || !deviceAuthenticationCode.isEmpty())) {
+        m_secureSession = new QKnxNetIpSecureSession(m_secureConfiguration.userId(),
+            passwordHash, deviceAuthenticationCode, m_secureConfiguration.serialNumber());
+        if (!m_secureSession->publicKey().isValid())
+            clearSecureSession();
+    }
+
+    if (!m_secureSession) {
+        setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::SecureSession,
+            QKnxNetIpEndpointConnection::tr("Could not derive the secure session keys."));
+
+        Q_Q(QKnxNetIpEndpointConnection);
+        q->disconnectFromHost();
+        return;
+    }
+
+    // otherwise the session request is sent once the socket is connected
+    if (m_tcpSocket && m_tcpSocket->state() == QAbstractSocket::ConnectedState)
+        sendSessionRequest();
+}
+
+void QKnxNetIpEndpointConnectionPrivate::clearKeyDerivation()
+{
+    if (m_keyDerivationWatcher) {
+        m_keyDerivationWatcher->disconnect();
+        m_keyDerivationWatcher->deleteLater();
+        m_keyDerivationWatcher = nullptr;
+    }
+    m_userPasswordHash = {};
+    m_deviceAuthenticationCodeHash = {};
+}
+
+void QKnxNetIpEndpointConnectionPrivate::clearSecureSession()
+{
+    clearKeyDerivation();
+    if (!m_secureSession)
+        return;
+
+    if (m_secureSession->state() == QKnxNetIpSecureSession::State::Authenticated && m_tcpSocket
+        && m_tcpSocket->state() == QAbstractSocket::ConnectedState) {
+            auto frame = QKnxNetIpSessionStatusProxy::builder()
+                .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+                .create();
+            qDebug() << "Sending session status:" << frame;
+            writeFrame(frame, m_remoteControlEndpoint);
+    }
+
+    delete m_secureSession;
+    m_secureSession = nullptr;
+    m_secureTxBuffer.fill(0x00);
+    m_secureRxBuffer.fill(0x00);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::sendSessionRequest()
+{
+    auto request = m_secureSession->createSessionRequest(m_nat ? m_natEndpoint : m_localEndpoint);
+    qDebug() << "Sending session request:" << request;
+
+    // the server answers and authenticates within the connect request timeout
+    m_connectRequestTimer->start(QKnxNetIp::ConnectRequestTimeout);
+    writeFrame(request, m_remoteControlEndpoint);
+}
+
+qint64 QKnxNetIpEndpointConnectionPrivate::writeSecureFrame(int size)
+{
+    if (!m_tcpSocket)
+        return -1;
+
+    // the session request is the only frame sent before the session key is known
+    if (!m_secureSession->hasSessionKey())
+        return m_tcpSocket->write(m_txBuffer.constData(), size);
+
+    const auto wrapped = m_secureSession->wrap(reinterpret_cast<const quint8 *>
+        (m_txBuffer.constData()), size, &m_secureTxBuffer);
+    if (wrapped < 0)
+        return -1;
+    return m_tcpSocket->write(m_secureTxBuffer.constData(), wrapped);
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::processSecureWrapper(const quint8 *data, int size,
+    const QHostAddress &address, int port)
+{
+    // decrypt straight from the received bytes into the reused secure buffer
+    const auto unwrapped = m_secureSession->unwrap(data, size, &m_secureRxBuffer);
+    if (unwrapped < 0) {
+        qDebug() << "Dropped secure wrapper frame that failed to authenticate.";
+        return false;
+    }
+
+    const auto peek = QKnxNetIpFramePeek::peek(m_secureRxBuffer);
+    if (peek.status != QKnxNetIpFramePeek::Status::Valid || peek.totalSize != unwrapped
+        || peek.serviceType == QKnxNetIp::ServiceType::SecureWrapper) {
+            return false;
+    }
+
+    const bool foreignChannel = peek.hasChannelId && m_channelId >= 0
+        && peek.channelId != m_channelId;
+    if (foreignChannel || !m_dispatcher.contains(peek.serviceType))
+        return false;
+
+    const auto frame = peek.createFrame(m_secureRxBuffer.constData());
+    if (frame.isNull())
+        return false;
+    dispatchFrame(frame, address, port);
+    return true;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processSessionResponse(const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session response:" << frame;
+
+    if (!m_secureSession
+        || m_secureSession->state() != QKnxNetIpSecureSession::State::Requested) {
+            qDebug() << "Response was ignored due to current secure session state.";
+            return;
+    }
+
+    const auto authenticate = m_secureSession->processSessionResponse(frame);
+    if (!authenticate.isValid()) {
+        setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::SecureSession,
+            QKnxNetIpEndpointConnection::tr("Could not verify the secure session response."));
+
+        Q_Q(QKnxNetIpEndpointConnection);
+        q->disconnectFromHost();
+        return;
+    }
+
+    qDebug() << "Sending session authenticate:" << authenticate;
+    writeFrame(authenticate, m_remoteControlEndpoint);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processSessionStatus(const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session status:" << frame;
+
+    if (!m_secureSession) {
+        qDebug() << "Status was ignored, there is no secure session.";
+        return;
+    }
+
+    const auto status = m_secureSession->processSessionStatus(frame);
+    if (status == QKnxNetIp::SecureSessionStatus::KeepAlive)
+        return;
+
+    if (status == QKnxNetIp::SecureSessionStatus::AuthenticationSuccess) {
+        if (m_state == QKnxNetIpEndpointConnection::State::Connecting && m_channelId < 0)
+            sendConnectRequest();
+        return;
+    }
+
+    auto metaEnum = QMetaEnum::fromType<QKnxNetIp::SecureSessionStatus>();
+    setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::SecureSession,
+        QKnxNetIpEndpointConnection::tr("Secure session closed. Status code: 0x%1 (%2)")
+            .arg(quint8(status), 2, 16, QLatin1Char('0'))
+            .arg(QString::fromLatin1(metaEnum.valueToKey(int(status)))));
+
+    // the session key is gone, nothing can be sent to the server anymore
+    setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnecting);
+    cleanup();
+}
+
+#else
+
+QKnxNetIpEndpointConnectionPrivate::~QKnxNetIpEndpointConnectionPrivate()
+{
+    detachTransport();
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::setupSecureSession()
+{
+    return false;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::continueSecureSession()
+{}
+
+void QKnxNetIpEndpointConnectionPrivate::clearKeyDerivation()
+{}
+
+void QKnxNetIpEndpointConnectionPrivate::clearSecureSession()
+{}
+
+void QKnxNetIpEndpointConnectionPrivate::sendSessionRequest()
+{}
+
+qint64 QKnxNetIpEndpointConnectionPrivate::writeSecureFrame(int)
+{
+    return -1;
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::processSecureWrapper(const quint8 *, int,
+    const QHostAddress &, int)
+{
+    return false;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processSessionResponse(const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session response:" << frame << "Secure sessions are not supported.";
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processSessionStatus(const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session status:" << frame << "Secure sessions are not supported.";
+}
+
+#endif
+
 void QKnxNetIpEndpointConnectionPrivate::setAndEmitStateChanged(
     QKnxNetIpEndpointConnection::State newState)
 {
@@ -913,6 +1303,39 @@ void QKnxNetIpEndpointConnection::setSupportedProtocolVersions(const QKnxByteArr
     d->m_user.supportedVersions = versions;
 }
 
+/*!
+    \since 5.13
+
+    Returns the shared transport used by the connection, or \c nullptr if the
+    connection binds its own socket.
+
+    \sa setTransport()
+*/
+QKnxNetIpSharedTransport *QKnxNetIpEndpointConnection::transport() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_transport.data();
+}
+
+/*!
+    \since 5.13
+
+    Sets the shared transport \a transport to be used by UDP connections
+    instead of binding an own socket. The local address and port of the
+    connection are those of the transport. Passing \c nullptr restores the
+    default behavior.
+
+    The transport can only be changed while the connection is disconnected.
+
+    \sa QKnxNetIpSharedTransport
+*/
+void QKnxNetIpEndpointConnection::setTransport(QKnxNetIpSharedTransport *transport)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    if (d->m_state == State::Disconnected)
+        d->m_transport = transport;
+}
+
 /*!
     Establishes a connection to the KNXnet/IP control endpoint \a controlEndpoint.
 */
@@ -953,16 +1376,30 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
 
     QKnxPrivate::clearSocket(&(d->m_udpSocket));
 
-    d->m_udpSocket = new QUdpSocket(this);
-    if (!d->m_udpSocket->bind(d->m_user.address, d->m_user.port)) {
-        d->setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
-            QKnxNetIpEndpointConnection::tr("Could not bind endpoint: %1")
-                .arg(d->m_udpSocket->errorString()));
-        QKnxPrivate::clearSocket(&d->m_udpSocket);
-        d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
-        return;
+    if (d->m_transport) {
+        if (!d->m_transport->isBound()) {
+            d->setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                QKnxNetIpEndpointConnection::tr("The shared transport is not bound."));
+            d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
+            return;
+        }
+        d->m_transport->attach(d);
+        d->m_transportAttached = true;
+        d->m_localEndpoint = Endpoint(d->m_transport->localAddress(),
+            d->m_transport->localPort());
+    } else {
+        d->m_udpSocket = new QUdpSocket(this);
+        if (!d->m_udpSocket->bind(d->m_user.address, d->m_user.port)) {
+            d->setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                QKnxNetIpEndpointConnection::tr("Could not bind endpoint: %1")
+                    .arg(d->m_udpSocket->errorString()));
+            QKnxPrivate::clearSocket(&d->m_udpSocket);
+            d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
+            return;
+        }
+        d->m_localEndpoint = Endpoint(d->m_udpSocket->localAddress(),
+            d->m_udpSocket->localPort());
     }
-    d->m_localEndpoint = Endpoint(d->m_udpSocket->localAddress(), d->m_udpSocket->localPort());
 
     d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Bound);
 
@@ -970,19 +1407,8 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
 
     d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Connecting);
 
-    auto request = QKnxNetIpConnectRequestProxy::builder()
-        .setControlEndpoint(d->m_nat ? d->m_natEndpoint : d->m_localEndpoint)
-        .setDataEndpoint(d->m_nat ? d->m_natEndpoint : d->m_localEndpoint)
-        .setRequestInformation(d->m_cri)
-        .create();
-    d->m_controlEndpointVersion = request.header().protocolVersion();
-
-    qDebug() << "Sending connect request:" << request;
-
     d->m_connectRequestTimer->start(QKnxNetIp::ConnectRequestTimeout);
-
-    d->m_udpSocket->writeDatagram(request.bytes().toByteArray(),
-        d->m_remoteControlEndpoint.address, d->m_remoteControlEndpoint.port);
+    d->sendConnectRequest();
 }
 
 /*!
@@ -1044,20 +1470,91 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
 
     connect(d->m_tcpSocket, &QTcpSocket::connected, this, [&]() {
         Q_D(QKnxNetIpEndpointConnection);
-        auto request = QKnxNetIpConnectRequestProxy::builder()
-            .setControlEndpoint(d->m_nat ? d->m_natEndpoint : d->m_localEndpoint)
-            .setDataEndpoint(d->m_nat ? d->m_natEndpoint : d->m_localEndpoint)
-            .setRequestInformation(d->m_cri)
-            .create();
-        d->m_controlEndpointVersion = request.header().protocolVersion();
-
-        qDebug() << "Sending connect request:" << request;
-        d->m_tcpSocket->write(request.bytes().toByteArray());
+        if (d->m_secureSession)
+            d->sendSessionRequest(); // the connect request follows the authentication
+        else if (!d->m_keyDerivationWatcher)
+            d->sendConnectRequest(); // otherwise the session request follows the keys
     });
 
     // TODO: Implement connect request timeout.
 }
 
+/*!
+    \since 5.13
+
+    Returns the credentials used to establish secure connections.
+
+    \sa connectToHostEncrypted()
+*/
+QKnxNetIpSecureConfiguration QKnxNetIpEndpointConnection::secureConfiguration() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_secureConfiguration;
+}
+
+/*!
+    \since 5.13
+
+    Sets the credentials used to establish secure connections to
+    \a configuration. The configuration is used the next time
+    connectToHostEncrypted() is called.
+
+    Setting a valid configuration starts generating the key pairs used by
+    secure sessions in the background, so that establishing the session does
+    not have to wait for it.
+*/
+void QKnxNetIpEndpointConnection::setSecureConfiguration(
+    const QKnxNetIpSecureConfiguration &configuration)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_secureConfiguration = configuration;
+#if QT_CONFIG(opensslv11)
+    if (configuration.isValid())
+        QKnxCurve25519KeyPool::instance()->refill();
+#endif
+}
+
+/*!
+    \since 5.13
+
+    Establishes a secure connection over TCP to the host with \a address and
+    \a port, using the credentials set with setSecureConfiguration().
+
+    A KNXnet/IP secure session is set up with the server first. Once the
+    session is authenticated, the connection is established and every frame
+    exchanged with the server is sent wrapped into a secure wrapper frame.
+    Frames that fail authentication, are replayed, or are not encrypted are
+    dropped.
+
+    The session key is set up once per connection and kept for its lifetime,
+    so encrypting and decrypting a frame does not repeat any key setup. The
+    password hashes are derived on the global thread pool while the socket
+    connects, so calling this function does not block the caller's thread.
+
+    If the secure configuration is invalid or OpenSSL is not available, the
+    errorOccurred() signal is emitted with
+    \l {QKnxNetIpEndpointConnection::Error}{Error::SecureSession}.
+*/
+void QKnxNetIpEndpointConnection::connectToHostEncrypted(const QHostAddress &address,
+    quint16 port)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    if (d->m_state != State::Disconnected)
+        return;
+
+    if (!d->setupSecureSession()) {
+        d->setAndEmitErrorOccurred(Error::SecureSession, tr("Could not set up a secure session. "
+            "Check the secure configuration and the availability of OpenSSL."));
+        return;
+    }
+
+    connectToHost(address, port, QKnxNetIp::HostProtocol::TCP_IPv4);
+    if (d->m_state == State::Disconnected)
+        d->clearSecureSession();
+    else
+        d->continueSecureSession(); // continues right away if the keys are cached
+}
+
 /*!
     Closes an established connection.
 */
@@ -1080,18 +1577,64 @@ void QKnxNetIpEndpointConnection::disconnectFromHost()
             .create();
 
         qDebug() << "Sending disconnect request:" << frame;
-        if (d->m_tcpSocket) {
-            d->m_tcpSocket->write(frame.bytes().toByteArray());
-        } else {
-            d->m_udpSocket->writeDatagram(frame.bytes().toByteArray(),
-                d->m_remoteControlEndpoint.address, d->m_remoteControlEndpoint.port);
-        }
+        d->writeFrame(frame, d->m_remoteControlEndpoint);
 
         d->m_disconnectRequestTimer->start(QKnxNetIp::DisconnectRequestTimeout);
         // Fully disconnected will be handled inside the private cleanup function.
     }
 }
 
+/*!
+    \typedef QKnxNetIpEndpointConnection::ServiceHandler
+    \since 5.13
+
+    A synonym for \c {std::function<void (const QKnxNetIpFrame &frame)>}, the
+    type of function invoked for incoming frames of a registered service type.
+*/
+
+/*!
+    \since 5.13
+
+    Registers \a handler to be invoked with every incoming KNXnet/IP frame of
+    the service type \a type. Returns \c true on success; otherwise returns
+    \c false.
+
+    Registering fails if \a handler is empty or the connection handles \a type
+    itself, for example
+    \l {QKnxNetIp::ServiceType}{QKnxNetIp::ServiceType::TunnelingRequest}.
+    An already registered handler for \a type is replaced. Any 16-bit service
+    type can be claimed, including vendor specific ones unknown to Qt KNX;
+    frames of such a type carry their body as data().
+
+    Frames are validated, and frames of unhandled service types or of other
+    communication channels are dropped, before a QKnxNetIpFrame is created.
+
+    \sa unregisterServiceHandler()
+*/
+bool QKnxNetIpEndpointConnection::registerServiceHandler(QKnxNetIp::ServiceType type,
+    const ServiceHandler &handler)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    return d->m_dispatcher.registerHandler(type, handler);
+}
+
+/*!
+    \since 5.13
+
+    Removes the handler registered for the service type \a type. Returns
+    \c true if a handler was removed; otherwise returns \c false.
+
+    Handlers for service types the connection handles itself cannot be
+    removed.
+
+    \sa registerServiceHandler()
+*/
+bool QKnxNetIpEndpointConnection::unregisterServiceHandler(QKnxNetIp::ServiceType type)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    return d->m_dispatcher.unregisterHandler(type);
+}
+
 QKnxNetIpEndpointConnection::QKnxNetIpEndpointConnection(QKnxNetIpEndpointConnectionPrivate &dd,
         QObject *parent)
     : QObject(dd, parent)
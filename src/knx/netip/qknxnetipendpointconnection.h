@@ -34,10 +34,15 @@
 #include <QtKnx/qknxnetipcri.h>
 #include <QtKnx/qknxnetiphpai.h>
 #include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
 #include <QtNetwork/qudpsocket.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+class QKnxNetIpSharedTransport;
+
 class QKnxNetIpEndpointConnectionPrivate;
 class Q_KNX_EXPORT QKnxNetIpEndpointConnection : public QObject
 {
@@ -67,6 +72,7 @@ public:
         Acknowledge,
         Heartbeat,
         Cemi,
+        SecureSession,
         Unknown = 0x80
     };
     Q_ENUM(Error)
@@ -107,12 +113,23 @@ public:
     QKnxByteArray supportedProtocolVersions() const;
     void setSupportedProtocolVersions(const QKnxByteArray &versions);
 
+    QKnxNetIpSharedTransport *transport() const;
+    void setTransport(QKnxNetIpSharedTransport *transport);
+
     void connectToHost(const QKnxNetIpHpai &controlEndpoint);
     void connectToHost(const QHostAddress &address, quint16 port);
     void connectToHost(const QHostAddress &address, quint16 port, QKnxNetIp::HostProtocol proto);
 
+    QKnxNetIpSecureConfiguration secureConfiguration() const;
+    void setSecureConfiguration(const QKnxNetIpSecureConfiguration &configuration);
+    void connectToHostEncrypted(const QHostAddress &address, quint16 port);
+
     void disconnectFromHost();
 
+    using ServiceHandler = std::function<void (const QKnxNetIpFrame &frame)>;
+    bool registerServiceHandler(QKnxNetIp::ServiceType type, const ServiceHandler &handler);
+    bool unregisterServiceHandler(QKnxNetIp::ServiceType type);
+
 protected:
     QKnxNetIpEndpointConnection(QKnxNetIpEndpointConnectionPrivate &dd, QObject *parent);
 
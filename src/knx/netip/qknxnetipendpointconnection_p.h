@@ -41,6 +41,8 @@
 // We mean it.
 //
 
+#include <QtCore/qfuturewatcher.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qtimer.h>
 #include <QtKnx/qknxaddress.h>
 #include <QtKnx/qtknxglobal.h>
@@ -48,6 +50,9 @@
 #include <QtNetwork/qhostaddress.h>
 #include <QtKnx/qknxdevicemanagementframe.h>
 #include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipsharedtransport.h>
+#include <QtKnx/private/qknxnetipservicedispatcher_p.h>
+#include <QtKnx/private/qknxtimer_p.h>
 
 #include <private/qobject_p.h>
 
@@ -59,6 +64,7 @@ class QKnxNetIpDeviceConfigurationAcknowledgeProxy;
 class QKnxNetIpDeviceConfigurationRequestProxy;
 class QKnxNetIpDisconnectRequestProxy;
 class QKnxNetIpDisconnectResponseProxy;
+class QKnxNetIpSecureSession;
 class QKnxNetIpTunnelingAcknowledgeProxy;
 class QKnxNetIpTunnelingRequestProxy;
 class QUdpSocket;
@@ -118,8 +124,10 @@ public:
         , m_localEndpoint { address, port }
         , m_maxCemiRequest(sendAttempts)
         , m_acknowledgeTimeout(ackTimeout)
-    {}
-    ~QKnxNetIpEndpointConnectionPrivate() override = default;
+    {
+        setupServiceHandlers();
+    }
+    ~QKnxNetIpEndpointConnectionPrivate() override;
 
     void setup();
     void setupTimer();
@@ -127,14 +135,22 @@ public:
 
     bool sendCemiRequest();
     void sendStateRequest();
+    void sendConnectRequest();
+
+    qint64 writeFrame(const QKnxNetIpFrame &frame, const Endpoint &endpoint);
 
-    void processReceivedFrame(const QHostAddress &address, int port);
+    void setupServiceHandlers();
+    bool processReceivedFrame(const quint8 *data, int size, int *consumed,
+        const QHostAddress &address, int port);
+    bool processDatagram(const quint8 *data, int size, const QHostAddress &address, int port);
+    void dispatchFrame(const QKnxNetIpFrame &frame, const QHostAddress &address, int port);
     virtual void process(const QKnxLinkLayerFrame &frame);
     virtual void process(const QKnxDeviceManagementFrame &frame);
 
     // datapoint related processing
     bool sendTunnelingRequest(const QKnxLinkLayerFrame &frame);
     virtual void processTunnelingRequest(const QKnxNetIpFrame &frame);
+    virtual void processTunnelingCemi(const QKnxNetIpFrame &frame);
     virtual void processTunnelingAcknowledge(const QKnxNetIpFrame &frame);
 
     bool sendDeviceConfigurationRequest(const QKnxDeviceManagementFrame &frame);
@@ -152,12 +168,35 @@ public:
     virtual void processDisconnectRequest(const QKnxNetIpFrame &frame);
     virtual void processDisconnectResponse(const QKnxNetIpFrame &frame);
 
+    // secure session related processing
+    bool setupSecureSession();
+    void continueSecureSession();
+    void clearKeyDerivation();
+    void clearSecureSession();
+    void sendSessionRequest();
+    qint64 writeSecureFrame(int size);
+    bool processSecureWrapper(const quint8 *data, int size, const QHostAddress &address,
+        int port);
+    virtual void processSessionResponse(const QKnxNetIpFrame &frame);
+    virtual void processSessionStatus(const QKnxNetIpFrame &frame);
+
+    // shared transport related processing
+    void detachTransport();
+    void processTransportClosed();
+    void processTransportError(const QString &errorString);
+
     void setAndEmitStateChanged(QKnxNetIpEndpointConnection::State newState);
     void setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error newError, const QString &message);
 
     void setCri(const QKnxNetIpCri &cri) { m_cri = cri; }
 
+    // received frames a handler ignored for a wrong channel or sequence number
+    quint64 discardedFrames() const { return m_discardedFrames; }
+
 private:
+    friend class QKnxNetIpSharedTransport;
+    friend class QKnxNetIpSharedTransportPrivate;
+
     QKnxNetIpCri m_cri;
     Endpoint m_remoteDataEndpoint;
     Endpoint m_remoteControlEndpoint;
@@ -168,6 +207,7 @@ private:
     int m_channelId { -1 };
     quint8 m_sendCount { 0 };
     quint8 m_receiveCount { 0 };
+    quint64 m_discardedFrames { 0 };
 
     int m_cemiRequests { 0 };
     const int m_maxCemiRequest { 0 };
@@ -191,17 +231,29 @@ private:
     QKnxNetIpEndpointConnection::Error m_error = QKnxNetIpEndpointConnection::Error::None;
     QKnxNetIpEndpointConnection::State m_state = QKnxNetIpEndpointConnection::State::Disconnected;
 
-    QTimer *m_heartbeatTimer { nullptr };
-    QTimer *m_connectRequestTimer { nullptr };
-    QTimer *m_connectionStateTimer { nullptr };
-    QTimer *m_disconnectRequestTimer { nullptr };
-    QTimer *m_acknowledgeTimer { nullptr };
+    QKnxTimer *m_heartbeatTimer { nullptr };
+    QKnxTimer *m_connectRequestTimer { nullptr };
+    QKnxTimer *m_connectionStateTimer { nullptr };
+    QKnxTimer *m_disconnectRequestTimer { nullptr };
+    QKnxTimer *m_acknowledgeTimer { nullptr };
     bool m_waitForAcknowledgement { false };
 
     QUdpSocket *m_udpSocket { nullptr };
     QTcpSocket *m_tcpSocket { nullptr };
+    QPointer<QKnxNetIpSharedTransport> m_transport;
+    bool m_transportAttached { false };
     QKnxByteArray m_rxBuffer;
+    QByteArray m_txBuffer;
+
+    QKnxNetIpSecureConfiguration m_secureConfiguration;
+    QKnxNetIpSecureSession *m_secureSession { nullptr };
+    QFuture<QKnxByteArray> m_userPasswordHash;
+    QFuture<QKnxByteArray> m_deviceAuthenticationCodeHash;
+    QFutureWatcher<QKnxByteArray> *m_keyDerivationWatcher { nullptr };
+    QByteArray m_secureTxBuffer;
+    QKnxByteArray m_secureRxBuffer;
 
+    QKnxNetIpServiceDispatcher m_dispatcher;
     UserProperties m_user;
 };
 
@@ -313,6 +313,47 @@ QKnxByteArray QKnxNetIpFrame::bytes() const
     return d_ptr->m_header.bytes() + d_ptr->m_connectionHeader.bytes() + d_ptr->m_data;
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for the KNXnet/IP frame.
+    The size includes the frame header, the optional connection header, and
+    the frame's data part.
+
+    \sa serializeInto(), bytes()
+*/
+quint16 QKnxNetIpFrame::serializedSize() const
+{
+    return d_ptr->m_header.serializedSize() + d_ptr->m_connectionHeader.serializedSize()
+        + d_ptr->m_data.size();
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the KNXnet/IP frame to \a dst, which must
+    provide room for at least \a capacity bytes. Returns the number of bytes
+    written, or \c 0 if \a capacity is too small to hold serializedSize()
+    bytes.
+
+    Unlike bytes(), the function does not allocate any memory. This makes it
+    possible to serialize outgoing frames into a reused send buffer.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxNetIpFrame::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (!dst || capacity < size)
+        return 0;
+
+    auto offset = d_ptr->m_header.serializeInto(dst, capacity);
+    offset += d_ptr->m_connectionHeader.serializeInto(dst + offset, capacity - offset);
+    if (!d_ptr->m_data.isEmpty())
+        memcpy(dst + offset, d_ptr->m_data.constData(), d_ptr->m_data.size());
+    return size;
+}
+
 /*!
     Constructs the KNXnet/IP frame from the byte array \a bytes starting
     at position \a index inside the array.
@@ -79,6 +79,9 @@ public:
     void setData(const QKnxByteArray &data);
 
     QKnxByteArray bytes() const;
+    quint16 serializedSize() const;
+    quint16 serializeInto(quint8 *dst, size_t capacity) const;
+
     static QKnxNetIpFrame fromBytes(const QKnxByteArray &bytes, quint16 index = 0);
 
     QKnxNetIpFrame(const QKnxNetIpFrame &other);
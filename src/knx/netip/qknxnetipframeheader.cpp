@@ -242,6 +242,37 @@ QKnxByteArray QKnxNetIpFrameHeader::bytes() const
     return { m_bytes[0], m_bytes[1], m_bytes[2], m_bytes[3], m_bytes[4], m_bytes[5] };
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for this header. This is
+    the header size if the header is valid; otherwise \c 0.
+
+    \sa serializeInto(), bytes()
+*/
+quint16 QKnxNetIpFrameHeader::serializedSize() const
+{
+    return isValid() ? m_bytes[0] : 0;
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the KNXnet/IP frame header to \a dst, which
+    must provide room for at least \a capacity bytes. Returns the number of
+    bytes written, or \c 0 if the header is invalid or \a capacity is too small.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxNetIpFrameHeader::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (size == 0 || !dst || capacity < size)
+        return 0;
+    memcpy(dst, m_bytes, size);
+    return size;
+}
+
 /*!
     Constructs the KNXnet/IP frame header from the byte array \a bytes starting
     at position \a index inside the array.
@@ -67,6 +67,9 @@ public:
     quint8 byte(quint8 index) const;
     QKnxByteArray bytes() const;
 
+    quint16 serializedSize() const;
+    quint16 serializeInto(quint8 *dst, size_t capacity) const;
+
     static QKnxNetIpFrameHeader fromBytes(const QKnxByteArray &bytes, quint16 index = 0);
 
     bool operator==(const QKnxNetIpFrameHeader &other) const;
@@ -0,0 +1,209 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPFRAMESCHEDULER_P_H
+#define QKNXNETIPFRAMESCHEDULER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qqueue.h>
+#include <QtKnx/qknxcontrolfield.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+template <typename T>
+class QKnxNetIpFrameScheduler final
+{
+public:
+    // drain order is System, Urgent, Normal, Low; an entry moves up one level
+    // for each aging interval it has been waiting, measured on the time in
+    // milliseconds passed in by the owner so a virtual clock can drive it
+    enum : int { LevelCount = 4, DefaultAgingInterval = 500 };
+
+    struct Latency
+    {
+        quint64 count { 0 };
+        qint64 total { 0 };
+        qint64 maximum { 0 };
+
+        qint64 average() const { return count ? qint64(total / count) : 0; }
+    };
+
+    QKnxNetIpFrameScheduler() = default;
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+
+    int agingInterval() const { return m_agingInterval; }
+    void setAgingInterval(int msec) { m_agingInterval = qMax(0, msec); }
+
+    quint64 enqueue(const T &value, QKnxControlField::Priority priority, qint64 now)
+    {
+        m_levels[level(priority)].enqueue({ m_nextId, now, value });
+        ++m_size;
+        return m_nextId++;
+    }
+
+    bool replace(quint64 id, const T &value)
+    {
+        for (auto &queue : m_levels) {
+            // ids are increasing inside of a level
+            auto it = std::lower_bound(queue.begin(), queue.end(), id,
+                [](const Entry &entry, quint64 id) { return entry.id < id; });
+            if (it != queue.end() && it->id == id) {
+                it->value = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool remove(quint64 id)
+    {
+        for (auto &queue : m_levels) {
+            auto it = std::lower_bound(queue.begin(), queue.end(), id,
+                [](const Entry &entry, quint64 id) { return entry.id < id; });
+            if (it != queue.end() && it->id == id) {
+                queue.erase(it);
+                --m_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // removes the oldest entry of the lowest priority level that holds one, unless
+    // all entries have a higher priority than the given one
+    bool dropLowest(QKnxControlField::Priority priority)
+    {
+        for (int i = LevelCount - 1; i >= level(priority); --i) {
+            if (m_levels[i].isEmpty())
+                continue;
+            m_levels[i].dequeue();
+            --m_size;
+            return true;
+        }
+        return false;
+    }
+
+    T dequeue(qint64 now, quint64 *id = nullptr)
+    {
+        int next = -1;
+        qint64 nextRank = 0;
+        for (int i = 0; i < LevelCount; ++i) {
+            if (m_levels[i].isEmpty())
+                continue;
+            const qint64 waited = now - m_levels[i].head().enqueued;
+            const qint64 rank = i - (m_agingInterval > 0 ? waited / m_agingInterval : 0);
+            if (next < 0 || rank < nextRank) {
+                next = i;
+                nextRank = rank;
+            }
+        }
+        if (next < 0)
+            return T();
+
+        const auto entry = m_levels[next].dequeue();
+        --m_size;
+
+        auto &latency = m_latency[next];
+        const qint64 waited = now - entry.enqueued;
+        latency.count++;
+        latency.total += waited;
+        latency.maximum = qMax(latency.maximum, waited);
+
+        if (id)
+            *id = entry.id;
+        return entry.value;
+    }
+
+    void clear()
+    {
+        for (auto &queue : m_levels)
+            queue.clear();
+        m_size = 0;
+    }
+
+    Latency latency(QKnxControlField::Priority priority) const
+    {
+        return m_latency[level(priority)];
+    }
+
+    void resetLatency()
+    {
+        for (auto &latency : m_latency)
+            latency = {};
+    }
+
+private:
+    static int level(QKnxControlField::Priority priority)
+    {
+        switch (priority) {
+        case QKnxControlField::Priority::System:
+            return 0;
+        case QKnxControlField::Priority::Urgent:
+            return 1;
+        case QKnxControlField::Priority::Normal:
+            return 2;
+        case QKnxControlField::Priority::Low:
+        default:
+            break;
+        }
+        return 3;
+    }
+
+    struct Entry
+    {
+        quint64 id;
+        qint64 enqueued;
+        T value;
+    };
+
+    QQueue<Entry> m_levels[LevelCount];
+    Latency m_latency[LevelCount];
+    quint64 m_nextId { 0 };
+    int m_size { 0 };
+    int m_agingInterval { DefaultAgingInterval };
+};
+
+QT_END_NAMESPACE
+
+#endif
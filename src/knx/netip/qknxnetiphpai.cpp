@@ -28,10 +28,20 @@
 ******************************************************************************/
 
 #include "qknxnetiphpai.h"
-#include "qknxutils.h"
+#include "qknxnetipstructlayout_p.h"
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxHpai
+{
+    using namespace QKnxNetIpStructLayout;
+
+    using HostAddress = Field<0, 4>;
+    using Port = Field<4, 2>;
+
+    using Layout = QKnxNetIpStructLayout::Layout<6, HostAddress, Port>;
+}
+
 /*!
     \class QKnxNetIpHpaiProxy
 
@@ -103,7 +113,8 @@ bool QKnxNetIpHpaiProxy::isValid() const
 {
     bool validHostProtocolCode = m_hpai.code() == QKnxNetIp::HostProtocol::UDP_IPv4
         || m_hpai.code() == QKnxNetIp::HostProtocol::TCP_IPv4;
-    return m_hpai.isValid() && m_hpai.size() == 8 && validHostProtocolCode;
+    return m_hpai.isValid() && QKnxHpai::Layout::hasSize(m_hpai.constData())
+        && validHostProtocolCode;
 }
 
 /*!
@@ -125,7 +136,7 @@ QKnxNetIp::HostProtocol QKnxNetIpHpaiProxy::hostProtocol() const
 QHostAddress QKnxNetIpHpaiProxy::hostAddress() const
 {
     if (isValid())
-        return QKnxUtils::HostAddress::fromBytes(m_hpai.constData());
+        return QHostAddress(QKnxHpai::HostAddress::read(m_hpai.constData()));
     return {};
 }
 
@@ -135,7 +146,7 @@ QHostAddress QKnxNetIpHpaiProxy::hostAddress() const
 */
 quint16 QKnxNetIpHpaiProxy::port() const
 {
-    return QKnxUtils::QUint16::fromBytes(m_hpai.constData(), 4);
+    return QKnxHpai::Port::read(m_hpai.constData());
 }
 
 /*!
@@ -214,7 +225,10 @@ QKnxNetIpHpaiProxy::Builder &QKnxNetIpHpaiProxy::Builder::setPort(quint16 port)
 */
 QKnxNetIpHpai QKnxNetIpHpaiProxy::Builder::create() const
 {
-    return { m_code, QKnxUtils::HostAddress::bytes(m_address) + QKnxUtils::QUint16::bytes(m_port) };
+    auto data = QKnxHpai::Layout::create();
+    QKnxHpai::HostAddress::write(data, m_address.toIPv4Address());
+    QKnxHpai::Port::write(data, m_port);
+    return { m_code, data };
 }
 
 QT_END_NAMESPACE
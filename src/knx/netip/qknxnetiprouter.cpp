@@ -444,29 +444,191 @@ void QKnxNetIpRouter::setIndividualAddress(const QKnxAddress &address)
     }
 }
 
+/*!
+    \typedef QKnxNetIpRouter::ServiceHandler
+    \since 5.13
+
+    A synonym for \c {std::function<void (const QKnxNetIpFrame &frame)>}, the
+    type of function invoked for received frames of a registered service type.
+*/
+
+/*!
+    \since 5.13
+
+    Registers \a handler to be invoked with every KNXnet/IP frame of the service
+    type \a type received on the multicast group. Returns \c true on success;
+    otherwise returns \c false.
+
+    Registering fails if \a handler is empty or the router handles \a type
+    itself, as it does for the routing services. An already registered handler
+    for \a type is replaced. Any 16-bit service type can be claimed, including
+    vendor specific ones unknown to Qt KNX; frames of such a type carry their
+    body as data().
+
+    Datagrams of service types without a handler are discarded before a
+    QKnxNetIpFrame is created.
+
+    \sa unregisterServiceHandler()
+*/
+bool QKnxNetIpRouter::registerServiceHandler(QKnxNetIp::ServiceType type,
+    const ServiceHandler &handler)
+{
+    Q_D(QKnxNetIpRouter);
+    return d->m_dispatcher.registerHandler(type, handler);
+}
+
+/*!
+    \since 5.13
+
+    Removes the handler registered for the service type \a type. Returns
+    \c true if a handler was removed; otherwise returns \c false.
+
+    \sa registerServiceHandler()
+*/
+bool QKnxNetIpRouter::unregisterServiceHandler(QKnxNetIp::ServiceType type)
+{
+    Q_D(QKnxNetIpRouter);
+    return d->m_dispatcher.unregisterHandler(type);
+}
+
 /*!
     Multicasts the routing indication \a frame through the network interface
     associated with the QKnxNetIpRouter.
+
+    While a neighbor router is busy, routing indications are queued and sent
+    once the router is back in the \l {QKnxNetIpRouter::State}{Routing} state.
+    The queue drains indications by the priority set in the control field of
+    the carried link layer frame: system frames first, followed by urgent,
+    normal, and low priority frames. A waiting indication is treated as one
+    priority higher for each queueAgingInterval() it has spent in the queue,
+    so that low priority traffic does not starve.
+
+    The queue holds at most queueLimit() indications. If it is full, the
+    oldest indication of the lowest priority is dropped to make room for
+    \a frame, or \a frame itself is dropped if all waiting indications have
+    a higher priority. Dropped indications are counted by
+    droppedIndicationCount().
  */
 void QKnxNetIpRouter::sendRoutingIndication(const QKnxNetIpFrame &frame)
 {
     Q_D(QKnxNetIpRouter);
 
-    if (d->m_state != QKnxNetIpRouter::State::Routing)
+    if (d->m_state != QKnxNetIpRouter::State::Routing
+        && d->m_state != QKnxNetIpRouter::State::NeighborBusy) {
         return;
+    }
 
     QKnxNetIpRoutingIndicationProxy indication(frame);
     if (!indication.isValid())
         return;
 
-    if (!d->sendFrame(frame)) {
-        d->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, tr("Could not send routing "
-            "indication."));
-    } else {
-        emit routingIndicationSent(frame);
+    if (d->m_state == QKnxNetIpRouter::State::NeighborBusy)
+        d->enqueueIndication(frame, indication.cemi().controlField().priority());
+    else
+        d->sendRoutingIndication(frame);
+}
+
+/*!
+    \since 5.13
+
+    Returns the time in milliseconds after which a queued routing indication
+    is moved up by one priority level. The default is 500 milliseconds.
+
+    \sa sendRoutingIndication()
+*/
+int QKnxNetIpRouter::queueAgingInterval() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_scheduler.agingInterval();
+}
+
+/*!
+    \since 5.13
+
+    Sets the aging interval of the routing indication queue to \a msec
+    milliseconds. An interval of \c 0 disables aging, indications are then
+    drained strictly by priority.
+*/
+void QKnxNetIpRouter::setQueueAgingInterval(int msec)
+{
+    Q_D(QKnxNetIpRouter);
+    d->m_scheduler.setAgingInterval(msec);
+}
+
+/*!
+    \since 5.13
+
+    Returns the maximum number of routing indications queued while a neighbor
+    router is busy. The default is 256 indications.
+
+    \sa sendRoutingIndication(), droppedIndicationCount()
+*/
+int QKnxNetIpRouter::queueLimit() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_queueLimit;
+}
+
+/*!
+    \since 5.13
+
+    Sets the maximum number of routing indications queued while a neighbor
+    router is busy to \a frames. Values below \c 1 are treated as \c 1. If
+    more indications are waiting, the ones with the lowest priority are
+    dropped, oldest first.
+*/
+void QKnxNetIpRouter::setQueueLimit(int frames)
+{
+    Q_D(QKnxNetIpRouter);
+    d->m_queueLimit = qMax(1, frames);
+    while (d->m_scheduler.size() > d->m_queueLimit) {
+        d->m_scheduler.dropLowest(QKnxControlField::Priority::System);
+        ++d->m_droppedIndications;
     }
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of routing indications that were dropped because the
+    queue was full, since the router was created.
+
+    \sa queueLimit()
+*/
+quint64 QKnxNetIpRouter::droppedIndicationCount() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_droppedIndications;
+}
+
+/*!
+    \since 5.13
+
+    Returns the average time in milliseconds routing indications carrying a
+    frame of the given \a priority spent in the queue before they were sent.
+
+    \sa maximumQueueLatency()
+*/
+qint64 QKnxNetIpRouter::averageQueueLatency(QKnxControlField::Priority priority) const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_scheduler.latency(priority).average();
+}
+
+/*!
+    \since 5.13
+
+    Returns the longest time in milliseconds a routing indication carrying a
+    frame of the given \a priority spent in the queue before it was sent.
+
+    \sa averageQueueLatency()
+*/
+qint64 QKnxNetIpRouter::maximumQueueLatency(QKnxControlField::Priority priority) const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_scheduler.latency(priority).maximum;
+}
+
 /*!
     Multicasts the routing busy message containing \a frame through the
     network interface associated with the QKnxNetIpRouter.
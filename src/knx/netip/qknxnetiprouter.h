@@ -39,6 +39,8 @@
 #include <QtNetwork/qnetworkinterface.h>
 #include <QtNetwork/qudpsocket.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QKnxNetIpRouterPrivate;
@@ -109,6 +111,20 @@ public:
     QKnxAddress individualAddress() const;
     void setIndividualAddress(const QKnxAddress &address);
 
+    using ServiceHandler = std::function<void (const QKnxNetIpFrame &frame)>;
+    bool registerServiceHandler(QKnxNetIp::ServiceType type, const ServiceHandler &handler);
+    bool unregisterServiceHandler(QKnxNetIp::ServiceType type);
+
+    int queueAgingInterval() const;
+    void setQueueAgingInterval(int msec);
+
+    int queueLimit() const;
+    void setQueueLimit(int frames);
+    quint64 droppedIndicationCount() const;
+
+    qint64 averageQueueLatency(QKnxControlField::Priority priority) const;
+    qint64 maximumQueueLatency(QKnxControlField::Priority priority) const;
+
 public Q_SLOTS:
     void sendRoutingIndication(const QKnxNetIpFrame &frame);
     void sendRoutingBusy(const QKnxNetIpFrame &frame);
@@ -61,6 +61,40 @@ void QKnxNetIpRouterPrivate::changeState(QKnxNetIpRouter::State state)
 
     Q_Q(QKnxNetIpRouter);
     emit q->stateChanged(m_state);
+
+    if (m_state == QKnxNetIpRouter::State::Routing)
+        sendQueuedIndications();
+}
+
+void QKnxNetIpRouterPrivate::sendRoutingIndication(const QKnxNetIpFrame &frame)
+{
+    Q_Q(QKnxNetIpRouter);
+    if (!sendFrame(frame)) {
+        errorOccurred(QKnxNetIpRouter::Error::KnxRouting, QKnxNetIpRouter::tr("Could not send "
+            "routing indication."));
+    } else {
+        emit q->routingIndicationSent(frame);
+    }
+}
+
+void QKnxNetIpRouterPrivate::enqueueIndication(const QKnxNetIpFrame &frame,
+    QKnxControlField::Priority priority)
+{
+    // a full queue sheds the oldest indication of the lowest priority, that is the
+    // new indication itself if everything waiting has a higher priority
+    if (m_scheduler.size() >= m_queueLimit) {
+        ++m_droppedIndications;
+        if (!m_scheduler.dropLowest(priority))
+            return;
+    }
+    m_scheduler.enqueue(frame, priority, elapsed());
+}
+
+void QKnxNetIpRouterPrivate::sendQueuedIndications()
+{
+    // sending might fail and change the state, stop draining in that case
+    while (m_state == QKnxNetIpRouter::State::Routing && !m_scheduler.isEmpty())
+        sendRoutingIndication(m_scheduler.dequeue(elapsed()));
 }
 
 void QKnxNetIpRouterPrivate::start()
@@ -95,11 +129,11 @@ void QKnxNetIpRouterPrivate::start()
     }
     m_ownAddress = m_iface.addressEntries().first().ip();
 
-    m_busyTimer = new QTimer;
+    m_busyTimer = new QKnxTimer;
     m_busyTimer->setSingleShot(true);
 
     // while neighbor router busy don't overflow him with messages, timeout until some msec
-    QObject::connect(m_busyTimer, &QTimer::timeout, [&]() {
+    QObject::connect(m_busyTimer, &QKnxTimer::timeout, [&]() {
         switch (m_busyStage) {
         case BusyTimerStage::NotInit:
             break;
@@ -163,54 +197,15 @@ void QKnxNetIpRouterPrivate::start()
         // TODO: Review this part, the following members might get cleared unexpectedly
         // when messages come in one after the other and are not contained all in a single
         // datagram.
-        m_framesReadCount = 0;
-        m_sameKnxDstAddressIndicationCount = 0;
-        m_lastIndicationAddress = QKnxAddress();
+        beginReadBatch();
         while (m_socket && m_socket->state() == QUdpSocket::BoundState
             && m_socket->hasPendingDatagrams()) {
-
             QNetworkDatagram datagram = m_socket->receiveDatagram();
-            if (datagram.senderAddress() == m_ownAddress
-                || m_framesReadCount == 10 // incoming queue too big, signal busy
-                || m_sameKnxDstAddressIndicationCount == 5) {
-                    continue; // discard packet
-            }
-
-            auto data = QKnxByteArray::fromByteArray(datagram.data());
-            const auto header = QKnxNetIpFrameHeader::fromBytes(data, 0);
-            if (!header.isValid() || header.totalSize() != data.size())
-                continue; // discard packet
-
-            m_framesReadCount++;
-            switch (header.serviceType()) {
-            case QKnxNetIp::ServiceType::RoutingIndication:
-                processRoutingIndication(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingBusy:
-                processRoutingBusy(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingLostMessage:
-                processRoutingLostMessage(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingSystemBroadcast:
-                processRoutingSystemBroadcast(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            default:
-                break;
-            }
-        }
-
-        if (m_framesReadCount == 10 || m_sameKnxDstAddressIndicationCount == 5) {
-            // incoming queue over 10 packets or over 5 packets with
-            // individual address destination.
-            auto routingBusyNetIpFrame = QKnxNetIpRoutingBusyProxy::builder()
-                .setDeviceState(QKnxNetIp::DeviceState::KnxFault)
-                .setRoutingBusyWaitTime(m_busyWaitTime)
-                .setRoutingBusyControl(0)
-                .create();
-            sendFrame(routingBusyNetIpFrame);
-            flowControlHandling(m_busyWaitTime);
+            const auto data = datagram.data();
+            processDatagram(reinterpret_cast<const quint8 *> (data.constData()), data.size(),
+                datagram.senderAddress());
         }
+        endReadBatch();
     });
 
     // handle UDP socket errors
@@ -231,6 +226,69 @@ void QKnxNetIpRouterPrivate::start()
     }
 }
 
+void QKnxNetIpRouterPrivate::beginReadBatch()
+{
+    m_framesReadCount = 0;
+    m_sameKnxDstAddressIndicationCount = 0;
+    m_lastIndicationAddress = QKnxAddress();
+}
+
+bool QKnxNetIpRouterPrivate::processDatagram(const quint8 *data, int size,
+    const QHostAddress &sender)
+{
+    if (sender == m_ownAddress
+        || m_framesReadCount == 10 // incoming queue too big, signal busy
+        || m_sameKnxDstAddressIndicationCount == 5) {
+            return false; // discard packet
+    }
+
+    const auto peek = QKnxNetIpFramePeek::peek(data, size);
+    if (!peek.isValid() || peek.totalSize != size)
+        return false; // discard packet
+
+    m_framesReadCount++;
+    if (!m_dispatcher.contains(peek.serviceType))
+        return true; // nobody interested, skip building the frame
+
+    const auto frame = peek.createFrame(data);
+    if (!frame.isNull())
+        m_dispatcher.dispatch(frame);
+    return true;
+}
+
+void QKnxNetIpRouterPrivate::endReadBatch()
+{
+    if (m_framesReadCount == 10 || m_sameKnxDstAddressIndicationCount == 5) {
+        // incoming queue over 10 packets or over 5 packets with
+        // individual address destination.
+        auto routingBusyNetIpFrame = QKnxNetIpRoutingBusyProxy::builder()
+            .setDeviceState(QKnxNetIp::DeviceState::KnxFault)
+            .setRoutingBusyWaitTime(m_busyWaitTime)
+            .setRoutingBusyControl(0)
+            .create();
+        sendFrame(routingBusyNetIpFrame);
+        flowControlHandling(m_busyWaitTime);
+    }
+}
+
+void QKnxNetIpRouterPrivate::setupServiceHandlers()
+{
+    using Type = QKnxNetIp::ServiceType;
+    m_dispatcher.registerBuiltInHandler(Type::RoutingIndication, [this](const QKnxNetIpFrame &f) {
+        processRoutingIndication(f);
+    });
+    m_dispatcher.registerBuiltInHandler(Type::RoutingBusy, [this](const QKnxNetIpFrame &f) {
+        processRoutingBusy(f);
+    });
+    m_dispatcher.registerBuiltInHandler(Type::RoutingLostMessage, [this](const QKnxNetIpFrame &f) {
+        processRoutingLostMessage(f);
+    });
+    m_dispatcher.registerBuiltInHandler(Type::RoutingSystemBroadcast,
+        [this](const QKnxNetIpFrame &f) {
+            processRoutingSystemBroadcast(f);
+    });
+}
+
 void QKnxNetIpRouterPrivate::restart()
 {
     stop();
@@ -260,6 +318,7 @@ void QKnxNetIpRouterPrivate::cleanup()
     }
     m_busyCounter = 0;
     m_busyStage = BusyTimerStage::NotInit;
+    m_scheduler.clear();
 
     m_errorMessage = QString();
     m_error = QKnxNetIpRouter::Error::None;
@@ -333,8 +392,16 @@ bool QKnxNetIpRouterPrivate::sendFrame(const QKnxNetIpFrame &frame)
     if (m_state != QKnxNetIpRouter::State::Routing)
         return true; // no errors, only ignore the frame
 
-    return m_socket->writeDatagram(frame.bytes().toByteArray(),
-        m_multicastAddress,
+    const auto size = frame.serializedSize();
+    if (m_txBuffer.size() < size)
+        m_txBuffer.resize(size);
+
+    const auto written = frame.serializeInto(reinterpret_cast<quint8 *> (m_txBuffer.data()),
+        size_t(m_txBuffer.size()));
+    if (written == 0)
+        return false;
+
+    return m_socket->writeDatagram(m_txBuffer.constData(), written, m_multicastAddress,
         m_multicastPort) != -1;
 }
 
@@ -41,12 +41,16 @@
 // We mean it.
 //
 
-#include <QtCore/qtimer.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/private/qobject_p.h>
 
 #include <QtKnx/qknxnetip.h>
 #include <QtKnx/qknxnetipframe.h>
 #include <QtKnx/qknxnetiprouter.h>
+#include <QtKnx/private/qknxnetipframescheduler_p.h>
+#include <QtKnx/private/qknxnetipservicedispatcher_p.h>
+#include <QtKnx/private/qknxtimer_p.h>
 
 #include <QtNetwork/qnetworkdatagram.h>
 #include <QtNetwork/qnetworkinterface.h>
@@ -58,21 +62,34 @@ class QKnxNetIpRouterPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QKnxNetIpRouter)
 public:
-    QKnxNetIpRouterPrivate() = default;
+    QKnxNetIpRouterPrivate()
+    {
+        m_clock.start();
+        setupServiceHandlers();
+    }
     ~QKnxNetIpRouterPrivate() = default;
 
+    void setupServiceHandlers();
+
     void start();
     void restart();
     void stop();
 
     void cleanup();
 
+    void beginReadBatch();
+    bool processDatagram(const quint8 *data, int size, const QHostAddress &sender);
+    void endReadBatch();
+
     void processRoutingIndication(const QKnxNetIpFrame &frame);
     void processRoutingBusy(const QKnxNetIpFrame &frame);
     void processRoutingLostMessage(const QKnxNetIpFrame &frame);
     void processRoutingSystemBroadcast(const QKnxNetIpFrame &frame);
 
     bool sendFrame(const QKnxNetIpFrame &frame);
+    void sendRoutingIndication(const QKnxNetIpFrame &frame);
+    void enqueueIndication(const QKnxNetIpFrame &frame, QKnxControlField::Priority priority);
+    void sendQueuedIndications();
 
     void flowControlHandling(quint16 newBusyWaitTime);
 
@@ -81,7 +98,14 @@ public:
 
     QKnxNetIpRouter::FilterAction filterAction(const QKnxLinkLayerFrame &frame);
 
+    qint64 elapsed() const
+    {
+        return m_virtualClock ? m_virtualClock->elapsed() : m_clock.elapsed();
+    }
+
     QUdpSocket *m_socket { nullptr };
+    QByteArray m_txBuffer;
+    QKnxNetIpServiceDispatcher m_dispatcher;
 
     QKnxAddress m_individualAddress;
 
@@ -97,7 +121,7 @@ public:
     QKnxNetIpRouter::State m_state { QKnxNetIpRouter::State::NotInit };
 
     quint16 m_busyWaitTime { QKnxNetIp::RoutingBusyWaitTime };
-    QTimer *m_busyTimer { nullptr };
+    QKnxTimer *m_busyTimer { nullptr };
 
     enum class BusyTimerStage : quint8
     {
@@ -110,6 +134,13 @@ public:
     BusyTimerStage m_busyStage { BusyTimerStage::NotInit };
     quint32 m_busyCounter { 0 };
 
+    // the clock installed when the router was created drives queue aging
+    QPointer<QKnxVirtualClock> m_virtualClock { QKnxVirtualClock::installed() };
+    QElapsedTimer m_clock;
+    QKnxNetIpFrameScheduler<QKnxNetIpFrame> m_scheduler;
+    int m_queueLimit { 256 };
+    quint64 m_droppedIndications { 0 };
+
     QKnxNetIpRouter::Error m_error { QKnxNetIpRouter::Error::None };
     QString m_errorMessage;
 
@@ -0,0 +1,230 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipsecureconfiguration.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpSecureConfiguration
+
+    \since 5.13
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+
+    \brief The QKnxNetIpSecureConfiguration class holds the credentials used
+    to establish a KNXnet/IP secure session.
+
+    A secure session is authenticated with a user ID and the password of that
+    user. Optionally, the device authentication code of the KNXnet/IP server
+    is used to verify the identity of the server during the handshake.
+
+    The passwords are turned into keys by the Password-Based Key Derivation
+    Function (PBKDF2) when the session is established. Derived keys are kept
+    in an in-process cache, so reconnecting with the same credentials does not
+    repeat the derivation.
+
+    \sa QKnxNetIpEndpointConnection::connectToHostEncrypted()
+*/
+
+struct QKnxNetIpSecureConfigurationPrivate final : public QSharedData
+{
+    quint8 userId { 0 };
+    QByteArray userPassword;
+    QByteArray deviceAuthenticationCode;
+    QKnxByteArray serialNumber;
+};
+
+/*!
+    Constructs an empty, invalid secure configuration.
+*/
+QKnxNetIpSecureConfiguration::QKnxNetIpSecureConfiguration()
+    : d_ptr(new QKnxNetIpSecureConfigurationPrivate)
+{}
+
+/*!
+    Destroys the secure configuration.
+*/
+QKnxNetIpSecureConfiguration::~QKnxNetIpSecureConfiguration()
+{}
+
+/*!
+    Returns \c true if no credentials are set; otherwise returns \c false.
+*/
+bool QKnxNetIpSecureConfiguration::isNull() const
+{
+    return d_ptr->userId == 0 && d_ptr->userPassword.isEmpty()
+        && d_ptr->deviceAuthenticationCode.isEmpty() && d_ptr->serialNumber.isEmpty();
+}
+
+/*!
+    Returns \c true if the configuration holds a user ID in the range of
+    \c 1 to \c 127 and a user password; otherwise returns \c false.
+*/
+bool QKnxNetIpSecureConfiguration::isValid() const
+{
+    return d_ptr->userId > 0 && d_ptr->userId < 0x80 && !d_ptr->userPassword.isEmpty()
+        && (d_ptr->serialNumber.isEmpty() || d_ptr->serialNumber.size() == 6);
+}
+
+/*!
+    Returns the ID of the user used to authenticate the session.
+*/
+quint8 QKnxNetIpSecureConfiguration::userId() const
+{
+    return d_ptr->userId;
+}
+
+/*!
+    Sets the ID of the user used to authenticate the session to \a userId.
+*/
+void QKnxNetIpSecureConfiguration::setUserId(quint8 userId)
+{
+    d_ptr->userId = userId;
+}
+
+/*!
+    Returns the password of the user.
+*/
+QByteArray QKnxNetIpSecureConfiguration::userPassword() const
+{
+    return d_ptr->userPassword;
+}
+
+/*!
+    Sets the password of the user to \a password.
+*/
+void QKnxNetIpSecureConfiguration::setUserPassword(const QByteArray &password)
+{
+    d_ptr->userPassword = password;
+}
+
+/*!
+    Returns the device authentication code of the server.
+*/
+QByteArray QKnxNetIpSecureConfiguration::deviceAuthenticationCode() const
+{
+    return d_ptr->deviceAuthenticationCode;
+}
+
+/*!
+    Sets the device authentication code of the server to
+    \a authenticationCode. If the code is empty, the session response of
+    the server is not verified.
+*/
+void QKnxNetIpSecureConfiguration::setDeviceAuthenticationCode(const QByteArray &authenticationCode)
+{
+    d_ptr->deviceAuthenticationCode = authenticationCode;
+}
+
+/*!
+    Returns the KNX serial number sent with every secure frame.
+*/
+QKnxByteArray QKnxNetIpSecureConfiguration::serialNumber() const
+{
+    return d_ptr->serialNumber;
+}
+
+/*!
+    Sets the six byte KNX serial number sent with every secure frame to
+    \a serialNumber. An empty serial number is sent as six \c 0x00 bytes.
+*/
+void QKnxNetIpSecureConfiguration::setSerialNumber(const QKnxByteArray &serialNumber)
+{
+    d_ptr->serialNumber = serialNumber;
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QKnxNetIpSecureConfiguration::QKnxNetIpSecureConfiguration(const QKnxNetIpSecureConfiguration &other)
+    : d_ptr(other.d_ptr)
+{}
+
+/*!
+    Assigns \a other to this object.
+*/
+QKnxNetIpSecureConfiguration &
+    QKnxNetIpSecureConfiguration::operator=(const QKnxNetIpSecureConfiguration &other)
+{
+    d_ptr = other.d_ptr;
+    return *this;
+}
+
+/*!
+    Move-constructs an object instance, making it point to the same object
+    that \a other was pointing to.
+*/
+QKnxNetIpSecureConfiguration::QKnxNetIpSecureConfiguration(QKnxNetIpSecureConfiguration &&other)
+    Q_DECL_NOTHROW
+    : d_ptr(other.d_ptr)
+{
+    other.d_ptr = nullptr;
+}
+
+/*!
+    Move-assigns \a other to this object instance.
+*/
+QKnxNetIpSecureConfiguration &
+    QKnxNetIpSecureConfiguration::operator=(QKnxNetIpSecureConfiguration &&other) Q_DECL_NOTHROW
+{
+    swap(other);
+    return *this;
+}
+
+/*!
+    Returns \c true if this object and the given \a other are equal; otherwise
+    returns \c false.
+*/
+bool QKnxNetIpSecureConfiguration::operator==(const QKnxNetIpSecureConfiguration &other) const
+{
+    return d_ptr == other.d_ptr || (d_ptr->userId == other.d_ptr->userId
+        && d_ptr->userPassword == other.d_ptr->userPassword
+        && d_ptr->deviceAuthenticationCode == other.d_ptr->deviceAuthenticationCode
+        && d_ptr->serialNumber == other.d_ptr->serialNumber);
+}
+
+/*!
+    Returns \c true if this object and the given \a other are not equal;
+    otherwise returns \c false.
+*/
+bool QKnxNetIpSecureConfiguration::operator!=(const QKnxNetIpSecureConfiguration &other) const
+{
+    return !operator==(other);
+}
+
+/*!
+    Swaps \a other with this object. This operation is very fast and never fails.
+*/
+void QKnxNetIpSecureConfiguration::swap(QKnxNetIpSecureConfiguration &other) Q_DECL_NOTHROW
+{
+    d_ptr.swap(other.d_ptr);
+}
+
+QT_END_NAMESPACE
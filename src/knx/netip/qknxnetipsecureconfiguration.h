@@ -0,0 +1,80 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSECURECONFIGURATION_H
+#define QKNXNETIPSECURECONFIGURATION_H
+
+#include <QtCore/qshareddata.h>
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QKnxNetIpSecureConfigurationPrivate;
+
+class Q_KNX_EXPORT QKnxNetIpSecureConfiguration final
+{
+public:
+    QKnxNetIpSecureConfiguration();
+    ~QKnxNetIpSecureConfiguration();
+
+    bool isNull() const;
+    bool isValid() const;
+
+    quint8 userId() const;
+    void setUserId(quint8 userId);
+
+    QByteArray userPassword() const;
+    void setUserPassword(const QByteArray &password);
+
+    QByteArray deviceAuthenticationCode() const;
+    void setDeviceAuthenticationCode(const QByteArray &authenticationCode);
+
+    QKnxByteArray serialNumber() const;
+    void setSerialNumber(const QKnxByteArray &serialNumber);
+
+    QKnxNetIpSecureConfiguration(const QKnxNetIpSecureConfiguration &other);
+    QKnxNetIpSecureConfiguration &operator=(const QKnxNetIpSecureConfiguration &other);
+
+    QKnxNetIpSecureConfiguration(QKnxNetIpSecureConfiguration &&other) Q_DECL_NOTHROW;
+    QKnxNetIpSecureConfiguration &operator=(QKnxNetIpSecureConfiguration &&other) Q_DECL_NOTHROW;
+
+    bool operator==(const QKnxNetIpSecureConfiguration &other) const;
+    bool operator!=(const QKnxNetIpSecureConfiguration &other) const;
+
+    void swap(QKnxNetIpSecureConfiguration &other) Q_DECL_NOTHROW;
+
+private:
+    QSharedDataPointer<QKnxNetIpSecureConfigurationPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -214,7 +214,7 @@ void QKnxNetIpServerDescriptionAgentPrivate::setupSocket()
 
 namespace QKnxPrivate
 {
-    static void clearTimer(QTimer **timer)
+    static void clearTimer(QKnxTimer **timer)
     {
         if (*timer) {
             (*timer)->stop();
@@ -231,10 +231,10 @@ void QKnxNetIpServerDescriptionAgentPrivate::setupAndStartReceiveTimer()
 
     QKnxPrivate::clearTimer(&receiveTimer);
     if (timeout >= 0) {
-        receiveTimer = new QTimer(q);
+        receiveTimer = new QKnxTimer(q);
         receiveTimer->setSingleShot(true);
         receiveTimer->start(timeout);
-        QObject::connect(receiveTimer, &QTimer::timeout, q, &QKnxNetIpServerDescriptionAgent::stop);
+        QObject::connect(receiveTimer, &QKnxTimer::timeout, q, &QKnxNetIpServerDescriptionAgent::stop);
     }
 }
 
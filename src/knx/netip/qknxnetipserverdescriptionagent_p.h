@@ -41,7 +41,6 @@
 // We mean it.
 //
 
-#include <QtCore/qtimer.h>
 #include <QtKnx/qtknxglobal.h>
 #include <QtKnx/qknxnetip.h>
 #include <QtKnx/qknxnetipdescriptionrequest.h>
@@ -49,6 +48,7 @@
 #include <QtKnx/qknxnetiphpai.h>
 #include <QtKnx/qknxnetipserverdescriptionagent.h>
 #include <QtKnx/qknxnetipserverinfo.h>
+#include <QtKnx/private/qknxtimer_p.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qnetworkdatagram.h>
 #include <QtNetwork/qudpsocket.h>
@@ -74,7 +74,7 @@ public:
 
 private:
     QUdpSocket *socket { nullptr };
-    QTimer *receiveTimer { nullptr };
+    QKnxTimer *receiveTimer { nullptr };
 
     quint16 port { 0 }, usedPort { 0 };
     QHostAddress address { QHostAddress::AnyIPv4 };
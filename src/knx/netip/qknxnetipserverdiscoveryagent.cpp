@@ -356,7 +356,7 @@ void QKnxNetIpServerDiscoveryAgentPrivate::setupSocket()
 
 namespace QKnxPrivate
 {
-    static void clearTimer(QTimer **timer)
+    static void clearTimer(QKnxTimer **timer)
     {
         if (*timer) {
             (*timer)->stop();
@@ -373,10 +373,10 @@ void QKnxNetIpServerDiscoveryAgentPrivate::setupAndStartReceiveTimer()
 
     QKnxPrivate::clearTimer(&receiveTimer);
     if (timeout >= 0) {
-        receiveTimer = new QTimer(q);
+        receiveTimer = new QKnxTimer(q);
         receiveTimer->setSingleShot(true);
         receiveTimer->start(timeout);
-        QObject::connect(receiveTimer, &QTimer::timeout, q, &QKnxNetIpServerDiscoveryAgent::stop);
+        QObject::connect(receiveTimer, &QKnxTimer::timeout, q, &QKnxNetIpServerDiscoveryAgent::stop);
     }
 }
 
@@ -386,11 +386,11 @@ void QKnxNetIpServerDiscoveryAgentPrivate::setupAndStartFrequencyTimer()
 
     QKnxPrivate::clearTimer(&frequencyTimer);
     if (frequency > 0) {
-        frequencyTimer = new QTimer(q);
+        frequencyTimer = new QKnxTimer(q);
         frequencyTimer->setSingleShot(false);
         frequencyTimer->start(60000 / frequency);
 
-        QObject::connect(receiveTimer, &QTimer::timeout, [&]() {
+        QObject::connect(receiveTimer, &QKnxTimer::timeout, [&]() {
             Q_Q(QKnxNetIpServerDiscoveryAgent);
             if (q->state() == QKnxNetIpServerDiscoveryAgent::State::Running) {
                 servers.clear();
@@ -41,12 +41,12 @@
 // We mean it.
 //
 
-#include <QtCore/qtimer.h>
 #include <QtKnx/qtknxglobal.h>
 #include <QtKnx/qknxnetip.h>
 #include <QtKnx/qknxnetipsearchrequest.h>
 #include <QtKnx/qknxnetipsearchresponse.h>
 #include <QtKnx/qknxnetipserverdiscoveryagent.h>
+#include <QtKnx/private/qknxtimer_p.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qnetworkdatagram.h>
 #include <QtNetwork/qudpsocket.h>
@@ -74,8 +74,8 @@ public:
 
 private:
     QUdpSocket *socket { nullptr };
-    QTimer *receiveTimer { nullptr };
-    QTimer *frequencyTimer { nullptr };
+    QKnxTimer *receiveTimer { nullptr };
+    QKnxTimer *frequencyTimer { nullptr };
 
     quint16 port { 0 }, usedPort { 0 };
     QHostAddress address { QHostAddress::AnyIPv4 }, usedAddress;
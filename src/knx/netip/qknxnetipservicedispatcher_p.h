@@ -0,0 +1,243 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSERVICEDISPATCHER_P_H
+#define QKNXNETIPSERVICEDISPATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+
+#include <QtKnx/qknxnetip.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetipframeheader.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+struct QKnxNetIpFramePeek final
+{
+    enum class Status : quint8
+    {
+        Valid,
+        Incomplete,
+        Invalid
+    };
+
+    Status status { Status::Invalid };
+    QKnxNetIp::ServiceType serviceType { QKnxNetIp::ServiceType::Unknown };
+    quint16 totalSize { 0 };
+    bool hasChannelId { false };
+    quint8 channelId { 0 };
+    quint8 sequenceNumber { 0 };
+
+    bool isValid() const { return status == Status::Valid; }
+
+    static bool hasConnectionHeader(QKnxNetIp::ServiceType type)
+    {
+        switch (type) {
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+        case QKnxNetIp::ServiceType::TunnelingFeatureGet:
+        case QKnxNetIp::ServiceType::TunnelingFeatureSet:
+        case QKnxNetIp::ServiceType::TunnelingFeatureInfo:
+        case QKnxNetIp::ServiceType::TunnelingFeatureResponse:
+        case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
+        case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    // Services without connection header that carry the communication channel
+    // ID as the first byte of the body.
+    static bool hasChannelIdInBody(QKnxNetIp::ServiceType type)
+    {
+        switch (type) {
+        case QKnxNetIp::ServiceType::ConnectionStateRequest:
+        case QKnxNetIp::ServiceType::ConnectionStateResponse:
+        case QKnxNetIp::ServiceType::DisconnectRequest:
+        case QKnxNetIp::ServiceType::DisconnectResponse:
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    // Validates the frame header and, if present, the connection header of the
+    // frame at the start of the given raw bytes without copying or allocating.
+    // Returns a peek with status Incomplete if more bytes are needed to decide.
+    static QKnxNetIpFramePeek peek(const quint8 *data, int size)
+    {
+        QKnxNetIpFramePeek result;
+        if (!data || size < QKnxNetIpFrameHeader::HeaderSize10) {
+            result.status = Status::Incomplete;
+            return result;
+        }
+
+        // KNXnet/IP 1.0 is the only protocol version, it mandates a six byte header
+        if (data[0] != QKnxNetIpFrameHeader::HeaderSize10
+            || data[1] != QKnxNetIpFrameHeader::KnxNetIpVersion10) {
+            return result;
+        }
+
+        // the service type is not checked, handlers may claim any 16-bit value
+        const auto type = QKnxNetIp::ServiceType(quint16(data[2]) << 8 | data[3]);
+        const auto totalSize = quint16(quint16(data[4]) << 8 | data[5]);
+        if (totalSize < QKnxNetIpFrameHeader::HeaderSize10)
+            return result;
+
+        result.serviceType = type;
+        result.totalSize = totalSize;
+        if (size < totalSize) {
+            result.status = Status::Incomplete;
+            return result;
+        }
+
+        const quint8 *body = data + QKnxNetIpFrameHeader::HeaderSize10;
+        const int bodySize = totalSize - QKnxNetIpFrameHeader::HeaderSize10;
+        if (hasConnectionHeader(type)) {
+            // structure length, channel ID, sequence counter and reserved byte,
+            // optionally followed by connection type specific header items
+            if (bodySize < 4 || body[0] < 4 || body[0] > bodySize)
+                return result;
+            result.hasChannelId = true;
+            result.channelId = body[1];
+            result.sequenceNumber = body[2];
+        } else if (hasChannelIdInBody(type)) {
+            if (bodySize < 1)
+                return result;
+            result.hasChannelId = true;
+            result.channelId = body[0];
+        }
+
+        result.status = Status::Valid;
+        return result;
+    }
+
+    static QKnxNetIpFramePeek peek(const QKnxByteArray &bytes)
+    {
+        return peek(bytes.constData(), bytes.size());
+    }
+
+    // Creates the frame described by this peek from the raw bytes it was taken
+    // from. Frames of service types unknown to Qt KNX carry the body as data.
+    // Returns a null frame if a frame of a known service type is malformed.
+    QKnxNetIpFrame createFrame(const quint8 *data) const
+    {
+        if (!isValid())
+            return {};
+
+        if (!QKnxNetIp::isServiceType(serviceType)) {
+            return { serviceType, QKnxByteArray(data + QKnxNetIpFrameHeader::HeaderSize10,
+                totalSize - QKnxNetIpFrameHeader::HeaderSize10) };
+        }
+
+        auto frame = QKnxNetIpFrame::fromBytes(QKnxByteArray(data, totalSize));
+        if (!frame.isValid())
+            return {};
+        return frame;
+    }
+};
+
+class QKnxNetIpServiceDispatcher final
+{
+public:
+    using Handler = std::function<void (const QKnxNetIpFrame &frame)>;
+
+    // Built-in handlers implement the protocol and cannot be replaced or
+    // removed by handlers registered through the public API.
+    void registerBuiltInHandler(QKnxNetIp::ServiceType type, const Handler &handler)
+    {
+        if (handler)
+            m_handlers.insert(quint16(type), { handler, true });
+    }
+
+    bool registerHandler(QKnxNetIp::ServiceType type, const Handler &handler)
+    {
+        if (!handler || isBuiltIn(type))
+            return false;
+        m_handlers.insert(quint16(type), { handler, false });
+        return true;
+    }
+
+    bool unregisterHandler(QKnxNetIp::ServiceType type)
+    {
+        if (isBuiltIn(type))
+            return false;
+        return m_handlers.remove(quint16(type)) > 0;
+    }
+
+    bool contains(QKnxNetIp::ServiceType type) const
+    {
+        return m_handlers.contains(quint16(type));
+    }
+
+    bool isBuiltIn(QKnxNetIp::ServiceType type) const
+    {
+        const auto it = m_handlers.constFind(quint16(type));
+        return it != m_handlers.constEnd() && it.value().builtIn;
+    }
+
+    bool dispatch(const QKnxNetIpFrame &frame) const
+    {
+        const auto it = m_handlers.constFind(quint16(frame.serviceType()));
+        if (it == m_handlers.constEnd())
+            return false;
+        // copy, the handler might unregister itself while running
+        const auto handler = it.value().handler;
+        handler(frame);
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        Handler handler;
+        bool builtIn;
+    };
+    QHash<quint16, Entry> m_handlers;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,437 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipendpointconnection_p.h"
+#include "qknxnetipsharedtransport.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <QtNetwork/qudpsocket.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpSharedTransport
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxNetIpSharedTransport class serves many KNXnet/IP tunnel and
+    device management connections from a single local UDP port.
+
+    By default, every QKnxNetIpEndpointConnection binds its own UDP socket.
+    Applications connecting to thousands of KNXnet/IP servers can instead
+    share one transport between all connections by calling
+    QKnxNetIpEndpointConnection::setTransport() before connecting. This cuts
+    the number of file descriptors and event loop socket notifiers to one.
+
+    Inbound datagrams are demultiplexed through a hash table keyed by the
+    IP address of the server's data endpoint, as negotiated in the connect
+    response, and the communication channel ID. A datagram is passed to a
+    connection only if it was sent from that connection's data or control
+    endpoint. Connect responses, which carry no channel ID yet, are matched to
+    the connections waiting for a response from that control endpoint in the
+    order the requests were sent. Datagrams not belonging to any attached
+    connection are dropped.
+
+    Outbound datagrams are collected and written in one batch when control
+    returns to the event loop. If the socket fails to write a datagram, the
+    connection that sent it reports a
+    \l {QKnxNetIpEndpointConnection::Error}{Network} error and disconnects.
+
+    \code
+        QKnxNetIpSharedTransport transport;
+        transport.bind(QHostAddress::AnyIPv4, 3672);
+
+        for (const auto &server : servers) {
+            auto tunnel = new QKnxNetIpTunnel(&transport);
+            tunnel->setTransport(&transport);
+            tunnel->connectToHost(server, 3671);
+        }
+    \endcode
+
+    \note Only UDP connections can use a shared transport.
+*/
+
+class QKnxNetIpSharedTransportPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxNetIpSharedTransport)
+
+public:
+    static quint64 endpointKey(const QHostAddress &address, quint16 port)
+    {
+        return quint64(address.toIPv4Address()) << 16 | port;
+    }
+
+    static quint64 channelKey(const QHostAddress &address, quint8 channelId)
+    {
+        return quint64(address.toIPv4Address()) << 8 | channelId;
+    }
+
+    static bool matches(const Endpoint &endpoint, const QHostAddress &address, quint16 port)
+    {
+        return endpointKey(endpoint.address, endpoint.port) == endpointKey(address, port);
+    }
+
+    void readPendingDatagrams();
+    bool dispatch(const quint8 *data, int size, const QHostAddress &address, quint16 port);
+    void registerChannel(QKnxNetIpEndpointConnectionPrivate *connection);
+    void scheduleFlush();
+    void flush();
+
+    QUdpSocket *m_socket { nullptr };
+    QString m_errorString;
+
+    QVector<QKnxNetIpEndpointConnectionPrivate *> m_connections;
+    QHash<quint64, QVector<QKnxNetIpEndpointConnectionPrivate *>> m_connecting;
+    QMultiHash<quint64, QKnxNetIpEndpointConnectionPrivate *> m_channels;
+    QMultiHash<QKnxNetIpEndpointConnectionPrivate *, quint64> m_channelKeys;
+
+    QByteArray m_rxBuffer;
+
+    struct PendingDatagram
+    {
+        QKnxNetIpEndpointConnectionPrivate *connection;
+        int offset;
+        int size;
+        QHostAddress address;
+        quint16 port;
+    };
+    QByteArray m_txBuffer;
+    QVector<PendingDatagram> m_pending;
+    bool m_flushScheduled { false };
+
+    quint64 m_received { 0 };
+    quint64 m_sent { 0 };
+    quint64 m_dropped { 0 };
+};
+
+void QKnxNetIpSharedTransportPrivate::readPendingDatagrams()
+{
+    QHostAddress address;
+    quint16 port = 0;
+    while (m_socket && m_socket->hasPendingDatagrams()) {
+        const auto size = m_socket->pendingDatagramSize();
+        if (m_rxBuffer.size() < size)
+            m_rxBuffer.resize(int(size));
+
+        const auto read = m_socket->readDatagram(m_rxBuffer.data(), m_rxBuffer.size(), &address,
+            &port);
+        if (read < 0)
+            break;
+
+        ++m_received;
+        if (!dispatch(reinterpret_cast<const quint8 *> (m_rxBuffer.constData()), int(read),
+            address, port)) {
+            ++m_dropped;
+        }
+    }
+}
+
+bool QKnxNetIpSharedTransportPrivate::dispatch(const quint8 *data, int size,
+    const QHostAddress &address, quint16 port)
+{
+    const auto peek = QKnxNetIpFramePeek::peek(data, size);
+    if (!peek.isValid())
+        return false;
+
+    QKnxNetIpEndpointConnectionPrivate *connection = nullptr;
+    if (peek.hasChannelId) {
+        const auto key = channelKey(address, peek.channelId);
+        for (auto it = m_channels.constFind(key); it != m_channels.cend() && it.key() == key; ++it) {
+            // two servers behind the same address can only be told apart by port
+            const auto candidate = it.value();
+            if (matches(candidate->m_remoteDataEndpoint, address, port)
+                || matches(candidate->m_remoteControlEndpoint, address, port)) {
+                connection = candidate;
+                break;
+            }
+        }
+    } else if (peek.serviceType == QKnxNetIp::ServiceType::ConnectResponse) {
+        const auto it = m_connecting.find(endpointKey(address, port));
+        if (it != m_connecting.end() && !it.value().isEmpty())
+            connection = it.value().takeFirst();
+    }
+
+    if (!connection)
+        return false;
+
+    const bool processed = connection->processDatagram(data, size, address, port);
+
+    // the connection might have been deleted or disconnected while processing
+    if (peek.serviceType == QKnxNetIp::ServiceType::ConnectResponse
+        && m_connections.contains(connection)) {
+        registerChannel(connection);
+    }
+    return processed;
+}
+
+void QKnxNetIpSharedTransportPrivate::registerChannel(QKnxNetIpEndpointConnectionPrivate *connection)
+{
+    if (connection->m_channelId < 0)
+        return;
+
+    // requests and acknowledges come from the negotiated data endpoint, connection
+    // state and disconnect frames from the control endpoint, which might differ
+    for (const auto endpoint : { &connection->m_remoteDataEndpoint,
+        &connection->m_remoteControlEndpoint }) {
+        if (endpoint->address.toIPv4Address() == 0)
+            continue; // a route back endpoint, not known before the first frame
+        const auto key = channelKey(endpoint->address, quint8(connection->m_channelId));
+        if (m_channels.contains(key, connection))
+            continue;
+        m_channels.insert(key, connection);
+        m_channelKeys.insert(connection, key);
+    }
+}
+
+void QKnxNetIpSharedTransportPrivate::scheduleFlush()
+{
+    if (m_flushScheduled)
+        return;
+    m_flushScheduled = true;
+
+    Q_Q(QKnxNetIpSharedTransport);
+    QMetaObject::invokeMethod(q, [this]() { flush(); }, Qt::QueuedConnection);
+}
+
+void QKnxNetIpSharedTransportPrivate::flush()
+{
+    m_flushScheduled = false;
+
+    QVector<QKnxNetIpEndpointConnectionPrivate *> failed;
+    if (m_socket) {
+        for (const auto &datagram : qAsConst(m_pending)) {
+            if (m_socket->writeDatagram(m_txBuffer.constData() + datagram.offset, datagram.size,
+                datagram.address, datagram.port) >= 0) {
+                ++m_sent;
+            } else if (!failed.contains(datagram.connection)) {
+                m_errorString = m_socket->errorString();
+                failed.append(datagram.connection);
+            }
+        }
+    }
+    m_pending.resize(0);
+    m_txBuffer.resize(0); // keeps the capacity for the next batch
+
+    // disconnecting sends a request, so only report once the batch is cleared
+    for (auto connection : qAsConst(failed)) {
+        if (m_connections.contains(connection))
+            connection->processTransportError(m_errorString);
+    }
+}
+
+/*!
+    Creates an unbound shared transport with the parent \a parent.
+*/
+QKnxNetIpSharedTransport::QKnxNetIpSharedTransport(QObject *parent)
+    : QObject(*new QKnxNetIpSharedTransportPrivate, parent)
+{}
+
+/*!
+    Closes the transport and destroys it.
+
+    \sa close()
+*/
+QKnxNetIpSharedTransport::~QKnxNetIpSharedTransport()
+{
+    close();
+}
+
+/*!
+    Binds the transport to the local \a address and \a port. If \a port is
+    \c 0, the system chooses a free port.
+
+    Returns \c true on success; otherwise returns \c false and errorString()
+    describes the error.
+*/
+bool QKnxNetIpSharedTransport::bind(const QHostAddress &address, quint16 port)
+{
+    Q_D(QKnxNetIpSharedTransport);
+    if (d->m_socket)
+        return false;
+
+    d->m_socket = new QUdpSocket(this);
+    if (!d->m_socket->bind(address, port)) {
+        d->m_errorString = tr("Could not bind endpoint: %1").arg(d->m_socket->errorString());
+        delete d->m_socket;
+        d->m_socket = nullptr;
+        return false;
+    }
+
+    d->m_errorString.clear();
+    connect(d->m_socket, &QUdpSocket::readyRead, this, [d]() { d->readPendingDatagrams(); });
+    return true;
+}
+
+/*!
+    Returns \c true if the transport is bound; otherwise returns \c false.
+*/
+bool QKnxNetIpSharedTransport::isBound() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_socket != nullptr;
+}
+
+/*!
+    Writes all pending datagrams and closes the transport. All connections
+    using the transport are disconnected with a network error.
+*/
+void QKnxNetIpSharedTransport::close()
+{
+    Q_D(QKnxNetIpSharedTransport);
+
+    const auto connections = d->m_connections;
+    for (auto connection : connections)
+        connection->processTransportClosed();
+
+    d->flush();
+    if (d->m_socket) {
+        d->m_socket->close();
+        d->m_socket->deleteLater();
+        d->m_socket = nullptr;
+    }
+}
+
+/*!
+    Returns the local address the transport is bound to.
+*/
+QHostAddress QKnxNetIpSharedTransport::localAddress() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_socket ? d->m_socket->localAddress() : QHostAddress();
+}
+
+/*!
+    Returns the local port the transport is bound to.
+*/
+quint16 QKnxNetIpSharedTransport::localPort() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_socket ? d->m_socket->localPort() : 0;
+}
+
+/*!
+    Returns a human-readable description of the last error that occurred.
+*/
+QString QKnxNetIpSharedTransport::errorString() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_errorString;
+}
+
+/*!
+    Returns the number of connections currently using the transport.
+*/
+int QKnxNetIpSharedTransport::connectionCount() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_connections.size();
+}
+
+/*!
+    Returns the number of datagrams received since the transport was created.
+*/
+quint64 QKnxNetIpSharedTransport::datagramsReceived() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_received;
+}
+
+/*!
+    Returns the number of datagrams sent since the transport was created.
+*/
+quint64 QKnxNetIpSharedTransport::datagramsSent() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_sent;
+}
+
+/*!
+    Returns the number of received datagrams that were invalid, did not
+    belong to any connection or were rejected by their connection.
+*/
+quint64 QKnxNetIpSharedTransport::datagramsDropped() const
+{
+    Q_D(const QKnxNetIpSharedTransport);
+    return d->m_dropped;
+}
+
+void QKnxNetIpSharedTransport::attach(QKnxNetIpEndpointConnectionPrivate *connection)
+{
+    Q_D(QKnxNetIpSharedTransport);
+    if (d->m_connections.contains(connection))
+        return;
+
+    d->m_connections.append(connection);
+    const auto &endpoint = connection->m_remoteControlEndpoint;
+    d->m_connecting[d->endpointKey(endpoint.address, endpoint.port)].append(connection);
+}
+
+void QKnxNetIpSharedTransport::detach(QKnxNetIpEndpointConnectionPrivate *connection)
+{
+    Q_D(QKnxNetIpSharedTransport);
+    if (!d->m_connections.removeOne(connection))
+        return;
+
+    const auto &endpoint = connection->m_remoteControlEndpoint;
+    const auto it = d->m_connecting.find(d->endpointKey(endpoint.address, endpoint.port));
+    if (it != d->m_connecting.end()) {
+        it.value().removeOne(connection);
+        if (it.value().isEmpty())
+            d->m_connecting.erase(it);
+    }
+
+    const auto keys = d->m_channelKeys.values(connection);
+    for (const auto key : keys)
+        d->m_channels.remove(key, connection);
+    d->m_channelKeys.remove(connection);
+}
+
+qint64 QKnxNetIpSharedTransport::writeDatagram(QKnxNetIpEndpointConnectionPrivate *connection,
+    const char *data, qint64 size, const QHostAddress &address, quint16 port)
+{
+    Q_D(QKnxNetIpSharedTransport);
+    if (!d->m_socket)
+        return -1;
+    if (d->m_socket->state() != QAbstractSocket::BoundState) {
+        d->m_errorString = d->m_socket->errorString();
+        return -1;
+    }
+
+    d->m_pending.append({ connection, d->m_txBuffer.size(), int(size), address, port });
+    d->m_txBuffer.append(data, int(size));
+    d->scheduleFlush();
+    return size;
+}
+
+QT_END_NAMESPACE
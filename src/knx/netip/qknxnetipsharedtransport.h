@@ -0,0 +1,78 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSHAREDTRANSPORT_H
+#define QKNXNETIPSHAREDTRANSPORT_H
+
+#include <QtCore/qobject.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpEndpointConnectionPrivate;
+
+class QKnxNetIpSharedTransportPrivate;
+class Q_KNX_EXPORT QKnxNetIpSharedTransport final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxNetIpSharedTransport)
+    Q_DECLARE_PRIVATE(QKnxNetIpSharedTransport)
+
+public:
+    explicit QKnxNetIpSharedTransport(QObject *parent = nullptr);
+    ~QKnxNetIpSharedTransport() override;
+
+    bool bind(const QHostAddress &address = QHostAddress::AnyIPv4, quint16 port = 0);
+    bool isBound() const;
+    void close();
+
+    QHostAddress localAddress() const;
+    quint16 localPort() const;
+    QString errorString() const;
+
+    int connectionCount() const;
+
+    quint64 datagramsReceived() const;
+    quint64 datagramsSent() const;
+    quint64 datagramsDropped() const;
+
+private:
+    friend class QKnxNetIpEndpointConnectionPrivate;
+    void attach(QKnxNetIpEndpointConnectionPrivate *connection);
+    void detach(QKnxNetIpEndpointConnectionPrivate *connection);
+    qint64 writeDatagram(QKnxNetIpEndpointConnectionPrivate *connection, const char *data,
+        qint64 size, const QHostAddress &address, quint16 port);
+};
+
+QT_END_NAMESPACE
+
+#endif
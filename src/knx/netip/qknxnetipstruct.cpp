@@ -187,6 +187,26 @@ QT_BEGIN_NAMESPACE
     the header and the payload.
 */
 
+/*!
+    \fn template <typename CodeType> QKnxNetIpStruct<CodeType>::serializedSize() const
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for the KNXnet/IP
+    structure, including the header and the payload.
+*/
+
+/*!
+    \fn template <typename CodeType> QKnxNetIpStruct<CodeType>::serializeInto(quint8 *dst, size_t capacity) const
+    \since 5.13
+
+    Writes the bytes that represent the KNXnet/IP structure including the
+    header and the payload to \a dst, which must provide room for at least
+    \a capacity bytes. Returns the number of bytes written, or \c 0 if
+    \a capacity is too small to hold serializedSize() bytes.
+
+    \sa bytes()
+*/
+
 /*!
     \fn template <typename CodeType> QKnxNetIpStruct<CodeType>::constData() const
 
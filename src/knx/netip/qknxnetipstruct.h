@@ -114,6 +114,21 @@ public:
         return m_header.bytes() + m_data;
     }
 
+    quint16 serializedSize() const
+    {
+        return m_header.serializedSize() + m_data.size();
+    }
+
+    quint16 serializeInto(quint8 *dst, size_t capacity) const
+    {
+        if (!dst || capacity < serializedSize())
+            return 0;
+        const auto headerSize = m_header.serializeInto(dst, capacity);
+        if (!m_data.isEmpty())
+            memcpy(dst + headerSize, m_data.constData(), m_data.size());
+        return headerSize + m_data.size();
+    }
+
     static QKnxNetIpStruct fromBytes(const QKnxByteArray &bytes, quint16 index = 0)
     {
         auto header = QKnxNetIpStructHeader<CodeType>::fromBytes(bytes, index);
@@ -173,6 +173,24 @@ QT_BEGIN_NAMESPACE
     Returns an array of bytes that represent the KNXnet/IP structure header.
 */
 
+/*!
+    \fn template <typename CodeType> QKnxNetIpStructHeader<CodeType>::serializedSize() const
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for this header, which
+    is \c 2 or \c 4 depending on the structure size, or \c 0 for a null header.
+*/
+
+/*!
+    \fn template <typename CodeType> QKnxNetIpStructHeader<CodeType>::serializeInto(quint8 *dst, size_t capacity) const
+    \since 5.13
+
+    Writes the bytes that represent the KNXnet/IP structure header to \a dst,
+    which must provide room for at least \a capacity bytes. Returns the number
+    of bytes written, or \c 0 if the header is null or \a capacity is too
+    small.
+*/
+
 /*!
     \fn template <typename CodeType> static QKnxNetIpStructHeader<CodeType>::fromBytes(const QKnxByteArray &bytes, quint16 index = 0)
 
@@ -144,6 +144,22 @@ public:
         return {};
     }
 
+    quint16 serializedSize() const
+    {
+        if (size() == 2 || size() == 4)
+            return size();
+        return 0;
+    }
+
+    quint16 serializeInto(quint8 *dst, size_t capacity) const
+    {
+        const auto headerSize = serializedSize();
+        if (headerSize == 0 || !dst || capacity < headerSize)
+            return 0;
+        memcpy(dst, m_bytes + 1, headerSize);
+        return headerSize;
+    }
+
     static QKnxNetIpStructHeader fromBytes(const QKnxByteArray &bytes, quint16 index = 0)
     {
         const qint32 availableSize = bytes.size() - index;
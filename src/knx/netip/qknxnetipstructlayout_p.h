@@ -0,0 +1,210 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSTRUCTLAYOUT_P_H
+#define QKNXNETIPSTRUCTLAYOUT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxNetIpStructLayout
+{
+    enum class ByteOrder : quint8
+    {
+        BigEndian,
+        LittleEndian
+    };
+
+    template <int Width> struct Storage;
+    template <> struct Storage<1> { using Type = quint8; };
+    template <> struct Storage<2> { using Type = quint16; };
+    template <> struct Storage<4> { using Type = quint32; };
+    template <> struct Storage<6> { using Type = quint48; };
+    template <> struct Storage<8> { using Type = quint64; };
+
+    // Describes an unsigned integer field of Width bytes at Offset inside
+    // the data part of a KNXnet/IP structure. KNXnet/IP itself is big-endian,
+    // little-endian fields exist only for manufacturer specific data.
+    template <quint16 Offset, quint16 Width, ByteOrder Order = ByteOrder::BigEndian>
+    struct Field final
+    {
+        using Type = typename Storage<Width>::Type;
+
+        static constexpr quint16 offset() { return Offset; }
+        static constexpr quint16 width() { return Width; }
+        static constexpr quint16 end() { return Offset + Width; }
+
+        static Type read(const quint8 *data)
+        {
+            Type value = 0;
+            for (int i = 0; i < Width; ++i)
+                value |= Type(Type(data[Offset + i]) << shift(i));
+            return value;
+        }
+
+        static Type read(const QKnxByteArray &data)
+        {
+            if (data.size() < end())
+                return {};
+            return read(data.constData());
+        }
+
+        static void write(quint8 *data, Type value)
+        {
+            for (int i = 0; i < Width; ++i)
+                data[Offset + i] = quint8(value >> shift(i));
+        }
+
+        static void write(QKnxByteArray &data, Type value)
+        {
+            if (data.size() >= end())
+                write(data.data(), value);
+        }
+
+    private:
+        static constexpr int shift(int i)
+        {
+            return (Order == ByteOrder::BigEndian ? (Width - 1 - i) : i) * 8;
+        }
+    };
+
+    // Describes an opaque byte sequence of Width bytes at Offset, such as
+    // a MAC address, a serial number or a fixed size, zero padded string.
+    template <quint16 Offset, quint16 Width>
+    struct Bytes final
+    {
+        static constexpr quint16 offset() { return Offset; }
+        static constexpr quint16 width() { return Width; }
+        static constexpr quint16 end() { return Offset + Width; }
+
+        static QKnxByteArray read(const QKnxByteArray &data)
+        {
+            if (data.size() < end())
+                return {};
+            return QKnxByteArray(data.constData() + Offset, Width);
+        }
+
+        static QByteArray readString(const QKnxByteArray &data)
+        {
+            if (data.size() < end())
+                return {};
+            const auto string = reinterpret_cast<const char *> (data.constData() + Offset);
+            return QByteArray(string, int(qstrnlen(string, Width)));
+        }
+
+        static void write(quint8 *data, const quint8 *value, int size)
+        {
+            const int count = qBound(0, size, int(Width));
+            if (count > 0)
+                memcpy(data + Offset, value, size_t(count));
+            if (count < Width)
+                memset(data + Offset + count, 0, size_t(Width - count));
+        }
+
+        static void write(QKnxByteArray &data, const QKnxByteArray &value)
+        {
+            if (data.size() >= end())
+                write(data.data(), value.constData(), value.size());
+        }
+
+        static void write(QKnxByteArray &data, const QByteArray &value)
+        {
+            if (data.size() >= end()) {
+                write(data.data(), reinterpret_cast<const quint8 *> (value.constData()),
+                    value.size());
+            }
+        }
+    };
+
+    namespace Detail
+    {
+        template <typename... Fields> struct FieldList;
+
+        template <> struct FieldList<> final
+        {
+            static constexpr quint16 end() { return 0; }
+            static constexpr bool isOrdered() { return true; }
+        };
+
+        template <typename Last> struct FieldList<Last> final
+        {
+            static constexpr quint16 end() { return Last::end(); }
+            static constexpr bool isOrdered() { return true; }
+        };
+
+        template <typename First, typename Second, typename... Rest>
+        struct FieldList<First, Second, Rest...> final
+        {
+            static constexpr quint16 end() { return FieldList<Second, Rest...>::end(); }
+            static constexpr bool isOrdered()
+            {
+                return First::end() <= Second::offset()
+                    && FieldList<Second, Rest...>::isOrdered();
+            }
+        };
+    }
+
+    // Describes the data part of a fixed size KNXnet/IP structure of Size
+    // bytes. The fields must be listed in ascending, non overlapping order and
+    // must fit into the structure; both are checked at compile time. Bytes not
+    // covered by any field are reserved and written as zero.
+    template <quint16 Size, typename... Fields>
+    struct Layout final
+    {
+        static_assert(Detail::FieldList<Fields...>::isOrdered(),
+            "Layout fields overlap or are out of order.");
+        static_assert(Detail::FieldList<Fields...>::end() <= Size,
+            "Layout fields exceed the structure size.");
+
+        static constexpr quint16 size() { return Size; }
+
+        static bool hasSize(const QKnxByteArray &data) { return data.size() == Size; }
+
+        static QKnxByteArray create() { return QKnxByteArray(Size, 0x00); }
+    };
+}
+
+QT_END_NAMESPACE
+
+#endif
@@ -27,12 +27,28 @@
 **
 ******************************************************************************/
 
+#include "qknxbusmonitorbuffer.h"
+#include "qknxgroupvaluecache.h"
+#include "qknxlinklayerframebuilder.h"
 #include "qknxnetipconnectresponse.h"
 #include "qknxnetipendpointconnection_p.h"
 #include "qknxnetiptunnel.h"
 #include "qknxnetiptunnelingfeatureinfo.h"
 #include "qknxnetiptunnelingrequest.h"
 #include "qknxnetiptunnelingfeatureresponse.h"
+#include "qknxvirtualclock.h"
+
+#include <QtKnx/private/qknxbusloadestimator_p.h>
+#include <QtKnx/private/qknxnetipframescheduler_p.h>
+
+#include <QtCore/qbitarray.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qpointer.h>
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -111,10 +127,209 @@ public:
         , m_layer(l)
     {}
 
+    ~QKnxNetIpTunnelPrivate() override
+    {
+        cancelPendingReads();
+    }
+
     void process(const QKnxLinkLayerFrame &frame) override
     {
+        switch (frame.messageCode()) {
+        case QKnxLinkLayerFrame::MessageCode::DataIndication:
+        case QKnxLinkLayerFrame::MessageCode::DataConfirmation:
+            // confirmations stand for our own telegrams, which makes sure
+            // each telegram on the line is accounted for exactly once
+            m_busLoad.record(QKnxBusLoadEstimator::busTime(frame), elapsed());
+            break;
+        default:
+            break;
+        }
+
         Q_Q(QKnxNetIpTunnel);
         emit q->frameReceived(frame);
+
+        if (!m_pendingReads.isEmpty())
+            resolvePendingRead(frame);
+    }
+
+    void processTunnelingCemi(const QKnxNetIpFrame &frame) override
+    {
+        // capture bus monitor frames as they are, they get decoded when read
+        const auto &cemi = frame.constData();
+        if (m_busMonitorBuffer && cemi.size() > 0 && cemi.at(0)
+            == quint8(QKnxLinkLayerFrame::MessageCode::BusmonitorIndication)) {
+            m_busMonitorBuffer->write(cemi, QDateTime::currentMSecsSinceEpoch());
+            return;
+        }
+        QKnxNetIpEndpointConnectionPrivate::processTunnelingCemi(frame);
+    }
+
+    void processTunnelingAcknowledge(const QKnxNetIpFrame &frame) override
+    {
+        QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge(frame);
+        sendQueuedFrames();
+    }
+
+    bool isReplaceableWrite(const QKnxLinkLayerFrame &frame, quint16 group) const
+    {
+        return m_replaceWrites.testBit(group)
+            && frame.messageCode() == QKnxLinkLayerFrame::MessageCode::DataRequest
+            && frame.tpdu().applicationControlField()
+                == QKnxTpdu::ApplicationControlField::GroupValueWrite;
+    }
+
+    void enqueue(const QKnxLinkLayerFrame &frame)
+    {
+        const auto now = elapsed();
+        const auto priority = frame.controlField().priority();
+        const auto destination = frame.destinationAddress();
+        if (destination.type() == QKnxAddress::Type::Group) {
+            const auto group = destination.toUInt16();
+            if (isReplaceableWrite(frame, group)) {
+                // the pending write keeps its place in the queue, only the value changes;
+                // at another priority the older value could be sent after the new one,
+                // so it is dropped and the new value is queued at its own priority
+                const auto it = m_pendingWrites.constFind(group);
+                if (it != m_pendingWrites.constEnd()) {
+                    if (it->priority == priority && m_scheduler.replace(it->id, frame))
+                        return;
+                    m_scheduler.remove(it->id);
+                }
+                m_pendingWrites.insert(group,
+                    { m_scheduler.enqueue(frame, priority, now), priority });
+                return;
+            }
+            // anything queued after a write must not be overtaken by a newer value
+            m_pendingWrites.remove(group);
+        }
+        m_scheduler.enqueue(frame, priority, now);
+    }
+
+    void sendQueuedFrames()
+    {
+        while (!m_waitForAcknowledgement && !m_scheduler.isEmpty()) {
+            const auto now = elapsed();
+            if (m_busLoad.isThrottled(now)) {
+                if (!m_throttleTimer.isActive())
+                    m_throttleTimer.start(m_busLoad.nextDecay(now));
+                return;
+            }
+
+            quint64 id = 0;
+            const auto frame = m_scheduler.dequeue(now, &id);
+            const auto destination = frame.destinationAddress();
+            if (destination.type() == QKnxAddress::Type::Group) {
+                const auto it = m_pendingWrites.find(destination.toUInt16());
+                if (it != m_pendingWrites.end() && it->id == id)
+                    m_pendingWrites.erase(it);
+            }
+            sendTunnelingRequest(frame);
+        }
+    }
+
+    void clearQueue()
+    {
+        m_throttleTimer.stop();
+        m_scheduler.clear();
+        m_pendingWrites.clear();
+    }
+
+    static QFuture<QKnxByteArray> finishedRead(const QKnxByteArray &value)
+    {
+        QFutureInterface<QKnxByteArray> result(QFutureInterfaceBase::Started);
+        result.reportResult(value);
+        result.reportFinished();
+        return result.future();
+    }
+
+    static QFuture<QKnxByteArray> canceledRead()
+    {
+        QFutureInterface<QKnxByteArray> result(QFutureInterfaceBase::Started);
+        result.reportCanceled();
+        result.reportFinished();
+        return result.future();
+    }
+
+    void resolvePendingRead(const QKnxLinkLayerFrame &frame)
+    {
+        if (frame.messageCode() != QKnxLinkLayerFrame::MessageCode::DataIndication)
+            return;
+
+        const auto destination = frame.destinationAddress();
+        if (destination.type() != QKnxAddress::Type::Group)
+            return;
+
+        auto it = m_pendingReads.find(destination.toUInt16());
+        if (it == m_pendingReads.end())
+            return;
+
+        // a group value write seen while waiting carries the current value as well
+        const auto tpdu = frame.tpdu();
+        switch (tpdu.applicationControlField()) {
+        case QKnxTpdu::ApplicationControlField::GroupValueWrite:
+        case QKnxTpdu::ApplicationControlField::GroupValueResponse:
+            break;
+        default:
+            return;
+        }
+
+        auto result = it->result;
+        m_pendingReads.erase(it);
+        scheduleReadTimeout();
+
+        result.reportResult(tpdu.data());
+        result.reportFinished();
+    }
+
+    void expirePendingReads()
+    {
+        QVector<QFutureInterface<QKnxByteArray>> expired;
+        const auto now = elapsed();
+        for (auto it = m_pendingReads.begin(); it != m_pendingReads.end();) {
+            if (it->deadline <= now) {
+                expired.append(it->result);
+                it = m_pendingReads.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        scheduleReadTimeout();
+
+        for (auto &result : expired) {
+            result.reportCanceled();
+            result.reportFinished();
+        }
+    }
+
+    void cancelPendingReads()
+    {
+        const auto pending = m_pendingReads;
+        m_pendingReads.clear();
+        m_readTimer.stop();
+
+        for (auto read : pending) {
+            read.result.reportCanceled();
+            read.result.reportFinished();
+        }
+    }
+
+    void scheduleReadTimeout()
+    {
+        if (m_pendingReads.isEmpty()) {
+            m_readTimer.stop();
+            return;
+        }
+
+        qint64 next = std::numeric_limits<qint64>::max();
+        for (const auto &read : qAsConst(m_pendingReads))
+            next = qMin(next, read.deadline);
+        m_readTimer.start(int(qMax<qint64>(0, next - elapsed())));
+    }
+
+    // read deadlines run on the virtual clock the tunnel was created with, if any
+    qint64 elapsed() const
+    {
+        return m_virtualClock ? m_virtualClock->elapsed() : m_clock.elapsed();
     }
 
     void processConnectResponse(const QKnxNetIpFrame &frame) override
@@ -172,6 +387,31 @@ private:
     QKnxAddress m_address;
     QKnxAddress m_criAddress;
     QKnxNetIp::TunnelLayer m_layer { QKnxNetIp::TunnelLayer::Unknown };
+
+    struct PendingRead
+    {
+        QFutureInterface<QKnxByteArray> result;
+        qint64 deadline; // in milliseconds of elapsed()
+    };
+    QHash<quint16, PendingRead> m_pendingReads;
+
+    struct PendingWrite
+    {
+        quint64 id;
+        QKnxControlField::Priority priority;
+    };
+    QKnxNetIpFrameScheduler<QKnxLinkLayerFrame> m_scheduler;
+    QHash<quint16, PendingWrite> m_pendingWrites;
+
+    QKnxBusLoadEstimator m_busLoad;
+    QElapsedTimer m_clock;
+    QKnxTimer m_throttleTimer;
+    QBitArray m_replaceWrites { 65536 };
+
+    QKnxTimer m_readTimer;
+    QPointer<QKnxVirtualClock> m_virtualClock;
+    QPointer<QKnxGroupValueCache> m_cache;
+    QKnxBusMonitorBuffer *m_busMonitorBuffer { nullptr };
 };
 
 /*!
@@ -209,7 +449,23 @@ QKnxNetIpTunnel::QKnxNetIpTunnel(const QHostAddress &localAddress,
         quint16 localPort, QKnxNetIp::TunnelLayer layer, QObject *parent)
     : QKnxNetIpEndpointConnection(*new QKnxNetIpTunnelPrivate(localAddress, localPort,
         layer), parent)
-{}
+{
+    Q_D(QKnxNetIpTunnel);
+    d->m_clock.start();
+    d->m_throttleTimer.setSingleShot(true);
+    QObject::connect(&d->m_throttleTimer, &QKnxTimer::timeout, this, [d]() {
+        d->sendQueuedFrames();
+    });
+    d->m_virtualClock = QKnxVirtualClock::installed();
+    d->m_readTimer.setSingleShot(true);
+    QObject::connect(&d->m_readTimer, &QKnxTimer::timeout, this, [d]() {
+        d->expirePendingReads();
+    });
+    QObject::connect(this, &QKnxNetIpEndpointConnection::disconnected, this, [d]() {
+        d->clearQueue();
+        d->cancelPendingReads();
+    });
+}
 
 /*!
     Returns the individual address of the KNXnet/IP client assigned by the
@@ -285,6 +541,217 @@ bool QKnxNetIpTunnel::sendFrame(const QKnxLinkLayerFrame &frame)
     return d->sendTunnelingRequest(frame);
 }
 
+/*!
+    \since 5.13
+
+    Appends the link layer frame \a frame to the outbound queue of the tunnel.
+    Queued frames are sent one after the other, each as soon as the previous
+    tunneling request has been acknowledged by the KNXnet/IP server.
+
+    The queue drains frames by the priority set in their control field: system
+    frames first, followed by urgent, normal, and low priority frames. Frames
+    of the same priority are sent in the order they were queued. To keep low
+    priority traffic from starving, a waiting frame is treated as one priority
+    higher for each queueAgingInterval() it has spent in the queue.
+
+    If the queue policy for the destination group address of \a frame is
+    QueuePolicy::ReplacePendingWrite and \a frame is a group value write, a
+    group value write of the same priority to the same address that is still
+    waiting in the queue is replaced by \a frame. The replaced write keeps its
+    position in the queue.
+
+    Returns \c false and does not queue the frame if no connection is currently
+    established or the tunnel runs in bus monitor mode.
+
+    \note Frames sent with sendFrame() bypass the queue.
+
+    \sa setQueuePolicy(), queuedFrameCount()
+*/
+bool QKnxNetIpTunnel::enqueueFrame(const QKnxLinkLayerFrame &frame)
+{
+    if (state() != State::Connected)
+        return false;
+
+    Q_D(QKnxNetIpTunnel);
+    if (d->m_layer == QKnxNetIp::TunnelLayer::Busmonitor)
+        return false; // 03_08_04 Tunneling v01.05.03, paragraph 2.4
+
+    d->enqueue(frame);
+    d->sendQueuedFrames();
+    return true;
+}
+
+/*!
+    \since 5.13
+
+    Returns the number of frames waiting in the outbound queue.
+*/
+int QKnxNetIpTunnel::queuedFrameCount() const
+{
+    return d_func()->m_scheduler.size();
+}
+
+/*!
+    \since 5.13
+
+    Returns the time in milliseconds after which a queued frame is moved up by
+    one priority level. The default is 500 milliseconds.
+
+    \sa enqueueFrame()
+*/
+int QKnxNetIpTunnel::queueAgingInterval() const
+{
+    return d_func()->m_scheduler.agingInterval();
+}
+
+/*!
+    \since 5.13
+
+    Sets the aging interval of the outbound queue to \a msec milliseconds. An
+    interval of \c 0 disables aging, frames are then drained strictly by
+    priority.
+*/
+void QKnxNetIpTunnel::setQueueAgingInterval(int msec)
+{
+    d_func()->m_scheduler.setAgingInterval(msec);
+}
+
+/*!
+    \since 5.13
+
+    Returns the average time in milliseconds frames of the given \a priority
+    spent in the outbound queue before they were sent.
+
+    \sa maximumQueueLatency()
+*/
+qint64 QKnxNetIpTunnel::averageQueueLatency(QKnxControlField::Priority priority) const
+{
+    return d_func()->m_scheduler.latency(priority).average();
+}
+
+/*!
+    \since 5.13
+
+    Returns the longest time in milliseconds a frame of the given \a priority
+    spent in the outbound queue before it was sent.
+
+    \sa averageQueueLatency()
+*/
+qint64 QKnxNetIpTunnel::maximumQueueLatency(QKnxControlField::Priority priority) const
+{
+    return d_func()->m_scheduler.latency(priority).maximum;
+}
+
+/*!
+    \since 5.13
+
+    Returns the estimated utilization of the KNX line the tunnel is connected
+    to, between \c 0 for an idle line and \c 1 for a line that was busy all the
+    time during the last second.
+
+    The estimate assumes a TP1 line running at 9600 bit/s. It is computed from
+    the link layer frames received by the tunnel, data indications for foreign
+    telegrams and data confirmations for the telegrams sent by the tunnel, so
+    it requires a tunnel at link layer.
+
+    \sa setBusLoadLimit()
+*/
+qreal QKnxNetIpTunnel::busLoad() const
+{
+    Q_D(const QKnxNetIpTunnel);
+    return d->m_busLoad.load(d->elapsed());
+}
+
+/*!
+    \since 5.13
+
+    Returns the bus load above which the outbound queue holds back frames. The
+    default is \c 1, which disables throttling.
+
+    \sa busLoad(), enqueueFrame()
+*/
+qreal QKnxNetIpTunnel::busLoadLimit() const
+{
+    return d_func()->m_busLoad.limit();
+}
+
+/*!
+    \since 5.13
+
+    Sets the bus load above which the outbound queue holds back frames to
+    \a limit, a value between \c 0 and \c 1. While busLoad() is at or above
+    \a limit, queued frames wait until the load has decreased. Frames sent
+    with sendFrame() are not throttled.
+
+    For example, a limit of \c 0.4 keeps bulk reads from loading a line with
+    more than 40 percent of its capacity.
+
+    A \a limit of \c 0 or less would hold back queued frames forever, even on
+    an idle line. It is treated like \c 1 and disables throttling.
+*/
+void QKnxNetIpTunnel::setBusLoadLimit(qreal limit)
+{
+    Q_D(QKnxNetIpTunnel);
+    d->m_busLoad.setLimit(limit);
+    d->sendQueuedFrames();
+}
+
+/*!
+    \since 5.13
+
+    Removes all frames from the outbound queue without sending them. The queue
+    is also cleared if the connection is closed.
+*/
+void QKnxNetIpTunnel::clearQueue()
+{
+    d_func()->clearQueue();
+}
+
+/*!
+    \since 5.13
+
+    Returns the queue policy applied to frames sent to the group \a address.
+    For all other addresses QueuePolicy::Append is returned.
+*/
+QKnxNetIpTunnel::QueuePolicy QKnxNetIpTunnel::queuePolicy(const QKnxAddress &address) const
+{
+    if (address.type() != QKnxAddress::Type::Group)
+        return QueuePolicy::Append;
+    return d_func()->m_replaceWrites.testBit(address.toUInt16())
+        ? QueuePolicy::ReplacePendingWrite : QueuePolicy::Append;
+}
+
+/*!
+    \since 5.13
+
+    Sets the queue \a policy for all group addresses. The default policy is
+    QueuePolicy::Append.
+*/
+void QKnxNetIpTunnel::setQueuePolicy(QueuePolicy policy)
+{
+    d_func()->m_replaceWrites.fill(policy == QueuePolicy::ReplacePendingWrite);
+}
+
+/*!
+    \since 5.13
+
+    Sets the queue \a policy for the group addresses from \a first to \a last,
+    inclusive. Policies set for other addresses are left untouched.
+
+    Changing the policy does not affect frames that are already queued.
+*/
+void QKnxNetIpTunnel::setQueuePolicy(QueuePolicy policy, const QKnxAddress &first,
+    const QKnxAddress &last)
+{
+    if (first.type() != QKnxAddress::Type::Group || last.type() != QKnxAddress::Type::Group)
+        return;
+
+    const int begin = first.toUInt16(), end = last.toUInt16();
+    if (begin > end)
+        return;
+    d_func()->m_replaceWrites.fill(policy == QueuePolicy::ReplacePendingWrite, begin, end + 1);
+}
+
 /*!
     \since 5.12
 
@@ -332,4 +799,129 @@ bool QKnxNetIpTunnel::sendTunnelingFeatureSet(QKnx::InterfaceFeature feature,
     return d->sendTunnelingFeatureSet(feature, value);
 }
 
+/*!
+    \since 5.13
+
+    Returns the buffer bus monitor frames are captured to, or \c nullptr if
+    no buffer is set.
+
+    \sa setBusMonitorBuffer()
+*/
+QKnxBusMonitorBuffer *QKnxNetIpTunnel::busMonitorBuffer() const
+{
+    return d_func()->m_busMonitorBuffer;
+}
+
+/*!
+    \since 5.13
+
+    Sets the buffer bus monitor frames are captured to to \a buffer. Pass
+    \c nullptr to stop capturing.
+
+    While a buffer is set, every bus monitor indication received by the tunnel
+    is written to \a buffer together with its time of arrival, without being
+    decoded and without emitting frameReceived(). All other frames are handled
+    as usual. The tunnel does not take ownership of the buffer; the buffer
+    must outlive the tunnel or be unset before it is destroyed.
+
+    \sa QKnxNetIp::TunnelLayer
+*/
+void QKnxNetIpTunnel::setBusMonitorBuffer(QKnxBusMonitorBuffer *buffer)
+{
+    d_func()->m_busMonitorBuffer = buffer;
+}
+
+/*!
+    \since 5.13
+
+    Returns the group value cache consulted by readGroupValue(), or \c nullptr
+    if no cache is set.
+
+    \sa setGroupValueCache()
+*/
+QKnxGroupValueCache *QKnxNetIpTunnel::groupValueCache() const
+{
+    return d_func()->m_cache;
+}
+
+/*!
+    \since 5.13
+
+    Sets the group value cache consulted by readGroupValue() to \a cache. The
+    tunnel does not take ownership of the cache and does not feed it, use
+    QKnxGroupValueCache::attach() to record the values received by the tunnel.
+*/
+void QKnxNetIpTunnel::setGroupValueCache(QKnxGroupValueCache *cache)
+{
+    d_func()->m_cache = cache;
+}
+
+/*!
+    \since 5.13
+
+    Reads the value of the group \a address and returns a future that holds
+    the value once the first group value response or group value write for
+    the address has been received.
+
+    If a group value cache is set and holds a value for \a address that is at
+    most \a maxAge milliseconds old, the returned future is already finished
+    and nothing is sent to the bus. Concurrent reads of the same address share
+    a single group value read request; the request is kept alive for the
+    longest \a timeout (in milliseconds) of all waiting readers.
+
+    The returned future is canceled if no value is received in time, if the
+    connection is closed while waiting, if \a address is not a group address,
+    if no connection is currently established, or if the tunnel runs in bus
+    monitor mode.
+
+    \note The returned future reports its result from the thread the tunnel
+    lives in; use QFutureWatcher to get notified.
+
+    \sa setGroupValueCache()
+*/
+QFuture<QKnxByteArray> QKnxNetIpTunnel::readGroupValue(const QKnxAddress &address, int timeout,
+    int maxAge)
+{
+    if (address.type() != QKnxAddress::Type::Group)
+        return QKnxNetIpTunnelPrivate::canceledRead();
+
+    Q_D(QKnxNetIpTunnel);
+    if (maxAge > 0 && d->m_cache) {
+        QKnxByteArray value;
+        QDateTime timestamp;
+        if (d->m_cache->lookup(address, &value, &timestamp)
+            && timestamp.msecsTo(QDateTime::currentDateTime()) <= maxAge) {
+            return QKnxNetIpTunnelPrivate::finishedRead(value);
+        }
+    }
+
+    const qint64 deadline = d->elapsed() + qMax(0, timeout);
+    auto it = d->m_pendingReads.find(address.toUInt16());
+    if (it != d->m_pendingReads.end() && !it->result.isCanceled()) {
+        if (it->deadline < deadline) {
+            it->deadline = deadline;
+            d->scheduleReadTimeout();
+        }
+        return it->result.future();
+    }
+
+    if (state() != State::Connected || d->m_layer == QKnxNetIp::TunnelLayer::Busmonitor)
+        return QKnxNetIpTunnelPrivate::canceledRead();
+
+    QKnxNetIpTunnelPrivate::PendingRead read;
+    read.result.reportStarted();
+    read.deadline = deadline;
+    d->m_pendingReads.insert(address.toUInt16(), read);
+    d->scheduleReadTimeout();
+
+    d->enqueue(QKnxLinkLayerFrame::builder()
+        .setDestinationAddress(address)
+        .setTpdu({ QKnxTpdu::TransportControlField::DataGroup,
+            QKnxTpdu::ApplicationControlField::GroupValueRead })
+        .createFrame());
+    d->sendQueuedFrames();
+
+    return read.result.future();
+}
+
 QT_END_NAMESPACE
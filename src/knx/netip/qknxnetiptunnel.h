@@ -35,8 +35,12 @@
 #include <QtKnx/qknxnetipendpointconnection.h>
 #include <QtKnx/qknxlinklayerframe.h>
 
+#include <QtCore/qfuture.h>
+
 QT_BEGIN_NAMESPACE
 
+class QKnxBusMonitorBuffer;
+class QKnxGroupValueCache;
 class QKnxNetIpTunnelPrivate;
 class Q_KNX_EXPORT QKnxNetIpTunnel final : public QKnxNetIpEndpointConnection
 {
@@ -45,6 +49,13 @@ class Q_KNX_EXPORT QKnxNetIpTunnel final : public QKnxNetIpEndpointConnection
     Q_DECLARE_PRIVATE(QKnxNetIpTunnel)
 
 public:
+    enum class QueuePolicy : quint8
+    {
+        Append,
+        ReplacePendingWrite
+    };
+    Q_ENUM(QueuePolicy)
+
     QKnxNetIpTunnel(QObject *parent = nullptr);
     ~QKnxNetIpTunnel() override = default;
 
@@ -61,9 +72,36 @@ public:
 
     bool sendFrame(const QKnxLinkLayerFrame &frame);
 
+    bool enqueueFrame(const QKnxLinkLayerFrame &frame);
+    int queuedFrameCount() const;
+    void clearQueue();
+
+    int queueAgingInterval() const;
+    void setQueueAgingInterval(int msec);
+
+    qint64 averageQueueLatency(QKnxControlField::Priority priority) const;
+    qint64 maximumQueueLatency(QKnxControlField::Priority priority) const;
+
+    qreal busLoad() const;
+    qreal busLoadLimit() const;
+    void setBusLoadLimit(qreal limit);
+
+    QueuePolicy queuePolicy(const QKnxAddress &address) const;
+    void setQueuePolicy(QueuePolicy policy);
+    void setQueuePolicy(QueuePolicy policy, const QKnxAddress &first, const QKnxAddress &last);
+
     bool sendTunnelingFeatureGet(QKnx::InterfaceFeature feature);
     bool sendTunnelingFeatureSet(QKnx::InterfaceFeature feature, const QKnxByteArray &value);
 
+    QKnxBusMonitorBuffer *busMonitorBuffer() const;
+    void setBusMonitorBuffer(QKnxBusMonitorBuffer *buffer);
+
+    QKnxGroupValueCache *groupValueCache() const;
+    void setGroupValueCache(QKnxGroupValueCache *cache);
+
+    QFuture<QKnxByteArray> readGroupValue(const QKnxAddress &address, int timeout = 3000,
+        int maxAge = 0);
+
 Q_SIGNALS:
     void frameReceived(QKnxLinkLayerFrame frame);
 
@@ -0,0 +1,111 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxtimer_p.h"
+#include "qknxtimerwheel_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QKnxTimer::QKnxTimer(QObject *parent)
+    : QObject(parent)
+    , m_clock(QKnxVirtualClock::installed())
+{
+    if (m_clock)
+        m_clock->registerTimer(this);
+}
+
+QKnxTimer::~QKnxTimer()
+{
+    stop();
+    if (m_clock)
+        m_clock->unregisterTimer(this);
+}
+
+void QKnxTimer::setInterval(int msec)
+{
+    m_interval = msec;
+    if (m_active)
+        start(); // same as QTimer, an active timer restarts with the new interval
+}
+
+int QKnxTimer::remainingTime() const
+{
+    if (!m_active)
+        return -1;
+    const qint64 now = m_clock ? m_clock->elapsed() : m_wheel->now();
+    return int(qMax<qint64>(0, m_deadline - now));
+}
+
+void QKnxTimer::start()
+{
+    stop();
+    m_active = true;
+
+    if (m_clock) {
+        m_deadline = m_clock->elapsed() + qMax(0, m_interval);
+        m_sequence = m_clock->nextSequence();
+        return;
+    }
+
+    m_wheel = QKnxTimerWheel::instance();
+    m_wheel->arm(this, m_wheel->now() + qMax(0, m_interval));
+}
+
+void QKnxTimer::start(int msec)
+{
+    m_interval = msec;
+    start();
+}
+
+void QKnxTimer::stop()
+{
+    if (m_wheel) {
+        m_wheel->cancel(this);
+        m_wheel = nullptr;
+    }
+    m_active = false;
+}
+
+void QKnxTimer::fire()
+{
+    // the wheel has already unlinked the timer
+    if (m_singleShot) {
+        m_wheel = nullptr;
+        m_active = false;
+    } else if (m_clock) {
+        // never fire twice at the same virtual time, advance() would not return
+        m_deadline += qMax(1, m_interval);
+        m_sequence = m_clock->nextSequence();
+    } else {
+        m_wheel->arm(this, m_wheel->now() + qMax(1, m_interval));
+    }
+    emit timeout();
+}
+
+QT_END_NAMESPACE
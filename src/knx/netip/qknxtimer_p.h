@@ -0,0 +1,106 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXTIMER_P_H
+#define QKNXTIMER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtKnx/qknxvirtualclock.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxTimerWheel;
+
+// Drop-in replacement for the subset of QTimer used by the protocol state
+// machines. A timer created while a QKnxVirtualClock is installed runs on
+// that clock's virtual time, otherwise it is driven by the thread's shared
+// QKnxTimerWheel and behaves like a coarse QTimer.
+class Q_KNX_EXPORT QKnxTimer final : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QKnxTimer(QObject *parent = nullptr);
+    ~QKnxTimer() override;
+
+    bool isVirtual() const { return !m_clock.isNull(); }
+
+    bool isActive() const { return m_active; }
+    bool isSingleShot() const { return m_singleShot; }
+    void setSingleShot(bool singleShot) { m_singleShot = singleShot; }
+
+    int interval() const { return m_interval; }
+    void setInterval(int msec);
+    int remainingTime() const;
+
+    void start();
+    void start(int msec);
+    void stop();
+
+Q_SIGNALS:
+    void timeout();
+
+private:
+    friend class QKnxTimerWheel;
+    friend class QKnxVirtualClock;
+    friend class QKnxVirtualClockPrivate;
+    void fire();
+
+    QPointer<QKnxVirtualClock> m_clock;
+    int m_interval { 0 };
+    bool m_singleShot { false };
+    bool m_active { false };
+
+    qint64 m_deadline { 0 }; // in milliseconds of the clock or wheel
+    quint64 m_sequence { 0 };
+
+    // intrusive list node of the timer wheel, level -1 is the expiring list
+    QKnxTimerWheel *m_wheel { nullptr };
+    QKnxTimer *m_wheelPrev { nullptr };
+    QKnxTimer *m_wheelNext { nullptr };
+    int m_wheelLevel { 0 };
+    int m_wheelSlot { 0 };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,247 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxtimer_p.h"
+#include "qknxtimerwheel_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxPrivate
+{
+    static QThreadStorage<QKnxTimerWheel *> timerWheels;
+
+    static quint64 rotateRight(quint64 value, int count)
+    {
+        return count ? (value >> count) | (value << (64 - count)) : value;
+    }
+}
+
+QKnxTimerWheel::QKnxTimerWheel()
+{
+    m_clock.start();
+}
+
+QKnxTimerWheel::~QKnxTimerWheel()
+{
+    // detach timers that outlive the thread's wheel, they simply never fire
+    const auto detach = [](QKnxTimer *timer) {
+        while (timer) {
+            auto next = timer->m_wheelNext;
+            timer->m_wheel = nullptr;
+            timer->m_active = false;
+            timer = next;
+        }
+    };
+    for (int level = 0; level < LevelCount; ++level) {
+        for (int slot = 0; slot < SlotCount; ++slot)
+            detach(m_slots[level][slot]);
+    }
+    detach(m_expiring);
+}
+
+QKnxTimerWheel *QKnxTimerWheel::instance()
+{
+    auto &wheels = QKnxPrivate::timerWheels;
+    if (!wheels.hasLocalData())
+        wheels.setLocalData(new QKnxTimerWheel);
+    return wheels.localData();
+}
+
+void QKnxTimerWheel::arm(QKnxTimer *timer, qint64 deadline)
+{
+    // without anything due, the wheel can skip to the current time; this keeps
+    // new timers on the lowest possible level
+    const qint64 now = m_clock.elapsed();
+    if (nextTick() > now)
+        m_current = qMax(m_current, now + 1);
+
+    timer->m_wheel = this;
+    timer->m_deadline = deadline;
+    insert(timer);
+    ++m_count;
+
+    if (!m_expiring)
+        scheduleOsTimer();
+}
+
+void QKnxTimerWheel::cancel(QKnxTimer *timer)
+{
+    if (timer->m_wheel != this)
+        return;
+
+    unlink(timer);
+    timer->m_wheel = nullptr;
+    if (--m_count == 0 && m_osTimerId) {
+        killTimer(m_osTimerId);
+        m_osTimerId = 0;
+    }
+}
+
+void QKnxTimerWheel::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_osTimerId) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    killTimer(m_osTimerId);
+    m_osTimerId = 0;
+
+    const qint64 now = m_clock.elapsed();
+    for (qint64 tick = nextTick(); tick <= now; tick = nextTick())
+        process(tick);
+    m_current = qMax(m_current, now + 1);
+
+    scheduleOsTimer();
+}
+
+void QKnxTimerWheel::insert(QKnxTimer *timer)
+{
+    const qint64 deadline = qMax(timer->m_deadline, m_current);
+    const quint64 delta = quint64(deadline - m_current);
+
+    int level = 0;
+    while (level < LevelCount - 1 && delta >= (quint64(1) << (LevelBits * (level + 1))))
+        ++level;
+    const int slot = int((deadline >> (LevelBits * level)) & (SlotCount - 1));
+
+    auto &head = m_slots[level][slot];
+    timer->m_wheelLevel = level;
+    timer->m_wheelSlot = slot;
+    timer->m_wheelPrev = nullptr;
+    timer->m_wheelNext = head;
+    if (head)
+        head->m_wheelPrev = timer;
+    head = timer;
+    m_occupied[level] |= quint64(1) << slot;
+}
+
+void QKnxTimerWheel::unlink(QKnxTimer *timer)
+{
+    const int level = timer->m_wheelLevel;
+    const int slot = timer->m_wheelSlot;
+    auto &head = (level < 0) ? m_expiring : m_slots[level][slot];
+
+    if (timer->m_wheelPrev)
+        timer->m_wheelPrev->m_wheelNext = timer->m_wheelNext;
+    else
+        head = timer->m_wheelNext;
+    if (timer->m_wheelNext)
+        timer->m_wheelNext->m_wheelPrev = timer->m_wheelPrev;
+
+    timer->m_wheelPrev = nullptr;
+    timer->m_wheelNext = nullptr;
+    if (level >= 0 && !head)
+        m_occupied[level] &= ~(quint64(1) << slot);
+}
+
+qint64 QKnxTimerWheel::nextTick() const
+{
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (int level = 0; level < LevelCount; ++level) {
+        if (!m_occupied[level])
+            continue;
+
+        // a slot of this level is expired or cascaded at the first multiple of
+        // 64^level, not before the current tick, that maps to the slot
+        const int shift = LevelBits * level;
+        const qint64 block = (m_current + (qint64(1) << shift) - 1) >> shift;
+        const int start = int(block & (SlotCount - 1));
+        const auto steps = qCountTrailingZeroBits(QKnxPrivate::rotateRight(m_occupied[level],
+            start));
+        next = qMin(next, (block + steps) << shift);
+    }
+    return next;
+}
+
+void QKnxTimerWheel::process(qint64 tick)
+{
+    m_current = tick;
+
+    // move timers of the upper levels down first, they might be due now
+    for (int level = LevelCount - 1; level > 0; --level) {
+        const int shift = LevelBits * level;
+        if (tick & ((qint64(1) << shift) - 1))
+            continue;
+
+        const int slot = int((tick >> shift) & (SlotCount - 1));
+        auto timer = m_slots[level][slot];
+        m_slots[level][slot] = nullptr;
+        m_occupied[level] &= ~(quint64(1) << slot);
+        while (timer) {
+            auto next = timer->m_wheelNext;
+            insert(timer);
+            timer = next;
+        }
+    }
+
+    const int slot = int(tick & (SlotCount - 1));
+    m_expiring = m_slots[0][slot];
+    m_slots[0][slot] = nullptr;
+    m_occupied[0] &= ~(quint64(1) << slot);
+    for (auto timer = m_expiring; timer; timer = timer->m_wheelNext)
+        timer->m_wheelLevel = -1;
+
+    // timers re-armed by a timeout land in a later tick
+    m_current = tick + 1;
+
+    // a timeout might stop or delete any other expiring timer, so always
+    // take the current list head
+    while (auto timer = m_expiring) {
+        unlink(timer);
+        --m_count;
+        timer->fire();
+    }
+}
+
+void QKnxTimerWheel::scheduleOsTimer()
+{
+    if (m_count == 0)
+        return;
+
+    const qint64 next = nextTick();
+    if (m_osTimerId) {
+        if (m_osTimerTick <= next)
+            return; // fires early enough, a premature wake up only reschedules
+        killTimer(m_osTimerId);
+    }
+
+    const qint64 interval = qBound<qint64>(0, next - m_clock.elapsed(),
+        std::numeric_limits<int>::max());
+    m_osTimerId = startTimer(int(interval), Qt::CoarseTimer);
+    m_osTimerTick = next;
+}
+
+QT_END_NAMESPACE
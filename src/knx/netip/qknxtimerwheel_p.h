@@ -0,0 +1,98 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXTIMERWHEEL_P_H
+#define QKNXTIMERWHEEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qobject.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxTimer;
+
+// Hierarchical hashed timer wheel with a resolution of one millisecond that
+// drives all wall clock QKnxTimer instances of a thread with a single OS
+// timer. Each level has 64 slots, a slot of level n spans 64^n ticks; timers
+// are kept in intrusive lists, so arming and canceling is O(1). The OS timer
+// is only armed for the next tick that has a slot to expire or cascade.
+class Q_KNX_EXPORT QKnxTimerWheel final : public QObject
+{
+public:
+    enum : int { LevelBits = 6, SlotCount = 1 << LevelBits, LevelCount = 6 };
+
+    ~QKnxTimerWheel() override;
+
+    static QKnxTimerWheel *instance();
+
+    qint64 now() const { return m_clock.elapsed(); }
+    int count() const { return m_count; }
+
+    void arm(QKnxTimer *timer, qint64 deadline);
+    void cancel(QKnxTimer *timer);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    QKnxTimerWheel();
+
+    void insert(QKnxTimer *timer);
+    void unlink(QKnxTimer *timer);
+    qint64 nextTick() const;
+    void process(qint64 tick);
+    void scheduleOsTimer();
+
+    QElapsedTimer m_clock;
+    qint64 m_current { 0 }; // the next tick to process
+    int m_count { 0 };
+
+    int m_osTimerId { 0 };
+    qint64 m_osTimerTick { 0 };
+
+    quint64 m_occupied[LevelCount] {};
+    QKnxTimer *m_slots[LevelCount][SlotCount] {};
+    QKnxTimer *m_expiring { nullptr };
+};
+
+QT_END_NAMESPACE
+
+#endif
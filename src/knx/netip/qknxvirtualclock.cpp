@@ -0,0 +1,248 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxtimer_p.h"
+#include "qknxvirtualclock.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qvector.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxVirtualClock
+
+    \inmodule QtKnx
+    \ingroup qtknx-netip
+    \since 5.13
+
+    \brief The QKnxVirtualClock class drives the KNXnet/IP protocol timers
+    with deterministic virtual time.
+
+    All timers of the KNXnet/IP endpoint connections, the router and the
+    server discovery and description agents, such as the heartbeat, connect,
+    connection state, disconnect, acknowledge and routing busy timers, are
+    created through an internal timer service. Timers created while a virtual
+    clock is installed do not run on wall clock time, but only advance when
+    advance() or advanceToNextTimeout() is called. This allows to simulate
+    hours of heartbeat and retry behavior in milliseconds and makes timer
+    heavy scenarios reproducible.
+
+    Timers stay bound to the clock that was installed when they were created,
+    even if the clock is uninstalled later. Protocol timers are created when a
+    connection is established or a router or agent is started, so the clock
+    should be installed before that.
+
+    \code
+        QKnxVirtualClock clock;
+        clock.install();
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.connectToHost(QHostAddress::LocalHost, 3671);
+        clock.advance(QKnxNetIp::ConnectRequestTimeout); // connect request times out
+    \endcode
+
+    Timeouts fire in the order of their deadlines; timers with the same
+    deadline fire in the order they were started. A slot connected to a
+    timeout observes elapsed() at the timer's deadline. Network I/O still
+    needs a running event loop.
+*/
+
+class QKnxVirtualClockPrivate final : public QObjectPrivate
+{
+public:
+    QKnxTimer *nextTimer() const;
+
+    qint64 m_elapsed { 0 };
+    quint64 m_sequence { 0 };
+    QVector<QKnxTimer *> m_timers;
+
+    static QBasicAtomicPointer<QKnxVirtualClock> s_installed;
+};
+
+QBasicAtomicPointer<QKnxVirtualClock> QKnxVirtualClockPrivate::s_installed = Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+
+QKnxTimer *QKnxVirtualClockPrivate::nextTimer() const
+{
+    QKnxTimer *next = nullptr;
+    for (auto timer : m_timers) {
+        if (!timer->m_active)
+            continue;
+        if (!next || timer->m_deadline < next->m_deadline
+            || (timer->m_deadline == next->m_deadline
+                && timer->m_sequence < next->m_sequence)) {
+            next = timer;
+        }
+    }
+    return next;
+}
+
+/*!
+    Creates a virtual clock at elapsed time \c 0 with the parent \a parent.
+    The clock is not installed.
+*/
+QKnxVirtualClock::QKnxVirtualClock(QObject *parent)
+    : QObject(*new QKnxVirtualClockPrivate, parent)
+{}
+
+/*!
+    Uninstalls and destroys the clock. Active timers bound to the clock are
+    stopped.
+*/
+QKnxVirtualClock::~QKnxVirtualClock()
+{
+    uninstall();
+
+    Q_D(QKnxVirtualClock);
+    for (auto timer : qAsConst(d->m_timers))
+        timer->stop();
+}
+
+/*!
+    Returns the installed virtual clock, or \c nullptr if protocol timers run
+    on wall clock time.
+*/
+QKnxVirtualClock *QKnxVirtualClock::installed()
+{
+    return QKnxVirtualClockPrivate::s_installed.load();
+}
+
+/*!
+    Returns \c true if this clock is installed; otherwise returns \c false.
+*/
+bool QKnxVirtualClock::isInstalled() const
+{
+    return installed() == this;
+}
+
+/*!
+    Installs this clock, replacing a previously installed clock. Protocol
+    timers created from now on run on this clock's virtual time.
+*/
+void QKnxVirtualClock::install()
+{
+    QKnxVirtualClockPrivate::s_installed.store(this);
+}
+
+/*!
+    Uninstalls this clock if it is installed. Protocol timers created from
+    now on run on wall clock time again; timers already bound to this clock
+    are not affected.
+*/
+void QKnxVirtualClock::uninstall()
+{
+    QKnxVirtualClockPrivate::s_installed.testAndSetOrdered(this, nullptr);
+}
+
+/*!
+    Returns the virtual time in milliseconds that elapsed since the clock was
+    created.
+*/
+qint64 QKnxVirtualClock::elapsed() const
+{
+    Q_D(const QKnxVirtualClock);
+    return d->m_elapsed;
+}
+
+/*!
+    Returns the number of active timers bound to this clock.
+*/
+int QKnxVirtualClock::activeTimerCount() const
+{
+    Q_D(const QKnxVirtualClock);
+    return int(std::count_if(d->m_timers.cbegin(), d->m_timers.cend(),
+        [](const QKnxTimer *timer) { return timer->isActive(); }));
+}
+
+/*!
+    Returns the virtual time in milliseconds until the next timer fires, or
+    \c -1 if there is no active timer.
+*/
+qint64 QKnxVirtualClock::nextTimeout() const
+{
+    Q_D(const QKnxVirtualClock);
+    const auto timer = d->nextTimer();
+    return timer ? qMax<qint64>(0, timer->m_deadline - d->m_elapsed) : -1;
+}
+
+/*!
+    Advances the virtual time by \a msecs milliseconds, firing all timers
+    that become due in the order of their deadlines. Timers started or
+    restarted by a timeout fire as well if they become due in the advanced
+    period.
+*/
+void QKnxVirtualClock::advance(qint64 msecs)
+{
+    Q_D(QKnxVirtualClock);
+    const qint64 target = d->m_elapsed + qMax<qint64>(0, msecs);
+    while (auto timer = d->nextTimer()) {
+        if (timer->m_deadline > target)
+            break;
+        d->m_elapsed = qMax(d->m_elapsed, timer->m_deadline);
+        timer->fire();
+    }
+    d->m_elapsed = target;
+}
+
+/*!
+    Advances the virtual time to the deadline of the next active timer and
+    fires it, together with all other timers due at that time. Returns
+    \c false if there is no active timer; otherwise returns \c true.
+*/
+bool QKnxVirtualClock::advanceToNextTimeout()
+{
+    const qint64 next = nextTimeout();
+    if (next < 0)
+        return false;
+    advance(next);
+    return true;
+}
+
+void QKnxVirtualClock::registerTimer(QKnxTimer *timer)
+{
+    Q_D(QKnxVirtualClock);
+    d->m_timers.append(timer);
+}
+
+void QKnxVirtualClock::unregisterTimer(QKnxTimer *timer)
+{
+    Q_D(QKnxVirtualClock);
+    d->m_timers.removeAll(timer);
+}
+
+quint64 QKnxVirtualClock::nextSequence()
+{
+    Q_D(QKnxVirtualClock);
+    return ++d->m_sequence;
+}
+
+QT_END_NAMESPACE
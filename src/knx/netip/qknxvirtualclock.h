@@ -0,0 +1,73 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXVIRTUALCLOCK_H
+#define QKNXVIRTUALCLOCK_H
+
+#include <QtCore/qobject.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxTimer;
+
+class QKnxVirtualClockPrivate;
+class Q_KNX_EXPORT QKnxVirtualClock final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxVirtualClock)
+    Q_DECLARE_PRIVATE(QKnxVirtualClock)
+
+public:
+    explicit QKnxVirtualClock(QObject *parent = nullptr);
+    ~QKnxVirtualClock() override;
+
+    static QKnxVirtualClock *installed();
+    bool isInstalled() const;
+    void install();
+    void uninstall();
+
+    qint64 elapsed() const;
+    int activeTimerCount() const;
+    qint64 nextTimeout() const;
+
+    void advance(qint64 msecs);
+    bool advanceToNextTimeout();
+
+private:
+    friend class QKnxTimer;
+    void registerTimer(QKnxTimer *timer);
+    void unregisterTimer(QKnxTimer *timer);
+    quint64 nextSequence();
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -411,6 +411,15 @@ bool QKnxAddress::operator!=(const QKnxAddress &other) const
     value are part of the address.
 */
 
+/*!
+    \fn quint16 QKnxAddress::toUInt16() const
+    \since 5.13
+
+    Returns the KNX address as a 16-bit integer value if the address is valid;
+    otherwise returns \c 0. Contrary to bytes(), the function does not allocate
+    any memory.
+*/
+
 /*!
     \relates QKnxAddress
 
@@ -83,6 +83,7 @@ public:
             return {};
         return QKnxUtils::QUint16::bytes(quint16(m_address));
     }
+    quint16 toUInt16() const { return isValid() ? quint16(m_address) : 0; }
 
     QString toString(Notation notation = Notation::ThreeLevel) const;
 
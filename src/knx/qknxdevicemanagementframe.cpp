@@ -556,6 +556,42 @@ QKnxByteArray QKnxDeviceManagementFrame::bytes() const
     return QKnxByteArray { quint8(d_ptr->m_code) } + d_ptr->m_serviceInformation;
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for the local device
+    management frame.
+
+    \sa size(), bytes()
+*/
+quint16 QKnxDeviceManagementFrame::serializedSize() const
+{
+    return size();
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the local device management frame to
+    \a dst, which must provide room for at least \a capacity bytes. Returns
+    the number of bytes written, or \c 0 if \a capacity is too small to hold
+    serializedSize() bytes.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxDeviceManagementFrame::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (!dst || capacity < size)
+        return 0;
+
+    dst[0] = quint8(d_ptr->m_code);
+    const auto &serviceInfo = d_ptr->m_serviceInformation;
+    if (!serviceInfo.isEmpty())
+        memcpy(dst + 1, serviceInfo.constData(), serviceInfo.size());
+    return size;
+}
+
 /*!
     Constructs the local device management frame from the byte array \a data
     starting at the position \a index inside the array with the size \a size.
@@ -404,7 +404,7 @@ void QKnxLinkLayerFrame::setMediumType(QKnx::MediumType type)
 */
 quint16 QKnxLinkLayerFrame::size() const
 {
-    return bytes().size();
+    return serializedSize();
 }
 
 /*!
@@ -467,6 +467,81 @@ QKnxByteArray QKnxLinkLayerFrame::bytes() const
         + d_ptr->m_tpdu.bytes();
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for the link layer frame
+    if it is valid; otherwise returns \c 0.
+
+    \sa serializeInto(), bytes()
+*/
+quint16 QKnxLinkLayerFrame::serializedSize() const
+{
+    if (!isValid())
+        return 0;
+
+    quint16 size = 2; // message code and additional info length
+    for (const auto &info : qAsConst(d_ptr->m_additionalInfos))
+        size += (info.isValid() ? info.size() : 0);
+
+    size += d_ptr->m_ctrl.size() + d_ptr->m_extCtrl.size();
+    size += (d_ptr->m_srcAddress.isValid() ? d_ptr->m_srcAddress.size() : 0);
+    size += (d_ptr->m_dstAddress.isValid() ? d_ptr->m_dstAddress.size() : 0);
+
+    return size + 1 /* length */ + d_ptr->m_tpdu.serializedSize();
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the link layer frame to \a dst, which must
+    provide room for at least \a capacity bytes. Returns the number of bytes
+    written, or \c 0 if the frame is invalid or \a capacity is too small to
+    hold serializedSize() bytes.
+
+    The written bytes are identical to the ones returned by bytes(), but no
+    intermediate byte arrays are created.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxLinkLayerFrame::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (size == 0 || !dst || capacity < size)
+        return 0;
+
+    quint16 offset = 0;
+    dst[offset++] = quint8(d_ptr->m_code);
+    dst[offset++] = d_ptr->m_additionalInfoSize;
+
+    for (const auto &info : qAsConst(d_ptr->m_additionalInfos)) {
+        if (!info.isValid())
+            continue;
+        const auto infoBytes = info.bytes();
+        memcpy(dst + offset, infoBytes.constData(), infoBytes.size());
+        offset += infoBytes.size();
+    }
+
+    dst[offset++] = d_ptr->m_ctrl.byte();
+    dst[offset++] = d_ptr->m_extCtrl.byte();
+
+    auto writeAddress = [&](const QKnxAddress &address) {
+        if (!address.isValid())
+            return;
+        const auto raw = address.toUInt16();
+        dst[offset++] = quint8(raw >> 8);
+        dst[offset++] = quint8(raw);
+    };
+    writeAddress(d_ptr->m_srcAddress);
+    writeAddress(d_ptr->m_dstAddress);
+
+    dst[offset++] = quint8(d_ptr->m_tpdu.dataSize());
+    offset += d_ptr->m_tpdu.serializeInto(dst + offset, capacity - offset);
+
+    Q_ASSERT(offset == size);
+    return offset;
+}
+
 /*!
     Constructs a link layer frame from the byte array \a data starting at the
     position \a index inside the array using the number of bytes specified by
@@ -93,6 +93,9 @@ public:
     void setServiceInformation(const QKnxByteArray &serviceInfo);
 
     QKnxByteArray bytes() const;
+    quint16 serializedSize() const;
+    quint16 serializeInto(quint8 *dst, size_t capacity) const;
+
     static QKnxLinkLayerFrame fromBytes(const QKnxByteArray &data, quint16 index, quint16 size,
         QKnx::MediumType mediumType = QKnx::MediumType::NetIP);
 
@@ -161,6 +161,9 @@ QT_BEGIN_NAMESPACE
     \value DomainAddressSerialNumberResponse
     \value DomainAddressSerialNumberWrite
     \value FileStreamInfoReport
+    \value SecureService
+            A KNX Data Secure APDU that carries an authenticated and
+            optionally encrypted APDU. This value was introduced in Qt 5.13.
     \value Invalid
 */
 
@@ -353,6 +356,12 @@ bool QKnxTpdu::isValid() const
          // 6 bytes serial number, 2 bytes new tpdu, 4 reserved bytes
         return (size() >= HEADER_SIZE) && (size() <= HEADER_SIZE + 12);
 
+    case ApplicationControlField::SecureService:
+        // security control field, 6 bytes sequence number, at least the
+        // secured APCI and a 4 bytes MAC, AN158 Data Secure
+        return (size() >= HEADER_SIZE + 1 + 6 + 2 + 4)
+            && (size() <= HEADER_SIZE + L_DATA_EXTENDED_PAYLOAD);
+
     case ApplicationControlField::DomainAddressWrite:
     case ApplicationControlField::DomainAddressResponse:
        return (size() == HEADER_SIZE + 2) || (size() == HEADER_SIZE + 6); // 2 or 6 byteToTest domain tpdu
@@ -626,6 +635,37 @@ QKnxByteArray QKnxTpdu::bytes() const
     return d_ptr->m_tpduBytes;
 }
 
+/*!
+    \since 5.13
+
+    Returns the number of bytes serializeInto() writes for the TPDU.
+
+    \sa size(), bytes()
+*/
+quint16 QKnxTpdu::serializedSize() const
+{
+    return size();
+}
+
+/*!
+    \since 5.13
+
+    Writes the bytes that represent the TPDU to \a dst, which must provide
+    room for at least \a capacity bytes. Returns the number of bytes written,
+    or \c 0 if \a capacity is too small to hold serializedSize() bytes.
+
+    \sa serializedSize(), bytes()
+*/
+quint16 QKnxTpdu::serializeInto(quint8 *dst, size_t capacity) const
+{
+    const auto size = serializedSize();
+    if (!dst || capacity < size)
+        return 0;
+    if (size > 0)
+        memcpy(dst, d_ptr->m_tpduBytes.constData(), size);
+    return size;
+}
+
 /*!
     Creates a TPDU with the medium type \a mediumType from the byte array
     \a data starting at the position \a index inside the array with the size
@@ -154,6 +154,7 @@ public:
         DomainAddressSerialNumberResponse = 0x03ed,
         DomainAddressSerialNumberWrite = 0x03ee,
         FileStreamInfoReport = 0x03f0,
+        SecureService = 0x03f1,
 
         Invalid = 0x00ff
     };
@@ -191,6 +192,9 @@ public:
     void setData(const QKnxByteArray &data);
 
     QKnxByteArray bytes() const;
+    quint16 serializedSize() const;
+    quint16 serializeInto(quint8 *dst, size_t capacity) const;
+
     static QKnxTpdu fromBytes(const QKnxByteArray &data, quint16 index, quint16 size,
         QKnx::MediumType mediumType = QKnx::MediumType::NetIP);
 
@@ -41,6 +41,8 @@
 // We mean it.
 //
 
+#include <QtCore/qatomic.h>
+
 #include <QtKnx/qtknxglobal.h>
 #include <QtKnx/private/qsslsocket_openssl_symbols_p.h>
 #include <QtKnx/private/qsslsocket_openssl11_symbols_p.h>
@@ -68,12 +70,28 @@ class QKnxCurve25519KeyData : public QSharedData
 {
 public:
     QKnxCurve25519KeyData() = default;
+    QKnxCurve25519KeyData(const QKnxCurve25519KeyData &other)
+        : QSharedData(other)
+        , m_evpPKey(other.m_evpPKey)
+    {
+        if (m_evpPKey)
+            q_EVP_PKEY_up_ref(m_evpPKey);
+    }
     ~QKnxCurve25519KeyData()
     {
+        if (auto ctx = m_deriveCtx.load())
+            q_EVP_PKEY_CTX_free(ctx);
         q_EVP_PKEY_free(m_evpPKey);
     }
 
+    EVP_PKEY_CTX *takeDeriveContext() const;
+    void releaseDeriveContext(EVP_PKEY_CTX *ctx) const;
+
     EVP_PKEY *m_evpPKey { nullptr };
+
+private:
+    // derive context set up for m_evpPKey, kept between calls to sharedSecret()
+    mutable QAtomicPointer<EVP_PKEY_CTX> m_deriveCtx { nullptr };
 };
 
 QT_END_NAMESPACE
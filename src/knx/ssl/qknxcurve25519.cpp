@@ -29,6 +29,7 @@
 
 #include "qknxcurve25519.h"
 #include "qknxcryptographicdata_p.h"
+#include "qknxsecurecipher_p.h"
 
 #include "qknxnetipsessionauthenticate.h"
 #include "qknxnetipsecurewrapper.h"
@@ -37,7 +38,14 @@
 #include "qknxnetipsessionstatus.h"
 #include "qknxnetiptimernotify.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcryptographichash.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmessageauthenticationcode.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
 #include <QMutex>
 
 QT_BEGIN_NAMESPACE
@@ -129,6 +137,39 @@ bool QKnxOpenSsl::ensureLibraryLoaded()
     return s_libraryEnabled;
 }
 
+/*!
+    \internal
+    Returns a derive context for the key, set up for \c EVP_PKEY_derive(). The
+    context cached by a previous call to releaseDeriveContext() is handed out
+    if there is one; otherwise a new context is created. Returns \c nullptr on
+    error.
+*/
+EVP_PKEY_CTX *QKnxCurve25519KeyData::takeDeriveContext() const
+{
+    if (auto ctx = m_deriveCtx.fetchAndStoreAcquire(nullptr))
+        return ctx;
+
+    if (!m_evpPKey)
+        return nullptr;
+
+    auto ctx = q_EVP_PKEY_CTX_new(m_evpPKey, nullptr);
+    if (ctx && q_EVP_PKEY_derive_init(ctx) <= 0) {
+        q_EVP_PKEY_CTX_free(ctx);
+        return nullptr;
+    }
+    return ctx;
+}
+
+/*!
+    \internal
+    Keeps the derive context \a ctx for the next call to takeDeriveContext(),
+    or frees it if another context has been cached in the meantime.
+*/
+void QKnxCurve25519KeyData::releaseDeriveContext(EVP_PKEY_CTX *ctx) const
+{
+    if (ctx && !m_deriveCtx.testAndSetRelease(nullptr, ctx))
+        q_EVP_PKEY_CTX_free(ctx);
+}
 
 /*!
     \inmodule QtKnx
@@ -505,31 +546,21 @@ QKnxByteArray QKnxCryptographicEngine::sharedSecret(const QKnxCurve25519PublicKe
     if (!qt_QKnxOpenSsl->supportsSsl())
         return {};
 
-    auto evpPKeyCtx = q_EVP_PKEY_CTX_new(priv.d_ptr->m_evpPKey, nullptr);
+    // the derive context of the private key is set up once and reused, so
+    // only the X25519 operation itself is left for the handshake
+    auto evpPKeyCtx = priv.d_ptr->takeDeriveContext();
     if (!evpPKeyCtx)
         return {};
 
-    struct ScopedFree final
-    {
-        ScopedFree(EVP_PKEY_CTX *key) : m_evpPKeyCtx(key) {}
-        ~ScopedFree() { q_EVP_PKEY_CTX_free(m_evpPKeyCtx); }
-        EVP_PKEY_CTX *m_evpPKeyCtx = nullptr;
-    } _ { evpPKeyCtx };
-
-    if (q_EVP_PKEY_derive_init(evpPKeyCtx) <= 0)
-        return {};
-
-    if (q_EVP_PKEY_derive_set_peer(evpPKeyCtx, pub.d_ptr->m_evpPKey) <= 0)
-        return {};
-
-    size_t keylen = 0;
-    if (q_EVP_PKEY_derive(evpPKeyCtx, nullptr, &keylen) <= 0)
-        return {};
+    QKnxByteArray ba(32, 0);
+    size_t keylen = size_t(ba.size());
+    const bool derived = q_EVP_PKEY_derive_set_peer(evpPKeyCtx, pub.d_ptr->m_evpPKey) > 0
+        && q_EVP_PKEY_derive(evpPKeyCtx, ba.data(), &keylen) > 0;
+    priv.d_ptr->releaseDeriveContext(evpPKeyCtx);
 
-    QKnxByteArray ba(int(keylen), 0);
-    if (q_EVP_PKEY_derive(evpPKeyCtx, ba.data(), &keylen) <= 0)
+    if (!derived)
         return {};
-
+    ba.resize(int(keylen));
     return ba;
 }
 
@@ -555,18 +586,221 @@ QKnxByteArray QKnxCryptographicEngine::sessionKey(const QKnxCurve25519PublicKey
     return sessionKey(sharedSecret(pub, priv));
 }
 
+namespace QKnxPrivate
+{
+    static const char UserPasswordSalt[] = "user-password.1.secure.ip.knx.org";
+    static const char DeviceAuthenticationSalt[] = "device-authentication-code.1.secure.ip.knx.org";
+
+    static void secureZero(void *data, size_t size)
+    {
+        // volatile keeps the compiler from dropping the stores on dead memory
+        volatile quint8 *p = static_cast<volatile quint8 *>(data);
+        while (size--)
+            *p++ = 0x00;
+    }
+
+    struct DerivedKey final
+    {
+        explicit DerivedKey(const QKnxByteArray &k)
+            : key(k.constData(), k.size())
+        {}
+        ~DerivedKey()
+        {
+            secureZero(key.data(), size_t(key.size()));
+        }
+
+        // hand out deep copies, the cached bytes are never shared and can be wiped
+        QKnxByteArray copy() const
+        {
+            return QKnxByteArray(key.constData(), key.size());
+        }
+        QKnxByteArray key;
+    };
+
+    class KeyDerivationCache final
+    {
+    public:
+        enum : int { MaxEntries = 32, SecretSize = 32 };
+
+        KeyDerivationCache()
+            : m_secret(SecretSize, Qt::Uninitialized)
+        {
+            QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(m_secret.data()),
+                SecretSize / int(sizeof(quint32)));
+        }
+
+        ~KeyDerivationCache()
+        {
+            secureZero(m_secret.data(), size_t(m_secret.size()));
+        }
+
+        QByteArray id(const QByteArray &password, const QKnxByteArray &salt,
+            qint32 iterations, quint8 length) const
+        {
+            // Never keep the plain password or a plain digest of it around, the
+            // latter could be brute-forced far quicker than the derived key. The
+            // MAC is keyed with a random secret that never leaves the process.
+            QMessageAuthenticationCode mac(QCryptographicHash::Sha256, m_secret);
+            mac.addData(QKnxUtils::QUint32::bytes(quint32(password.size())).toByteArray());
+            mac.addData(password);
+            mac.addData(salt.toByteArray());
+            mac.addData(QKnxUtils::QUint32::bytes(quint32(iterations)).toByteArray());
+            mac.addData(QByteArray(1, char(length)));
+            return mac.result();
+        }
+
+        bool lookup(const QByteArray &id, QKnxByteArray *key)
+        {
+            QMutexLocker locker(&m_mutex);
+            if (auto entry = m_cache.object(id)) {
+                *key = entry->copy();
+                return true;
+            }
+            return false;
+        }
+
+        void insert(const QByteArray &id, const QKnxByteArray &key)
+        {
+            if (key.isEmpty())
+                return;
+            QMutexLocker locker(&m_mutex);
+            m_cache.insert(id, new DerivedKey(key));
+        }
+
+        QFuture<QKnxByteArray> derive(const QByteArray &password, const QKnxByteArray &salt,
+            qint32 iterations, quint8 length);
+        void finish(const QByteArray &id, const QKnxByteArray &key)
+        {
+            insert(id, key);
+
+            QMutexLocker locker(&m_mutex);
+            auto fi = m_pending.take(id);
+            locker.unlock();
+
+            fi.reportResult(key);
+            fi.reportFinished();
+        }
+
+        void clear()
+        {
+            QMutexLocker locker(&m_mutex);
+            m_cache.clear();
+        }
+
+    private:
+        QByteArray m_secret;
+        QMutex m_mutex;
+        QCache<QByteArray, DerivedKey> m_cache { MaxEntries };
+        QHash<QByteArray, QFutureInterface<QKnxByteArray>> m_pending;
+    };
+}
+
+Q_GLOBAL_STATIC(QKnxPrivate::KeyDerivationCache, qt_knxKeyDerivationCache)
+
+namespace QKnxPrivate
+{
+    class KeyDerivationTask final : public QRunnable
+    {
+    public:
+        KeyDerivationTask(const QByteArray &id, const QByteArray &password,
+                const QKnxByteArray &salt, qint32 iterations, quint8 length)
+            : m_id(id)
+            , m_password(password.constData(), password.size()) // deep copy, wiped in run()
+            , m_salt(salt)
+            , m_iterations(iterations)
+            , m_length(length)
+        {}
+
+        ~KeyDerivationTask() override
+        {
+            wipePassword();
+        }
+
+        void run() override
+        {
+            const auto key = QKnxCryptographicEngine::pkcs5Pbkdf2HmacSha256(m_password, m_salt,
+                m_iterations, m_length);
+            wipePassword();
+
+            if (!qt_knxKeyDerivationCache.isDestroyed())
+                qt_knxKeyDerivationCache->finish(m_id, key);
+        }
+
+    private:
+        void wipePassword()
+        {
+            if (m_password.isEmpty())
+                return;
+            secureZero(m_password.data(), size_t(m_password.size()));
+            m_password.clear();
+        }
+
+        QByteArray m_id;
+        QByteArray m_password;
+        QKnxByteArray m_salt;
+        qint32 m_iterations;
+        quint8 m_length;
+    };
+
+    QFuture<QKnxByteArray> KeyDerivationCache::derive(const QByteArray &password,
+        const QKnxByteArray &salt, qint32 iterations, quint8 length)
+    {
+        const auto key = id(password, salt, iterations, length);
+
+        QMutexLocker locker(&m_mutex);
+        if (auto entry = m_cache.object(key)) {
+            QFutureInterface<QKnxByteArray> fi;
+            fi.reportStarted();
+            fi.reportResult(entry->copy());
+            fi.reportFinished();
+            return fi.future();
+        }
+
+        // share a running derivation between all callers asking for the same key
+        auto it = m_pending.constFind(key);
+        if (it != m_pending.constEnd())
+            return it.value().future();
+
+        QFutureInterface<QKnxByteArray> fi;
+        fi.reportStarted();
+        m_pending.insert(key, fi);
+        locker.unlock();
+
+        QThreadPool::globalInstance()->start(new KeyDerivationTask(key, password, salt,
+            iterations, length));
+        return fi.future();
+    }
+
+    static QKnxByteArray cachedKey(const QByteArray &password, const QKnxByteArray &salt,
+        qint32 iterations, quint8 length)
+    {
+        const auto id = qt_knxKeyDerivationCache->id(password, salt, iterations, length);
+
+        QKnxByteArray key;
+        if (qt_knxKeyDerivationCache->lookup(id, &key))
+            return key;
+
+        key = QKnxCryptographicEngine::pkcs5Pbkdf2HmacSha256(password, salt, iterations, length);
+        qt_knxKeyDerivationCache->insert(id, key);
+        return key;
+    }
+}
+
 /*!
     Returns the password hash derived from the user chosen password \a password.
 
     \note The salt used in the Password-Based Key Derivation Function (PBKDF2)
     function is set to \e {user-password.1.secure.ip.knx.org}.
 
-    \sa pkcs5Pbkdf2HmacSha256()
+    Derived keys are kept in a small in-process cache, so subsequent calls with
+    the same \a password return without running the key derivation again.
+
+    \sa pkcs5Pbkdf2HmacSha256(), userPasswordHashAsync(), clearDerivedKeyCache()
 */
 QKnxByteArray QKnxCryptographicEngine::userPasswordHash(const QByteArray &password)
 {
-    return pkcs5Pbkdf2HmacSha256(password,
-        QKnxByteArray("user-password.1.secure.ip.knx.org", 33), 0x10000, 16);
+    return QKnxPrivate::cachedKey(password, QKnxByteArray(QKnxPrivate::UserPasswordSalt,
+        sizeof(QKnxPrivate::UserPasswordSalt) - 1), 0x10000, 16);
 }
 
 /*!
@@ -576,12 +810,68 @@ QKnxByteArray QKnxCryptographicEngine::userPasswordHash(const QByteArray &passwo
     \note The salt used in the Password-Based Key Derivation Function (PBKDF2)
     function is set to \e {device-authentication-code.1.secure.ip.knx.org}.
 
-    \sa pkcs5Pbkdf2HmacSha256()
+    Derived keys are kept in a small in-process cache, so subsequent calls with
+    the same \a password return without running the key derivation again.
+
+    \sa pkcs5Pbkdf2HmacSha256(), deviceAuthenticationCodeHashAsync(),
+        clearDerivedKeyCache()
 */
 QKnxByteArray QKnxCryptographicEngine::deviceAuthenticationCodeHash(const QByteArray &password)
 {
-    return pkcs5Pbkdf2HmacSha256(password,
-        QKnxByteArray("device-authentication-code.1.secure.ip.knx.org", 46), 0x10000, 16);
+    return QKnxPrivate::cachedKey(password, QKnxByteArray(QKnxPrivate::DeviceAuthenticationSalt,
+        sizeof(QKnxPrivate::DeviceAuthenticationSalt) - 1), 0x10000, 16);
+}
+
+/*!
+    \since 5.13
+
+    Starts deriving the password hash from the user chosen password \a password
+    on the global thread pool and returns a future that provides the result.
+    The future is already finished if the hash is found in the cache. Requests
+    for the same password while a derivation is running share its future.
+
+    The future's result is an empty byte array in case of an error.
+
+    \sa userPasswordHash(), QThreadPool::globalInstance()
+*/
+QFuture<QKnxByteArray> QKnxCryptographicEngine::userPasswordHashAsync(const QByteArray &password)
+{
+    return pkcs5Pbkdf2HmacSha256Async(password, QKnxByteArray(QKnxPrivate::UserPasswordSalt,
+        sizeof(QKnxPrivate::UserPasswordSalt) - 1), 0x10000, 16);
+}
+
+/*!
+    \since 5.13
+
+    Starts deriving the device authentication code hash from the user chosen
+    password \a password on the global thread pool and returns a future that
+    provides the result. The future is already finished if the hash is found
+    in the cache.
+
+    The future's result is an empty byte array in case of an error.
+
+    \sa deviceAuthenticationCodeHash(), userPasswordHashAsync()
+*/
+QFuture<QKnxByteArray>
+    QKnxCryptographicEngine::deviceAuthenticationCodeHashAsync(const QByteArray &password)
+{
+    return pkcs5Pbkdf2HmacSha256Async(password,
+        QKnxByteArray(QKnxPrivate::DeviceAuthenticationSalt,
+            sizeof(QKnxPrivate::DeviceAuthenticationSalt) - 1), 0x10000, 16);
+}
+
+/*!
+    \since 5.13
+
+    Wipes and removes all keys kept by the derived key cache. Call this
+    function once the credentials are no longer needed, for example after
+    the last secure session to a device has been closed.
+
+    \sa userPasswordHash(), deviceAuthenticationCodeHash()
+*/
+void QKnxCryptographicEngine::clearDerivedKeyCache()
+{
+    qt_knxKeyDerivationCache->clear();
 }
 
 /*!
@@ -602,61 +892,19 @@ QKnxByteArray QKnxCryptographicEngine::XOR(const QKnxByteArray &left, const QKnx
 
 namespace QKnxPrivate
 {
-    static QKnxByteArray b0(quint48 sequence, const QKnxByteArray &serial, quint16 tag, quint16 len)
-    {
-        return QKnxUtils::QUint48::bytes(sequence) + serial + QKnxUtils::QUint16::bytes(tag)
-            + QKnxUtils::QUint16::bytes(len);
-    }
-
-    static QKnxByteArray ctr0(quint48 sequence, const QKnxByteArray &serial, quint16 tag)
-    {
-        return QKnxPrivate::b0(sequence, serial, tag, 0xff00);
-    }
-
-    static QKnxByteArray encrypt(const QKnxByteArray &key, const QKnxByteArray &data)
-    {
-        QSharedPointer<EVP_CIPHER_CTX> ctxPtr(q_EVP_CIPHER_CTX_new(), q_EVP_CIPHER_CTX_free);
-        if (ctxPtr.isNull())
-            return {};
-
-        const auto ctx = ctxPtr.data();
-        const auto c = q_EVP_aes_128_cbc();
-        if (q_EVP_CipherInit_ex(ctx, c, nullptr, nullptr, nullptr, 0x01) <= 0)
-            return {};
-
-        if (q_EVP_CIPHER_CTX_set_padding(ctx, 0) <= 0)
-            return {};
-
-        Q_ASSERT(q_EVP_CIPHER_CTX_iv_length(ctx) == 16);
-        Q_ASSERT(q_EVP_CIPHER_CTX_key_length(ctx) == 16);
-
-        static const quint8 iv[16] { 0x00 };
-        if (q_EVP_CipherInit_ex(ctx, nullptr, nullptr, key.constData(), iv, 0x01) <= 0)
-            return {};
-
-        int outl, offset = 0;
-        QKnxByteArray out(data.size() + q_EVP_CIPHER_block_size(c), 0x00);
-        if (q_EVP_CipherUpdate(ctx, out.data(), &outl, data.constData(), data.size()) <= 0)
-            return {};
-        offset += outl;
-
-        if (q_EVP_CipherFinal_ex(ctx, out.data() + offset, &outl) <= 0)
-            return {};
-        offset += outl;
-
-        return out.mid(offset - 16, 16);
-    }
-
     static QKnxByteArray processMAC(const QKnxByteArray &key, const QKnxByteArray &mac,
         quint48 sequenceNumber, const QKnxByteArray &serialNumber, quint16 messageTag)
     {
         if (key.isEmpty() || mac.isEmpty())
             return {};
 
-        auto Ctr0 = QKnxPrivate::ctr0(sequenceNumber,
-            (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber), messageTag);
-
-        return QKnxCryptographicEngine::XOR(QKnxPrivate::encrypt(key, Ctr0), mac);
+        QKnxSecureCipher cipher(key);
+        QKnxByteArray stream(QKnxSecureCipher::MacSize, 0x00);
+        if (!cipher.processMac({ sequenceNumber, serialNumber, messageTag }, stream.constData(),
+            stream.data())) {
+                return {};
+        }
+        return QKnxCryptographicEngine::XOR(stream, mac);
     }
 
     static QKnxByteArray processPayload(const QKnxByteArray &key, const QKnxByteArray &payload,
@@ -665,16 +913,13 @@ namespace QKnxPrivate
         if (key.isEmpty() || payload.isEmpty())
             return {};
 
-        auto Ctr0 = QKnxPrivate::ctr0(sequenceNumber,
-            (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber), messageTag);
-
-        QKnxByteArray ctrArray;
-        for (int i = 0; i < (payload.size() + 15) >> 4; ++i) {
-            Ctr0.set(15, Ctr0.at(15) + 1);
-            ctrArray += QKnxPrivate::encrypt(key, Ctr0);
+        QKnxSecureCipher cipher(key);
+        QKnxByteArray out(payload.size(), 0x00);
+        if (!cipher.processPayload({ sequenceNumber, serialNumber, messageTag },
+            payload.constData(), payload.size(), out.data())) {
+                return {};
         }
-
-        return QKnxCryptographicEngine::XOR(ctrArray, payload, false);
+        return out;
     }
 }
 
@@ -699,35 +944,37 @@ QKnxByteArray QKnxCryptographicEngine::calculateMessageAuthenticationCode(const
     if (key.isEmpty() || !header.isValid())
         return {};
 
-    auto sn = (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber);
-
-    QKnxByteArray B0, B;
+    quint16 length = 0;
+    QKnxByteArray B;
     if (header.serviceType() == QKnxNetIp::ServiceType::SecureWrapper) {
         if (data.isEmpty())
             return {};
 
         const auto A = header.bytes() + QKnxUtils::QUint16::bytes(id);
-        B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, data.size());
-        B = B0 + QKnxUtils::QUint16::bytes(A.size()) + A + data;
+        length = quint16(data.size());
+        B = QKnxUtils::QUint16::bytes(A.size()) + A + data;
     } else if (header.serviceType() == QKnxNetIp::ServiceType::SessionResponse
         || header.serviceType() == QKnxNetIp::ServiceType::SessionAuthenticate) {
             if (data.isEmpty())
                 return {};
 
             const auto A = header.bytes() + QKnxUtils::QUint16::bytes(id);
-            B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, 0);
-            B = B0 + QKnxUtils::QUint16::bytes(A.size() + data.size()) + A + data;
+            B = QKnxUtils::QUint16::bytes(A.size() + data.size()) + A + data;
     } else if (header.serviceType() == QKnxNetIp::ServiceType::TimerNotify) {
         const auto A = header.bytes();
-        B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, 0);
-        B = B0 + QKnxUtils::QUint16::bytes(A.size()) + A;
+        B = QKnxUtils::QUint16::bytes(A.size()) + A;
     }
 
     if (B.isEmpty())
         return {};
-    B.resize(B.size() + (16 - (B.size() % 16))); // pad to multiple of 16
 
-    return QKnxPrivate::encrypt(key, B);
+    QKnxSecureCipher cipher(key);
+    QKnxByteArray mac(QKnxSecureCipher::MacSize, 0x00);
+    if (!cipher.calculateMac({ sequenceNumber, serialNumber, messageTag }, length, B.constData(),
+        B.size(), mac.data())) {
+            return {};
+    }
+    return mac;
 }
 
 /*!
@@ -816,4 +1063,21 @@ QKnxByteArray QKnxCryptographicEngine::pkcs5Pbkdf2HmacSha256(const QByteArray &p
     return out;
 }
 
+/*!
+    \since 5.13
+
+    Starts deriving the hash code from the user chosen password \a password,
+    with the given \a salt, \a iterations and \a derivedKeyLength on the global
+    thread pool and returns a future that provides the result. Derived keys are
+    cached, the returned future is already finished on a cache hit.
+
+    \sa pkcs5Pbkdf2HmacSha256(), clearDerivedKeyCache()
+*/
+QFuture<QKnxByteArray> QKnxCryptographicEngine::pkcs5Pbkdf2HmacSha256Async(
+    const QByteArray &password, const QKnxByteArray &salt, qint32 iterations,
+    quint8 derivedKeyLength)
+{
+    return qt_knxKeyDerivationCache->derive(password, salt, iterations, derivedKeyLength);
+}
+
 QT_END_NAMESPACE
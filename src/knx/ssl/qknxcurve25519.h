@@ -30,6 +30,7 @@
 #ifndef QKNXCURVE25519_H
 #define QKNXCURVE25519_H
 
+#include <QtCore/qfuture.h>
 #include <QtCore/qshareddata.h>
 
 #include <QtKnx/qknxbytearray.h>
@@ -80,6 +81,7 @@ public:
 
 private:
     friend class QKnxCurve25519PublicKey;
+    friend class QKnxCurve25519KeyPool;
     friend class QKnxCryptographicEngine;
     QSharedDataPointer<QKnxCurve25519KeyData> d_ptr;
 };
@@ -100,6 +102,9 @@ public:
     static QKnxByteArray userPasswordHash(const QByteArray &password);
     static QKnxByteArray deviceAuthenticationCodeHash(const QByteArray &password);
 
+    static QFuture<QKnxByteArray> userPasswordHashAsync(const QByteArray &password);
+    static QFuture<QKnxByteArray> deviceAuthenticationCodeHashAsync(const QByteArray &password);
+
     static QKnxByteArray XOR(const QKnxByteArray &l, const QKnxByteArray &r, bool adjust = true);
 
     static QKnxByteArray calculateMessageAuthenticationCode(const QKnxByteArray &key,
@@ -136,6 +141,10 @@ public:
 
     static QKnxByteArray pkcs5Pbkdf2HmacSha256(const QByteArray &password, const QKnxByteArray &salt,
         qint32 iterations, quint8 derivedKeyLength);
+    static QFuture<QKnxByteArray> pkcs5Pbkdf2HmacSha256Async(const QByteArray &password,
+        const QKnxByteArray &salt, qint32 iterations, quint8 derivedKeyLength);
+
+    static void clearDerivedKeyCache();
 };
 
 QT_END_NAMESPACE
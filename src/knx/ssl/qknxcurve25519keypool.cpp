@@ -0,0 +1,218 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcurve25519keypool_p.h"
+#include "qknxcryptographicdata_p.h"
+
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_GLOBAL_STATIC(QKnxCurve25519KeyPool, qt_knxCurve25519KeyPool)
+
+class QKnxCurve25519KeyPoolTask final : public QRunnable
+{
+public:
+    explicit QKnxCurve25519KeyPoolTask(QKnxCurve25519KeyPool *pool)
+        : m_pool(pool)
+    {}
+
+    void run() override
+    {
+        while (m_pool->push(QKnxCurve25519KeyPool::generate())) {}
+        m_pool->refillFinished();
+    }
+
+private:
+    QKnxCurve25519KeyPool *m_pool { nullptr };
+};
+
+/*!
+    \internal
+    \class QKnxCurve25519KeyPool
+    \inmodule QtKnx
+
+    \brief The QKnxCurve25519KeyPool class keeps a number of ephemeral
+    Curve25519 key pairs generated ahead of time.
+
+    Generating a key pair is the most expensive part of setting up a secure
+    session next to the key agreement itself. The pool generates keys on the
+    global thread pool and prepares their derive context, so that a session
+    taking a key from the pool only has to run the X25519 derivation when the
+    session response arrives.
+
+    Every key is handed out exactly once. Whenever a key is taken, the pool is
+    refilled in the background up to its capacity. If the pool is empty, for
+    example because many sessions are set up at the same time, take() generates
+    a key on the calling thread.
+*/
+
+/*!
+    \internal
+    Stops refilling the pool and destroys all keys that were not handed out.
+*/
+QKnxCurve25519KeyPool::~QKnxCurve25519KeyPool()
+{
+    QMutexLocker locker(&m_mutex);
+    m_capacity = 0;
+    while (m_refilling)
+        m_refillDone.wait(&m_mutex);
+    m_keys.clear();
+}
+
+/*!
+    \internal
+    Returns the process wide key pool.
+*/
+QKnxCurve25519KeyPool *QKnxCurve25519KeyPool::instance()
+{
+    return qt_knxCurve25519KeyPool;
+}
+
+/*!
+    \internal
+    Returns the number of keys the pool keeps ready.
+*/
+int QKnxCurve25519KeyPool::capacity() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_capacity;
+}
+
+/*!
+    \internal
+    Sets the number of keys the pool keeps ready to \a capacity. Keys exceeding
+    a smaller capacity are destroyed. A capacity of \c 0 disables the pool.
+*/
+void QKnxCurve25519KeyPool::setCapacity(int capacity)
+{
+    QMutexLocker locker(&m_mutex);
+    m_capacity = qMax(0, capacity);
+    if (m_keys.size() > m_capacity)
+        m_keys.resize(m_capacity);
+}
+
+/*!
+    \internal
+    Returns the number of keys that are currently ready to be taken.
+*/
+int QKnxCurve25519KeyPool::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_keys.size();
+}
+
+/*!
+    \internal
+    Removes a key from the pool and returns it, and starts refilling the pool
+    in the background. If the pool is empty, a new key is generated.
+*/
+QKnxCurve25519PrivateKey QKnxCurve25519KeyPool::take()
+{
+    QMutexLocker locker(&m_mutex);
+    const bool empty = m_keys.isEmpty();
+    auto key = empty ? QKnxCurve25519PrivateKey() : m_keys.takeLast();
+    locker.unlock();
+
+    refill();
+    return empty ? generate() : key;
+}
+
+/*!
+    \internal
+    Generates keys on the calling thread until the pool reaches its capacity,
+    for example to prepare for a large number of sessions at start up.
+*/
+void QKnxCurve25519KeyPool::fill()
+{
+    while (push(generate())) {}
+}
+
+/*!
+    \internal
+    Starts refilling the pool on the global thread pool, unless the pool is
+    full or is being refilled already.
+*/
+void QKnxCurve25519KeyPool::refill()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_refilling || m_keys.size() >= m_capacity || !QKnxOpenSsl::supportsSsl())
+        return;
+    m_refilling = true;
+    locker.unlock();
+
+    QThreadPool::globalInstance()->start(new QKnxCurve25519KeyPoolTask(this));
+}
+
+/*!
+    \internal
+    Destroys all keys in the pool.
+*/
+void QKnxCurve25519KeyPool::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_keys.clear();
+}
+
+/*!
+    \internal
+    Generates a new private key and sets up its derive context.
+*/
+QKnxCurve25519PrivateKey QKnxCurve25519KeyPool::generate()
+{
+    QKnxCurve25519PrivateKey key;
+    if (key.isValid())
+        key.d_ptr->releaseDeriveContext(key.d_ptr->takeDeriveContext());
+    return key;
+}
+
+/*!
+    \internal
+    Adds the generated \a key to the pool. Returns \c true if the pool needs
+    more keys; otherwise returns \c false.
+*/
+bool QKnxCurve25519KeyPool::push(const QKnxCurve25519PrivateKey &key)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!key.isValid())
+        return false;
+    if (m_keys.size() < m_capacity)
+        m_keys.append(key);
+    return m_keys.size() < m_capacity;
+}
+
+void QKnxCurve25519KeyPool::refillFinished()
+{
+    QMutexLocker locker(&m_mutex);
+    m_refilling = false;
+    m_refillDone.wakeAll();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCURVE25519KEYPOOL_P_H
+#define QKNXCURVE25519KEYPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtKnx/qknxcurve25519.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxCurve25519KeyPool final
+{
+public:
+    enum : int { DefaultCapacity = 16 };
+
+    QKnxCurve25519KeyPool() = default;
+    ~QKnxCurve25519KeyPool();
+
+    static QKnxCurve25519KeyPool *instance();
+
+    int capacity() const;
+    void setCapacity(int capacity);
+    int size() const;
+
+    QKnxCurve25519PrivateKey take();
+
+    void fill();
+    void refill();
+    void clear();
+
+    static QKnxCurve25519PrivateKey generate();
+
+private:
+    Q_DISABLE_COPY(QKnxCurve25519KeyPool)
+    friend class QKnxCurve25519KeyPoolTask;
+
+    bool push(const QKnxCurve25519PrivateKey &key);
+    void refillFinished();
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_refillDone;
+    QVector<QKnxCurve25519PrivateKey> m_keys;
+    int m_capacity { DefaultCapacity };
+    bool m_refilling { false };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,405 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxdatasecuredecoder.h"
+#include "qknxsecurecipher_p.h"
+
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxDataSecureDecoder
+
+    \since 5.13
+    \inmodule QtKnx
+    \ingroup qtknx-general-classes
+
+    \brief The QKnxDataSecureDecoder class verifies and decrypts KNX Data
+    Secure group telegrams.
+
+    KNX Data Secure protects the application layer of a telegram end-to-end.
+    The secured APDU uses the application control field
+    \l {QKnxTpdu::ApplicationControlField}{SecureService} and carries a
+    security control field, a 48 bit sequence number, the authenticated and
+    optionally encrypted APDU, and a 4 byte message authentication code (MAC).
+
+    The decoder takes link layer frames as received from a tunneling or routing
+    connection, looks up the key of the destination group address, checks the
+    sequence number of the source address, verifies the MAC, and returns the
+    plain TPDU. Frames that are not secured are passed through unmodified.
+
+    \code
+        QKnxDataSecureDecoder decoder;
+        decoder.setGroupKey({ QKnxAddress::Type::Group, QLatin1String("1/2/3") },
+            QKnxByteArray::fromHex("...")); // the key from the project keyring
+
+        QKnxTpdu tpdu;
+        switch (decoder.decode(frame, &tpdu)) {
+        case QKnxDataSecureDecoder::Status::NotSecured:
+        case QKnxDataSecureDecoder::Status::Decrypted:
+        case QKnxDataSecureDecoder::Status::Authenticated:
+            // process tpdu
+            break;
+        default:
+            break; // drop the frame
+        }
+    \endcode
+
+    Group keys and the last accepted sequence number of every individual
+    address are kept in tables indexed directly by the 16 bit address, and the
+    AES key schedule of every group key is set up once when the key is set. The
+    sequence number is checked before any cryptographic work is done, so
+    replayed telegrams are rejected cheaply.
+
+    Only group communication using the \c S-A_Data service is supported. Tool
+    access, system broadcast, and synchronization telegrams are reported as
+    \l Status::Unsupported.
+
+    \note This class is not thread-safe.
+*/
+
+/*!
+    \enum QKnxDataSecureDecoder::Status
+
+    This enum describes the result of decoding a link layer frame.
+
+    \value NotSecured
+            The frame does not contain a secured APDU and was passed through.
+    \value Decrypted
+            The frame was authenticated and decrypted.
+    \value Authenticated
+            The frame was authenticated, its APDU was not encrypted.
+    \value UnknownKey
+            No key is known for the destination group address.
+    \value Replayed
+            The sequence number is not higher than the last sequence number
+            accepted from the source address.
+    \value AuthenticationFailed
+            The message authentication code does not match.
+    \value Unsupported
+            The secured APDU uses a service or security mode that is not
+            supported.
+    \value Invalid
+            The frame or the secured APDU is malformed.
+*/
+
+class QKnxDataSecureDecoderPrivate final
+{
+public:
+    enum : int
+    {
+        AddressCount = 0x10000,
+        HeaderSize = 9, // TPCI/APCI, security control field, sequence number
+        MacSize = 4,
+        MinimumSize = HeaderSize + 2 + MacSize
+    };
+
+    enum : quint8
+    {
+        ToolAccess = 0x80,
+        SystemBroadcast = 0x08,
+        AlgorithmMask = 0x70,
+        AuthenticationOnly = 0x00,
+        AuthenticationConfidentiality = 0x10,
+        ServiceMask = 0x07,
+        DataService = 0x00
+    };
+
+    ~QKnxDataSecureDecoderPrivate()
+    {
+        qDeleteAll(m_ciphers);
+    }
+
+    QKnxSecureCipher *cipher(quint16 groupAddress) const
+    {
+        if (m_keySlots.isEmpty())
+            return nullptr;
+        const auto slot = m_keySlots.at(groupAddress);
+        return slot ? m_ciphers.at(slot - 1) : nullptr;
+    }
+
+    // slot index + 1 of the cipher per group address, 0 if there is no key
+    QVector<quint16> m_keySlots;
+    QVector<QKnxSecureCipher *> m_ciphers;
+    // last accepted sequence number per individual address
+    QVector<quint48> m_lastSequence;
+};
+
+/*!
+    Creates a decoder without any group keys.
+*/
+QKnxDataSecureDecoder::QKnxDataSecureDecoder()
+    : d_ptr(new QKnxDataSecureDecoderPrivate)
+{}
+
+/*!
+    Destroys the decoder and releases all keys.
+*/
+QKnxDataSecureDecoder::~QKnxDataSecureDecoder() = default;
+
+/*!
+    Sets the 16 byte AES \a key used to secure telegrams sent to the group
+    address \a groupAddress, replacing any previous key. Returns \c true on
+    success; otherwise returns \c false.
+*/
+bool QKnxDataSecureDecoder::setGroupKey(const QKnxAddress &groupAddress, const QKnxByteArray &key)
+{
+    if (!groupAddress.isValid() || groupAddress.type() != QKnxAddress::Type::Group
+        || key.size() != QKnxSecureCipher::BlockSize) {
+        return false;
+    }
+
+    Q_D(QKnxDataSecureDecoder);
+    if (auto cipher = d->cipher(groupAddress.toUInt16()))
+        return cipher->setKey(key);
+
+    QScopedPointer<QKnxSecureCipher> cipher(new QKnxSecureCipher);
+    if (!cipher->setKey(key))
+        return false;
+
+    if (d->m_keySlots.isEmpty())
+        d->m_keySlots.fill(0, QKnxDataSecureDecoderPrivate::AddressCount);
+
+    auto slot = d->m_ciphers.indexOf(nullptr); // reuse slots of removed keys
+    if (slot < 0) {
+        slot = d->m_ciphers.size();
+        d->m_ciphers.append(nullptr);
+    }
+    d->m_ciphers[slot] = cipher.take();
+    d->m_keySlots[groupAddress.toUInt16()] = quint16(slot + 1);
+    return true;
+}
+
+/*!
+    Returns \c true if a key is set for the group address \a groupAddress;
+    otherwise returns \c false.
+*/
+bool QKnxDataSecureDecoder::hasGroupKey(const QKnxAddress &groupAddress) const
+{
+    Q_D(const QKnxDataSecureDecoder);
+    return groupAddress.type() == QKnxAddress::Type::Group
+        && d->cipher(groupAddress.toUInt16()) != nullptr;
+}
+
+/*!
+    Removes the key of the group address \a groupAddress.
+*/
+void QKnxDataSecureDecoder::removeGroupKey(const QKnxAddress &groupAddress)
+{
+    Q_D(QKnxDataSecureDecoder);
+    if (groupAddress.type() != QKnxAddress::Type::Group || d->m_keySlots.isEmpty())
+        return;
+
+    auto &slot = d->m_keySlots[groupAddress.toUInt16()];
+    if (slot == 0)
+        return;
+    delete d->m_ciphers.at(slot - 1);
+    d->m_ciphers[slot - 1] = nullptr;
+    slot = 0;
+}
+
+/*!
+    Removes all group keys.
+*/
+void QKnxDataSecureDecoder::clearGroupKeys()
+{
+    Q_D(QKnxDataSecureDecoder);
+    qDeleteAll(d->m_ciphers);
+    d->m_ciphers.clear();
+    d->m_keySlots.clear();
+}
+
+/*!
+    Returns the last sequence number accepted from the individual address
+    \a sourceAddress, or \c 0 if none has been accepted or set yet.
+*/
+quint48 QKnxDataSecureDecoder::lastSequenceNumber(const QKnxAddress &sourceAddress) const
+{
+    Q_D(const QKnxDataSecureDecoder);
+    if (sourceAddress.type() != QKnxAddress::Type::Individual || d->m_lastSequence.isEmpty())
+        return 0;
+    return d->m_lastSequence.at(sourceAddress.toUInt16());
+}
+
+/*!
+    Sets the last sequence number accepted from the individual address
+    \a sourceAddress to \a sequenceNumber. Only telegrams with a higher
+    sequence number will be accepted from that address.
+
+    Use this function to restore the sequence numbers that were persisted
+    or provided by the project keyring.
+*/
+void QKnxDataSecureDecoder::setLastSequenceNumber(const QKnxAddress &sourceAddress,
+    quint48 sequenceNumber)
+{
+    if (!sourceAddress.isValid() || sourceAddress.type() != QKnxAddress::Type::Individual)
+        return;
+
+    Q_D(QKnxDataSecureDecoder);
+    if (d->m_lastSequence.isEmpty())
+        d->m_lastSequence.fill(0, QKnxDataSecureDecoderPrivate::AddressCount);
+    d->m_lastSequence[sourceAddress.toUInt16()] = sequenceNumber & Q_UINT64_C(0xffffffffffff);
+}
+
+/*!
+    Forgets the sequence numbers of all individual addresses.
+*/
+void QKnxDataSecureDecoder::resetSequenceNumbers()
+{
+    Q_D(QKnxDataSecureDecoder);
+    d->m_lastSequence.clear();
+}
+
+/*!
+    Decodes the link layer \a frame and writes the plain TPDU to \a tpdu.
+    Returns the status of the operation. The \a tpdu is only written if the
+    returned status is \l Status::NotSecured, \l Status::Decrypted, or
+    \l Status::Authenticated.
+
+    On success, the sequence number of the frame's source address is advanced.
+*/
+QKnxDataSecureDecoder::Status QKnxDataSecureDecoder::decode(const QKnxLinkLayerFrame &frame,
+    QKnxTpdu *tpdu)
+{
+    using P = QKnxDataSecureDecoderPrivate;
+
+    if (!tpdu)
+        return Status::Invalid;
+
+    const auto secured = frame.tpdu();
+    if (secured.applicationControlField() != QKnxTpdu::ApplicationControlField::SecureService) {
+        *tpdu = secured;
+        return Status::NotSecured;
+    }
+
+    const auto bytes = secured.bytes();
+    if (bytes.size() < P::MinimumSize)
+        return Status::Invalid;
+
+    const auto source = frame.sourceAddress();
+    const auto destination = frame.destinationAddress();
+    if (source.type() != QKnxAddress::Type::Individual)
+        return Status::Invalid;
+
+    const auto data = bytes.constData();
+    const quint8 scf = data[2];
+    const quint8 algorithm = scf & P::AlgorithmMask;
+    if (destination.type() != QKnxAddress::Type::Group || (scf & P::ToolAccess)
+        || (scf & P::SystemBroadcast) || (scf & P::ServiceMask) != P::DataService
+        || (algorithm != P::AuthenticationOnly && algorithm != P::AuthenticationConfidentiality)) {
+        return Status::Unsupported;
+    }
+
+    Q_D(QKnxDataSecureDecoder);
+    auto cipher = d->cipher(destination.toUInt16());
+    if (!cipher)
+        return Status::UnknownKey;
+
+    quint48 sequence = 0;
+    for (int i = 3; i < P::HeaderSize; ++i)
+        sequence = (sequence << 8) | data[i];
+    const quint16 sourceRaw = source.toUInt16();
+    const quint48 last = d->m_lastSequence.isEmpty() ? 0 : d->m_lastSequence.at(sourceRaw);
+    if (sequence <= last)
+        return Status::Replayed; // before spending any AES work
+
+    const quint16 destinationRaw = destination.toUInt16();
+    const int size = bytes.size() - P::HeaderSize - P::MacSize;
+    const auto payload = data + P::HeaderSize;
+    const auto receivedMac = payload + size;
+
+    // B0: sequence number, addresses, frame format, TPCI/APCI and length
+    quint8 b0[QKnxSecureCipher::BlockSize];
+    memcpy(b0, data + 3, 6);
+    b0[6] = quint8(sourceRaw >> 8);
+    b0[7] = quint8(sourceRaw);
+    b0[8] = quint8(destinationRaw >> 8);
+    b0[9] = quint8(destinationRaw);
+    b0[10] = 0x00;
+    b0[11] = frame.extendedControlField().byte() & 0x8f; // address type and frame format
+    b0[12] = data[0];
+    b0[13] = data[1];
+    b0[14] = 0x00;
+    b0[15] = 0x00;
+
+    quint8 ctr0[QKnxSecureCipher::BlockSize];
+    memcpy(ctr0, b0, 10);
+    memset(ctr0 + 10, 0, 4);
+    ctr0[14] = 0x01;
+    ctr0[15] = 0x00;
+
+    QKnxByteArray plain(size, 0x00);
+    auto out = plain.data();
+
+    quint8 mac[QKnxSecureCipher::BlockSize];
+    quint8 expected[P::MacSize];
+    if (algorithm == P::AuthenticationConfidentiality) {
+        b0[15] = quint8(size);
+        const quint8 a[] = { 0x00, 0x01, scf };
+        ctr0[15] = 0x01;
+        if (!cipher->processCounterStream(ctr0, payload, size, out))
+            return Status::Invalid;
+        ctr0[15] = 0x00;
+        if (!cipher->processCounterStream(ctr0, receivedMac, P::MacSize, expected))
+            return Status::Invalid;
+        if (!cipher->cbcMac(b0, a, sizeof(a), out, size, mac,
+            QKnxSecureCipher::Padding::ToBlockSize)) {
+            return Status::Invalid;
+        }
+    } else {
+        // the APDU is part of the associated data, the MAC is sent as is
+        const quint8 a[] = { quint8((size + 1) >> 8), quint8(size + 1), scf };
+        memcpy(out, payload, size_t(size));
+        memcpy(expected, receivedMac, P::MacSize);
+        if (!cipher->cbcMac(b0, a, sizeof(a), payload, size, mac,
+            QKnxSecureCipher::Padding::ToBlockSize)) {
+            return Status::Invalid;
+        }
+    }
+
+    quint8 diff = 0; // constant time compare
+    for (int i = 0; i < P::MacSize; ++i)
+        diff |= mac[i] ^ expected[i];
+    if (diff != 0)
+        return Status::AuthenticationFailed;
+
+    if (d->m_lastSequence.isEmpty())
+        d->m_lastSequence.fill(0, P::AddressCount);
+    d->m_lastSequence[sourceRaw] = sequence;
+
+    // the secured APDU carries no transport layer bits, take them from the frame
+    out[0] = quint8((data[0] & 0xfc) | (out[0] & 0x03));
+    *tpdu = QKnxTpdu::fromBytes(plain, 0, quint16(size), secured.mediumType());
+
+    return algorithm == P::AuthenticationConfidentiality ? Status::Decrypted
+        : Status::Authenticated;
+}
+
+QT_END_NAMESPACE
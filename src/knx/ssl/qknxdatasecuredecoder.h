@@ -0,0 +1,85 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDATASECUREDECODER_H
+#define QKNXDATASECUREDECODER_H
+
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qscopedpointer.h>
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxtpdu.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxDataSecureDecoderPrivate;
+class Q_KNX_EXPORT QKnxDataSecureDecoder final
+{
+    Q_GADGET
+
+public:
+    enum class Status : quint8
+    {
+        NotSecured = 0x00,
+        Decrypted = 0x01,
+        Authenticated = 0x02,
+        UnknownKey = 0x03,
+        Replayed = 0x04,
+        AuthenticationFailed = 0x05,
+        Unsupported = 0x06,
+        Invalid = 0x07
+    };
+    Q_ENUM(Status)
+
+    QKnxDataSecureDecoder();
+    ~QKnxDataSecureDecoder();
+
+    bool setGroupKey(const QKnxAddress &groupAddress, const QKnxByteArray &key);
+    bool hasGroupKey(const QKnxAddress &groupAddress) const;
+    void removeGroupKey(const QKnxAddress &groupAddress);
+    void clearGroupKeys();
+
+    quint48 lastSequenceNumber(const QKnxAddress &sourceAddress) const;
+    void setLastSequenceNumber(const QKnxAddress &sourceAddress, quint48 sequenceNumber);
+    void resetSequenceNumbers();
+
+    Status decode(const QKnxLinkLayerFrame &frame, QKnxTpdu *tpdu);
+
+private:
+    Q_DISABLE_COPY(QKnxDataSecureDecoder)
+    Q_DECLARE_PRIVATE(QKnxDataSecureDecoder)
+    QScopedPointer<QKnxDataSecureDecoderPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
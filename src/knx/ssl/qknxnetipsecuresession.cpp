@@ -0,0 +1,340 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipsecuresession_p.h"
+#include "qknxnetipsessionauthenticate.h"
+#include "qknxnetipsessionrequest.h"
+#include "qknxnetipsessionresponse.h"
+#include "qknxnetipsessionstatus.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxNetIpSecureSession
+    \inmodule QtKnx
+
+    \brief The QKnxNetIpSecureSession class implements the client side of a
+    KNXnet/IP secure session.
+
+    The session runs the handshake built from session request, session
+    response, session authenticate and session status frames and afterwards
+    wraps and unwraps all frames exchanged over the connection into secure
+    wrapper frames.
+
+    The session key is set up once, when the session response has been
+    verified, and kept in a QKnxSecureCipher for the lifetime of the session.
+    Wrapping and unwrapping work on raw frame bytes and write into buffers
+    owned by the caller that are only grown, so no frame objects are created
+    and no allocations happen per frame once the buffers have reached their
+    final size.
+*/
+
+namespace QKnxPrivate
+{
+    static quint16 readUInt16(const quint8 *data)
+    {
+        return quint16(data[0] << 8 | data[1]);
+    }
+
+    static quint48 readUInt48(const quint8 *data)
+    {
+        quint48 value = 0;
+        for (int i = 0; i < 6; ++i)
+            value = (value << 8) | data[i];
+        return value;
+    }
+
+    static void writeUInt16(quint8 *data, quint16 value)
+    {
+        data[0] = quint8(value >> 8);
+        data[1] = quint8(value);
+    }
+
+    static void writeUInt48(quint8 *data, quint48 value)
+    {
+        for (int i = 5; i >= 0; --i, value >>= 8)
+            data[i] = quint8(value);
+    }
+
+    enum SecureWrapperOffsets : int
+    {
+        SessionIdOffset = 6,
+        SequenceOffset = 8,
+        SerialOffset = 14,
+        TagOffset = 20,
+        PayloadOffset = 22
+    };
+}
+
+/*!
+    \internal
+    Creates a session for the user \a userId, authenticating with the user
+    password hash \a userPasswordHash. If \a deviceAuthenticationCode is not
+    empty, it is used to verify the session response sent by the server.
+    The \a serialNumber is sent in every secure wrapper frame; an empty serial
+    number is sent as six \c 0x00 bytes.
+
+    The ephemeral key pair of the session is taken from QKnxCurve25519KeyPool.
+*/
+QKnxNetIpSecureSession::QKnxNetIpSecureSession(quint8 userId,
+        const QKnxByteArray &userPasswordHash, const QKnxByteArray &deviceAuthenticationCode,
+        const QKnxByteArray &serialNumber)
+    : m_userId(userId)
+    , m_userPasswordHash(userPasswordHash)
+    , m_deviceAuthenticationCode(deviceAuthenticationCode)
+    , m_serialNumber(QKnxSecureCipher::SerialNumberSize, 0x00)
+{
+    for (int i = 0; i < QKnxSecureCipher::SerialNumberSize; ++i)
+        m_serialNumber.set(i, serialNumber.value(i, 0x00));
+}
+
+/*!
+    \internal
+    Replaces the generated Curve25519 key pair of the session with the one
+    derived from the private key \a key. Has no effect once the session has
+    been requested.
+*/
+void QKnxNetIpSecureSession::setPrivateKey(const QKnxCurve25519PrivateKey &key)
+{
+    if (m_state != State::Idle || !key.isValid())
+        return;
+    m_privateKey = key;
+    m_publicKey = QKnxCurve25519PublicKey(key);
+}
+
+/*!
+    \internal
+    Sets up an already negotiated \a sessionKey for the session \a sessionId
+    and marks the session as authenticated. Returns \c true on success;
+    otherwise returns \c false.
+*/
+bool QKnxNetIpSecureSession::setSessionKey(quint16 sessionId, const QKnxByteArray &sessionKey)
+{
+    reset();
+    if (!m_cipher.setKey(sessionKey))
+        return false;
+
+    m_sessionId = sessionId;
+    m_state = State::Authenticated;
+    return true;
+}
+
+/*!
+    \internal
+    Returns the session request frame announcing the public key of the
+    session and the \a controlEndpoint of the client.
+*/
+QKnxNetIpFrame QKnxNetIpSecureSession::createSessionRequest(const QKnxNetIpHpai &controlEndpoint)
+{
+    reset();
+    if (!m_publicKey.isValid())
+        return {};
+
+    m_state = State::Requested;
+    return QKnxNetIpSessionRequestProxy::builder()
+        .setControlEndpoint(controlEndpoint)
+        .setPublicKey(m_publicKey.bytes())
+        .create();
+}
+
+/*!
+    \internal
+    Verifies the session response \a frame, sets up the session key and
+    returns the session authenticate frame to be sent wrapped to the server.
+    Returns an invalid frame and fails the session if the response could not
+    be verified.
+*/
+QKnxNetIpFrame QKnxNetIpSecureSession::processSessionResponse(const QKnxNetIpFrame &frame)
+{
+    if (m_state != State::Requested)
+        return {};
+
+    m_state = State::Failed;
+
+    const QKnxNetIpSessionResponseProxy response(frame);
+    if (!response.isValid())
+        return {};
+
+    const auto serverKey = QKnxCurve25519PublicKey::fromBytes(response.publicKey());
+    if (!serverKey.isValid())
+        return {};
+
+    const auto keys = QKnxCryptographicEngine::XOR(m_publicKey.bytes(), response.publicKey());
+    if (!m_deviceAuthenticationCode.isEmpty()) {
+        const auto mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(
+            m_deviceAuthenticationCode, frame.header(), response.secureSessionId(), keys);
+        const auto received = QKnxCryptographicEngine::decryptMessageAuthenticationCode(
+            m_deviceAuthenticationCode, response.messageAuthenticationCode());
+        if (mac.isEmpty() || mac != received)
+            return {};
+    }
+
+    if (!m_cipher.setKey(QKnxCryptographicEngine::sessionKey(serverKey, m_privateKey)))
+        return {};
+    m_sessionId = response.secureSessionId();
+
+    // the MAC covers the frame header, build the frame once to get it
+    auto builder = QKnxNetIpSessionAuthenticateProxy::builder();
+    auto authenticate = builder.setUserId(m_userId)
+        .setMessageAuthenticationCode(QKnxByteArray(QKnxSecureCipher::MacSize, 0x00))
+        .create();
+    const auto mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(
+        m_userPasswordHash, authenticate.header(), m_userId, keys);
+    if (mac.isEmpty()) {
+        m_cipher.clear();
+        return {};
+    }
+
+    m_state = State::Authenticating;
+    const auto encryptedMac = QKnxCryptographicEngine::encryptMessageAuthenticationCode(
+        m_userPasswordHash, mac);
+    return builder.setMessageAuthenticationCode(encryptedMac).create();
+}
+
+/*!
+    \internal
+    Processes the unwrapped session status \a frame, updates the session
+    state and returns the status. Returns
+    \l {QKnxNetIp::SecureSessionStatus}{QKnxNetIp::SecureSessionStatus::Unknown}
+    if the frame is invalid.
+*/
+QKnxNetIp::SecureSessionStatus QKnxNetIpSecureSession::processSessionStatus(
+    const QKnxNetIpFrame &frame)
+{
+    const QKnxNetIpSessionStatusProxy proxy(frame);
+    if (!proxy.isValid())
+        return QKnxNetIp::SecureSessionStatus::Unknown;
+
+    const auto status = proxy.status();
+    switch (status) {
+    case QKnxNetIp::SecureSessionStatus::AuthenticationSuccess:
+        if (m_state == State::Authenticating)
+            m_state = State::Authenticated;
+        break;
+    case QKnxNetIp::SecureSessionStatus::KeepAlive:
+        break;
+    default:
+        m_state = State::Failed;
+        m_cipher.clear();
+        break;
+    }
+    return status;
+}
+
+/*!
+    \internal
+    Wraps the \a size bytes of the KNXnet/IP frame \a frame into a secure
+    wrapper frame written to \a out, which is grown if needed. Returns the
+    size of the secure wrapper frame or \c -1 if no session key is set up or
+    an error occurred.
+*/
+int QKnxNetIpSecureSession::wrap(const quint8 *frame, int size, QByteArray *out)
+{
+    const int total = size + WrapperOverhead;
+    if (!m_cipher.isValid() || size <= 0 || total > 0xffff || !out)
+        return -1;
+
+    if (out->size() < total)
+        out->resize(total);
+    auto data = reinterpret_cast<quint8 *>(out->data());
+
+    data[0] = QKnxNetIpFrameHeader::HeaderSize10;
+    data[1] = QKnxNetIpFrameHeader::KnxNetIpVersion10;
+    QKnxPrivate::writeUInt16(data + 2, quint16(QKnxNetIp::ServiceType::SecureWrapper));
+    QKnxPrivate::writeUInt16(data + 4, quint16(total));
+    QKnxPrivate::writeUInt16(data + QKnxPrivate::SessionIdOffset, m_sessionId);
+    QKnxPrivate::writeUInt48(data + QKnxPrivate::SequenceOffset, m_sendSequence);
+    memcpy(data + QKnxPrivate::SerialOffset, m_serialNumber.constData(),
+        QKnxSecureCipher::SerialNumberSize);
+    QKnxPrivate::writeUInt16(data + QKnxPrivate::TagOffset, 0x0000);
+
+    const QKnxSecureCipher::Nonce nonce(m_sendSequence, m_serialNumber.constData(), 0x0000);
+    if (m_cipher.encryptSecureWrapper(nonce, data, m_sessionId, frame, size,
+        data + QKnxPrivate::PayloadOffset, total - QKnxPrivate::PayloadOffset) < 0) {
+            return -1;
+    }
+
+    ++m_sendSequence;
+    return total;
+}
+
+/*!
+    \internal
+    Verifies and decrypts the \a size bytes of the secure wrapper frame
+    \a frame and writes the encapsulated KNXnet/IP frame to \a out. Returns
+    the size of the encapsulated frame, or \c -1 if the frame does not belong
+    to the session, was replayed, or fails authentication.
+*/
+int QKnxNetIpSecureSession::unwrap(const quint8 *frame, int size, QKnxByteArray *out)
+{
+    const int payloadSize = size - WrapperOverhead;
+    if (!m_cipher.isValid() || payloadSize < QKnxNetIpFrameHeader::HeaderSize10 || !out)
+        return -1;
+
+    if (QKnxPrivate::readUInt16(frame + 2) != quint16(QKnxNetIp::ServiceType::SecureWrapper)
+        || QKnxPrivate::readUInt16(frame + 4) != size
+        || QKnxPrivate::readUInt16(frame + QKnxPrivate::SessionIdOffset) != m_sessionId) {
+            return -1;
+    }
+
+    const auto sequence = QKnxPrivate::readUInt48(frame + QKnxPrivate::SequenceOffset);
+    if (sequence < m_receiveSequence)
+        return -1; // replayed or reordered frame
+
+    if (out->size() != payloadSize)
+        out->resize(payloadSize);
+
+    const QKnxSecureCipher::Nonce nonce(sequence, frame + QKnxPrivate::SerialOffset,
+        QKnxPrivate::readUInt16(frame + QKnxPrivate::TagOffset));
+    if (m_cipher.decryptSecureWrapper(nonce, frame, m_sessionId,
+        frame + QKnxPrivate::PayloadOffset, size - QKnxPrivate::PayloadOffset, out->data(),
+        payloadSize) < 0) {
+            return -1;
+    }
+
+    m_receiveSequence = sequence + 1;
+    return payloadSize;
+}
+
+/*!
+    \internal
+    Drops the session key and resets the session to its initial state. The
+    key pair of the session is kept.
+*/
+void QKnxNetIpSecureSession::reset()
+{
+    m_cipher.clear();
+    m_state = State::Idle;
+    m_sessionId = 0;
+    m_sendSequence = 0;
+    m_receiveSequence = 0;
+}
+
+QT_END_NAMESPACE
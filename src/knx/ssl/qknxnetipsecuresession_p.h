@@ -0,0 +1,115 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSECURESESSION_P_H
+#define QKNXNETIPSECURESESSION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxcurve25519.h>
+#include <QtKnx/qknxnetip.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qtknxglobal.h>
+#include <QtKnx/private/qknxcurve25519keypool_p.h>
+#include <QtKnx/private/qknxsecurecipher_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxNetIpSecureSession final
+{
+public:
+    enum class State : quint8
+    {
+        Idle,
+        Requested,
+        Authenticating,
+        Authenticated,
+        Failed
+    };
+
+    // frame header, session id, sequence number, serial number, tag and MAC
+    enum : int { WrapperOverhead = 38 };
+
+    QKnxNetIpSecureSession(quint8 userId, const QKnxByteArray &userPasswordHash,
+        const QKnxByteArray &deviceAuthenticationCode = {}, const QKnxByteArray &serialNumber = {});
+    ~QKnxNetIpSecureSession() = default;
+
+    State state() const { return m_state; }
+    quint16 sessionId() const { return m_sessionId; }
+    bool hasSessionKey() const { return m_cipher.isValid(); }
+
+    quint48 sendSequenceNumber() const { return m_sendSequence; }
+    quint48 receiveSequenceNumber() const { return m_receiveSequence; }
+
+    QKnxCurve25519PublicKey publicKey() const { return m_publicKey; }
+    void setPrivateKey(const QKnxCurve25519PrivateKey &key);
+
+    bool setSessionKey(quint16 sessionId, const QKnxByteArray &sessionKey);
+
+    QKnxNetIpFrame createSessionRequest(const QKnxNetIpHpai &controlEndpoint);
+    QKnxNetIpFrame processSessionResponse(const QKnxNetIpFrame &frame);
+    QKnxNetIp::SecureSessionStatus processSessionStatus(const QKnxNetIpFrame &frame);
+
+    int wrap(const quint8 *frame, int size, QByteArray *out);
+    int unwrap(const quint8 *frame, int size, QKnxByteArray *out);
+
+    void reset();
+
+private:
+    Q_DISABLE_COPY(QKnxNetIpSecureSession)
+
+    quint8 m_userId { 0 };
+    QKnxByteArray m_userPasswordHash;
+    QKnxByteArray m_deviceAuthenticationCode;
+    QKnxByteArray m_serialNumber;
+
+    QKnxCurve25519PrivateKey m_privateKey { QKnxCurve25519KeyPool::instance()->take() };
+    QKnxCurve25519PublicKey m_publicKey { m_privateKey };
+
+    State m_state { State::Idle };
+    quint16 m_sessionId { 0 };
+    quint48 m_sendSequence { 0 };
+    quint48 m_receiveSequence { 0 };
+    QKnxSecureCipher m_cipher;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,375 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxsecurecipher_p.h"
+#include "qknxcryptographicdata_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxSecureCipher
+    \inmodule QtKnx
+
+    \brief The QKnxSecureCipher class implements the AES-128 based CCM variant
+    used by KNXnet/IP secure frames.
+
+    The AES key schedule is set up once in setKey() and kept in two OpenSSL
+    cipher contexts, one in ECB mode to produce the counter stream and one in
+    CBC mode to compute the CBC-MAC. All operations write into caller provided
+    buffers, so a cipher object can be kept per secure session and reused for
+    every frame without further allocations.
+
+    \note The KNX CCM variant uses a 16 byte \c B0 and counter block built from
+    the sequence number, serial number and message tag without a flags byte,
+    and increments only the last byte of the counter. Therefore the generic
+    OpenSSL CCM mode cannot be used.
+*/
+
+/*!
+    \internal
+    Creates the nonce used to build the \c B0 and counter blocks from the given
+    \a sequence, \a serial, and \a tag. An empty \a serial is treated as six
+    \c 0x00 bytes.
+*/
+QKnxSecureCipher::Nonce::Nonce(quint48 sequence, const QKnxByteArray &serial, quint16 tag)
+    : sequenceNumber(sequence)
+    , messageTag(tag)
+{
+    for (int i = 0; i < SerialNumberSize; ++i)
+        serialNumber[i] = serial.value(i, 0x00);
+}
+
+/*!
+    \internal
+    Creates the nonce from the given \a sequence, \a tag, and the six bytes
+    of serial number pointed to by \a serial.
+*/
+QKnxSecureCipher::Nonce::Nonce(quint48 sequence, const quint8 *serial, quint16 tag)
+    : sequenceNumber(sequence)
+    , messageTag(tag)
+{
+    memcpy(serialNumber, serial, SerialNumberSize);
+}
+
+/*!
+    \internal
+    Creates a cipher and initializes it with the given \a key.
+*/
+QKnxSecureCipher::QKnxSecureCipher(const QKnxByteArray &key)
+{
+    setKey(key);
+}
+
+/*!
+    \internal
+    Destroys the cipher and releases the OpenSSL cipher contexts.
+*/
+QKnxSecureCipher::~QKnxSecureCipher()
+{
+    clear();
+}
+
+/*!
+    \internal
+    Returns \c true if a valid key has been set; otherwise returns \c false.
+*/
+bool QKnxSecureCipher::isValid() const
+{
+    return m_ecb && m_cbc;
+}
+
+/*!
+    \internal
+    Sets the 16 byte AES \a key and sets up the key schedule of the internal
+    cipher contexts. Returns \c true on success; otherwise returns \c false
+    and leaves the cipher invalid.
+*/
+bool QKnxSecureCipher::setKey(const QKnxByteArray &key)
+{
+    clear();
+
+    if (key.size() != BlockSize || !QKnxOpenSsl::supportsSsl())
+        return false;
+
+    static const quint8 iv[BlockSize] { 0x00 };
+
+    m_ecb = q_EVP_CIPHER_CTX_new();
+    m_cbc = q_EVP_CIPHER_CTX_new();
+    if (!m_ecb || !m_cbc
+        || q_EVP_CipherInit_ex(m_ecb, q_EVP_aes_128_ecb(), nullptr, key.constData(), nullptr,
+            0x01) <= 0
+        || q_EVP_CipherInit_ex(m_cbc, q_EVP_aes_128_cbc(), nullptr, key.constData(), iv,
+            0x01) <= 0
+        || q_EVP_CIPHER_CTX_set_padding(m_ecb, 0) <= 0
+        || q_EVP_CIPHER_CTX_set_padding(m_cbc, 0) <= 0) {
+            clear();
+            return false;
+    }
+    return true;
+}
+
+/*!
+    \internal
+    Releases the cipher contexts and wipes the scratch buffer. The cipher is
+    invalid afterwards.
+*/
+void QKnxSecureCipher::clear()
+{
+    if (m_ecb)
+        q_EVP_CIPHER_CTX_free(m_ecb);
+    if (m_cbc)
+        q_EVP_CIPHER_CTX_free(m_cbc);
+    m_ecb = m_cbc = nullptr;
+    m_scratch.fill(0x00);
+}
+
+/*!
+    \internal
+    Encrypts \a size bytes of \a in with AES-128 in ECB mode and writes the
+    result to \a out. The \a size must be a multiple of the block size.
+*/
+bool QKnxSecureCipher::encryptBlocks(const quint8 *in, int size, quint8 *out)
+{
+    if (!isValid() || size < 0 || (size % BlockSize) != 0)
+        return false;
+    if (size == 0)
+        return true;
+
+    int outl = 0;
+    return q_EVP_CipherUpdate(m_ecb, out, &outl, in, size) > 0 && outl == size;
+}
+
+/*!
+    \internal
+    Computes the CBC-MAC over the \c B0 block built from \a nonce and
+    \a payloadLength followed by \a size bytes of \a data, and writes the
+    16 byte result to \a mac. The \a data is padded with \c 0x00 bytes.
+*/
+bool QKnxSecureCipher::calculateMac(const Nonce &nonce, quint16 payloadLength, const quint8 *data,
+    int size, quint8 *mac)
+{
+    quint8 b0[BlockSize];
+    block(b0, nonce, payloadLength);
+    return cbcMac(b0, data, size, nullptr, 0, mac);
+}
+
+/*!
+    \internal
+    Encrypts or decrypts the 16 byte MAC \a in by XOR'ing it with the
+    encrypted counter block \c Ctr0 and writes the result to \a out.
+*/
+bool QKnxSecureCipher::processMac(const Nonce &nonce, const quint8 *in, quint8 *out)
+{
+    quint8 ctr[BlockSize];
+    block(ctr, nonce, 0xff00);
+    if (!encryptBlocks(ctr, BlockSize, ctr))
+        return false;
+    for (int i = 0; i < MacSize; ++i)
+        out[i] = in[i] ^ ctr[i];
+    return true;
+}
+
+/*!
+    \internal
+    Encrypts or decrypts \a size bytes of \a in using the counter stream
+    starting at \c Ctr0 + 1 and writes the result to \a out. The buffers may
+    overlap completely.
+*/
+bool QKnxSecureCipher::processPayload(const Nonce &nonce, const quint8 *in, int size, quint8 *out)
+{
+    if (size < 0)
+        return false;
+
+    quint8 ctr[BlockSize];
+    block(ctr, nonce, 0xff00);
+    ctr[BlockSize - 1] = quint8(ctr[BlockSize - 1] + 1);
+    return processCounterStream(ctr, in, size, out);
+}
+
+/*!
+    \internal
+    Encrypts or decrypts \a size bytes of \a in using the counter stream
+    starting at the 16 byte \a counter block and writes the result to \a out.
+    Only the last byte of the counter is incremented from block to block. The
+    buffers may overlap completely.
+*/
+bool QKnxSecureCipher::processCounterStream(const quint8 *counter, const quint8 *in, int size,
+    quint8 *out)
+{
+    if (size < 0)
+        return false;
+
+    const int blocks = (size + BlockSize - 1) / BlockSize;
+    auto stream = scratch(blocks * BlockSize);
+
+    for (int i = 0; i < blocks; ++i) {
+        memcpy(stream + i * BlockSize, counter, BlockSize);
+        stream[i * BlockSize + BlockSize - 1] = quint8(counter[BlockSize - 1] + i);
+    }
+
+    if (!encryptBlocks(stream, blocks * BlockSize, stream))
+        return false;
+    for (int i = 0; i < size; ++i)
+        out[i] = in[i] ^ stream[i];
+    return true;
+}
+
+/*!
+    \internal
+    Encrypts \a size bytes of \a payload as the body of a secure wrapper frame
+    with the given frame \a header (6 bytes) and \a sessionId, and writes the
+    encrypted payload followed by the encrypted MAC to \a out. Returns the
+    number of bytes written or \c -1 if \a capacity is too small or an error
+    occurred.
+*/
+int QKnxSecureCipher::encryptSecureWrapper(const Nonce &nonce, const quint8 *header,
+    quint16 sessionId, const quint8 *payload, int size, quint8 *out, int capacity)
+{
+    if (size <= 0 || size > 0xffff || capacity < size + MacSize)
+        return -1;
+
+    quint8 mac[MacSize];
+    if (!secureWrapperMac(nonce, header, sessionId, payload, size, mac))
+        return -1;
+    if (!processMac(nonce, mac, out + size))
+        return -1;
+    if (!processPayload(nonce, payload, size, out))
+        return -1;
+    return size + MacSize;
+}
+
+/*!
+    \internal
+    Decrypts the body \a in of a secure wrapper frame with the given frame
+    \a header (6 bytes) and \a sessionId. The \a size covers the encrypted
+    payload and the trailing encrypted MAC. The decrypted payload is written
+    to \a out and its size returned. Returns \c -1 if \a capacity is too small,
+    the MAC does not match, or an error occurred.
+*/
+int QKnxSecureCipher::decryptSecureWrapper(const Nonce &nonce, const quint8 *header,
+    quint16 sessionId, const quint8 *in, int size, quint8 *out, int capacity)
+{
+    const int payloadSize = size - MacSize;
+    if (payloadSize <= 0 || payloadSize > 0xffff || capacity < payloadSize)
+        return -1;
+
+    quint8 received[MacSize], calculated[MacSize];
+    if (!processMac(nonce, in + payloadSize, received))
+        return -1;
+    if (!processPayload(nonce, in, payloadSize, out))
+        return -1;
+    if (!secureWrapperMac(nonce, header, sessionId, out, payloadSize, calculated))
+        return -1;
+
+    quint8 diff = 0; // constant time compare
+    for (int i = 0; i < MacSize; ++i)
+        diff |= received[i] ^ calculated[i];
+    if (diff != 0) {
+        memset(out, 0, size_t(payloadSize));
+        return -1;
+    }
+    return payloadSize;
+}
+
+quint8 *QKnxSecureCipher::scratch(int size)
+{
+    if (m_scratch.size() < size)
+        m_scratch.resize(size);
+    return reinterpret_cast<quint8 *>(m_scratch.data());
+}
+
+/*!
+    \internal
+    Computes the CBC-MAC over the 16 byte block \a b0, followed by \a aSize
+    bytes of \a a and \a pSize bytes of \a p, and writes the 16 byte result
+    to \a mac. The input is padded with \c 0x00 bytes as selected by
+    \a padding: \c Padding::Always appends 1 to 16 bytes, as done for
+    KNXnet/IP secure frames, while \c Padding::ToBlockSize pads only up to
+    the next block boundary, as done for KNX Data Secure APDUs.
+*/
+bool QKnxSecureCipher::cbcMac(const quint8 *b0, const quint8 *a, int aSize, const quint8 *p,
+    int pSize, quint8 *mac, Padding padding)
+{
+    if (!isValid() || aSize < 0 || pSize < 0)
+        return false;
+
+    // KNXnet/IP secure always appends 1 to 16 bytes of padding, matching the
+    // way the MAC has been calculated before.
+    const int size = BlockSize + aSize + pSize;
+    const int pad = BlockSize - size % BlockSize;
+    const int total = size + ((padding == Padding::ToBlockSize && pad == BlockSize) ? 0 : pad);
+    auto buffer = scratch(total);
+    memcpy(buffer, b0, BlockSize);
+    if (aSize > 0)
+        memcpy(buffer + BlockSize, a, size_t(aSize));
+    if (pSize > 0)
+        memcpy(buffer + BlockSize + aSize, p, size_t(pSize));
+    memset(buffer + size, 0, size_t(total - size));
+
+    static const quint8 iv[BlockSize] { 0x00 };
+    if (q_EVP_CipherInit_ex(m_cbc, nullptr, nullptr, nullptr, iv, 0x01) <= 0)
+        return false;
+
+    int outl = 0;
+    if (q_EVP_CipherUpdate(m_cbc, buffer, &outl, buffer, total) <= 0 || outl != total)
+        return false;
+    memcpy(mac, buffer + total - BlockSize, BlockSize);
+    return true;
+}
+
+bool QKnxSecureCipher::secureWrapperMac(const Nonce &nonce, const quint8 *header,
+    quint16 sessionId, const quint8 *payload, int size, quint8 *mac)
+{
+    enum : int { HeaderSize = 6, AssociatedSize = HeaderSize + 2 };
+
+    quint8 a[2 + AssociatedSize];
+    a[0] = 0x00;
+    a[1] = AssociatedSize;
+    memcpy(a + 2, header, HeaderSize);
+    a[2 + HeaderSize] = quint8(sessionId >> 8);
+    a[3 + HeaderSize] = quint8(sessionId);
+
+    quint8 b0[BlockSize];
+    block(b0, nonce, quint16(size));
+    return cbcMac(b0, a, sizeof(a), payload, size, mac);
+}
+
+void QKnxSecureCipher::block(quint8 *out, const Nonce &nonce, quint16 length)
+{
+    for (int i = 0; i < 6; ++i)
+        out[i] = quint8(nonce.sequenceNumber >> (8 * (5 - i)));
+    memcpy(out + 6, nonce.serialNumber, SerialNumberSize);
+    out[12] = quint8(nonce.messageTag >> 8);
+    out[13] = quint8(nonce.messageTag);
+    out[14] = quint8(length >> 8);
+    out[15] = quint8(length);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,108 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXSECURECIPHER_P_H
+#define QKNXSECURECIPHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
+class Q_KNX_EXPORT QKnxSecureCipher final
+{
+public:
+    enum : int { BlockSize = 16, MacSize = 16, SerialNumberSize = 6 };
+    enum class Padding : quint8 { Always, ToBlockSize };
+
+    struct Q_KNX_EXPORT Nonce final
+    {
+        Nonce(quint48 sequence, const QKnxByteArray &serial, quint16 tag);
+        Nonce(quint48 sequence, const quint8 *serial, quint16 tag);
+
+        quint48 sequenceNumber;
+        quint8 serialNumber[SerialNumberSize];
+        quint16 messageTag;
+    };
+
+    QKnxSecureCipher() = default;
+    explicit QKnxSecureCipher(const QKnxByteArray &key);
+    ~QKnxSecureCipher();
+
+    bool isValid() const;
+    bool setKey(const QKnxByteArray &key);
+    void clear();
+
+    bool encryptBlocks(const quint8 *in, int size, quint8 *out);
+
+    bool calculateMac(const Nonce &nonce, quint16 payloadLength, const quint8 *data, int size,
+        quint8 *mac);
+    bool processMac(const Nonce &nonce, const quint8 *in, quint8 *out);
+    bool processPayload(const Nonce &nonce, const quint8 *in, int size, quint8 *out);
+
+    bool cbcMac(const quint8 *b0, const quint8 *a, int aSize, const quint8 *p, int pSize,
+        quint8 *mac, Padding padding = Padding::Always);
+    bool processCounterStream(const quint8 *counter, const quint8 *in, int size, quint8 *out);
+
+    int encryptSecureWrapper(const Nonce &nonce, const quint8 *header, quint16 sessionId,
+        const quint8 *payload, int size, quint8 *out, int capacity);
+    int decryptSecureWrapper(const Nonce &nonce, const quint8 *header, quint16 sessionId,
+        const quint8 *in, int size, quint8 *out, int capacity);
+
+private:
+    quint8 *scratch(int size);
+    bool secureWrapperMac(const Nonce &nonce, const quint8 *header, quint16 sessionId,
+        const quint8 *payload, int size, quint8 *mac);
+
+    static void block(quint8 *out, const Nonce &nonce, quint16 length);
+
+private:
+    Q_DISABLE_COPY(QKnxSecureCipher)
+
+    EVP_CIPHER_CTX *m_ecb { nullptr };
+    EVP_CIPHER_CTX *m_cbc { nullptr };
+    QByteArray m_scratch;
+};
+
+QT_END_NAMESPACE
+
+#endif
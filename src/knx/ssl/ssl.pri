@@ -2,10 +2,18 @@ qtConfig(opensslv11) { # OpenSSL 1.1 support is required.
     HEADERS += ssl/qssl.h \
                ssl/qssl_p.h \
                ssl/qknxcurve25519.h \
-               ssl/qknxcryptographicdata_p.h
+               ssl/qknxdatasecuredecoder.h \
+               ssl/qknxcryptographicdata_p.h \
+               ssl/qknxcurve25519keypool_p.h \
+               ssl/qknxsecurecipher_p.h \
+               ssl/qknxnetipsecuresession_p.h
 
     SOURCES += ssl/qssl.cpp \
-               ssl/qknxcurve25519.cpp
+               ssl/qknxcurve25519.cpp \
+               ssl/qknxcurve25519keypool.cpp \
+               ssl/qknxdatasecuredecoder.cpp \
+               ssl/qknxsecurecipher.cpp \
+               ssl/qknxnetipsecuresession.cpp
 
     HEADERS += ssl/qsslsocket_openssl_symbols_p.h
     SOURCES += ssl/qsslsocket_openssl_symbols.cpp
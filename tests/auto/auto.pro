@@ -46,7 +46,19 @@ SUBDIRS += cmake \
     qknxnetipsecuredservicefamiliesdib \
     qknxnetipsessionrequest \
     qknxnetipsessionresponse \
-    qknxnetiprouter
+    qknxnetiprouter \
+    qknxgroupvaluecache \
+    qknxnetipframescheduler \
+    qknxbusloadestimator \
+    qknxbusmonitorbuffer \
+    qknxcapturereplay \
+    qknxcapturewriter \
+    qknxtimerwheel \
+    qknxvirtualclock \
+    qknxnetipsharedtransport \
+    qknxdatapointtypecodec \
+    qknxgroupvaluedecoder \
+    qknxnetiptunnel
 
 QT_FOR_CONFIG += network
-qtConfig(opensslv11):SUBDIRS+=qknxcryptographicengine
+qtConfig(opensslv11):SUBDIRS+=qknxcryptographicengine qknxdatasecuredecoder qknxnetipsecuresession
@@ -0,0 +1,7 @@
+TARGET = tst_qknxbusloadestimator
+
+QT = core testlib knx knx-private
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qknxbusloadestimator.cpp
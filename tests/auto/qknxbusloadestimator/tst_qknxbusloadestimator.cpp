@@ -0,0 +1,104 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/private/qknxbusloadestimator_p.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxBusLoadEstimator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testBusTime()
+    {
+        // 182 bit times at 9600 bit/s
+        QCOMPARE(QKnxBusLoadEstimator::busTime(8), qint64(18959));
+
+        // GroupValueWrite with a 1 bit value: 7 octets header and checksum, 2 octets TPDU
+        const auto frame = QKnxLinkLayerFrame::builder()
+            .setMedium(QKnx::MediumType::NetIP)
+            .setData(QKnxByteArray::fromHex("2900bcd011590ade010081"))
+            .createFrame();
+        QCOMPARE(QKnxBusLoadEstimator::busTime(frame), QKnxBusLoadEstimator::busTime(9));
+    }
+
+    void testLoad()
+    {
+        QKnxBusLoadEstimator estimator;
+        QCOMPARE(estimator.load(0), 0.);
+
+        // 20 telegrams spread over the first second
+        for (int i = 0; i < 20; ++i)
+            estimator.record(QKnxBusLoadEstimator::busTime(8), i * 50);
+        QVERIFY(qAbs(estimator.load(999) - 0.37918) < 0.0001);
+
+        // the first bucket held two telegrams
+        QVERIFY(qAbs(estimator.load(1000) - 0.34126) < 0.0001);
+        QCOMPARE(estimator.load(2000), 0.);
+
+        estimator.record(1000000, 2000);
+        estimator.record(1000000, 2000);
+        QCOMPARE(estimator.load(2000), 1.);
+
+        estimator.reset();
+        QCOMPARE(estimator.load(2000), 0.);
+    }
+
+    void testThrottle()
+    {
+        QKnxBusLoadEstimator estimator;
+        QCOMPARE(estimator.limit(), 1.);
+
+        estimator.record(1000000, 0);
+        QCOMPARE(estimator.isThrottled(0), false);
+
+        estimator.setLimit(0.4);
+        QCOMPARE(estimator.limit(), 0.4);
+        QCOMPARE(estimator.isThrottled(10), true);
+        QCOMPARE(estimator.nextDecay(10), 90);
+        QCOMPARE(estimator.isThrottled(1000), false);
+
+        estimator.setLimit(2.);
+        QCOMPARE(estimator.limit(), 1.);
+
+        // a non-positive limit does not block an idle line, it disables throttling
+        estimator.setLimit(0.);
+        QCOMPARE(estimator.limit(), 1.);
+        QCOMPARE(estimator.isThrottled(1000000), false);
+        QCOMPARE(estimator.isThrottled(10), false);
+        estimator.setLimit(-0.5);
+        QCOMPARE(estimator.limit(), 1.);
+        QCOMPARE(estimator.isThrottled(10), false);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxBusLoadEstimator)
+
+#include "tst_qknxbusloadestimator.moc"
@@ -0,0 +1,155 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qthread.h>
+#include <QtKnx/qknxbusmonitorbuffer.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxBusMonitorBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCapacity()
+    {
+        QCOMPARE(QKnxBusMonitorBuffer().capacity(), int(QKnxBusMonitorBuffer::DefaultCapacity));
+        QCOMPARE(QKnxBusMonitorBuffer(8).capacity(), 8);
+        QCOMPARE(QKnxBusMonitorBuffer(9).capacity(), 16);
+        QCOMPARE(QKnxBusMonitorBuffer(0).capacity(), 2);
+    }
+
+    void testWriteRead()
+    {
+        // L_Busmon.ind with status and time stamp additional info
+        const auto cemi = QKnxByteArray::fromHex("2b0703010504021234bc11590ade01008116");
+
+        QKnxBusMonitorBuffer buffer(4);
+        QCOMPARE(buffer.isEmpty(), true);
+        QCOMPARE(buffer.write(cemi, 1000), true);
+        QCOMPARE(buffer.write(cemi.constData(), cemi.size(), 1001), true);
+        QCOMPARE(buffer.size(), 2);
+
+        QKnxLinkLayerFrame frame;
+        qint64 timestamp = 0;
+        QCOMPARE(buffer.read(&frame, &timestamp), true);
+        QCOMPARE(timestamp, qint64(1000));
+        QCOMPARE(frame.messageCode(), QKnxLinkLayerFrame::MessageCode::BusmonitorIndication);
+        QCOMPARE(frame.additionalInfos().size(), 2);
+
+        QKnxByteArray raw;
+        QCOMPARE(buffer.readRaw(&raw, &timestamp), true);
+        QCOMPARE(timestamp, qint64(1001));
+        QCOMPARE(raw, cemi);
+
+        QCOMPARE(buffer.isEmpty(), true);
+        QCOMPARE(buffer.read(&frame), false);
+        QCOMPARE(buffer.readRaw(&raw), false);
+    }
+
+    void testOverflow()
+    {
+        const auto cemi = QKnxByteArray::fromHex("2b00bc11590ade01008116");
+
+        QKnxBusMonitorBuffer buffer(2);
+        QCOMPARE(buffer.write(cemi, 1), true);
+        QCOMPARE(buffer.write(cemi, 2), true);
+        QCOMPARE(buffer.write(cemi, 3), false);
+        QCOMPARE(buffer.droppedCount(), quint64(1));
+
+        QCOMPARE(buffer.write(QKnxByteArray(QKnxBusMonitorBuffer::MaximumFrameSize + 1, 0), 4),
+            false);
+        QCOMPARE(buffer.write(QKnxByteArray(), 5), false);
+        QCOMPARE(buffer.droppedCount(), quint64(3));
+
+        qint64 timestamp = 0;
+        QCOMPARE(buffer.readRaw(nullptr, &timestamp), true);
+        QCOMPARE(timestamp, qint64(1));
+        QCOMPARE(buffer.write(cemi, 6), true);
+
+        buffer.clear();
+        QCOMPARE(buffer.isEmpty(), true);
+        QCOMPARE(buffer.droppedCount(), quint64(3));
+    }
+
+    void testConsume()
+    {
+        QKnxBusMonitorBuffer buffer(8);
+        for (int i = 0; i < 5; ++i) {
+            const quint8 cemi[] = { 0x2b, 0x00, quint8(i) };
+            buffer.write(cemi, 3, i);
+        }
+
+        QVector<qint64> seen;
+        const auto visitor = [&](qint64 timestamp, const quint8 *cemi, int size) {
+            QCOMPARE(size, 3);
+            QCOMPARE(qint64(cemi[2]), timestamp);
+            seen.append(timestamp);
+        };
+        QCOMPARE(buffer.consume(visitor, 2), 2);
+        QCOMPARE(seen, QVector<qint64>({ 0, 1 }));
+        QCOMPARE(buffer.consume(visitor), 3);
+        QCOMPARE(seen.size(), 5);
+        QCOMPARE(buffer.consume(visitor), 0);
+    }
+
+    void testConcurrentReader()
+    {
+        const int count = 100000;
+        QKnxBusMonitorBuffer buffer(256);
+
+        QScopedPointer<QThread> writer(QThread::create([&buffer]() {
+            for (int i = 0; i < count;) {
+                const quint8 cemi[] = { 0x2b, 0x00, quint8(i), quint8(i >> 8), quint8(i >> 16) };
+                if (buffer.write(cemi, sizeof(cemi), i))
+                    ++i;
+                else
+                    QThread::yieldCurrentThread();
+            }
+        }));
+        writer->start();
+
+        int expected = 0;
+        bool ordered = true;
+        const auto visitor = [&](qint64 timestamp, const quint8 *cemi, int) {
+            const int value = cemi[2] | (cemi[3] << 8) | (cemi[4] << 16);
+            ordered &= (value == timestamp) && (timestamp == expected);
+            ++expected;
+        };
+        while (expected < count)
+            buffer.consume(visitor);
+        writer->wait();
+
+        QCOMPARE(ordered, true);
+        QCOMPARE(buffer.isEmpty(), true);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxBusMonitorBuffer)
+
+#include "tst_qknxbusmonitorbuffer.moc"
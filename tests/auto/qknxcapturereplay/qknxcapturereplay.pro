@@ -0,0 +1,7 @@
+TARGET = tst_qknxcapturereplay
+
+QT = core network testlib knx
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qknxcapturereplay.cpp
@@ -0,0 +1,222 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qtemporarydir.h>
+#include <QtKnx/qknxcapturereplay.h>
+#include <QtKnx/qknxcapturewriter.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtNetwork/qudpsocket.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxCaptureReplay : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        m_fileName = m_dir.filePath(QStringLiteral("replay.pcapng"));
+
+        const auto frame = QKnxLinkLayerFrame::builder().setMedium(QKnx::MediumType::NetIP)
+            .setData(QKnxByteArray::fromHex("2900bce011010a03010081")).createFrame();
+        QVERIFY(frame.isValid());
+
+        QKnxCaptureWriter writer;
+        QVERIFY(writer.open(m_fileName));
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(writer.writeCemiFrame(frame, QKnxCaptureWriter::Direction::Inbound));
+            QTest::qSleep(20);
+        }
+        // sent by the recording side, never replayed
+        QVERIFY(writer.writeCemiFrame(frame, QKnxCaptureWriter::Direction::Outbound));
+        writer.close();
+    }
+
+    void testDefaults()
+    {
+        QKnxCaptureReplay replay;
+        QCOMPARE(replay.target(), nullptr);
+        QCOMPARE(replay.pacing(), QKnxCaptureReplay::Pacing::Timed);
+        QCOMPARE(replay.speed(), 1.0);
+        QCOMPARE(replay.isRunning(), false);
+
+        replay.setSpeed(0.);
+        QCOMPARE(replay.speed(), 1.0);
+        replay.setSpeed(2.5);
+        QCOMPARE(replay.speed(), 2.5);
+
+        QCOMPARE(replay.open(m_dir.filePath(QStringLiteral("missing.pcapng"))), false);
+        QVERIFY(!replay.errorString().isEmpty());
+    }
+
+    void testAsFastAsPossible()
+    {
+        QKnxCaptureReplay replay;
+        QVERIFY(replay.open(m_fileName));
+        replay.setPacing(QKnxCaptureReplay::Pacing::AsFastAsPossible);
+
+        QSignalSpy started(&replay, &QKnxCaptureReplay::started);
+        QSignalSpy finished(&replay, &QKnxCaptureReplay::finished);
+        replay.start();
+        QCOMPARE(started.count(), 1);
+        QCOMPARE(replay.isRunning(), true);
+        QVERIFY(finished.wait(1000));
+
+        // without a target every frame is dropped
+        QCOMPARE(replay.isRunning(), false);
+        QCOMPARE(replay.replayedCount(), quint64(0));
+        QCOMPARE(replay.droppedCount(), quint64(4));
+        QVERIFY(replay.elapsedTime() < 60 * 1000000);
+        QVERIFY(replay.throughput() > 0.);
+    }
+
+    void testTimed()
+    {
+        QKnxNetIpTunnel tunnel; // not connected, drops all frames
+
+        QKnxCaptureReplay replay;
+        QVERIFY(replay.open(m_fileName));
+        replay.setTarget(&tunnel);
+        QCOMPARE(replay.target(), &tunnel);
+
+        QSignalSpy finished(&replay, &QKnxCaptureReplay::finished);
+        replay.start();
+        QVERIFY(finished.wait(2000));
+        QCOMPARE(replay.droppedCount(), quint64(4));
+        QVERIFY(replay.elapsedTime() >= 60 * 1000000);
+
+        replay.setSpeed(4.);
+        replay.start();
+        QVERIFY(finished.wait(2000));
+        QCOMPARE(replay.droppedCount(), quint64(4));
+        QVERIFY(replay.elapsedTime() >= 15 * 1000000);
+        QVERIFY(replay.maximumLateness() >= 0);
+    }
+
+    void testConnectedTunnel()
+    {
+        const auto cemi = QKnxLinkLayerFrame::builder().setMedium(QKnx::MediumType::NetIP)
+            .setData(QKnxByteArray::fromHex("2900bce011010a03010081")).createFrame();
+        auto request = [&cemi](quint8 channelId, quint8 sequenceNumber) {
+            return QKnxNetIpTunnelingRequestProxy::builder().setChannelId(channelId)
+                .setSequenceNumber(sequenceNumber).setCemi(cemi).create();
+        };
+
+        const QString fileName = m_dir.filePath(QStringLiteral("tunnel.pcapng"));
+        {
+            QKnxCaptureWriter writer;
+            QVERIFY(writer.open(fileName));
+            const auto inbound = QKnxCaptureWriter::Direction::Inbound;
+            const QHostAddress host(QHostAddress::LocalHost);
+            QVERIFY(writer.writeNetIpFrame(request(1, 0), host, 3671, host, 3671, inbound));
+            QVERIFY(writer.writeNetIpFrame(request(1, 1), host, 3671, host, 3671, inbound));
+            // repeated sequence number, acknowledged but not processed again
+            QVERIFY(writer.writeNetIpFrame(request(1, 1), host, 3671, host, 3671, inbound));
+            // out of sequence
+            QVERIFY(writer.writeNetIpFrame(request(1, 5), host, 3671, host, 3671, inbound));
+            // foreign channel
+            QVERIFY(writer.writeNetIpFrame(request(7, 2), host, 3671, host, 3671, inbound));
+            QVERIFY(writer.writeCemiFrame(cemi, inbound));
+        }
+
+        QUdpSocket server;
+        QVERIFY(server.bind(QHostAddress::LocalHost));
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setLocalAddress(QHostAddress::LocalHost);
+        tunnel.connectToHost(QHostAddress::LocalHost, server.localPort());
+        QVERIFY(QTest::qWaitFor([&]() { return server.hasPendingDatagrams(); }));
+
+        QHostAddress client;
+        quint16 clientPort = 0;
+        QByteArray datagram(int(server.pendingDatagramSize()), Qt::Uninitialized);
+        server.readDatagram(datagram.data(), datagram.size(), &client, &clientPort);
+
+        const auto response = QKnxNetIpConnectResponseProxy::builder()
+            .setChannelId(1)
+            .setStatus(QKnxNetIp::Error::None)
+            .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+                .setHostAddress(server.localAddress())
+                .setPort(server.localPort())
+                .create())
+            .setResponseData(QKnxNetIpCrdProxy::builder()
+                .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+                .setIndividualAddress({ QKnxAddress::Type::Individual, QStringLiteral("1.1.1") })
+                .create())
+            .create().bytes();
+        server.writeDatagram(reinterpret_cast<const char *> (response.constData()),
+            response.size(), client, clientPort);
+        QTRY_COMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connected);
+
+        QSignalSpy received(&tunnel, &QKnxNetIpTunnel::frameReceived);
+
+        QKnxCaptureReplay replay;
+        QVERIFY(replay.open(fileName));
+        replay.setTarget(&tunnel);
+        replay.setPacing(QKnxCaptureReplay::Pacing::AsFastAsPossible);
+
+        QSignalSpy finished(&replay, &QKnxCaptureReplay::finished);
+        replay.start();
+        QVERIFY(finished.wait(1000));
+
+        QVERIFY(replay.replayedCount() > 0);
+        QCOMPARE(replay.replayedCount(), quint64(3));
+        QCOMPARE(replay.droppedCount(), quint64(3));
+        QCOMPARE(received.count(), 3);
+    }
+
+    void testStop()
+    {
+        QKnxCaptureReplay replay;
+        QVERIFY(replay.open(m_fileName));
+
+        QSignalSpy finished(&replay, &QKnxCaptureReplay::finished);
+        replay.start();
+        replay.stop();
+        QCOMPARE(finished.count(), 1);
+        QCOMPARE(replay.isRunning(), false);
+
+        replay.stop();
+        QCOMPARE(finished.count(), 1);
+    }
+
+private:
+    QTemporaryDir m_dir;
+    QString m_fileName;
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxCaptureReplay)
+
+#include "tst_qknxcapturereplay.moc"
@@ -0,0 +1,151 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtKnx/qknxcapturereader.h>
+#include <QtKnx/qknxcapturewriter.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxCaptureWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testWriteRead()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto fileName = dir.filePath(QStringLiteral("capture.pcapng"));
+
+        // tunneling acknowledge and L_Data.ind group value write
+        const auto ack = QKnxNetIpFrame::fromBytes(QKnxByteArray::fromHex("06100421000a04290000"));
+        const auto cemi = QKnxByteArray::fromHex("2900bce011010a03010081");
+        const auto ind = QKnxLinkLayerFrame::builder().setMedium(QKnx::MediumType::NetIP)
+            .setData(cemi).createFrame();
+        QVERIFY(ack.isValid());
+        QVERIFY(ind.isValid());
+
+        QKnxCaptureWriter writer;
+        writer.setBufferSize(64); // forces several drains
+        QCOMPARE(writer.open(fileName), true);
+        QCOMPARE(writer.isOpen(), true);
+
+        QCOMPARE(writer.writeNetIpFrame(ack, QHostAddress(QStringLiteral("192.168.1.10")),
+            3671, QHostAddress(QStringLiteral("192.168.1.20")), 50000,
+            QKnxCaptureWriter::Direction::Outbound), true);
+        QCOMPARE(writer.writeCemiFrame(ind, QKnxCaptureWriter::Direction::Inbound), true);
+        QCOMPARE(writer.writeCemiFrame(ind, QKnxCaptureWriter::Direction::Unknown), true);
+        QCOMPARE(writer.frameCount(), quint64(3));
+        writer.close();
+        QCOMPARE(writer.isOpen(), false);
+        QVERIFY(writer.errorString().isEmpty());
+
+        QKnxCaptureReader reader(fileName);
+        QCOMPARE(reader.isOpen(), true);
+        QCOMPARE(reader.format(), QKnxCaptureReader::Format::Pcapng);
+
+        QCOMPARE(reader.readNext(), true);
+        QCOMPARE(reader.recordType(), QKnxCaptureReader::RecordType::NetIp);
+        QCOMPARE(reader.direction(), QKnxCaptureWriter::Direction::Outbound);
+        QCOMPARE(reader.netIpFrame().bytes(), ack.bytes());
+        QCOMPARE(reader.linkLayerFrame().isValid(), false);
+        const auto first = reader.timestamp();
+        QVERIFY(first > 0);
+
+        QCOMPARE(reader.readNext(), true);
+        QCOMPARE(reader.recordType(), QKnxCaptureReader::RecordType::Cemi);
+        QCOMPARE(reader.direction(), QKnxCaptureWriter::Direction::Inbound);
+        QCOMPARE(QKnxByteArray(reader.constData(), reader.size()), cemi);
+        QCOMPARE(reader.linkLayerFrame().messageCode(),
+            QKnxLinkLayerFrame::MessageCode::DataIndication);
+        QVERIFY(reader.timestamp() >= first);
+
+        QCOMPARE(reader.readNext(), true);
+        QCOMPARE(reader.direction(), QKnxCaptureWriter::Direction::Unknown);
+
+        QCOMPARE(reader.readNext(), false);
+        QCOMPARE(reader.atEnd(), true);
+        QVERIFY(reader.errorString().isEmpty());
+    }
+
+    void testPcapEthernet()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto fileName = dir.filePath(QStringLiteral("capture.pcap"));
+
+        // little-endian pcap header with Ethernet link type, followed by an ARP
+        // frame that must be skipped and a KNXnet/IP search request header
+        const auto bytes = QKnxByteArray::fromHex("d4c3b2a1020004000000000000000000"
+            "ffff000001000000"
+            "01000000000000001600000016000000"
+            "ffffffffffff0000000000010806" "0001080006040001"
+            "02000000400000003000000030000000"
+            "0000000000020000000000010800"
+            "4500002200000000011100000a0000010a000002"
+            "0e570e57000e0000"
+            "061002010006");
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(reinterpret_cast<const char *>(bytes.constData()), bytes.size());
+        file.close();
+
+        QKnxCaptureReader reader;
+        QCOMPARE(reader.open(fileName), true);
+        QCOMPARE(reader.format(), QKnxCaptureReader::Format::Pcap);
+        QCOMPARE(reader.readNext(), true);
+        QCOMPARE(reader.recordType(), QKnxCaptureReader::RecordType::NetIp);
+        QCOMPARE(reader.timestamp(), qint64(2000000000) + 64000);
+        QCOMPARE(reader.size(), 6);
+        QCOMPARE(reader.readNext(), false);
+    }
+
+    void testInvalidFile()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto fileName = dir.filePath(QStringLiteral("invalid.pcapng"));
+
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(32, 'x'));
+        file.close();
+
+        QKnxCaptureReader reader;
+        QCOMPARE(reader.open(fileName), false);
+        QCOMPARE(reader.isOpen(), false);
+        QVERIFY(!reader.errorString().isEmpty());
+        QCOMPARE(reader.readNext(), false);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxCaptureWriter)
+
+#include "tst_qknxcapturewriter.moc"
@@ -36,6 +36,8 @@
 #include <QtKnx/qknxnetipsessionresponse.h>
 #include <QtKnx/qknxnetipsessionstatus.h>
 #include <QtKnx/private/qknxcryptographicdata_p.h>
+#include <QtKnx/private/qknxcurve25519keypool_p.h>
+#include <QtKnx/private/qknxsecurecipher_p.h>
 #include <QtTest/qtest.h>
 
 QT_BEGIN_NAMESPACE
@@ -151,6 +153,49 @@ private slots:
         secret = QKnxCryptographicEngine::sharedSecret(pubKey, privKey);
         QCOMPARE(secret, QKnxByteArray::fromHex("d801525217618f0da90a4ff22148aee0"
             "ff4c19b430e8081223ffe99c81a98b05"));
+
+        // the cached derive context is reused with another peer
+        pubKey = QKnxCurve25519PublicKey::fromBytes(QKnxByteArray::fromHex(
+            "0aa227b4fd7a32319ba9960ac036ce0e5c4507b5ae55161f1078b1dcfb3cb631"));
+        QCOMPARE(QKnxCryptographicEngine::sharedSecret(pubKey, privKey),
+            QKnxCryptographicEngine::sharedSecret(pubKey, QKnxCurve25519PrivateKey::fromBytes(
+                privBytes)));
+    }
+
+    void testKeyPool()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QKnxCurve25519KeyPool pool;
+        QCOMPARE(pool.capacity(), int(QKnxCurve25519KeyPool::DefaultCapacity));
+        pool.setCapacity(4);
+        pool.fill();
+        QCOMPARE(pool.size(), 4);
+
+        const auto first = pool.take();
+        const auto second = pool.take();
+        QCOMPARE(first.isValid(), true);
+        QCOMPARE(second.isValid(), true);
+        QVERIFY(first.bytes() != second.bytes());
+
+        const QKnxCurve25519PublicKey firstPublic(first), secondPublic(second);
+        const auto secret = QKnxCryptographicEngine::sharedSecret(secondPublic, first);
+        QCOMPARE(secret.size(), 32);
+        QCOMPARE(QKnxCryptographicEngine::sharedSecret(firstPublic, second), secret);
+
+        // taken keys are replaced in the background
+        QTRY_COMPARE(pool.size(), 4);
+
+        pool.setCapacity(1);
+        QCOMPARE(pool.size(), 1);
+        pool.clear();
+        QCOMPARE(pool.size(), 0);
+
+        // an empty pool still hands out fresh keys
+        pool.setCapacity(0);
+        QCOMPARE(pool.take().isValid(), true);
+        QCOMPARE(pool.size(), 0);
     }
 
     void testSessionKey()
@@ -172,6 +217,37 @@ private slots:
         QCOMPARE(result, QKnxByteArray::fromHex("e158e4012047bd6cc41aafbc5c04c1fc"));
     }
 
+    void testPasswordHashAsync()
+    {
+        QKnxCryptographicEngine::clearDerivedKeyCache();
+
+        // concurrent requests for the same password share a single derivation
+        auto first = QKnxCryptographicEngine::userPasswordHashAsync({ "secret" });
+        auto second = QKnxCryptographicEngine::userPasswordHashAsync({ "secret" });
+        auto device = QKnxCryptographicEngine::deviceAuthenticationCodeHashAsync({ "trustme" });
+
+        first.waitForFinished();
+        second.waitForFinished();
+        device.waitForFinished();
+        QCOMPARE(first.result(), QKnxByteArray::fromHex("03fcedb66660251ec81a1a716901696a"));
+        QCOMPARE(second.result(), first.result());
+        QCOMPARE(device.result(), QKnxByteArray::fromHex("e158e4012047bd6cc41aafbc5c04c1fc"));
+
+        // cached keys are served with an already finished future
+        auto cached = QKnxCryptographicEngine::userPasswordHashAsync({ "secret" });
+        QCOMPARE(cached.isFinished(), true);
+        QCOMPARE(cached.result(), first.result());
+        QCOMPARE(QKnxCryptographicEngine::userPasswordHash({ "secret" }), first.result());
+
+        auto invalid = QKnxCryptographicEngine::pkcs5Pbkdf2HmacSha256Async({ "secret" },
+            QKnxByteArray("salt", 4), 1, 33);
+        invalid.waitForFinished();
+        QCOMPARE(invalid.result(), QKnxByteArray());
+
+        QKnxCryptographicEngine::clearDerivedKeyCache();
+        QCOMPARE(QKnxCryptographicEngine::userPasswordHash({ "secret" }), first.result());
+    }
+
     void testMessageAuthenticationCode()
     {
         if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
@@ -358,6 +434,66 @@ private slots:
 
     }
 
+    void testSecureCipher()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QKnxSecureCipher cipher;
+        QCOMPARE(cipher.isValid(), false);
+        QCOMPARE(cipher.setKey(QKnxByteArray::fromHex("0001020304")), false);
+        QCOMPARE(cipher.isValid(), false);
+
+        auto frame = QKnxNetIpRoutingIndicationProxy::builder()
+            .setCemi(QKnxLinkLayerFrame::builder()
+                .setMedium(QKnx::MediumType::NetIP)
+                .setData(QKnxByteArray::fromHex("2900bcd011590ade010081"))
+                .createFrame())
+            .create();
+        const auto payload = frame.bytes();
+
+        QCOMPARE(cipher.setKey(QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f")), true);
+        QCOMPARE(cipher.isValid(), true);
+
+        const QKnxSecureCipher::Nonce nonce(211938428830917, QKnxByteArray::fromHex("00fa12345678"),
+            0xaffe);
+        const auto header = QKnxByteArray::fromHex("061009500037");
+
+        QKnxByteArray encrypted(payload.size() + QKnxSecureCipher::MacSize, 0x00);
+        QCOMPARE(cipher.encryptSecureWrapper(nonce, header.constData(), 0x0000,
+            payload.constData(), payload.size(), encrypted.data(), encrypted.size() - 1), -1);
+        QCOMPARE(cipher.encryptSecureWrapper(nonce, header.constData(), 0x0000,
+            payload.constData(), payload.size(), encrypted.data(), encrypted.size()),
+            encrypted.size());
+        QCOMPARE(encrypted, QKnxByteArray::fromHex("b7ee7e8a1c2f7bbabec775fd6e10d0bc4b"
+            "7212a03aaae49da85689774c1d2b4da4"));
+
+        // the cipher is reused for the reverse direction without a new key setup
+        QKnxByteArray decrypted(payload.size(), 0x00);
+        QCOMPARE(cipher.decryptSecureWrapper(nonce, header.constData(), 0x0000,
+            encrypted.constData(), encrypted.size(), decrypted.data(), decrypted.size()),
+            payload.size());
+        QCOMPARE(decrypted, payload);
+
+        // tampering with the ciphertext or the associated data fails authentication
+        encrypted.set(3, encrypted.at(3) ^ 0x01);
+        QCOMPARE(cipher.decryptSecureWrapper(nonce, header.constData(), 0x0000,
+            encrypted.constData(), encrypted.size(), decrypted.data(), decrypted.size()), -1);
+        encrypted.set(3, encrypted.at(3) ^ 0x01);
+        QCOMPARE(cipher.decryptSecureWrapper(nonce, header.constData(), 0x0001,
+            encrypted.constData(), encrypted.size(), decrypted.data(), decrypted.size()), -1);
+
+        // in-place processing of the payload
+        auto data = payload;
+        QCOMPARE(cipher.processPayload(nonce, data.constData(), data.size(), data.data()), true);
+        QCOMPARE(data, encrypted.mid(0, payload.size()));
+        QCOMPARE(cipher.processPayload(nonce, data.constData(), data.size(), data.data()), true);
+        QCOMPARE(data, payload);
+
+        cipher.clear();
+        QCOMPARE(cipher.isValid(), false);
+    }
+
     void cleanupTestCase()
     {}
 };
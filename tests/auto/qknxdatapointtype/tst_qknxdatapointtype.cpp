@@ -28,6 +28,7 @@
 
 #include <QtCore/qvector.h>
 #include <QtCore/qmetaobject.h>
+#include <QtCore/qtranslator.h>
 #include <QtKnx/qknx1bit.h>
 #include <QtKnx/qknx1bitcontrolled.h>
 #include <QtKnx/qknx1byte.h>
@@ -58,12 +59,15 @@
 #include <QtKnx/qknxutils.h>
 #include <QtTest/qtest.h>
 
+#include <limits>
+
 class tst_QKnxDatapointType : public QObject
 {
     Q_OBJECT
 
 private slots:
     void datapointType();
+    void datapointTypeMetadata();
     void dpt1_1Bit();
     void dpt2_1BitControlled();
     void dpt3_3BitControlled();
@@ -74,6 +78,7 @@ private slots:
     void dpt7_2ByteUnsignedValue();
     void dpt8_2ByteSignedValue();
     void dpt9_2ByteFloat();
+    void dpt9_2ByteFloatRoundTrip();
     void dpt10_TimeOfDay();
     void dpt11_Date();
     void dpt12_4ByteUnsignedValue();
@@ -91,6 +96,7 @@ private slots:
     void dpt26_SceneInfo();
     void dpt27_32BitSet();
     void dpt28_StringUtf8();
+    void dpt28_StringUtf8Malformed();
     void dpt29_ElectricalEnergy();
 };
 
@@ -117,6 +123,75 @@ void tst_QKnxDatapointType::datapointType()
     QCOMPARE(type.type(), QKnxDatapointType::Type::DptColourRGB);
 }
 
+void tst_QKnxDatapointType::datapointTypeMetadata()
+{
+    QKnxTemperatureCelsius first, second;
+    QCOMPARE(first.unit(), second.unit());
+    QCOMPARE(first.description(), second.description());
+    QVERIFY(first == second);
+
+    // metadata is shared between instances, but changing it affects only one
+    const auto unit = first.unit();
+    second.setUnit(QStringLiteral("custom"));
+    QCOMPARE(first.unit(), unit);
+    QCOMPARE(second.unit(), QStringLiteral("custom"));
+    QVERIFY(first != second);
+
+    second.setUnit(unit);
+    QVERIFY(first == second);
+
+    QKnxTemperatureCelsius copy = first;
+    copy.setRange(QVariant::fromValue(0.), QVariant::fromValue(100.));
+    QCOMPARE(copy.maximum().toDouble(), 100.);
+    QCOMPARE(first.maximum(), second.maximum());
+
+    // changing an instance never leaks into the metadata its class shares
+    for (int i = 0; i < 2000; ++i)
+        copy.setDescription(QString::number(i));
+    QCOMPARE(copy.description(), QStringLiteral("1999"));
+    QCOMPARE(first.description(), second.description());
+    QCOMPARE(QKnxTemperatureCelsius().description(), first.description());
+    QCOMPARE(QKnxTemperatureCelsius().maximum(), first.maximum());
+
+    // subclasses keep what they do not override from their base class
+    QKnx2ByteFloat base;
+    QCOMPARE(base.description(), QStringLiteral("2-byte float"));
+    QVERIFY(first.description() != base.description());
+    QCOMPARE(QKnxSwitchControl().description(), QStringLiteral("Switch control"));
+    QCOMPARE(QKnxSwitchControl().minimumText(), QStringLiteral("No control, %1")
+        .arg(QKnxSwitch().minimumText()));
+    QCOMPARE(QKnxBoolControl().minimumText(), QStringLiteral("No control, %1")
+        .arg(QKnxBool().minimumText()));
+    QCOMPARE(QKnxControlDimming().maximum(), QKnx3BitControlled().maximum());
+
+    // texts are translated when read, in the context of the class that set them
+    class Translator : public QTranslator
+    {
+    public:
+        bool isEmpty() const override { return false; }
+        QString translate(const char *context, const char *source, const char *, int) const override
+        {
+            return QStringLiteral("%1:%2").arg(QLatin1String(context), QString::fromUtf8(source));
+        }
+    } translator;
+    QVERIFY(QCoreApplication::installTranslator(&translator));
+
+    auto tr = [](const QMetaObject &context, const char *source) {
+        return QStringLiteral("%1:%2").arg(QLatin1String(context.className()),
+            QString::fromUtf8(source));
+    };
+    QCOMPARE(QKnxSwitch().minimumText(), tr(QKnxSwitch::staticMetaObject, "Off"));
+    QCOMPARE(QKnxSwitchControl().description(),
+        tr(QKnxSwitchControl::staticMetaObject, "Switch control"));
+    QCOMPARE(QKnxSwitchControl().minimumText(), tr(QKnx1BitControlled::staticMetaObject,
+        "No control, %1").arg(tr(QKnxSwitch::staticMetaObject, "Off")));
+    QCOMPARE(base.description(), tr(QKnx2ByteFloat::staticMetaObject, "2-byte float"));
+    QCOMPARE(copy.description(), QStringLiteral("1999"));
+
+    QVERIFY(QCoreApplication::removeTranslator(&translator));
+    QCOMPARE(base.description(), QStringLiteral("2-byte float"));
+}
+
 void tst_QKnxDatapointType::dpt1_1Bit()
 {
     QKnx1Bit dpt1Bit;
@@ -559,6 +634,42 @@ void tst_QKnxDatapointType::dpt9_2ByteFloat()
     // TODO: Extend the auto-test.
 }
 
+void tst_QKnxDatapointType::dpt9_2ByteFloatRoundTrip()
+{
+    QKnx2ByteFloat decoder, encoder;
+    for (int raw = 0; raw < 65536; ++raw) {
+        const QKnxByteArray bytes { quint8(raw >> 8), quint8(raw) };
+        QVERIFY(decoder.setBytes(bytes, 0, 2));
+
+        const float value = decoder.value();
+        QVERIFY2(encoder.setValue(value), qPrintable(QString::number(raw, 16)));
+        QVERIFY2(encoder.value() == value, qPrintable(QString::number(raw, 16)));
+
+        // an encoding that cannot be expressed with a smaller exponent is
+        // reproduced exactly
+        const int E = (raw >> 11) & 0x0f;
+        const int M = (raw & 0x07ff) - ((raw & 0x8000) ? 2048 : 0);
+        if (E == 0 || M >= 1024 || M < -1024)
+            QVERIFY2(encoder.bytes() == bytes, qPrintable(QString::number(raw, 16)));
+    }
+
+    // rounding up to a mantissa of 2048 moves to the next exponent for
+    // positive values only
+    QVERIFY(encoder.setValue(20.47f));
+    QCOMPARE(encoder.bytes(), QKnxByteArray({ 0x07, 0xff }));
+    QVERIFY(encoder.setValue(20.48f));
+    QCOMPARE(encoder.bytes(), QKnxByteArray({ 0x0c, 0x00 }));
+    QVERIFY(encoder.setValue(-20.48f));
+    QCOMPARE(encoder.bytes(), QKnxByteArray({ 0x80, 0x00 }));
+
+    QVERIFY(encoder.setValue(-0.f));
+    QCOMPARE(encoder.bytes(), QKnxByteArray({ 0x00, 0x00 }));
+    QVERIFY(encoder.setValue(0.001f));
+    QCOMPARE(encoder.bytes(), QKnxByteArray({ 0x00, 0x00 }));
+    QCOMPARE(encoder.setValue(std::numeric_limits<float>::quiet_NaN()), false);
+    QCOMPARE(encoder.setValue(std::numeric_limits<float>::infinity()), false);
+}
+
 void tst_QKnxDatapointType::dpt10_TimeOfDay()
 {
 #if defined(Q_CC_MSVC) && Q_CC_MSVC == 1914
@@ -2145,6 +2256,42 @@ void tst_QKnxDatapointType::dpt28_StringUtf8()
         0x4b, 0x00 }));
 }
 
+void tst_QKnxDatapointType::dpt28_StringUtf8Malformed()
+{
+    const QVector<QKnxByteArray> malformed {
+        { 0x4b, 0xc3, 0x28, 0x00 },         // invalid continuation byte
+        { 0x4b, 0x80, 0x00 },               // unexpected continuation byte
+        { 0x4b, 0xc0, 0xaf, 0x00 },         // overlong encoding of '/'
+        { 0x4b, 0xed, 0xa0, 0x80, 0x00 },   // encoded surrogate
+        { 0x4b, 0xf4, 0x90, 0x80, 0x80, 0x00 }, // code point above U+10FFFF
+        { 0x4b, 0xe2, 0x88, 0x00 }          // truncated sequence
+    };
+
+    for (const auto &bytes : malformed) {
+        // setBytes() takes the raw bytes as received from the bus
+        QKnxUtf8String string(QStringLiteral("KNX"));
+        QCOMPARE(string.setBytes(bytes, 0, quint16(bytes.size())), true);
+        QCOMPARE(string.bytes(), bytes);
+        QCOMPARE(string.isValid(), false);
+        QCOMPARE(string.string(), QString());
+        QVERIFY(string.string().isNull());
+
+        QCOMPARE(string.setString(reinterpret_cast<const char *>(bytes.constData()),
+            bytes.size() - 1), false);
+    }
+
+    QKnxUtf8String string;
+    QCOMPARE(string.setBytes({ 0x4b, 0xc3, 0xa4, 0x00 }, 0, 4), true);
+    QCOMPARE(string.isValid(), true);
+    QCOMPARE(string.string(), QString::fromUtf8("K\xc3\xa4"));
+
+    // the stored string ends at the terminating null byte
+    QCOMPARE(string.setBytes({ 0x4b, 0x4e, 0x58, 0x00 }, 0, 4), true);
+    QCOMPARE(string.string(), QStringLiteral("KNX"));
+    QCOMPARE(string.setBytes({ 0x4b, 0x4e, 0x58 }, 0, 3), true);
+    QCOMPARE(string.isValid(), false);
+}
+
 void tst_QKnxDatapointType::dpt29_ElectricalEnergy()
 {
     QKnxElectricalEnergy dpt;
@@ -0,0 +1,280 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qvector.h>
+#include <QtKnx/qknx2bytefloat.h>
+#include <QtKnx/qknx2bytesignedvalue.h>
+#include <QtKnx/qknx2byteunsignedvalue.h>
+#include <QtKnx/qknx4bytefloat.h>
+#include <QtKnx/qknx4bytesignedvalue.h>
+#include <QtKnx/qknx8bitunsignedvalue.h>
+#include <QtKnx/qknxcharstring.h>
+#include <QtKnx/qknxdatapointtypecodec.h>
+#include <QtKnx/qknxutf8string.h>
+#include <QtKnx/qknxvarstring.h>
+#include <QtTest/qtest.h>
+
+#include <cstring>
+#include <limits>
+
+class tst_QKnxDatapointTypeCodec : public QObject
+{
+    Q_OBJECT
+
+private:
+    // every 16 bit pattern, preceded by a padding byte to test unaligned input
+    static QVector<quint8> allPatterns16()
+    {
+        QVector<quint8> bytes(1 + 2 * 65536);
+        for (int i = 0; i < 65536; ++i) {
+            bytes[1 + 2 * i] = quint8(i >> 8);
+            bytes[2 + 2 * i] = quint8(i);
+        }
+        return bytes;
+    }
+
+    template <typename T> static bool bitEqual(T a, T b)
+    {
+        return memcmp(&a, &b, sizeof(T)) == 0;
+    }
+
+private slots:
+    void testDecodeDpt5()
+    {
+        QVector<quint8> bytes(256);
+        for (int i = 0; i < 256; ++i)
+            bytes[i] = quint8(i);
+
+        QKnxScaling scaling;
+        QVector<double> values(256);
+        QKnxDatapointTypeCodec::decodeDpt5(bytes.constData(), values.data(), 256,
+            scaling.coefficient());
+        for (int i = 0; i < 256; ++i) {
+            scaling.setByte(0, quint8(i));
+            if (!scaling.isValid())
+                continue; // value() reports -1 for values above the subtype maximum
+            QVERIFY2(bitEqual(values[i], scaling.value()), qPrintable(QString::number(i)));
+        }
+    }
+
+    void testDecodeDpt7()
+    {
+        const auto bytes = allPatterns16();
+        QKnxTimePeriod10Msec period;
+
+        QVector<quint32> values(65536);
+        QKnxDatapointTypeCodec::decodeDpt7(bytes.constData() + 1, values.data(), 65536,
+            period.coefficient());
+        for (int i = 0; i < 65536; i += 7) {
+            period.setBytes({ bytes[1 + 2 * i], bytes[2 + 2 * i] }, 0, 2);
+            QCOMPARE(values[i], period.value());
+        }
+
+        QKnxDatapointTypeCodec::decodeDpt7(bytes.constData() + 1, values.data(), 65536);
+        for (int i = 0; i < 65536; ++i)
+            QCOMPARE(values[i], quint32(i));
+    }
+
+    void testDecodeDpt8()
+    {
+        const auto bytes = allPatterns16();
+        QKnxPercentV16 percent;
+
+        QVector<double> values(65536);
+        QKnxDatapointTypeCodec::decodeDpt8(bytes.constData() + 1, values.data(), 65536,
+            percent.coefficient());
+        for (int i = 0; i < 65536; ++i) {
+            percent.setBytes({ bytes[1 + 2 * i], bytes[2 + 2 * i] }, 0, 2);
+            QVERIFY2(bitEqual(values[i], percent.value()), qPrintable(QString::number(i)));
+        }
+    }
+
+    void testDecodeDpt9()
+    {
+        const auto bytes = allPatterns16();
+        QKnx2ByteFloat dpt;
+
+        // odd counts leave a tail for the scalar code after the vector kernels
+        for (int count : { 65536, 65535, 3 }) {
+            QVector<float> values(count);
+            QKnxDatapointTypeCodec::decodeDpt9(bytes.constData() + 1, values.data(), count);
+            for (int i = 0; i < count; ++i) {
+                dpt.setBytes({ bytes[1 + 2 * i], bytes[2 + 2 * i] }, 0, 2);
+                QVERIFY2(bitEqual(values[i], dpt.value()), qPrintable(QString::number(i)));
+            }
+        }
+    }
+
+    void testEncodeDpt9()
+    {
+        QVector<float> values;
+        for (float value = -671088.64f; value <= 670760.96f; value += 97.13f)
+            values.append(value);
+        values << 0.f << -0.f << 20.48f << -20.48f << 0.01f << -671088.64f << 670760.96f;
+
+        QVector<quint8> bytes(2 * values.size());
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt9(values.constData(), bytes.data(),
+            values.size()), size_t(values.size()));
+
+        QKnx2ByteFloat dpt;
+        for (int i = 0; i < values.size(); ++i) {
+            QVERIFY(dpt.setValue(values[i]));
+            QCOMPARE(dpt.bytes().at(0), bytes[2 * i]);
+            QCOMPARE(dpt.bytes().at(1), bytes[2 * i + 1]);
+        }
+
+        // encoding stops at the first value out of range
+        const float outOfRange[] = { 1.f, 2.f, 700000.f, 3.f };
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt9(outOfRange, bytes.data(), 4), size_t(2));
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt9(outOfRange, bytes.data(), 0), size_t(0));
+    }
+
+    void testEncodeDpt8()
+    {
+        const double values[] = { -327.68, -0.01, 0., 12.34, 327.67, 327.68 };
+        QVector<quint8> bytes(2 * 6);
+
+        QKnxPercentV16 percent;
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt8(values, bytes.data(), 6,
+            percent.coefficient()), size_t(5));
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(percent.setValue(values[i]));
+            QCOMPARE(percent.bytes().at(0), bytes[2 * i]);
+            QCOMPARE(percent.bytes().at(1), bytes[2 * i + 1]);
+        }
+    }
+
+    void testFourByteTypes()
+    {
+        QVector<qint32> integers;
+        QVector<float> floats;
+        for (int i = 0; i < 37; ++i) {
+            integers.append(qint32(0x01020304u * quint32(i) - 0x7fffffffu));
+            floats.append(float(i) * -3.3f);
+        }
+        floats.append(std::numeric_limits<float>::quiet_NaN());
+
+        QVector<quint8> bytes(4 * floats.size());
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt13(integers.constData(), bytes.data(),
+            integers.size()), size_t(integers.size()));
+
+        QKnxValue4Count count;
+        QVector<qint32> decodedIntegers(integers.size());
+        QKnxDatapointTypeCodec::decodeDpt13(bytes.constData(), decodedIntegers.data(),
+            integers.size());
+        QCOMPARE(decodedIntegers, integers);
+        for (int i = 0; i < integers.size(); ++i) {
+            count.setValue(integers[i]);
+            QCOMPARE(count.bytes(), QKnxByteArray(bytes.constData() + 4 * i, 4));
+        }
+
+        QKnxDatapointTypeCodec::encodeDpt14(floats.constData(), bytes.data(), floats.size());
+        QVector<float> decodedFloats(floats.size());
+        QKnxDatapointTypeCodec::decodeDpt14(bytes.constData(), decodedFloats.data(),
+            floats.size());
+
+        QKnx4ByteFloat dpt;
+        for (int i = 0; i < floats.size(); ++i) {
+            QVERIFY(bitEqual(decodedFloats[i], floats[i]));
+            dpt.setBytes(QKnxByteArray(bytes.constData() + 4 * i, 4), 0, 4);
+            QVERIFY(bitEqual(decodedFloats[i], dpt.value()));
+        }
+    }
+
+    void testCharString()
+    {
+        quint8 bytes[14];
+        QVERIFY(QKnxDatapointTypeCodec::encodeDpt16(QLatin1String("KNX is OK"), bytes));
+        QCOMPARE(QKnxDatapointTypeCodec::decodeDpt16(bytes), QLatin1String("KNX is OK"));
+        QCOMPARE(bytes[13], quint8(0));
+
+        // all 14 characters, without a terminating null byte
+        QVERIFY(QKnxDatapointTypeCodec::encodeDpt16(QLatin1String("abcdefghijklmn"), bytes));
+        QCOMPARE(QKnxDatapointTypeCodec::decodeDpt16(bytes), QLatin1String("abcdefghijklmn"));
+        QKnxCharString full("abcdefghijklmn");
+        QCOMPARE(full.string(), QLatin1String("abcdefghijklmn"));
+
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt16(QLatin1String("abcdefghijklmno"), bytes),
+            false);
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt16(QLatin1String("gr\xfc\xdf"), bytes, true),
+            false);
+        QVERIFY(QKnxDatapointTypeCodec::encodeDpt16(QLatin1String("gr\xfc\xdf"), bytes));
+
+        QKnxCharStringASCII ascii("ASCII");
+        QCOMPARE(ascii.setString("gr\xfc\xdf"), false);
+        QCOMPARE(ascii.string(), QLatin1String("ASCII"));
+        QCOMPARE(ascii.isValid(), true);
+    }
+
+    void testVarString()
+    {
+        quint8 bytes[8];
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt24(QLatin1String("Hallo"), bytes, 8), 6);
+        QCOMPARE(QKnxDatapointTypeCodec::decodeDpt24(bytes, 8), QLatin1String("Hallo"));
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt24(QLatin1String("Hallo Welt"), bytes, 8), -1);
+
+        QKnxVarString string("Hallo");
+        QCOMPARE(string.size(), 6);
+        QCOMPARE(string.string(), QLatin1String("Hallo"));
+    }
+
+    void testUtf8String()
+    {
+        const QString text = QStringLiteral("KNX \u00e4\u20ac \U0001F600 and a long ASCII tail");
+
+        quint8 bytes[64];
+        const int size = QKnxDatapointTypeCodec::encodeDpt28(text, bytes, sizeof(bytes));
+        QCOMPARE(size, text.toUtf8().size() + 1);
+        QCOMPARE(QByteArray(reinterpret_cast<const char *>(bytes)), text.toUtf8());
+        QVERIFY(QKnxDatapointTypeCodec::isValidUtf8(bytes, size - 1));
+        QCOMPARE(QKnxDatapointTypeCodec::encodeDpt28(text, bytes, size - 1), -1);
+
+        QChar chars[64];
+        const int length = QKnxDatapointTypeCodec::decodeDpt28(bytes, size, chars, 64);
+        QCOMPARE(QString(chars, length), text);
+        QCOMPARE(QKnxDatapointTypeCodec::decodeDpt28(bytes, size, chars, length - 1), -1);
+
+        // overlong, encoded surrogate, beyond U+10FFFF, truncated and stray continuation
+        for (const char *invalid : { "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe2\x82",
+            "0123456789abcdef\x80" }) {
+            QCOMPARE(QKnxDatapointTypeCodec::isValidUtf8(reinterpret_cast<const quint8 *>(invalid),
+                int(strlen(invalid))), false);
+            QCOMPARE(QKnxUtf8String().setString(invalid), false);
+        }
+
+        QKnxUtf8String utf8(text);
+        QCOMPARE(utf8.string(), text);
+        QCOMPARE(utf8.setString(QString(QChar(0xd800))), false);
+        QCOMPARE(utf8.string(), text);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxDatapointTypeCodec)
+
+#include "tst_qknxdatapointtypecodec.moc"
@@ -0,0 +1,281 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtKnx/qknxdatasecuredecoder.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/private/qknxcryptographicdata_p.h>
+#include <QtKnx/private/qknxsecurecipher_p.h>
+#include <QtTest/qtest.h>
+
+QT_BEGIN_NAMESPACE
+
+char *toString(const QKnxByteArray &ba)
+{
+    using QTest::toString;
+    return toString("QKnxByteArray(" + ba.toByteArray() + ')');
+}
+
+QT_END_NAMESPACE
+
+static const quint16 Source = 0x1159;
+static const quint16 Destination = 0x0ade;
+static const quint8 ExtendedControlField = 0xe0; // group address, hop count 6
+
+static QKnxLinkLayerFrame createFrame(const QKnxByteArray &tpdu, quint16 source = Source)
+{
+    QKnxByteArray cemi { 0x29, 0x00, 0xbc, ExtendedControlField,
+        quint8(source >> 8), quint8(source), quint8(Destination >> 8), quint8(Destination),
+        quint8(tpdu.size() - 1) };
+    cemi += tpdu;
+    return QKnxLinkLayerFrame::builder()
+        .setMedium(QKnx::MediumType::NetIP)
+        .setData(cemi)
+        .createFrame();
+}
+
+// Secures the plain group APDU the way a KNX Data Secure device does.
+static QKnxByteArray secureTpdu(const QKnxByteArray &key, quint48 sequence,
+    const QKnxByteArray &apdu, bool encrypt, quint16 source = Source)
+{
+    QKnxSecureCipher cipher(key);
+
+    const quint8 scf = encrypt ? 0x10 : 0x00;
+    QKnxByteArray tpdu { 0x03, 0xf1, scf };
+    for (int i = 5; i >= 0; --i)
+        tpdu += quint8(sequence >> (8 * i));
+
+    quint8 b0[16] = { 0x00 }, ctr0[16] = { 0x00 }, mac[16];
+    memcpy(b0, tpdu.constData() + 3, 6);
+    b0[6] = quint8(source >> 8);
+    b0[7] = quint8(source);
+    b0[8] = quint8(Destination >> 8);
+    b0[9] = quint8(Destination);
+    b0[11] = ExtendedControlField & 0x8f;
+    b0[12] = 0x03;
+    b0[13] = 0xf1;
+    memcpy(ctr0, b0, 10);
+    ctr0[14] = 0x01;
+
+    QKnxByteArray payload = apdu;
+    if (encrypt) {
+        b0[15] = quint8(apdu.size());
+        const quint8 a[] = { 0x00, 0x01, scf };
+        cipher.cbcMac(b0, a, 3, apdu.constData(), apdu.size(), mac,
+            QKnxSecureCipher::Padding::ToBlockSize);
+        ctr0[15] = 0x01;
+        cipher.processCounterStream(ctr0, apdu.constData(), apdu.size(), payload.data());
+        ctr0[15] = 0x00;
+        cipher.processCounterStream(ctr0, mac, 4, mac);
+    } else {
+        const quint8 a[] = { 0x00, quint8(apdu.size() + 1), scf };
+        cipher.cbcMac(b0, a, 3, apdu.constData(), apdu.size(), mac,
+            QKnxSecureCipher::Padding::ToBlockSize);
+    }
+
+    tpdu += payload;
+    tpdu += QKnxByteArray(mac, 4);
+    return tpdu;
+}
+
+class tst_QKnxDataSecureDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        QLoggingCategory::setFilterRules("qt.network.ssl=false");
+    }
+
+    void testKeyTable()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        const QKnxAddress group { QKnxAddress::Type::Group, Destination };
+        const QKnxAddress individual { QKnxAddress::Type::Individual, Source };
+        const auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+
+        QKnxDataSecureDecoder decoder;
+        QCOMPARE(decoder.hasGroupKey(group), false);
+        QCOMPARE(decoder.setGroupKey(individual, key), false);
+        QCOMPARE(decoder.setGroupKey(group, QKnxByteArray(15, 0x00)), false);
+        QCOMPARE(decoder.setGroupKey(group, key), true);
+        QCOMPARE(decoder.hasGroupKey(group), true);
+        QCOMPARE(decoder.hasGroupKey({ QKnxAddress::Type::Group, 0x0001 }), false);
+
+        decoder.removeGroupKey(group);
+        QCOMPARE(decoder.hasGroupKey(group), false);
+        QCOMPARE(decoder.setGroupKey(group, key), true);
+        decoder.clearGroupKeys();
+        QCOMPARE(decoder.hasGroupKey(group), false);
+
+        QCOMPARE(decoder.lastSequenceNumber(individual), quint48(0));
+        decoder.setLastSequenceNumber(individual, 42);
+        QCOMPARE(decoder.lastSequenceNumber(individual), quint48(42));
+        decoder.resetSequenceNumbers();
+        QCOMPARE(decoder.lastSequenceNumber(individual), quint48(0));
+    }
+
+    void testDecode_data()
+    {
+        QTest::addColumn<bool>("encrypt");
+        QTest::addColumn<QKnxDataSecureDecoder::Status>("status");
+
+        QTest::newRow("authentication") << false << QKnxDataSecureDecoder::Status::Authenticated;
+        QTest::newRow("confidentiality") << true << QKnxDataSecureDecoder::Status::Decrypted;
+    }
+
+    void testDecode()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QFETCH(bool, encrypt);
+        QFETCH(QKnxDataSecureDecoder::Status, status);
+
+        const auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+        const auto apdu = QKnxByteArray::fromHex("0081"); // GroupValueWrite, switch on
+
+        QKnxDataSecureDecoder decoder;
+        QKnxTpdu tpdu;
+
+        // plain frames are passed through
+        QCOMPARE(decoder.decode(createFrame(apdu), &tpdu),
+            QKnxDataSecureDecoder::Status::NotSecured);
+        QCOMPARE(tpdu.bytes(), apdu);
+
+        const auto secured = createFrame(secureTpdu(key, 7, apdu, encrypt));
+        QCOMPARE(secured.tpdu().applicationControlField(),
+            QKnxTpdu::ApplicationControlField::SecureService);
+        QCOMPARE(decoder.decode(secured, &tpdu), QKnxDataSecureDecoder::Status::UnknownKey);
+
+        QCOMPARE(decoder.setGroupKey({ QKnxAddress::Type::Group, Destination }, key), true);
+        QCOMPARE(decoder.decode(secured, &tpdu), status);
+        QCOMPARE(tpdu.bytes(), apdu);
+        QCOMPARE(tpdu.applicationControlField(), QKnxTpdu::ApplicationControlField::GroupValueWrite);
+        QCOMPARE(decoder.lastSequenceNumber({ QKnxAddress::Type::Individual, Source }), quint48(7));
+
+        // replayed and older frames are rejected
+        QCOMPARE(decoder.decode(secured, &tpdu), QKnxDataSecureDecoder::Status::Replayed);
+        QCOMPARE(decoder.decode(createFrame(secureTpdu(key, 6, apdu, encrypt)), &tpdu),
+            QKnxDataSecureDecoder::Status::Replayed);
+
+        // sequence numbers are tracked per source address
+        QCOMPARE(decoder.decode(createFrame(secureTpdu(key, 7, apdu, encrypt, 0x1101), 0x1101),
+            &tpdu), status);
+
+        // tampered frames are rejected and do not advance the sequence number
+        auto tampered = secureTpdu(key, 8, apdu, encrypt);
+        tampered.set(tampered.size() - 5, quint8(tampered.at(tampered.size() - 5) ^ 0x01));
+        QCOMPARE(decoder.decode(createFrame(tampered), &tpdu),
+            QKnxDataSecureDecoder::Status::AuthenticationFailed);
+        QCOMPARE(decoder.lastSequenceNumber({ QKnxAddress::Type::Individual, Source }), quint48(7));
+
+        const auto wrongKey = QKnxByteArray::fromHex("0f0e0d0c0b0a09080706050403020100");
+        QCOMPARE(decoder.decode(createFrame(secureTpdu(wrongKey, 8, apdu, encrypt)), &tpdu),
+            QKnxDataSecureDecoder::Status::AuthenticationFailed);
+
+        QCOMPARE(decoder.decode(createFrame(secureTpdu(key, 8, apdu, encrypt)), &tpdu), status);
+        QCOMPARE(tpdu.bytes(), apdu);
+    }
+
+    void testReferenceVectors_data()
+    {
+        QTest::addColumn<QKnxByteArray>("apdu");
+        QTest::addColumn<QKnxByteArray>("secured");
+        QTest::addColumn<QKnxDataSecureDecoder::Status>("status");
+
+        // Computed outside of QtKnx with a standalone AES-128 CCM implementation for
+        // key ffeeddccbbaa99887766554433221100, sequence number 0x0000000004a2, source
+        // 1.1.89 and destination group 1/2/222 in an extended frame. The bytes are
+        // TPCI/APCI, SCF, sequence number, the (encrypted) APDU and the 4 byte MAC.
+        QTest::newRow("authentication")
+            << QKnxByteArray::fromHex("0081")
+            << QKnxByteArray::fromHex("03f1000000000004a20081eec14e70")
+            << QKnxDataSecureDecoder::Status::Authenticated;
+        QTest::newRow("confidentiality")
+            << QKnxByteArray::fromHex("0081")
+            << QKnxByteArray::fromHex("03f1100000000004a26058309f8ed4")
+            << QKnxDataSecureDecoder::Status::Decrypted;
+        QTest::newRow("confidentiality, two blocks") // DPT 16.000 "KNX is OK"
+            << QKnxByteArray::fromHex("00804b4e58206973204f4b0000000000")
+            << QKnxByteArray::fromHex("03f1100000000004a26059caa42a3229c036a8cafd4ca0c351c2ed1758")
+            << QKnxDataSecureDecoder::Status::Decrypted;
+    }
+
+    void testReferenceVectors()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QFETCH(QKnxByteArray, apdu);
+        QFETCH(QKnxByteArray, secured);
+        QFETCH(QKnxDataSecureDecoder::Status, status);
+
+        QKnxDataSecureDecoder decoder;
+        QCOMPARE(decoder.setGroupKey({ QKnxAddress::Type::Group, Destination },
+            QKnxByteArray::fromHex("ffeeddccbbaa99887766554433221100")), true);
+
+        QKnxTpdu tpdu;
+        QCOMPARE(decoder.decode(createFrame(secured), &tpdu), status);
+        QCOMPARE(tpdu.bytes(), apdu);
+        QCOMPARE(decoder.lastSequenceNumber({ QKnxAddress::Type::Individual, Source }),
+            quint48(0x04a2));
+    }
+
+    void testUnsupported()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        const auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+        QKnxDataSecureDecoder decoder;
+        decoder.setGroupKey({ QKnxAddress::Type::Group, Destination }, key);
+
+        QKnxTpdu tpdu;
+        auto bytes = secureTpdu(key, 1, QKnxByteArray::fromHex("0081"), true);
+        bytes.set(2, 0x12); // S-A_Sync_Req
+        QCOMPARE(decoder.decode(createFrame(bytes), &tpdu),
+            QKnxDataSecureDecoder::Status::Unsupported);
+
+        bytes.set(2, 0x90); // tool access
+        QCOMPARE(decoder.decode(createFrame(bytes), &tpdu),
+            QKnxDataSecureDecoder::Status::Unsupported);
+
+        QCOMPARE(decoder.decode(createFrame(bytes.mid(0, 12)), &tpdu),
+            QKnxDataSecureDecoder::Status::Invalid);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxDataSecureDecoder)
+
+#include "tst_qknxdatasecuredecoder.moc"
@@ -0,0 +1,191 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qdebug.h>
+#include <QtKnx/qknx1bit.h>
+#include <QtKnx/qknxgroupvaluecache.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+Q_DECLARE_METATYPE(QVector<QKnxAddress>)
+
+static QKnxLinkLayerFrame createFrame(const char *hex)
+{
+    return QKnxLinkLayerFrame::builder()
+        .setMedium(QKnx::MediumType::NetIP)
+        .setData(QKnxByteArray::fromHex(hex))
+        .createFrame();
+}
+
+class tst_QKnxGroupValueCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        qRegisterMetaType<QVector<QKnxAddress>>();
+    }
+
+    void testUpdate()
+    {
+        QKnxGroupValueCache cache;
+        const QKnxAddress group { QKnxAddress::Type::Group, QString("1/2/222") };
+
+        QCOMPARE(cache.contains(group), false);
+        QCOMPARE(cache.value(group), QKnxByteArray());
+        QCOMPARE(cache.timestamp(group).isValid(), false);
+
+        const auto before = QDateTime::currentDateTime();
+        QCOMPARE(cache.update(createFrame("2900bcd011590ade010081")), true);
+        QCOMPARE(cache.contains(group), true);
+        QCOMPARE(cache.value(group), QKnxByteArray { 0x01 });
+        QVERIFY(cache.timestamp(group) >= before.addMSecs(-1));
+        QVERIFY(cache.timestamp(group) <= QDateTime::currentDateTime());
+
+        // GroupValueResponse with a long value replaces the small one
+        QCOMPARE(cache.update(createFrame("2900bcd011590ade03004012ab")), true);
+        QCOMPARE(cache.value(group), QKnxByteArray({ 0x12, 0xab }));
+
+        QKnxByteArray value;
+        QDateTime timestamp;
+        QCOMPARE(cache.lookup(group, &value, &timestamp), true);
+        QCOMPARE(value, QKnxByteArray({ 0x12, 0xab }));
+        QCOMPARE(timestamp, cache.timestamp(group));
+
+        QCOMPARE(cache.addresses(), QVector<QKnxAddress> { group });
+    }
+
+    void testIgnoredFrames()
+    {
+        QKnxGroupValueCache cache;
+
+        // GroupValueRead
+        QCOMPARE(cache.update(createFrame("2900bcd011590ade010000")), false);
+        // individual destination address
+        QCOMPARE(cache.update(createFrame("2900bc5011590ade010081")), false);
+        // data request, not received from the bus
+        QCOMPARE(cache.update(createFrame("1100bcd011590ade010081")), false);
+        QCOMPARE(cache.update(QKnxLinkLayerFrame()), false);
+
+        QCOMPARE(cache.addresses().isEmpty(), true);
+    }
+
+    void testClear()
+    {
+        QKnxGroupValueCache cache;
+        cache.update(createFrame("2900bcd011590ade010081"));
+        cache.update(createFrame("2900bcd011590adf010080"));
+        QCOMPARE(cache.addresses().size(), 2);
+
+        cache.clear();
+        QCOMPARE(cache.addresses().isEmpty(), true);
+        QCOMPARE(cache.contains({ QKnxAddress::Type::Group, QString("1/2/222") }), false);
+    }
+
+    void testNotifications()
+    {
+        QKnxGroupValueCache cache;
+        cache.setNotificationInterval(20);
+        QCOMPARE(cache.notificationInterval(), 20);
+
+        QSignalSpy spy(&cache, &QKnxGroupValueCache::valuesChanged);
+        cache.update(createFrame("2900bcd011590ade010081"));
+        cache.update(createFrame("2900bcd011590adf010080"));
+        cache.update(createFrame("2900bcd011590ade010080"));
+
+        QTRY_COMPARE(spy.count(), 1);
+        auto changed = spy.takeFirst().at(0).value<QVector<QKnxAddress>>();
+        QCOMPARE(changed.size(), 2);
+        QVERIFY(changed.contains({ QKnxAddress::Type::Group, QString("1/2/222") }));
+        QVERIFY(changed.contains({ QKnxAddress::Type::Group, QString("1/2/223") }));
+
+        // unchanged value, no notification
+        cache.update(createFrame("2900bcd011590ade010080"));
+        QTest::qWait(50);
+        QCOMPARE(spy.count(), 0);
+    }
+
+    void testDatapointType()
+    {
+        const QKnxAddress group { QKnxAddress::Type::Group, QString("1/2/222") };
+
+        QKnxGroupAddressInfos infos;
+        infos.add(QStringLiteral("Light"), group, QKnxDatapointType::Type::DptSwitch,
+            QStringLiteral("Kitchen light"), QStringLiteral("P-0001"));
+
+        QKnxGroupValueCache cache;
+        QCOMPARE(cache.datapointType(group), QKnxDatapointType::Type::Unknown);
+        QVERIFY(!cache.createDatapointType(group));
+
+        cache.setGroupAddressInfos(infos, QStringLiteral("P-0001"));
+        QCOMPARE(cache.datapointType(group), QKnxDatapointType::Type::DptSwitch);
+        QVERIFY(!cache.createDatapointType(group));
+
+        cache.update(createFrame("2900bcd011590ade010081"));
+        QScopedPointer<QKnxDatapointType> dpt(cache.createDatapointType(group));
+        QVERIFY(dpt);
+        QCOMPARE(dpt->type(), QKnxDatapointType::Type::DptSwitch);
+        QCOMPARE(static_cast<QKnxSwitch *>(dpt.data())->value(), QKnxSwitch::State::On);
+    }
+
+    void testTunnelRead()
+    {
+        const QKnxAddress group { QKnxAddress::Type::Group, QString("1/2/222") };
+
+        QKnxNetIpTunnel tunnel;
+        auto future = tunnel.readGroupValue(group);
+        QCOMPARE(future.isFinished(), true);
+        QCOMPARE(future.isCanceled(), true);
+
+        future = tunnel.readGroupValue({ QKnxAddress::Type::Individual, 0x1159 });
+        QCOMPARE(future.isCanceled(), true);
+
+        QKnxGroupValueCache cache;
+        cache.update(createFrame("2900bcd011590ade010081"));
+        tunnel.setGroupValueCache(&cache);
+        QCOMPARE(tunnel.groupValueCache(), &cache);
+
+        // answered from the cache, no connection required
+        future = tunnel.readGroupValue(group, 3000, 60000);
+        QCOMPARE(future.isFinished(), true);
+        QCOMPARE(future.isCanceled(), false);
+        QCOMPARE(future.result(), QKnxByteArray { 0x01 });
+
+        // cached value not requested, falls back to the bus
+        future = tunnel.readGroupValue(group);
+        QCOMPARE(future.isCanceled(), true);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxGroupValueCache)
+
+#include "tst_qknxgroupvaluecache.moc"
@@ -0,0 +1,188 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtKnx/qknx2bytefloat.h>
+#include <QtKnx/qknxbusmonitorbuffer.h>
+#include <QtKnx/qknxgroupvaluedecoder.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtTest/qtest.h>
+
+static QKnxLinkLayerFrame createFrame(const char *hex)
+{
+    return QKnxLinkLayerFrame::builder()
+        .setMedium(QKnx::MediumType::NetIP)
+        .setData(QKnxByteArray::fromHex(hex))
+        .createFrame();
+}
+
+class tst_QKnxGroupValueDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDatapointTypes()
+    {
+        QKnxGroupAddressInfos infos;
+        infos.add(QStringLiteral("Light"), { QKnxAddress::Type::Group, QString("1/2/222") },
+            QKnxDatapointType::Type::DptSwitch, {}, QStringLiteral("P-0001"));
+        infos.add(QStringLiteral("Temperature"), { QKnxAddress::Type::Group, QString("1/2/223") },
+            QKnxDatapointType::Type::DptTemperatureCelsius, {}, QStringLiteral("P-0001"));
+
+        QKnxGroupValueDecoder decoder(infos, QStringLiteral("P-0001"));
+        QCOMPARE(decoder.datapointType({ QKnxAddress::Type::Group, QString("1/2/222") }),
+            QKnxDatapointType::Type::DptSwitch);
+        QCOMPARE(decoder.datapointType({ QKnxAddress::Type::Group, QString("1/2/223") }),
+            QKnxDatapointType::Type::DptTemperatureCelsius);
+        QCOMPARE(decoder.datapointType({ QKnxAddress::Type::Group, QString("1/2/224") }),
+            QKnxDatapointType::Type::Unknown);
+        QCOMPARE(decoder.datapointType({ QKnxAddress::Type::Individual, QString("1.1.2") }),
+            QKnxDatapointType::Type::Unknown);
+
+        const QKnxAddress group { QKnxAddress::Type::Group, QString("1/2/224") };
+        decoder.setDatapointType(group, QKnxDatapointType::Type::DptScaling);
+        QCOMPARE(decoder.datapointType(group), QKnxDatapointType::Type::DptScaling);
+
+        // a copy is not affected by later changes
+        const auto copy = decoder;
+        decoder.clear();
+        QCOMPARE(decoder.datapointType(group), QKnxDatapointType::Type::Unknown);
+        QCOMPARE(copy.datapointType(group), QKnxDatapointType::Type::DptScaling);
+    }
+
+    void testDecodeFrame()
+    {
+        QKnxGroupValueDecoder decoder;
+        decoder.setDatapointType({ QKnxAddress::Type::Group, QString("1/2/222") },
+            QKnxDatapointType::Type::DptSwitch);
+        decoder.setDatapointType({ QKnxAddress::Type::Group, QString("1/2/223") },
+            QKnxDatapointType::Type::DptTemperatureCelsius);
+        decoder.setDatapointType({ QKnxAddress::Type::Group, QString("1/2/224") },
+            QKnxDatapointType::Type::DptScaling);
+
+        QKnxGroupValueDecoder::Record record;
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590ade010081"), 42, &record), true);
+        QCOMPARE(record.timestamp, qint64(42));
+        QCOMPARE(record.address, quint16(0x0ade));
+        QCOMPARE(record.type, QKnxDatapointType::Type::DptSwitch);
+        QCOMPARE(record.valueType, QKnxGroupValueDecoder::ValueType::Boolean);
+        QCOMPARE(record.value, 1.);
+        QCOMPARE(record.size, quint8(1));
+        QCOMPARE(record.data[0], quint8(0x01));
+
+        // GroupValueResponse
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590adf0300400c1a"), 43, &record), true);
+        QCOMPARE(record.address, quint16(0x0adf));
+        QCOMPARE(record.valueType, QKnxGroupValueDecoder::ValueType::Real);
+        QCOMPARE(record.value, 21.);
+
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590ae002008080"), 44, &record), true);
+        QCOMPARE(record.valueType, QKnxGroupValueDecoder::ValueType::Real);
+        QCOMPARE(record.value, 128 * (100 / 255.));
+
+        // the value size does not match the datapoint type
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590ade0300800102"), 45, &record), true);
+        QCOMPARE(record.valueType, QKnxGroupValueDecoder::ValueType::Raw);
+        QCOMPARE(record.size, quint8(2));
+
+        // unknown datapoint type
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590ae1020080ff"), 46, &record), true);
+        QCOMPARE(record.type, QKnxDatapointType::Type::Unknown);
+        QCOMPARE(record.valueType, QKnxGroupValueDecoder::ValueType::Raw);
+        QCOMPARE(record.data[0], quint8(0xff));
+
+        // the record is left unchanged for frames without group value
+        QCOMPARE(decoder.decode(createFrame("2900bcd011590ade010000"), 47, &record), false);
+        QCOMPARE(decoder.decode(createFrame("2900bc5011590ade010081"), 47, &record), false);
+        QCOMPARE(decoder.decode(createFrame("1100bcd011590ade010081"), 47, &record), false);
+        QCOMPARE(decoder.decode(createFrame("2e00bdd011590ade010081"), 47, &record), false);
+        QCOMPARE(decoder.decode(QKnxLinkLayerFrame(), 47, &record), false);
+        QCOMPARE(record.timestamp, qint64(46));
+
+        QScopedPointer<QKnxDatapointType> dpt(decoder.createDatapointType(record));
+        QCOMPARE(dpt.isNull(), true);
+    }
+
+    void testDecodeRaw()
+    {
+        QKnxGroupValueDecoder decoder;
+        decoder.setDatapointType({ QKnxAddress::Type::Group, QString("1/2/223") },
+            QKnxDatapointType::Type::DptTemperatureCelsius);
+
+        QKnxGroupValueDecoder::Record record;
+        const auto frame = QKnxByteArray::fromHex("2e00bcd011590adf0300800c1a");
+        QCOMPARE(decoder.decode(frame.constData(), frame.size(), 1, &record), true);
+        QCOMPARE(record.value, 21.);
+
+        QScopedPointer<QKnxDatapointType> dpt(decoder.createDatapointType(record));
+        QVERIFY(!dpt.isNull());
+        QCOMPARE(static_cast<QKnx2ByteFloat *>(dpt.data())->value(), 21.f);
+
+        // bus monitor indication with status information and a standard TP1 frame
+        const auto busmon = QKnxByteArray::fromHex("2b03030100bc11590adfe3008012ab04");
+        QCOMPARE(decoder.decode(busmon.constData(), busmon.size(), 2, &record), true);
+        QCOMPARE(record.address, quint16(0x0adf));
+        QCOMPARE(record.size, quint8(2));
+        QCOMPARE(record.data[1], quint8(0xab));
+
+        // bad checksum, repeated frame, acknowledge, truncated frame
+        for (const char *hex : { "2b03030100bc11590adfe3008012ab05", "2b030301009c11590adfe3008012ab24",
+            "2b03030100cc", "2900bcd011590adf0300800c" }) {
+            const auto bytes = QKnxByteArray::fromHex(hex);
+            QCOMPARE(decoder.decode(bytes.constData(), bytes.size(), 3, &record), false);
+        }
+        QCOMPARE(record.timestamp, qint64(2));
+    }
+
+    void testDecodeBuffer()
+    {
+        QKnxGroupValueDecoder decoder;
+        decoder.setDatapointType({ QKnxAddress::Type::Group, QString("1/2/222") },
+            QKnxDatapointType::Type::DptSwitch);
+
+        QKnxBusMonitorBuffer buffer(8);
+        buffer.write(QKnxByteArray::fromHex("2b03030100bc11590adee10081bf"), 10);
+        buffer.write(QKnxByteArray::fromHex("2b03030100cc"), 11);
+        buffer.write(QKnxByteArray::fromHex("2b03030100bc11590adee10080be"), 12);
+
+        QVector<QKnxGroupValueDecoder::Record> records;
+        QCOMPARE(decoder.decode(&buffer, &records), 2);
+        QCOMPARE(buffer.isEmpty(), true);
+        QCOMPARE(records.size(), 2);
+        QCOMPARE(records.at(0).timestamp, qint64(10));
+        QCOMPARE(records.at(0).value, 1.);
+        QCOMPARE(records.at(1).timestamp, qint64(12));
+        QCOMPARE(records.at(1).value, 0.);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxGroupValueDecoder)
+
+#include "tst_qknxgroupvaluedecoder.moc"
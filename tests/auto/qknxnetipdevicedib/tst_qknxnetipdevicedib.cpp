@@ -78,6 +78,27 @@ private slots:
             + QKnxByteArray::fromHex("0000000000000000000000000000"));
     }
 
+    void testDeviceNameLength()
+    {
+        auto builder = QKnxNetIpDeviceDibProxy::builder()
+            .setMediumType(QKnx::MediumType::NetIP)
+            .setDeviceStatus(QKnxNetIp::ProgrammingMode::Inactive)
+            .setIndividualAddress(QKnxAddress::Individual::Unregistered)
+            .setSerialNumber(QKnxByteArray::fromHex("123456123456"))
+            .setMulticastAddress(QHostAddress::AnyIPv4)
+            .setMacAddress(QKnxByteArray::fromHex("bcaec56690f9"));
+
+        // the device name field is exactly 30 bytes, without terminating zero
+        const QByteArray name30("qt.io KNX device name 30 bytes");
+        auto dib = builder.setDeviceName(name30).create();
+        QCOMPARE(dib.size(), quint16(54));
+        QCOMPARE(QKnxNetIpDeviceDibProxy(dib).deviceName(), name30);
+
+        dib = builder.setDeviceName(name30 + QByteArray(" and some more")).create();
+        QCOMPARE(dib.size(), quint16(54));
+        QCOMPARE(QKnxNetIpDeviceDibProxy(dib).deviceName(), name30);
+    }
+
     void testDebugStream()
     {
     struct DebugHandler
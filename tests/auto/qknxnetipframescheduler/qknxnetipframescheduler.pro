@@ -0,0 +1,7 @@
+TARGET = tst_qknxnetipframescheduler
+
+QT = core testlib knx knx-private
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qknxnetipframescheduler.cpp
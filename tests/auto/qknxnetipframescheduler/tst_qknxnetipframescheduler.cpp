@@ -0,0 +1,163 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/private/qknxnetipframescheduler_p.h>
+#include <QtTest/qtest.h>
+
+using Priority = QKnxControlField::Priority;
+
+class tst_QKnxNetIpFrameScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testPriorityOrder()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.setAgingInterval(0);
+        QCOMPARE(scheduler.isEmpty(), true);
+
+        scheduler.enqueue(1, Priority::Low, 0);
+        scheduler.enqueue(2, Priority::Normal, 0);
+        scheduler.enqueue(3, Priority::Urgent, 0);
+        scheduler.enqueue(4, Priority::System, 0);
+        scheduler.enqueue(5, Priority::Normal, 0);
+        scheduler.enqueue(6, Priority::Urgent, 0);
+        QCOMPARE(scheduler.size(), 6);
+
+        QCOMPARE(scheduler.dequeue(0), 4);
+        QCOMPARE(scheduler.dequeue(0), 3);
+        QCOMPARE(scheduler.dequeue(0), 6);
+        QCOMPARE(scheduler.dequeue(0), 2);
+        QCOMPARE(scheduler.dequeue(0), 5);
+        QCOMPARE(scheduler.dequeue(0), 1);
+        QCOMPARE(scheduler.isEmpty(), true);
+        QCOMPARE(scheduler.dequeue(0), 0);
+    }
+
+    void testReplace()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.enqueue(1, Priority::Low, 0);
+        const auto id = scheduler.enqueue(2, Priority::Low, 0);
+        scheduler.enqueue(3, Priority::Low, 0);
+
+        QCOMPARE(scheduler.replace(id, 20), true);
+        QCOMPARE(scheduler.replace(id + 10, 30), false);
+        QCOMPARE(scheduler.size(), 3);
+
+        quint64 dequeued = 0;
+        QCOMPARE(scheduler.dequeue(0), 1);
+        QCOMPARE(scheduler.dequeue(0, &dequeued), 20);
+        QCOMPARE(dequeued, id);
+        QCOMPARE(scheduler.dequeue(0), 3);
+    }
+
+    void testRemove()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.enqueue(1, Priority::Low, 0);
+        const auto id = scheduler.enqueue(2, Priority::Urgent, 0);
+        scheduler.enqueue(3, Priority::Low, 0);
+
+        QCOMPARE(scheduler.remove(id), true);
+        QCOMPARE(scheduler.remove(id), false);
+        QCOMPARE(scheduler.size(), 2);
+        QCOMPARE(scheduler.dequeue(0), 1);
+        QCOMPARE(scheduler.dequeue(0), 3);
+        QCOMPARE(scheduler.isEmpty(), true);
+    }
+
+    void testAging()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.setAgingInterval(10);
+        QCOMPARE(scheduler.agingInterval(), 10);
+
+        // three intervals lift a low priority entry to the level of a system one,
+        // which still goes first as it is in the higher level
+        scheduler.enqueue(1, Priority::Low, 0);
+        scheduler.enqueue(2, Priority::System, 30);
+        QCOMPARE(scheduler.dequeue(30), 2);
+
+        // the low priority entry waited long enough to overtake
+        scheduler.enqueue(3, Priority::System, 40);
+        QCOMPARE(scheduler.dequeue(40), 1);
+        QCOMPARE(scheduler.dequeue(50), 3);
+
+        const auto latency = scheduler.latency(Priority::Low);
+        QCOMPARE(latency.count, quint64(1));
+        QCOMPARE(latency.maximum, qint64(40));
+        QCOMPARE(latency.average(), qint64(40));
+        QCOMPARE(scheduler.latency(Priority::System).count, quint64(2));
+        QCOMPARE(scheduler.latency(Priority::System).maximum, qint64(10));
+        QCOMPARE(scheduler.latency(Priority::Normal).count, quint64(0));
+
+        scheduler.resetLatency();
+        QCOMPARE(scheduler.latency(Priority::Low).count, quint64(0));
+    }
+
+    void testDropLowest()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.setAgingInterval(0);
+        scheduler.enqueue(1, Priority::Normal, 0);
+        scheduler.enqueue(2, Priority::Low, 0);
+        scheduler.enqueue(3, Priority::Urgent, 0);
+        scheduler.enqueue(4, Priority::Low, 0);
+
+        // oldest of the lowest priority first
+        QCOMPARE(scheduler.dropLowest(Priority::System), true);
+        QCOMPARE(scheduler.size(), 3);
+        QCOMPARE(scheduler.dropLowest(Priority::Low), true);
+        QCOMPARE(scheduler.size(), 2);
+
+        // nothing waiting has a priority as low as the given one
+        QCOMPARE(scheduler.dropLowest(Priority::Low), false);
+        QCOMPARE(scheduler.dropLowest(Priority::Normal), true);
+        QCOMPARE(scheduler.size(), 1);
+        QCOMPARE(scheduler.dequeue(0), 3);
+
+        QCOMPARE(scheduler.dropLowest(Priority::System), false);
+    }
+
+    void testClear()
+    {
+        QKnxNetIpFrameScheduler<int> scheduler;
+        scheduler.enqueue(1, Priority::Low, 0);
+        scheduler.enqueue(2, Priority::System, 0);
+        scheduler.clear();
+        QCOMPARE(scheduler.isEmpty(), true);
+        QCOMPARE(scheduler.size(), 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxNetIpFrameScheduler)
+
+#include "tst_qknxnetipframescheduler.moc"
@@ -34,6 +34,7 @@
 #include <QtKnx/qknxnetiproutingindication.h>
 #include <QtKnx/qknxnetiproutinglostmessage.h>
 #include <QtKnx/qknxnetiproutingsystembroadcast.h>
+#include <QtKnx/qknxnetipsearchrequest.h>
 
 #include <QtKnx/private/qknxnetiprouter_p.h>
 #include <QtKnx/private/qknxnetiptestrouter_p.h>
@@ -71,6 +72,8 @@ private slots:
     void test_routing_interface_receives_system_broadcast();
     void test_routing_filter();
     void test_routing_filter_data();
+    void test_routing_service_handler();
+    void test_routing_queue_limit();
 
 private:
     void simulateFramesReceived(const QKnxNetIpFrame &netIpFrame, int numFrames = 1);
@@ -303,13 +306,14 @@ void tst_QKnxNetIpRouter::test_routing_sends_indications()
     QVERIFY(stateChangedEmitted);
 }
 
-QKnxNetIpFrame dummyRoutingIndication(QKnxAddress dst, quint8 hopCount = 6)
+QKnxNetIpFrame dummyRoutingIndication(QKnxAddress dst, quint8 hopCount = 6,
+    QKnxControlField::Priority priority = QKnxControlField::Priority::Normal)
 {
     auto tpdu = QKnxTpduFactory::Multicast::createGroupValueReadTpdu();
     auto ctrl = QKnxControlField::builder()
         .setFrameFormat(QKnxControlField::FrameFormat::Standard)
         .setBroadcast(QKnxControlField::Broadcast::Domain)
-        .setPriority(QKnxControlField::Priority::Normal)
+        .setPriority(priority)
         .create();
 
     auto extCtrl = QKnxExtendedControlField::builder()
@@ -554,6 +558,115 @@ void tst_QKnxNetIpRouter::test_routing_filter_data()
         << filterTable;
 }
 
+void tst_QKnxNetIpRouter::test_routing_service_handler()
+{
+    if (!runTests)
+        return;
+
+    const QKnxNetIpRouter::ServiceHandler handler = [](const QKnxNetIpFrame &) {};
+    QCOMPARE(m_router.registerServiceHandler(QKnxNetIp::ServiceType::RoutingIndication,
+        handler), false);
+    QCOMPARE(m_router.unregisterServiceHandler(QKnxNetIp::ServiceType::RoutingIndication), false);
+    QCOMPARE(m_router.registerServiceHandler(QKnxNetIp::ServiceType::SearchRequest, {}), false);
+
+    int received = 0;
+    QVERIFY(m_router.registerServiceHandler(QKnxNetIp::ServiceType::SearchRequest,
+        [&](const QKnxNetIpFrame &frame) {
+            received++;
+            QCOMPARE(frame.serviceType(), QKnxNetIp::ServiceType::SearchRequest);
+    }));
+
+    m_router.start();
+
+    auto searchRequest = QKnxNetIpSearchRequestProxy::builder()
+        .setDiscoveryEndpoint(QKnxNetIpHpaiProxy::builder()
+            .setHostAddress(QHostAddress::LocalHost)
+            .setPort(3671).create()
+        ).create();
+
+    simulateFramesReceived(searchRequest);
+    QCOMPARE(received, 1);
+
+    QVERIFY(m_router.unregisterServiceHandler(QKnxNetIp::ServiceType::SearchRequest));
+    simulateFramesReceived(searchRequest);
+    QCOMPARE(received, 1);
+
+    // vendor specific service types unknown to Qt KNX can be claimed as well
+    const auto vendorType = QKnxNetIp::ServiceType(0x0950);
+    QKnxByteArray vendorData;
+    QVERIFY(m_router.registerServiceHandler(vendorType, [&](const QKnxNetIpFrame &frame) {
+        received++;
+        vendorData = frame.data();
+    }));
+
+    simulateFramesReceived({ vendorType, QKnxByteArray { 0x01, 0x02, 0x03 } });
+    QCOMPARE(received, 2);
+    QCOMPARE(vendorData, QKnxByteArray({ 0x01, 0x02, 0x03 }));
+    QVERIFY(m_router.unregisterServiceHandler(vendorType));
+}
+
+void tst_QKnxNetIpRouter::test_routing_queue_limit()
+{
+    if (!runTests)
+        return;
+
+    m_router.start();
+    m_router.setQueueAgingInterval(0);
+    simulateFramesReceived(QKnxNetIpRoutingBusyProxy::builder()
+        .setDeviceState(QKnxNetIp::DeviceState::IpFault)
+        .setRoutingBusyWaitTime(100)
+        .setRoutingBusyControl(0)
+        .create());
+    QCOMPARE(m_router.state(), QKnxNetIpRouter::State::NeighborBusy);
+
+    QCOMPARE(m_router.queueLimit(), 256);
+    m_router.setQueueLimit(3);
+    QCOMPARE(m_router.queueLimit(), 3);
+
+    const auto dst = QKnxAddress::createGroup(1, 1, 1);
+    const auto dropped = m_router.droppedIndicationCount();
+    auto send = [&](QKnxControlField::Priority priority) {
+        m_router.sendRoutingIndication(dummyRoutingIndication(dst, 6, priority));
+    };
+
+    auto scheduler = &QKnxNetIpTestRouter::instance()->routerInstance()->m_scheduler;
+    send(QKnxControlField::Priority::Low);
+    send(QKnxControlField::Priority::Normal);
+    send(QKnxControlField::Priority::Low);
+    QCOMPARE(scheduler->size(), 3);
+    QCOMPARE(m_router.droppedIndicationCount(), dropped);
+
+    // the oldest low priority indication makes room for a higher priority one
+    send(QKnxControlField::Priority::Urgent);
+    QCOMPARE(scheduler->size(), 3);
+    QCOMPARE(m_router.droppedIndicationCount(), dropped + 1);
+
+    // the second low priority indication makes room for a new one of the same priority
+    send(QKnxControlField::Priority::Low);
+    QCOMPARE(scheduler->size(), 3);
+    QCOMPARE(m_router.droppedIndicationCount(), dropped + 2);
+
+    // shrinking the limit drops the lowest priority first
+    m_router.setQueueLimit(2);
+    QCOMPARE(scheduler->size(), 2);
+    QCOMPARE(m_router.droppedIndicationCount(), dropped + 3);
+
+    // a new indication is dropped if everything waiting has a higher priority
+    send(QKnxControlField::Priority::Low);
+    QCOMPARE(scheduler->size(), 2);
+    QCOMPARE(m_router.droppedIndicationCount(), dropped + 4);
+
+    auto priority = [](const QKnxNetIpFrame &frame) {
+        return QKnxNetIpRoutingIndicationProxy(frame).cemi().controlField().priority();
+    };
+    QCOMPARE(priority(scheduler->dequeue()), QKnxControlField::Priority::Urgent);
+    QCOMPARE(priority(scheduler->dequeue()), QKnxControlField::Priority::Normal);
+
+    m_router.setQueueLimit(0);
+    QCOMPARE(m_router.queueLimit(), 1);
+    m_router.setQueueLimit(256);
+}
+
 //TODO: test threshold for sending busy after incoming queue is
 //      filled with 10 packets (queue should be able to hold until 30 messages)
 
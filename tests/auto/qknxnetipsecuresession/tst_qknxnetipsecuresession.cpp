@@ -0,0 +1,326 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtKnx/qknxcurve25519.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetipsessionauthenticate.h>
+#include <QtKnx/qknxnetipsessionrequest.h>
+#include <QtKnx/qknxnetipsessionresponse.h>
+#include <QtKnx/qknxnetipsessionstatus.h>
+#include <QtKnx/private/qknxcryptographicdata_p.h>
+#include <QtKnx/private/qknxnetipsecuresession_p.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxNetIpSecureSession : public QObject
+{
+    Q_OBJECT
+
+private:
+    // the fake server receives a TCP stream, frames are complete once the header size is met
+    bool hasFrame(const QKnxByteArray &received)
+    {
+        return received.size() >= QKnxNetIpFrameHeader::HeaderSize10
+            && received.size() >= ((received.at(4) << 8) | received.at(5));
+    }
+
+    QKnxByteArray takeFrame(QKnxByteArray *received)
+    {
+        const int size = (received->at(4) << 8) | received->at(5);
+        const auto frame = received->mid(0, size);
+        received->remove(0, size);
+        return frame;
+    }
+
+    void write(QTcpSocket *socket, const QKnxByteArray &bytes)
+    {
+        socket->write(reinterpret_cast<const char *> (bytes.constData()), bytes.size());
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QLoggingCategory::setFilterRules("qt.network.ssl=false");
+    }
+
+    void testConfiguration()
+    {
+        QKnxNetIpSecureConfiguration config;
+        QCOMPARE(config.isNull(), true);
+        QCOMPARE(config.isValid(), false);
+
+        config.setUserId(1);
+        config.setUserPassword("secret");
+        QCOMPARE(config.isNull(), false);
+        QCOMPARE(config.isValid(), true);
+
+        config.setSerialNumber(QKnxByteArray::fromHex("00fa1234"));
+        QCOMPARE(config.isValid(), false);
+        config.setSerialNumber(QKnxByteArray::fromHex("00fa12345678"));
+        QCOMPARE(config.isValid(), true);
+
+        auto copy = config;
+        QCOMPARE(copy, config);
+        copy.setUserId(0x80);
+        QCOMPARE(copy.isValid(), false);
+        QVERIFY(copy != config);
+    }
+
+    void testHandshake()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        const quint8 userId = 0x01;
+        const quint16 sessionId = 0x0001;
+        const auto passwordHash = QKnxCryptographicEngine::userPasswordHash({ "secret" });
+        const auto deviceCode = QKnxCryptographicEngine::deviceAuthenticationCodeHash({ "trustme" });
+
+        QKnxNetIpSecureSession client(userId, passwordHash, deviceCode);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Idle);
+        QCOMPARE(client.hasSessionKey(), false);
+
+        const auto request = client.createSessionRequest(QKnxNetIpHpaiProxy::builder()
+            .setHostProtocol(QKnxNetIp::HostProtocol::TCP_IPv4).create());
+        QCOMPARE(request.isValid(), true);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Requested);
+
+        const QKnxNetIpSessionRequestProxy requestProxy(request);
+        QCOMPARE(requestProxy.publicKey(), client.publicKey().bytes());
+
+        // server side of the handshake
+        QKnxCurve25519PrivateKey serverKey;
+        const QKnxCurve25519PublicKey serverPublicKey(serverKey);
+        const auto clientPublicKey = QKnxCurve25519PublicKey::fromBytes(requestProxy.publicKey());
+        const auto keys = QKnxCryptographicEngine::XOR(clientPublicKey.bytes(),
+            serverPublicKey.bytes());
+
+        auto builder = QKnxNetIpSessionResponseProxy::builder();
+        auto response = builder.setSecureSessionId(sessionId)
+            .setPublicKey(serverPublicKey.bytes())
+            .setMessageAuthenticationCode(QKnxByteArray(16, 0x00))
+            .create();
+        auto mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(deviceCode,
+            response.header(), sessionId, keys);
+        const auto encryptedMac =
+            QKnxCryptographicEngine::encryptMessageAuthenticationCode(deviceCode, mac);
+        response = builder.setMessageAuthenticationCode(encryptedMac).create();
+
+        const auto authenticate = client.processSessionResponse(response);
+        QCOMPARE(authenticate.isValid(), true);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Authenticating);
+        QCOMPARE(client.sessionId(), sessionId);
+        QCOMPARE(client.hasSessionKey(), true);
+
+        const QKnxNetIpSessionAuthenticateProxy authenticateProxy(authenticate);
+        QCOMPARE(authenticateProxy.userId(), userId);
+        mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(passwordHash,
+            authenticate.header(), userId, keys);
+        QCOMPARE(QKnxCryptographicEngine::decryptMessageAuthenticationCode(passwordHash,
+            authenticateProxy.messageAuthenticationCode()), mac);
+
+        // the authenticate frame travels wrapped, unwrap it with the server's session key
+        QKnxNetIpSecureSession server(0, {});
+        QCOMPARE(server.setSessionKey(sessionId,
+            QKnxCryptographicEngine::sessionKey(clientPublicKey, serverKey)), true);
+
+        QByteArray wrapped;
+        auto bytes = authenticate.bytes();
+        auto size = client.wrap(bytes.constData(), bytes.size(), &wrapped);
+        QCOMPARE(size, bytes.size() + QKnxNetIpSecureSession::WrapperOverhead);
+        QCOMPARE(client.sendSequenceNumber(), quint48(1));
+
+        QKnxByteArray unwrapped;
+        QCOMPARE(server.unwrap(reinterpret_cast<const quint8 *>(wrapped.constData()), size,
+            &unwrapped), bytes.size());
+        QCOMPARE(unwrapped, bytes);
+
+        const auto status = QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::AuthenticationSuccess)
+            .create();
+        bytes = status.bytes();
+        size = server.wrap(bytes.constData(), bytes.size(), &wrapped);
+        QVERIFY(size > 0);
+
+        auto data = reinterpret_cast<const quint8 *>(wrapped.constData());
+        QCOMPARE(client.unwrap(data, size, &unwrapped), bytes.size());
+        QCOMPARE(client.processSessionStatus(QKnxNetIpFrame::fromBytes(unwrapped)),
+            QKnxNetIp::SecureSessionStatus::AuthenticationSuccess);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Authenticated);
+        QCOMPARE(client.receiveSequenceNumber(), quint48(1));
+
+        // replayed frames are rejected
+        QCOMPARE(client.unwrap(data, size, &unwrapped), -1);
+
+        // so are older frames arriving late, a TCP connection never reorders
+        QByteArray earlier, later;
+        const int earlierSize = server.wrap(bytes.constData(), bytes.size(), &earlier);
+        const int laterSize = server.wrap(bytes.constData(), bytes.size(), &later);
+        QCOMPARE(client.unwrap(reinterpret_cast<const quint8 *>(later.constData()), laterSize,
+            &unwrapped), bytes.size());
+        QCOMPARE(client.unwrap(reinterpret_cast<const quint8 *>(earlier.constData()),
+            earlierSize, &unwrapped), -1);
+        QCOMPARE(client.receiveSequenceNumber(), quint48(3));
+
+        // tampered frames are rejected
+        size = server.wrap(bytes.constData(), bytes.size(), &wrapped);
+        wrapped[QKnxNetIpSecureSession::WrapperOverhead - 16] =
+            char(wrapped.at(QKnxNetIpSecureSession::WrapperOverhead - 16) ^ 0x01);
+        data = reinterpret_cast<const quint8 *>(wrapped.constData());
+        QCOMPARE(client.unwrap(data, size, &unwrapped), -1);
+
+        const auto close = QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+            .create();
+        QCOMPARE(client.processSessionStatus(close), QKnxNetIp::SecureSessionStatus::Close);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Failed);
+        QCOMPARE(client.hasSessionKey(), false);
+        QCOMPARE(client.wrap(bytes.constData(), bytes.size(), &wrapped), -1);
+    }
+
+    void testInvalidSessionResponse()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QKnxNetIpSecureSession client(0x01, QKnxCryptographicEngine::userPasswordHash({ "secret" }),
+            QKnxCryptographicEngine::deviceAuthenticationCodeHash({ "trustme" }));
+        client.createSessionRequest(QKnxNetIpHpaiProxy::builder().create());
+
+        const QKnxCurve25519PublicKey serverPublicKey { QKnxCurve25519PrivateKey() };
+        const auto response = QKnxNetIpSessionResponseProxy::builder()
+            .setSecureSessionId(0x0001)
+            .setPublicKey(serverPublicKey.bytes())
+            .setMessageAuthenticationCode(QKnxByteArray(16, 0x00))
+            .create();
+
+        QCOMPARE(client.processSessionResponse(response).isValid(), false);
+        QCOMPARE(client.state(), QKnxNetIpSecureSession::State::Failed);
+        QCOMPARE(client.hasSessionKey(), false);
+    }
+    void testUnencryptedSessionStatus()
+    {
+        if (QKnxOpenSsl::sslLibraryVersionNumber() < 0x1010000fL)
+            return;
+
+        QTcpServer listener;
+        QVERIFY(listener.listen(QHostAddress::LocalHost));
+
+        QKnxNetIpSecureConfiguration config;
+        config.setUserId(0x01);
+        config.setUserPassword("secret");
+        config.setDeviceAuthenticationCode("trustme");
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setSecureConfiguration(config);
+        QSignalSpy errorSpy(&tunnel, &QKnxNetIpEndpointConnection::errorOccurred);
+        tunnel.connectToHostEncrypted(QHostAddress::LocalHost, listener.serverPort());
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connecting);
+
+        QTRY_VERIFY(listener.hasPendingConnections());
+        auto socket = listener.nextPendingConnection();
+        QKnxByteArray received;
+        connect(socket, &QTcpSocket::readyRead, [&]() {
+            received += QKnxByteArray::fromByteArray(socket->readAll());
+        });
+
+        // the session request follows the key derivation done on the thread pool
+        QTRY_VERIFY(hasFrame(received));
+        auto bytes = takeFrame(&received);
+        const auto request = QKnxNetIpFrame::fromBytes(bytes);
+        QCOMPARE(request.serviceType(), QKnxNetIp::ServiceType::SessionRequest);
+
+        const quint16 sessionId = 0x0001;
+        const auto deviceCode = QKnxCryptographicEngine::deviceAuthenticationCodeHash("trustme");
+        QKnxCurve25519PrivateKey serverKey;
+        const QKnxCurve25519PublicKey serverPublicKey(serverKey);
+        const auto clientPublicKey = QKnxCurve25519PublicKey::fromBytes(
+            QKnxNetIpSessionRequestProxy(request).publicKey());
+
+        auto builder = QKnxNetIpSessionResponseProxy::builder();
+        auto response = builder.setSecureSessionId(sessionId)
+            .setPublicKey(serverPublicKey.bytes())
+            .setMessageAuthenticationCode(QKnxByteArray(16, 0x00))
+            .create();
+        const auto mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(deviceCode,
+            response.header(), sessionId, QKnxCryptographicEngine::XOR(clientPublicKey.bytes(),
+                serverPublicKey.bytes()));
+        response = builder.setMessageAuthenticationCode(QKnxCryptographicEngine
+            ::encryptMessageAuthenticationCode(deviceCode, mac)).create();
+        write(socket, response.bytes());
+
+        QKnxNetIpSecureSession server(0, {});
+        QCOMPARE(server.setSessionKey(sessionId,
+            QKnxCryptographicEngine::sessionKey(clientPublicKey, serverKey)), true);
+
+        QKnxByteArray unwrapped;
+        QTRY_VERIFY(hasFrame(received));
+        bytes = takeFrame(&received);
+        QVERIFY(server.unwrap(bytes.constData(), bytes.size(), &unwrapped) > 0);
+        QCOMPARE(QKnxNetIpFrame::fromBytes(unwrapped).serviceType(),
+            QKnxNetIp::ServiceType::SessionAuthenticate);
+
+        // neither an unencrypted success nor an unencrypted close reach the state machine
+        const auto success = QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::AuthenticationSuccess)
+            .create();
+        write(socket, success.bytes());
+        write(socket, QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+            .create().bytes());
+
+        QTest::qWait(200);
+        QCOMPARE(received.isEmpty(), true);
+        QCOMPARE(errorSpy.count(), 0);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connecting);
+
+        // the same status inside an authenticated secure wrapper continues the connect
+        QByteArray wrapped;
+        const auto successBytes = success.bytes();
+        const auto size = server.wrap(successBytes.constData(), successBytes.size(), &wrapped);
+        QVERIFY(size > 0);
+        socket->write(wrapped.constData(), size);
+
+        QTRY_VERIFY(hasFrame(received));
+        bytes = takeFrame(&received);
+        QVERIFY(server.unwrap(bytes.constData(), bytes.size(), &unwrapped) > 0);
+        QCOMPARE(QKnxNetIpFrame::fromBytes(unwrapped).serviceType(),
+            QKnxNetIp::ServiceType::ConnectRequest);
+        QCOMPARE(errorSpy.count(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxNetIpSecureSession)
+
+#include "tst_qknxnetipsecuresession.moc"
@@ -0,0 +1,197 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetipsharedtransport.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtNetwork/qudpsocket.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxNetIpSharedTransport : public QObject
+{
+    Q_OBJECT
+
+private:
+    QKnxNetIpFrame readFrame(QUdpSocket *server, QHostAddress *sender, quint16 *port)
+    {
+        QByteArray datagram(int(server->pendingDatagramSize()), Qt::Uninitialized);
+        server->readDatagram(datagram.data(), datagram.size(), sender, port);
+        return QKnxNetIpFrame::fromBytes(QKnxByteArray(reinterpret_cast<const quint8 *>
+            (datagram.constData()), datagram.size()));
+    }
+
+    void writeFrame(QUdpSocket *socket, const QKnxNetIpFrame &frame, const QHostAddress &address,
+        quint16 port)
+    {
+        const auto bytes = frame.bytes();
+        socket->writeDatagram(reinterpret_cast<const char *> (bytes.constData()), bytes.size(),
+            address, port);
+    }
+
+    void sendConnectResponse(QUdpSocket *server, quint8 channelId, const QHostAddress &address,
+        quint16 port, QUdpSocket *dataSocket = nullptr)
+    {
+        if (!dataSocket)
+            dataSocket = server;
+
+        const auto frame = QKnxNetIpConnectResponseProxy::builder()
+            .setChannelId(channelId)
+            .setStatus(QKnxNetIp::Error::None)
+            .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+                .setHostAddress(dataSocket->localAddress())
+                .setPort(dataSocket->localPort())
+                .create())
+            .setResponseData(QKnxNetIpCrdProxy::builder()
+                .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+                .setIndividualAddress({ QKnxAddress::Type::Individual, QStringLiteral("1.1.%1")
+                    .arg(channelId) })
+                .create())
+            .create();
+        writeFrame(server, frame, address, port);
+    }
+
+private slots:
+    void testUnbound()
+    {
+        QKnxNetIpSharedTransport transport;
+        QCOMPARE(transport.isBound(), false);
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setTransport(&transport);
+        QCOMPARE(tunnel.transport(), &transport);
+
+        tunnel.connectToHost(QHostAddress::LocalHost, 3671);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(tunnel.error(), QKnxNetIpEndpointConnection::Error::Network);
+        QCOMPARE(transport.connectionCount(), 0);
+    }
+
+    void testSharedTunnels()
+    {
+        QUdpSocket server;
+        QVERIFY(server.bind(QHostAddress::LocalHost));
+
+        QKnxNetIpSharedTransport transport;
+        QVERIFY(transport.bind(QHostAddress::LocalHost));
+        QVERIFY(transport.localPort() != 0);
+
+        QKnxNetIpTunnel first, second;
+        first.setTransport(&transport);
+        second.setTransport(&transport);
+
+        first.connectToHost(QHostAddress::LocalHost, server.localPort());
+        second.connectToHost(QHostAddress::LocalHost, server.localPort());
+        QCOMPARE(transport.connectionCount(), 2);
+        QCOMPARE(first.localPort(), transport.localPort());
+        QCOMPARE(second.localPort(), transport.localPort());
+
+        // both connect requests leave through the one shared socket
+        for (quint8 channelId = 1; channelId <= 2; ++channelId) {
+            QHostAddress sender;
+            quint16 port = 0;
+            // sends are flushed from the event loop, so do not block in waitForReadyRead()
+            QTRY_VERIFY(server.hasPendingDatagrams());
+            const auto frame = readFrame(&server, &sender, &port);
+            QCOMPARE(frame.serviceType(), QKnxNetIp::ServiceType::ConnectRequest);
+            QCOMPARE(port, transport.localPort());
+            sendConnectResponse(&server, channelId, sender, port);
+        }
+
+        QTRY_COMPARE(first.state(), QKnxNetIpEndpointConnection::State::Connected);
+        QTRY_COMPARE(second.state(), QKnxNetIpEndpointConnection::State::Connected);
+
+        // a connect response nobody waits for is dropped
+        const auto dropped = transport.datagramsDropped();
+        sendConnectResponse(&server, 3, transport.localAddress(), transport.localPort());
+        QTRY_COMPARE(transport.datagramsDropped(), dropped + 1);
+        QVERIFY(transport.datagramsSent() >= 2);
+
+        transport.close();
+        QCOMPARE(transport.isBound(), false);
+        QCOMPARE(first.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(second.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(first.error(), QKnxNetIpEndpointConnection::Error::Network);
+        QCOMPARE(transport.connectionCount(), 0);
+    }
+
+    void testDataEndpoint()
+    {
+        QUdpSocket control, data, foreign;
+        QVERIFY(control.bind(QHostAddress::LocalHost));
+        QVERIFY(data.bind(QHostAddress::LocalHost));
+        QVERIFY(foreign.bind(QHostAddress::LocalHost));
+
+        QKnxNetIpSharedTransport transport;
+        QVERIFY(transport.bind(QHostAddress::LocalHost));
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setTransport(&transport);
+        tunnel.connectToHost(QHostAddress::LocalHost, control.localPort());
+
+        QHostAddress sender;
+        quint16 port = 0;
+        QTRY_VERIFY(control.hasPendingDatagrams());
+        QCOMPARE(readFrame(&control, &sender, &port).serviceType(),
+            QKnxNetIp::ServiceType::ConnectRequest);
+        sendConnectResponse(&control, 1, sender, port, &data);
+        QTRY_COMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connected);
+
+        QSignalSpy received(&tunnel, &QKnxNetIpTunnel::frameReceived);
+        const auto request = [](quint8 sequenceNumber) {
+            return QKnxNetIpTunnelingRequestProxy::builder()
+                .setChannelId(1)
+                .setSequenceNumber(sequenceNumber)
+                .setCemi(QKnxLinkLayerFrame::builder().setMedium(QKnx::MediumType::NetIP)
+                    .setData(QKnxByteArray::fromHex("2900bce011010a03010081")).createFrame())
+                .create();
+        };
+
+        // the right channel ID from an endpoint the server did not negotiate is dropped
+        const auto dropped = transport.datagramsDropped();
+        writeFrame(&foreign, request(0), transport.localAddress(), transport.localPort());
+        QTRY_COMPARE(transport.datagramsDropped(), dropped + 1);
+        QCOMPARE(received.count(), 0);
+
+        // the negotiated data endpoint is served
+        writeFrame(&data, request(0), transport.localAddress(), transport.localPort());
+        QTRY_COMPARE(received.count(), 1);
+        QCOMPARE(transport.datagramsDropped(), dropped + 1);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connected);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxNetIpSharedTransport)
+
+#include "tst_qknxnetipsharedtransport.moc"
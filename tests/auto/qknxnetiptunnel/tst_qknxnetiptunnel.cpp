@@ -0,0 +1,438 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/qknxcontrolfield.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetipconnectionstateresponse.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetipdisconnectresponse.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetiptunnelingacknowledge.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtKnx/qknxvirtualclock.h>
+#include <QtNetwork/qudpsocket.h>
+#include <QtTest/qtest.h>
+
+static const quint8 ChannelId = 0x01;
+
+static QKnxAddress group(quint16 address)
+{
+    return { QKnxAddress::Type::Group, address };
+}
+
+static QKnxLinkLayerFrame groupFrame(quint16 address, QKnxTpdu::ApplicationControlField apci,
+    const QKnxByteArray &data = {})
+{
+    return QKnxLinkLayerFrame::builder()
+        .setDestinationAddress(group(address))
+        .setTpdu({ QKnxTpdu::TransportControlField::DataGroup, apci, data })
+        .createFrame();
+}
+
+static QKnxLinkLayerFrame groupWrite(quint16 address, quint8 value)
+{
+    return groupFrame(address, QKnxTpdu::ApplicationControlField::GroupValueWrite,
+        QKnxByteArray { value });
+}
+
+class tst_QKnxNetIpTunnel : public QObject
+{
+    Q_OBJECT
+
+private:
+    QKnxNetIpFrame readFrame()
+    {
+        QByteArray datagram(int(m_server.pendingDatagramSize()), Qt::Uninitialized);
+        m_server.readDatagram(datagram.data(), datagram.size(), &m_client, &m_clientPort);
+        return QKnxNetIpFrame::fromBytes(QKnxByteArray(reinterpret_cast<const quint8 *>
+            (datagram.constData()), datagram.size()));
+    }
+
+    void writeFrame(const QKnxNetIpFrame &frame)
+    {
+        const auto bytes = frame.bytes();
+        m_server.writeDatagram(reinterpret_cast<const char *> (bytes.constData()), bytes.size(),
+            m_client, m_clientPort);
+    }
+
+    bool connectTunnel(QKnxNetIpTunnel *tunnel)
+    {
+        tunnel->setLocalAddress(QHostAddress::LocalHost);
+        tunnel->connectToHost(QHostAddress::LocalHost, m_server.localPort());
+
+        // sends are flushed from the event loop, so do not block in waitForReadyRead()
+        forever {
+            if (!QTest::qWaitFor([&]() { return m_server.hasPendingDatagrams(); }))
+                return false;
+            if (readFrame().serviceType() == QKnxNetIp::ServiceType::ConnectRequest)
+                break;
+        }
+
+        writeFrame(QKnxNetIpConnectResponseProxy::builder()
+            .setChannelId(ChannelId)
+            .setStatus(QKnxNetIp::Error::None)
+            .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+                .setHostAddress(m_server.localAddress())
+                .setPort(m_server.localPort())
+                .create())
+            .setResponseData(QKnxNetIpCrdProxy::builder()
+                .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+                .setIndividualAddress({ QKnxAddress::Type::Individual, QStringLiteral("1.1.1") })
+                .create())
+            .create());
+        m_serverSequence = 0;
+
+        return QTest::qWaitFor([&]() {
+            return tunnel->state() == QKnxNetIpEndpointConnection::State::Connected;
+        });
+    }
+
+    // Waits for the next tunneling request sent by the tunnel, acknowledges it and
+    // returns its cEMI frame. Returns an invalid frame if no request arrives in time.
+    QKnxLinkLayerFrame takeRequest(int timeout = 5000)
+    {
+        forever {
+            if (!QTest::qWaitFor([&]() { return m_server.hasPendingDatagrams(); }, timeout))
+                return {};
+
+            const auto frame = readFrame();
+            if (frame.serviceType() == QKnxNetIp::ServiceType::ConnectionStateRequest) {
+                writeFrame(QKnxNetIpConnectionStateResponseProxy::builder()
+                    .setChannelId(ChannelId)
+                    .setStatus(QKnxNetIp::Error::None)
+                    .create());
+            }
+            if (frame.serviceType() != QKnxNetIp::ServiceType::TunnelingRequest)
+                continue;
+
+            writeFrame(QKnxNetIpTunnelingAcknowledgeProxy::builder()
+                .setChannelId(ChannelId)
+                .setSequenceNumber(frame.sequenceNumber())
+                .setStatus(QKnxNetIp::Error::None)
+                .create());
+            return QKnxNetIpTunnelingRequestProxy(frame).cemi();
+        }
+    }
+
+    void sendIndication(quint16 address, QKnxTpdu::ApplicationControlField apci,
+        const QKnxByteArray &data)
+    {
+        writeFrame(QKnxNetIpTunnelingRequestProxy::builder()
+            .setChannelId(ChannelId)
+            .setSequenceNumber(m_serverSequence++)
+            .setCemi(QKnxLinkLayerFrame::builder()
+                .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+                .setSourceAddress({ QKnxAddress::Type::Individual, QStringLiteral("1.1.5") })
+                .setDestinationAddress(group(address))
+                .setTpdu({ QKnxTpdu::TransportControlField::DataGroup, apci, data })
+                .createFrame())
+            .create());
+    }
+
+    // Acknowledges the queued frames one after the other and returns them as
+    // "<group>:<value>" strings, or "<group>:read" for group value reads.
+    QStringList drainQueue(int count)
+    {
+        QStringList sent;
+        for (int i = 0; i < count; ++i) {
+            const auto frame = takeRequest();
+            if (!frame.isValid())
+                break;
+            const auto tpdu = frame.tpdu();
+            sent << QStringLiteral("%1:%2").arg(frame.destinationAddress().toString(),
+                tpdu.applicationControlField() == QKnxTpdu::ApplicationControlField::GroupValueRead
+                    ? QStringLiteral("read") : QString::fromLatin1(tpdu.data().toHex().toByteArray()));
+        }
+        return sent;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_server.bind(QHostAddress::LocalHost));
+    }
+
+    void testReadGroupValue()
+    {
+        // the read timeouts of a tunnel run on the clock installed when it was created
+        QKnxVirtualClock clock;
+        clock.install();
+
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+
+        // concurrent reads of one address share a single group value read
+        auto first = tunnel.readGroupValue(group(0x0801), 1000);
+        auto second = tunnel.readGroupValue(group(0x0801), 3000);
+        QVERIFY(first == second);
+
+        auto request = takeRequest();
+        QCOMPARE(request.destinationAddress(), group(0x0801));
+        QCOMPARE(request.tpdu().applicationControlField(),
+            QKnxTpdu::ApplicationControlField::GroupValueRead);
+        QVERIFY(!takeRequest(100).isValid());
+
+        // resolved by a group value response
+        sendIndication(0x0801, QKnxTpdu::ApplicationControlField::GroupValueResponse,
+            QKnxByteArray { 0x01 });
+        QTRY_COMPARE(first.isFinished(), true);
+        QCOMPARE(first.isCanceled(), false);
+        QCOMPARE(first.result(), QKnxByteArray { 0x01 });
+        QCOMPARE(second.result(), QKnxByteArray { 0x01 });
+
+        // resolved by a group value write seen while waiting, other addresses are ignored
+        auto written = tunnel.readGroupValue(group(0x0802));
+        QVERIFY(takeRequest().isValid());
+        sendIndication(0x0803, QKnxTpdu::ApplicationControlField::GroupValueWrite,
+            QKnxByteArray { 0x07 });
+        sendIndication(0x0802, QKnxTpdu::ApplicationControlField::GroupValueRead, {});
+        sendIndication(0x0802, QKnxTpdu::ApplicationControlField::GroupValueWrite,
+            QKnxByteArray { 0x2a });
+        QTRY_COMPARE(written.isFinished(), true);
+        QCOMPARE(written.result(), QKnxByteArray { 0x2a });
+
+        // timed out by the read timer, the longest timeout of all readers is kept
+        auto shortRead = tunnel.readGroupValue(group(0x0804), 1000);
+        QVERIFY(takeRequest().isValid());
+        auto longRead = tunnel.readGroupValue(group(0x0804), 3000);
+        auto other = tunnel.readGroupValue(group(0x0805), 1000);
+        QVERIFY(takeRequest().isValid());
+
+        clock.advance(999);
+        QCOMPARE(other.isFinished(), false);
+        clock.advance(1);
+        QCOMPARE(other.isFinished(), true);
+        QCOMPARE(other.isCanceled(), true);
+        QCOMPARE(shortRead.isFinished(), false);
+
+        clock.advance(1999);
+        QCOMPARE(longRead.isFinished(), false);
+        clock.advance(1);
+        QCOMPARE(longRead.isFinished(), true);
+        QCOMPARE(shortRead.isCanceled(), true);
+
+        // a late response does not touch the expired read, a new read sends again
+        sendIndication(0x0804, QKnxTpdu::ApplicationControlField::GroupValueResponse,
+            QKnxByteArray { 0x01 });
+        auto again = tunnel.readGroupValue(group(0x0804));
+        QVERIFY(again != longRead);
+        QVERIFY(takeRequest().isValid());
+
+        // canceled when the connection is closed
+        tunnel.disconnectFromHost();
+        forever {
+            QVERIFY(QTest::qWaitFor([&]() { return m_server.hasPendingDatagrams(); }));
+            if (readFrame().serviceType() == QKnxNetIp::ServiceType::DisconnectRequest)
+                break;
+        }
+        QCOMPARE(again.isFinished(), false);
+        writeFrame(QKnxNetIpDisconnectResponseProxy::builder()
+            .setChannelId(ChannelId)
+            .setStatus(QKnxNetIp::Error::None)
+            .create());
+        QTRY_COMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(again.isFinished(), true);
+        QCOMPARE(again.isCanceled(), true);
+
+        // nothing is sent without a connection
+        QCOMPARE(tunnel.readGroupValue(group(0x0804)).isCanceled(), true);
+    }
+
+    void testThrottleOnVirtualClock()
+    {
+        // bus load throttling runs on the clock installed when the tunnel was created
+        QKnxVirtualClock clock;
+        clock.install();
+
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+        tunnel.setBusLoadLimit(0.01);
+
+        sendIndication(0x0d00, QKnxTpdu::ApplicationControlField::GroupValueWrite,
+            QKnxByteArray { 0x01 });
+        QTRY_VERIFY(tunnel.busLoad() >= 0.01);
+
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0d01, 0x02)));
+        QVERIFY(!takeRequest(200).isValid());
+        QCOMPARE(tunnel.queuedFrameCount(), 1);
+
+        // the indication drops out of the estimate once a full window has passed
+        clock.advance(999);
+        QVERIFY(!takeRequest(100).isValid());
+        clock.advance(1);
+        QCOMPARE(drainQueue(1), QStringList({ QStringLiteral("1/5/1:02") }));
+        QCOMPARE(tunnel.busLoad(), 0.);
+    }
+
+    void testReplacePendingWrite()
+    {
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+
+        QCOMPARE(tunnel.queuePolicy(group(0x0901)), QKnxNetIpTunnel::QueuePolicy::Append);
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+        QCOMPARE(tunnel.queuePolicy(group(0x0901)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+        QCOMPARE(tunnel.queuePolicy({ QKnxAddress::Type::Individual, 0x1101 }),
+            QKnxNetIpTunnel::QueuePolicy::Append);
+
+        // the first frame leaves right away, the others wait for its acknowledge
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0900, 0x00)));
+        QCOMPARE(tunnel.queuedFrameCount(), 0);
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x01)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0902, 0x02)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x03)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0903, 0x04)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0902, 0x05)));
+        QCOMPARE(tunnel.queuedFrameCount(), 3);
+
+        // a write that was sent already is not replaced
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0900, 0x06)));
+        QCOMPARE(tunnel.queuedFrameCount(), 4);
+
+        // newer values take the place of the pending writes, the order of the
+        // addresses is the order of their first write
+        QCOMPARE(drainQueue(5), QStringList({ QStringLiteral("1/1/0:00"),
+            QStringLiteral("1/1/1:03"), QStringLiteral("1/1/2:05"), QStringLiteral("1/1/3:04"),
+            QStringLiteral("1/1/0:06") }));
+        QCOMPARE(tunnel.queuedFrameCount(), 0);
+    }
+
+    void testReplaceAtOtherPriority()
+    {
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+
+        auto urgentWrite = [](quint16 address, quint8 value) {
+            auto frame = groupWrite(address, value);
+            frame.setControlField(QKnxControlField::builder()
+                .setPriority(QKnxControlField::Priority::Urgent)
+                .create());
+            return frame;
+        };
+
+        // holds the queue until its acknowledge
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0c00, 0x00)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0c01, 0x01)));
+        QVERIFY(tunnel.enqueueFrame(urgentWrite(0x0c01, 0x02)));
+        QCOMPARE(tunnel.queuedFrameCount(), 1);
+
+        // the older low priority value must not follow the urgent one onto the bus
+        QCOMPARE(drainQueue(2), QStringList({ QStringLiteral("1/4/0:00"),
+            QStringLiteral("1/4/1:02") }));
+        QVERIFY(!takeRequest(200).isValid());
+        QCOMPARE(tunnel.queuedFrameCount(), 0);
+    }
+
+    void testQueuePolicyRange()
+    {
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite, group(0x0a00),
+            group(0x0aff));
+        QCOMPARE(tunnel.queuePolicy(group(0x09ff)), QKnxNetIpTunnel::QueuePolicy::Append);
+        QCOMPARE(tunnel.queuePolicy(group(0x0a00)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+        QCOMPARE(tunnel.queuePolicy(group(0x0aff)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+        QCOMPARE(tunnel.queuePolicy(group(0x0b00)), QKnxNetIpTunnel::QueuePolicy::Append);
+
+        // inverted and non group ranges are ignored
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::Append, group(0x0aff), group(0x0a00));
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::Append,
+            { QKnxAddress::Type::Individual, 0x0a00 }, group(0x0aff));
+        QCOMPARE(tunnel.queuePolicy(group(0x0a80)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+
+        // ranges override parts of an earlier range
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::Append, group(0x0a80), group(0x0a80));
+        QCOMPARE(tunnel.queuePolicy(group(0x0a7f)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+        QCOMPARE(tunnel.queuePolicy(group(0x0a80)), QKnxNetIpTunnel::QueuePolicy::Append);
+        QCOMPARE(tunnel.queuePolicy(group(0x0a81)),
+            QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0900, 0x00)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0a01, 0x01)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0b01, 0x02)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0a80, 0x03)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0a01, 0x04)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0b01, 0x05)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0a80, 0x06)));
+        QCOMPARE(tunnel.queuedFrameCount(), 5);
+
+        // only the write inside the replacing range was collapsed
+        QCOMPARE(drainQueue(6), QStringList({ QStringLiteral("1/1/0:00"),
+            QStringLiteral("1/2/1:04"), QStringLiteral("1/3/1:02"), QStringLiteral("1/2/128:03"),
+            QStringLiteral("1/3/1:05"), QStringLiteral("1/2/128:06") }));
+    }
+
+    void testReplaceBlockedByOtherFrames()
+    {
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(connectTunnel(&tunnel));
+        tunnel.setQueuePolicy(QKnxNetIpTunnel::QueuePolicy::ReplacePendingWrite);
+
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0900, 0x00)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x01)));
+        QVERIFY(tunnel.enqueueFrame(groupFrame(0x0901,
+            QKnxTpdu::ApplicationControlField::GroupValueRead)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x02)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x03)));
+
+        // a write queued before a read of the same group must not be overtaken by a
+        // newer value, writes queued after the read replace each other again
+        QCOMPARE(tunnel.queuedFrameCount(), 3);
+
+        // frames to other groups do not block replacement
+        QVERIFY(tunnel.enqueueFrame(groupFrame(0x0902,
+            QKnxTpdu::ApplicationControlField::GroupValueRead)));
+        QVERIFY(tunnel.enqueueFrame(groupWrite(0x0901, 0x04)));
+        QCOMPARE(tunnel.queuedFrameCount(), 4);
+
+        QCOMPARE(drainQueue(5), QStringList({ QStringLiteral("1/1/0:00"),
+            QStringLiteral("1/1/1:01"), QStringLiteral("1/1/1:read"), QStringLiteral("1/1/1:04"),
+            QStringLiteral("1/1/2:read") }));
+    }
+
+private:
+    QUdpSocket m_server;
+    QHostAddress m_client;
+    quint16 m_clientPort { 0 };
+    quint8 m_serverSequence { 0 };
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxNetIpTunnel)
+
+#include "tst_qknxnetiptunnel.moc"
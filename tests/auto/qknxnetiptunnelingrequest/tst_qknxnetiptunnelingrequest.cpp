@@ -33,6 +33,7 @@
 #include <QtKnx/QKnxNetIpConnectionHeader>
 #include <QtKnx/qknxlinklayerframebuilder.h>
 #include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtKnx/private/qknxnetipservicedispatcher_p.h>
 
 static QString s_msg;
 static void myMessageHandler(QtMsgType, const QMessageLogContext &, const QString &msg)
@@ -48,6 +49,8 @@ private slots:
     void testDefaultConstructor();
     void testConstructor();
     void testValidationTunnelingRequest();
+    void testSerializeInto();
+    void testFramePeek();
     void testDebugStream();
 };
 
@@ -158,6 +161,85 @@ void tst_QKnxNetIpTunnelingRequest::testValidationTunnelingRequest()
     }
 }
 
+void tst_QKnxNetIpTunnelingRequest::testSerializeInto()
+{
+    auto cemi = QKnxLinkLayerFrame::builder()
+                .setData(QKnxByteArray::fromHex("1100b4e000000002010000"))
+                .setMedium(QKnx::MediumType::NetIP)
+                .createFrame();
+
+    auto frame = QKnxNetIpTunnelingRequestProxy::builder()
+                 .setChannelId(1)
+                 .setSequenceNumber(2)
+                 .setCemi(cemi)
+                 .create();
+
+    const auto bytes = frame.bytes();
+    QCOMPARE(frame.serializedSize(), quint16(bytes.size()));
+
+    QKnxByteArray buffer(32, 0x00);
+    QCOMPARE(frame.serializeInto(buffer.data(), size_t(bytes.size() - 1)), quint16(0));
+    QCOMPARE(frame.serializeInto(buffer.data(), size_t(buffer.size())), quint16(bytes.size()));
+    QCOMPARE(buffer.mid(0, bytes.size()), bytes);
+
+    QCOMPARE(QKnxNetIpFrame().serializedSize(), quint16(0));
+}
+
+void tst_QKnxNetIpTunnelingRequest::testFramePeek()
+{
+    auto frame = QKnxNetIpTunnelingRequestProxy::builder()
+                 .setChannelId(7)
+                 .setSequenceNumber(42)
+                 .setCemi(QKnxLinkLayerFrame::builder()
+                    .setData(QKnxByteArray::fromHex("1100b4e000000002010000"))
+                    .setMedium(QKnx::MediumType::NetIP)
+                    .createFrame())
+                 .create();
+    const auto bytes = frame.bytes();
+
+    auto peek = QKnxNetIpFramePeek::peek(bytes);
+    QCOMPARE(peek.isValid(), true);
+    QCOMPARE(peek.serviceType, QKnxNetIp::ServiceType::TunnelingRequest);
+    QCOMPARE(peek.totalSize, quint16(bytes.size()));
+    QCOMPARE(peek.hasChannelId, true);
+    QCOMPARE(peek.channelId, quint8(7));
+    QCOMPARE(peek.sequenceNumber, quint8(42));
+
+    // trailing bytes of a following frame do not matter
+    peek = QKnxNetIpFramePeek::peek(bytes + QKnxByteArray { 0x06, 0x10 });
+    QCOMPARE(peek.isValid(), true);
+    QCOMPARE(peek.totalSize, quint16(bytes.size()));
+
+    peek = QKnxNetIpFramePeek::peek(bytes.mid(0, 4));
+    QCOMPARE(peek.status, QKnxNetIpFramePeek::Status::Incomplete);
+    peek = QKnxNetIpFramePeek::peek(bytes.mid(0, bytes.size() - 1));
+    QCOMPARE(peek.status, QKnxNetIpFramePeek::Status::Incomplete);
+
+    auto invalid = bytes;
+    invalid.set(1, 0x20); // unsupported protocol version
+    QCOMPARE(QKnxNetIpFramePeek::peek(invalid).status, QKnxNetIpFramePeek::Status::Invalid);
+
+    invalid = bytes;
+    invalid.set(0, 0x08); // unsupported header size
+    QCOMPARE(QKnxNetIpFramePeek::peek(invalid).status, QKnxNetIpFramePeek::Status::Invalid);
+
+    // service types unknown to Qt KNX are valid and keep their body as data
+    auto vendor = bytes;
+    vendor.set(2, 0xff);
+    peek = QKnxNetIpFramePeek::peek(vendor);
+    QCOMPARE(peek.isValid(), true);
+    QCOMPARE(peek.serviceType, QKnxNetIp::ServiceType(0xff20));
+    QCOMPARE(peek.hasChannelId, false);
+    const auto vendorFrame = peek.createFrame(vendor.constData());
+    QCOMPARE(vendorFrame.serviceType(), QKnxNetIp::ServiceType(0xff20));
+    QCOMPARE(vendorFrame.data(), bytes.mid(6));
+    QCOMPARE(QKnxNetIpFramePeek::peek(bytes).createFrame(bytes.constData()), frame);
+
+    invalid = bytes;
+    invalid.set(6, 0x02); // connection header too short
+    QCOMPARE(QKnxNetIpFramePeek::peek(invalid).status, QKnxNetIpFramePeek::Status::Invalid);
+}
+
 void tst_QKnxNetIpTunnelingRequest::testDebugStream()
 {
     struct DebugHandler
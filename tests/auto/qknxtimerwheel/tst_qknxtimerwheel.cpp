@@ -0,0 +1,134 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtKnx/private/qknxtimer_p.h>
+#include <QtKnx/private/qknxtimerwheel_p.h>
+#include <QtTest/qtest.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QKnxTimerWheel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSingleShot()
+    {
+        auto wheel = QKnxTimerWheel::instance();
+        QCOMPARE(wheel, QKnxTimerWheel::instance());
+        const int count = wheel->count();
+
+        QStringList fired;
+        QKnxTimer slow, fast;
+        slow.setSingleShot(true);
+        fast.setSingleShot(true);
+        connect(&slow, &QKnxTimer::timeout, [&] { fired << QStringLiteral("slow"); });
+        connect(&fast, &QKnxTimer::timeout, [&] { fired << QStringLiteral("fast"); });
+
+        QElapsedTimer clock;
+        clock.start();
+        slow.start(150);
+        fast.start(20);
+        QCOMPARE(slow.isVirtual(), false);
+        QCOMPARE(wheel->count(), count + 2);
+        QVERIFY(slow.remainingTime() > 100);
+
+        QTRY_COMPARE(fired.size(), 2);
+        QCOMPARE(fired, QStringList({ QStringLiteral("fast"), QStringLiteral("slow") }));
+        QVERIFY(clock.elapsed() >= 140);
+        QCOMPARE(slow.isActive(), false);
+        QCOMPARE(slow.remainingTime(), -1);
+        QCOMPARE(wheel->count(), count);
+    }
+
+    void testRepeating()
+    {
+        int count = 0;
+        QKnxTimer timer;
+        connect(&timer, &QKnxTimer::timeout, [&] {
+            if (++count == 3)
+                timer.stop();
+        });
+        timer.start(10);
+        QTRY_COMPARE(count, 3);
+        QTest::qWait(50);
+        QCOMPARE(count, 3);
+    }
+
+    void testStopFromTimeout()
+    {
+        // both expire in the same tick, the first stops and deletes the second
+        bool fired = false;
+        QKnxTimer first;
+        auto second = new QKnxTimer;
+        first.setSingleShot(true);
+        second->setSingleShot(true);
+        connect(&first, &QKnxTimer::timeout, [&] { delete second; });
+        connect(second, &QKnxTimer::timeout, [&] { fired = true; });
+
+        first.start(5);
+        second->start(5);
+        QTRY_VERIFY(!first.isActive());
+        QTest::qWait(20);
+        QCOMPARE(fired, false);
+    }
+
+    void testManyTimers()
+    {
+        auto wheel = QKnxTimerWheel::instance();
+        const int count = wheel->count();
+
+        // spread over several levels of the wheel
+        std::vector<std::unique_ptr<QKnxTimer>> timers;
+        for (int i = 0; i < 5000; ++i) {
+            timers.emplace_back(new QKnxTimer);
+            timers.back()->setSingleShot(true);
+            timers.back()->start(1000 + i * 997);
+        }
+        QCOMPARE(wheel->count(), count + 5000);
+
+        int fired = 0;
+        for (int i = 0; i < 5000; i += 2)
+            timers[i]->stop();
+        for (int i = 1; i < 5000; i += 2) {
+            connect(timers[i].get(), &QKnxTimer::timeout, [&] { ++fired; });
+            timers[i]->setInterval(1 + i % 7); // restarts the active timer
+        }
+        QCOMPARE(wheel->count(), count + 2500);
+
+        QTRY_COMPARE(fired, 2500);
+        QCOMPARE(wheel->count(), count);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxTimerWheel)
+
+#include "tst_qknxtimerwheel.moc"
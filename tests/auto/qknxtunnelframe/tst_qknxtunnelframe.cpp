@@ -155,6 +155,32 @@ private slots:
         QCOMPARE(frame.bytes().mid(2, frame.additionalInfosSize()), info.bytes());
     }
 
+    void testSerializeInto()
+    {
+        auto frame = QKnxLinkLayerFrame::builder()
+            .setControlField(QKnxControlField(0xbc))
+            .setExtendedControlField(QKnxExtendedControlField(0xe0))
+            .setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01, 0x02 }))
+            .setDestinationAddress({ QKnxAddress::Type::Group, QString("1/2/3") })
+            .setSourceAddress({ QKnxAddress::Type::Individual, QString("1.1.1") })
+            .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+            .setMedium(QKnx::MediumType::NetIP)
+            .setAdditionalInfos({ { QKnxAdditionalInfo::Type::BiBatInformation,
+                QKnxByteArray::fromHex("1020") } })
+            .createFrame();
+
+        const auto bytes = frame.bytes();
+        QCOMPARE(frame.serializedSize(), quint16(bytes.size()));
+
+        QKnxByteArray buffer(64, 0xff);
+        QCOMPARE(frame.serializeInto(buffer.data(), 4), quint16(0));
+        QCOMPARE(frame.serializeInto(nullptr, 64), quint16(0));
+        QCOMPARE(frame.serializeInto(buffer.data(), size_t(buffer.size())), frame.serializedSize());
+        QCOMPARE(buffer.mid(0, bytes.size()), bytes);
+
+        QCOMPARE(QKnxLinkLayerFrame().serializedSize(), quint16(0));
+    }
+
     void testDebugStream()
     {
         struct DebugHandler
@@ -0,0 +1,160 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxvirtualclock.h>
+#include <QtKnx/private/qknxtimer_p.h>
+#include <QtNetwork/qudpsocket.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxVirtualClock : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testInstall()
+    {
+        QCOMPARE(QKnxVirtualClock::installed(), nullptr);
+        {
+            QKnxVirtualClock clock;
+            QCOMPARE(clock.isInstalled(), false);
+            QCOMPARE(QKnxTimer().isVirtual(), false);
+
+            clock.install();
+            QCOMPARE(QKnxVirtualClock::installed(), &clock);
+            QCOMPARE(QKnxTimer().isVirtual(), true);
+
+            clock.uninstall();
+            QCOMPARE(QKnxVirtualClock::installed(), nullptr);
+
+            clock.install();
+        }
+        QCOMPARE(QKnxVirtualClock::installed(), nullptr);
+    }
+
+    void testTimeouts()
+    {
+        QKnxVirtualClock clock;
+        clock.install();
+
+        QStringList fired;
+        QKnxTimer slow, fast, repeating;
+        slow.setSingleShot(true);
+        fast.setSingleShot(true);
+        connect(&slow, &QKnxTimer::timeout, [&] { fired << QStringLiteral("slow"); });
+        connect(&fast, &QKnxTimer::timeout, [&] { fired << QStringLiteral("fast"); });
+        connect(&repeating, &QKnxTimer::timeout, [&] {
+            fired << QString::number(clock.elapsed());
+        });
+
+        slow.start(3000);
+        fast.start(1000);
+        repeating.start(1000);
+        QCOMPARE(clock.activeTimerCount(), 3);
+        QCOMPARE(clock.nextTimeout(), qint64(1000));
+        QCOMPARE(slow.remainingTime(), 3000);
+
+        clock.advance(999);
+        QVERIFY(fired.isEmpty());
+        QCOMPARE(slow.remainingTime(), 2001);
+
+        // same deadline, started first fires first
+        clock.advance(1);
+        QCOMPARE(fired, QStringList({ QStringLiteral("fast"), QStringLiteral("1000") }));
+        QCOMPARE(fast.isActive(), false);
+        QCOMPARE(fast.remainingTime(), -1);
+
+        fired.clear();
+        clock.advance(2500);
+        QCOMPARE(fired, QStringList({ QStringLiteral("2000"), QStringLiteral("3000"),
+            QStringLiteral("slow") }));
+        QCOMPARE(clock.elapsed(), qint64(3500));
+
+        repeating.stop();
+        QCOMPARE(clock.activeTimerCount(), 0);
+        QCOMPARE(clock.nextTimeout(), qint64(-1));
+        QCOMPARE(clock.advanceToNextTimeout(), false);
+    }
+
+    void testRestart()
+    {
+        QKnxVirtualClock clock;
+        clock.install();
+
+        int count = 0;
+        QKnxTimer timer;
+        timer.setSingleShot(true);
+        connect(&timer, &QKnxTimer::timeout, [&] {
+            if (++count < 3)
+                timer.start(); // restarted from the timeout, fires in the same advance
+        });
+
+        timer.start(100);
+        clock.advance(150);
+        QCOMPARE(count, 1);
+        QCOMPARE(timer.remainingTime(), 50);
+
+        timer.setInterval(500); // restarts an active timer
+        QCOMPARE(timer.remainingTime(), 500);
+
+        QCOMPARE(clock.advanceToNextTimeout(), true);
+        QCOMPARE(clock.elapsed(), qint64(650));
+        QCOMPARE(count, 2);
+
+        clock.advance(10000);
+        QCOMPARE(count, 3);
+        QCOMPARE(timer.isActive(), false);
+    }
+
+    void testConnectRequestTimeout()
+    {
+        QKnxVirtualClock clock;
+        clock.install();
+
+        // a server that never answers
+        QUdpSocket server;
+        QVERIFY(server.bind(QHostAddress::LocalHost));
+
+        QKnxNetIpTunnel tunnel;
+        tunnel.setLocalAddress(QHostAddress::LocalHost);
+        tunnel.connectToHost(QHostAddress::LocalHost, server.localPort());
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connecting);
+
+        clock.advance(QKnxNetIp::ConnectRequestTimeout - 1);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connecting);
+
+        clock.advance(1);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(tunnel.error(), QKnxNetIpEndpointConnection::Error::Acknowledge);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QKnxVirtualClock)
+
+#include "tst_qknxvirtualclock.moc"
@@ -0,0 +1,4 @@
+TEMPLATE = subdirs
+
+QT_FOR_CONFIG += network
+qtConfig(opensslv11):SUBDIRS += qknxnetipsecuresession
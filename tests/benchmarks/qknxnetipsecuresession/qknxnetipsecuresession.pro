@@ -0,0 +1,7 @@
+TARGET = tst_bench_qknxnetipsecuresession
+
+QT = core testlib knx network knx-private
+CONFIG += benchmark c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_bench_qknxnetipsecuresession.cpp
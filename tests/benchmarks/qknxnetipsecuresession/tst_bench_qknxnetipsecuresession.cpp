@@ -0,0 +1,375 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qtimer.h>
+#include <QtKnx/qknxcurve25519.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetipconnectionstateresponse.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
+#include <QtKnx/qknxnetipsessionrequest.h>
+#include <QtKnx/qknxnetipsessionresponse.h>
+#include <QtKnx/qknxnetipsessionstatus.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtKnx/private/qknxcryptographicdata_p.h>
+#include <QtKnx/private/qknxnetipsecuresession_p.h>
+#include <QtKnx/private/qknxnetipservicedispatcher_p.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/qtest.h>
+
+// Drives a QKnxNetIpTunnel against a minimal KNXnet/IP server on a TCP loopback
+// connection, once connected in plaintext and once through a secure session.
+// The tunnel sends a batch of tunneling requests, the server answers each of
+// them with the same tunneling indication and the batch is done once the tunnel
+// received all of them. Both rows exchange the very same frames, so the
+// difference between them is the cost of the secure wrappers on both ends. The
+// secured tunnel is expected to stay within 10% of the plaintext tunnel.
+
+namespace {
+
+const quint16 SessionId = 0x0001;
+const quint8 ChannelId = 0x01;
+
+class LoopbackServer
+{
+public:
+    explicit LoopbackServer(bool secure)
+        : m_secure(secure)
+    {
+        m_indication = QKnxNetIpTunnelingRequestProxy::builder()
+            .setChannelId(ChannelId)
+            .setSequenceNumber(0x00)
+            .setCemi(QKnxLinkLayerFrame::builder()
+                .setMedium(QKnx::MediumType::NetIP)
+                .setData(QKnxByteArray::fromHex("2900bcd011590ade010081"))
+                .createFrame())
+            .create().bytes();
+
+        QObject::connect(&m_server, &QTcpServer::newConnection, &m_server, [this]() {
+            m_socket = m_server.nextPendingConnection();
+            QObject::connect(m_socket, &QTcpSocket::readyRead, &m_server, [this]() {
+                readFrames();
+            });
+        });
+    }
+
+    bool listen()
+    {
+        if (m_secure)
+            m_deviceCode = QKnxCryptographicEngine::deviceAuthenticationCodeHash("trustme");
+        return m_server.listen(QHostAddress::LocalHost);
+    }
+
+    quint16 port() const { return m_server.serverPort(); }
+
+private:
+    void readFrames()
+    {
+        m_rx += QKnxByteArray::fromByteArray(m_socket->readAll());
+        forever {
+            const auto peek = QKnxNetIpFramePeek::peek(m_rx);
+            if (peek.status != QKnxNetIpFramePeek::Status::Valid)
+                break;
+
+            if (peek.serviceType == QKnxNetIp::ServiceType::SecureWrapper) {
+                if (m_session.unwrap(m_rx.constData(), peek.totalSize, &m_unwrapped) > 0)
+                    process(m_unwrapped);
+            } else {
+                process(m_rx.mid(0, peek.totalSize));
+            }
+            m_rx.remove(0, peek.totalSize);
+        }
+    }
+
+    void process(const QKnxByteArray &bytes)
+    {
+        const auto peek = QKnxNetIpFramePeek::peek(bytes);
+        switch (peek.serviceType) {
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+            write(m_indication);
+            break;
+        case QKnxNetIp::ServiceType::SessionRequest:
+            processSessionRequest(QKnxNetIpFrame::fromBytes(bytes));
+            break;
+        case QKnxNetIp::ServiceType::SessionAuthenticate:
+            write(QKnxNetIpSessionStatusProxy::builder()
+                .setStatus(QKnxNetIp::SecureSessionStatus::AuthenticationSuccess)
+                .create().bytes());
+            break;
+        case QKnxNetIp::ServiceType::ConnectRequest:
+            write(QKnxNetIpConnectResponseProxy::builder()
+                .setChannelId(ChannelId)
+                .setStatus(QKnxNetIp::Error::None)
+                .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+                    .setHostProtocol(QKnxNetIp::HostProtocol::TCP_IPv4)
+                    .create())
+                .setResponseData(QKnxNetIpCrdProxy::builder()
+                    .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+                    .setIndividualAddress({ QKnxAddress::Type::Individual,
+                        QStringLiteral("1.1.1") })
+                    .create())
+                .create().bytes());
+            break;
+        case QKnxNetIp::ServiceType::ConnectionStateRequest:
+            write(QKnxNetIpConnectionStateResponseProxy::builder()
+                .setChannelId(ChannelId)
+                .setStatus(QKnxNetIp::Error::None)
+                .create().bytes());
+            break;
+        default:
+            break;
+        }
+    }
+
+    void processSessionRequest(const QKnxNetIpFrame &request)
+    {
+        QKnxCurve25519PrivateKey serverKey;
+        const QKnxCurve25519PublicKey serverPublicKey(serverKey);
+        const auto clientPublicKey = QKnxCurve25519PublicKey::fromBytes(
+            QKnxNetIpSessionRequestProxy(request).publicKey());
+
+        auto builder = QKnxNetIpSessionResponseProxy::builder();
+        auto response = builder.setSecureSessionId(SessionId)
+            .setPublicKey(serverPublicKey.bytes())
+            .setMessageAuthenticationCode(QKnxByteArray(16, 0x00))
+            .create();
+        const auto mac = QKnxCryptographicEngine::calculateMessageAuthenticationCode(
+            m_deviceCode, response.header(), SessionId,
+            QKnxCryptographicEngine::XOR(clientPublicKey.bytes(), serverPublicKey.bytes()));
+        response = builder.setMessageAuthenticationCode(QKnxCryptographicEngine
+            ::encryptMessageAuthenticationCode(m_deviceCode, mac)).create();
+
+        // the response is the only frame sent before the session key is in use
+        write(response.bytes());
+        m_session.setSessionKey(SessionId,
+            QKnxCryptographicEngine::sessionKey(clientPublicKey, serverKey));
+    }
+
+    void write(const QKnxByteArray &bytes)
+    {
+        if (!m_session.hasSessionKey()) {
+            m_socket->write(reinterpret_cast<const char *> (bytes.constData()), bytes.size());
+            return;
+        }
+        const auto size = m_session.wrap(bytes.constData(), bytes.size(), &m_wrapped);
+        if (size > 0)
+            m_socket->write(m_wrapped.constData(), size);
+    }
+
+    bool m_secure { false };
+    QTcpServer m_server;
+    QTcpSocket *m_socket { nullptr };
+    QKnxByteArray m_deviceCode;
+    QKnxNetIpSecureSession m_session { 0, {} };
+    QKnxByteArray m_indication;
+    QKnxByteArray m_rx;
+    QKnxByteArray m_unwrapped;
+    QByteArray m_wrapped;
+};
+
+class TunnelLoopback
+{
+public:
+    explicit TunnelLoopback(bool secure)
+        : m_server(secure)
+        , m_secure(secure)
+    {
+        m_frame = QKnxLinkLayerFrame::builder()
+            .setMedium(QKnx::MediumType::NetIP)
+            .setData(QKnxByteArray::fromHex("1100bcd011590ade010081"))
+            .createFrame();
+
+        QObject::connect(&m_tunnel, &QKnxNetIpTunnel::frameReceived, &m_tunnel, [this]() {
+            if (++m_received == m_expected)
+                m_loop.quit();
+        });
+        QObject::connect(&m_tunnel, &QKnxNetIpTunnel::stateChanged, &m_tunnel, [this]() {
+            if (m_tunnel.state() != QKnxNetIpEndpointConnection::State::Connecting)
+                m_loop.quit();
+        });
+
+        m_timeout.setSingleShot(true);
+        m_timeout.setInterval(10000);
+        QObject::connect(&m_timeout, &QTimer::timeout, &m_loop, &QEventLoop::quit);
+    }
+
+    bool connectToServer()
+    {
+        if (!m_server.listen())
+            return false;
+
+        if (m_secure) {
+            QKnxNetIpSecureConfiguration config;
+            config.setUserId(0x01);
+            config.setUserPassword("secret");
+            config.setDeviceAuthenticationCode("trustme");
+            m_tunnel.setSecureConfiguration(config);
+            m_tunnel.connectToHostEncrypted(QHostAddress::LocalHost, m_server.port());
+        } else {
+            m_tunnel.connectToHost(QHostAddress::LocalHost, m_server.port(),
+                QKnxNetIp::HostProtocol::TCP_IPv4);
+        }
+
+        if (m_tunnel.state() == QKnxNetIpEndpointConnection::State::Connecting)
+            run();
+        return m_tunnel.state() == QKnxNetIpEndpointConnection::State::Connected;
+    }
+
+    bool exchange(int frames)
+    {
+        m_received = 0;
+        m_expected = frames;
+        for (int i = 0; i < frames; ++i) {
+            if (!m_tunnel.sendFrame(m_frame))
+                return false;
+        }
+        if (m_received < m_expected)
+            run();
+        return m_received == m_expected;
+    }
+
+private:
+    void run()
+    {
+        m_timeout.start();
+        m_loop.exec();
+        m_timeout.stop();
+    }
+
+    LoopbackServer m_server;
+    bool m_secure { false };
+    QKnxNetIpTunnel m_tunnel;
+    QKnxLinkLayerFrame m_frame;
+    QEventLoop m_loop;
+    QTimer m_timeout;
+    int m_received { 0 };
+    int m_expected { -1 };
+};
+
+}
+
+class tst_bench_QKnxNetIpSecureSession : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void tunnel_data();
+    void tunnel();
+    void tunnelOverhead();
+
+private:
+    bool m_secureAvailable { false };
+};
+
+void tst_bench_QKnxNetIpSecureSession::initTestCase()
+{
+    // keep the per frame debug output of the connection out of the measurement
+    QLoggingCategory::setFilterRules("qt.network.ssl=false\ndefault.debug=false");
+    m_secureAvailable = QKnxOpenSsl::sslLibraryVersionNumber() >= 0x1010000fL;
+}
+
+void tst_bench_QKnxNetIpSecureSession::tunnel_data()
+{
+    QTest::addColumn<bool>("secure");
+    QTest::addColumn<int>("frames");
+
+    QTest::newRow("plaintext") << false << 1000;
+    QTest::newRow("secure") << true << 1000;
+}
+
+void tst_bench_QKnxNetIpSecureSession::tunnel()
+{
+    QFETCH(bool, secure);
+    QFETCH(int, frames);
+
+    if (secure && !m_secureAvailable)
+        QSKIP("OpenSSL 1.1 is required for secure sessions.");
+
+    TunnelLoopback loopback(secure);
+    QVERIFY(loopback.connectToServer());
+
+    QBENCHMARK {
+        QVERIFY(loopback.exchange(frames));
+    }
+}
+
+void tst_bench_QKnxNetIpSecureSession::tunnelOverhead()
+{
+    if (!m_secureAvailable)
+        QSKIP("OpenSSL 1.1 is required for secure sessions.");
+
+    const int frames = 1000;
+    const int rounds = 10;
+
+    TunnelLoopback plaintext(false), secure(true);
+    QVERIFY(plaintext.connectToServer());
+    QVERIFY(secure.connectToServer());
+
+    // warm up both connections, then interleave the rounds so that both
+    // tunnels see the same machine load
+    QVERIFY(plaintext.exchange(frames));
+    QVERIFY(secure.exchange(frames));
+
+    QElapsedTimer timer;
+    qint64 plaintextTime = 0, secureTime = 0;
+    for (int i = 0; i < rounds; ++i) {
+        timer.start();
+        QVERIFY(plaintext.exchange(frames));
+        plaintextTime += timer.nsecsElapsed();
+
+        timer.start();
+        QVERIFY(secure.exchange(frames));
+        secureTime += timer.nsecsElapsed();
+    }
+    QVERIFY(plaintextTime > 0);
+
+    const double ratio = double(secureTime) / double(plaintextTime);
+    qInfo("Secure tunnel takes %.3f times as long as the plaintext tunnel (%.1f%% overhead, "
+        "target 10%%).", ratio, (ratio - 1.) * 100.);
+
+    // machines too noisy for a stable ratio can turn the failure into a warning
+    if (qEnvironmentVariableIsSet("QTKNX_BENCH_OVERHEAD_WARN_ONLY")) {
+        if (ratio > 1.1)
+            QWARN("The secure tunnel exceeds the 10% overhead target.");
+        return;
+    }
+    QVERIFY2(ratio <= 1.1, "The secure tunnel exceeds the 10% overhead target.");
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QKnxNetIpSecureSession)
+
+#include "tst_bench_qknxnetipsecuresession.moc"
@@ -1,5 +1,6 @@
 TEMPLATE = subdirs
-SUBDIRS += auto
+SUBDIRS += auto \
+    benchmarks
 
 CONFIG += no_docs_target
 requires(qtHaveModule(testlib))